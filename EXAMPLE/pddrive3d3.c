@@ -128,7 +128,7 @@ main (int argc, char *argv[])
     
     nprow = 1;            /* Default process rows.      */
     npcol = 1;            /* Default process columns.   */
-    npdep = 1;            /* replication factor must be power of two */
+    npdep = 1;            /* replication factor (number of process layers) */
     nrhs = 1;             /* Number of right-hand side. */
     lookahead = -1;
     colperm = -1;
@@ -335,16 +335,14 @@ main (int argc, char *argv[])
                               nrhs, b, ldb, xtrue, ldx, grid.comm);
     }
     
-    /* Deallocate some storage, including replicated LU structure along
-       the Z dimension. keep around 2D matrix meta structure, including
-       the LU data structure on the host side.  */
+    /* Deallocate some storage. Keep around 2D matrix meta structure,
+       including the LU data structure on the host side, and the LU
+       structure replicated along the Z dimension, so that the next
+       factorization only sends the numerical values to the other layers. */
     Destroy_CompRowLoc_Matrix_dist (&A);
     
     if ( (grid.zscp).Iam == 0 ) { // process layer 0
 	PStatPrint (&options, &stat, &(grid.grid2d)); /* Print 2D statistics.*/
-    } else { // Process layers not equal 0
-        dDeAllocLlu_3d(n, &LUstruct, &grid);
-        dDeAllocGlu_3d(&LUstruct);
     }
     
     PStatFree(&stat);
@@ -411,7 +409,6 @@ main (int argc, char *argv[])
     SUPERLU_FREE (b1);
     SUPERLU_FREE (xtrue1);
     SUPERLU_FREE (berr);
-    fclose(fp);
 
     /* ------------------------------------------------------------
        RELEASE THE SUPERLU PROCESS GRID.
@@ -321,6 +321,10 @@ at the top-level directory.
  *                        matching to permute rows of the original matrix
  *                        to make the diagonal large relative to the
  *                        off-diagonal.
+ *           = LargeDiag_LDM: use a parallel locally dominant matching on
+ *                        the distributed matrix, with equilibration, to
+ *                        make the diagonal large relative to the
+ *                        off-diagonal; the values of A are not gathered.
  *           = MY_PERMR:  use the ordering given in ScalePermstruct->perm_r
  *                        input by the user.
  *
@@ -523,7 +527,7 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 	      structures are not used.                                  */
     fact_t   Fact;
     float   *a;
-    int_t    *colptr, *rowind;
+    int_t    *colptr = NULL, *rowind = NULL;
     int_t    *perm_r; /* row permutations from partial pivoting */
     int_t    *perm_c; /* column permutation vector */
     int_t    *etree;  /* elimination tree */
@@ -590,9 +594,9 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
     Fact = options->Fact;
     if ( Fact < DOFACT || Fact > FACTORED )
 	*info = -1;
-    else if ( options->RowPerm < NOROWPERM || options->RowPerm > MY_PERMR )
+    else if ( options->RowPerm < NOROWPERM || options->RowPerm > LargeDiag_LDM )
 	*info = -1;
-    else if ( options->ColPerm < NATURAL || options->ColPerm > MY_PERMC )
+    else if ( options->ColPerm < NATURAL || options->ColPerm > ND_AT_PLUS_A )
 	*info = -1;
     else if ( options->IterRefine < NOREFINE || options->IterRefine > SLU_EXTRA )
 	*info = -1;
@@ -766,9 +770,11 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 	 * compressed row format to global A in compressed column format.
          * Numerical values are gathered only when a row permutation
          * for large diagonal is sought after.
+         * With ParSymbFact, only MC64 needs A gathered; otherwise
+         * colptr and rowind stay NULL.
          */
 	if ( Fact != SamePattern_SameRowPerm &&
-             (parSymbFact == NO || options->RowPerm != NO) ) {
+             (parSymbFact == NO || options->RowPerm == LargeDiag_MC64) ) {
              /* Performs serial symbolic factorzation and/or MC64 */
 
             need_value = (options->RowPerm == LargeDiag_MC64);
@@ -796,12 +802,13 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 	    if ( Fact != SamePattern_SameRowPerm ) {
 	        if ( options->RowPerm == MY_PERMR ) { /* Use user's perm_r. */
 	            /* Permute the global matrix GA for symbfact() */
-	            for (i = 0; i < colptr[n]; ++i) {
+	            for (i = 0; colptr && i < colptr[n]; ++i) {
 	            	irow = rowind[i];
 		    	rowind[i] = perm_r[irow];
 	            }
-	        } else if ( options->RowPerm == LargeDiag_MC64 ) {
-	            /* Get a new perm_r[] from MC64 */
+	        } else if ( options->RowPerm == LargeDiag_MC64
+	                   || options->RowPerm == LargeDiag_LDM ) {
+	            /* Get a new perm_r[] from MC64 or the distributed matching */
 	            if ( job == 5 ) {
 		        /* Allocate storage for scaling factors. */
 		        if ( !(R1 = floatMalloc_dist(m)) )
@@ -810,7 +817,9 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 		            ABORT("SUPERLU_MALLOC fails for C1[]");
 	            }
 
-	            if ( !iam ) { /* Process 0 finds a row permutation */
+	            if ( options->RowPerm == LargeDiag_LDM ) {
+	                iinfo = psldperm_dist(A, grid, colptr, rowind, perm_r, R1, C1);
+	            } else if ( !iam ) { /* Process 0 finds a row permutation */
 		        iinfo = sldperm_dist(job, m, nnz, colptr, rowind, a_GA,
 		                perm_r, R1, C1);
 
@@ -884,7 +893,7 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 		        } /* end Equil */
 
                         /* Now permute global GA to prepare for symbfact() */
-                        for (j = 0; j < n; ++j) {
+                        for (j = 0; colptr && j < n; ++j) {
 		            for (i = colptr[j]; i < colptr[j+1]; ++i) {
 	                        irow = rowind[i];
 		                rowind[i] = perm_r[irow];
@@ -893,7 +902,7 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 		        SUPERLU_FREE (R1);
 		        SUPERLU_FREE (C1);
 	              } else { /* job = 2,3,4 */
-		        for (j = 0; j < n; ++j) {
+		        for (j = 0; colptr && j < n; ++j) {
 		            for (i = colptr[j]; i < colptr[j+1]; ++i) {
 			        irow = rowind[i];
 			        rowind[i] = perm_r[irow];
@@ -966,6 +975,9 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 	 *   permc_spec = METIS_AT_PLUS_A: METIS on structure of A'+A
 	 *   permc_spec = PARMETIS: parallel METIS on structure of A'+A
 	 *   permc_spec = MY_PERMC: the ordering already supplied in perm_c[]
+	 * With ParSymbFact = YES, ND_AT_PLUS_A is a distributed nested
+	 * dissection (get_perm_c_dnd), which also stands in for PARMETIS
+	 * when ParMETIS is not available.
 	 */
 	permc_spec = options->ColPerm;
 
@@ -994,7 +1006,7 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 		}
 		sizes[2*noDomains - 2] = m;
 		fstVtxSep[2*noDomains - 2] = 0;
-	    } else if ( permc_spec != PARMETIS ) {   /* same as before */
+	    } else if ( permc_spec != PARMETIS && permc_spec != ND_AT_PLUS_A ) {   /* same as before */
 		printf("{" IFMT "," IFMT "}: psgssvx: invalid ColPerm option when ParSymbfact is used\n",
 		       MYROW(grid->iam, grid), MYCOL(grid->iam, grid));
 	    }
@@ -1002,7 +1014,8 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 
 	if ( permc_spec != MY_PERMC && Fact == DOFACT ) {
           /* Reuse perm_c if Fact == SamePattern, or SamePattern_SameRowPerm */
-	  if ( permc_spec == PARMETIS ) {
+	  if ( permc_spec == PARMETIS ||
+	       (parSymbFact == YES && permc_spec == ND_AT_PLUS_A) ) {
 	// #pragma omp parallel
     // {
 	// #pragma omp master
@@ -1012,9 +1025,17 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 	       * and does not modify it.  It also allocates memory for       *
 	       * sizes[] and fstVtxSep[] arrays, that contain information    *
 	       * on the separator tree computed by ParMETIS.                 */
-	      flinfo = get_perm_c_parmetis(A, perm_r, perm_c, nprocs_num,
-                                  	   noDomains, &sizes, &fstVtxSep,
-                                           grid, &symb_comm);
+#ifdef HAVE_PARMETIS
+	      if ( permc_spec == PARMETIS )
+	          flinfo = get_perm_c_parmetis(A, perm_r, perm_c, nprocs_num,
+                                  	       noDomains, &sizes, &fstVtxSep,
+                                               grid, &symb_comm);
+	      else
+#endif
+	      /* Distributed nested dissection, no global A is formed. */
+	      flinfo = get_perm_c_dnd(A, perm_r, perm_c, nprocs_num,
+                                      noDomains, &sizes, &fstVtxSep,
+                                      grid, &symb_comm);
 	// }
 	// }
 	      if (flinfo > 0) {
@@ -1024,6 +1045,10 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 		  *info = flinfo;
 		  return;
      	      }
+	  } else if ( parSymbFact == YES && permc_spec == NATURAL ) {
+	      /* NATURAL: perm_c[] and the trivial tree are set above. */
+	  } else if ( permc_spec == BEST_ORDERING ) {
+	      get_perm_c_race_dist(sp_ienv_dist(12, options), &GA, perm_c, grid);
 	  } else {
 	      get_perm_c_dist(iam, permc_spec, &GA, perm_c);
           }
@@ -1070,8 +1095,8 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 		      SUPERLU_MALLOC(sizeof(Glu_freeable_t))) )
 		    ABORT("Malloc fails for Glu_freeable.");
 
-	    	/* Every process does this. */
-	    	iinfo = symbfact(options, iam, &GAC, perm_c, etree,
+	    	/* Every process does this, or one per node (sp_ienv(13)). */
+	    	iinfo = symbfact_shared(options, grid, &GAC, perm_c, etree,
 			     	 Glu_persist, Glu_freeable);
 			nnzLU = Glu_freeable->nnzLU;
 	    	stat->utime[SYMBFAC] = SuperLU_timer_() - t;
@@ -1118,7 +1143,7 @@ psgssvx_tracking(superlu_dist_options_t *options, SuperMatrix *A,
 	    }
 
             /* Destroy global GA */
-            if ( parSymbFact == NO || options->RowPerm != NO )
+            if ( parSymbFact == NO || options->RowPerm == LargeDiag_MC64 )
                 Destroy_CompCol_Matrix_dist(&GA);
             if ( parSymbFact == NO )
  	        Destroy_CompCol_Permuted_dist(&GAC);
@@ -133,7 +133,7 @@ main (int argc, char *argv[])
 
     nprow = 1;            /* Default process rows.      */
     npcol = 1;            /* Default process columns.   */
-    npdep = 1;            /* replication factor must be power of two */
+    npdep = 1;            /* replication factor (number of process layers) */
     nrhs = 1;             /* Number of right-hand side. */
     lookahead = -1;
     colperm = -1;
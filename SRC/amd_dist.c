@@ -0,0 +1,404 @@
+/*! \file
+Copyright (c) 2003, The Regents of the University of California, through
+Lawrence Berkeley National Laboratory (subject to receipt of any required
+approvals from U.S. Dept. of Energy)
+
+All rights reserved.
+
+The source code is distributed under BSD license, see the file License.txt
+at the top-level directory.
+*/
+/*! @file
+ * \brief Approximate minimum degree ordering of a symmetric pattern
+ *
+ * <pre>
+ * -- Distributed SuperLU routine (version 8.1.2) --
+ * Lawrence Berkeley National Lab, Univ. of California Berkeley.
+ * October 18, 2026
+ *
+ * The algorithm is that of
+ *     P. R. Amestoy, T. A. Davis and I. S. Duff, "An approximate minimum
+ *     degree ordering algorithm", SIAM J. Matrix Anal. Appl. 17 (1996).
+ * The elimination graph is kept implicitly as a quotient graph of
+ * variables (nodes) and elements in one workspace iw[].  Each step
+ * eliminates a node of minimum approximate external degree, merges the
+ * elements adjacent to it into a new element, and updates the degrees of
+ * the nodes in the new element from the set differences |Le \ Lk|.
+ * Indistinguishable nodes are detected by hashing and merged into
+ * supervariables; dense rows are deferred to the end.  The ordering is
+ * the postorder of the resulting assembly tree.
+ *
+ * The routine keeps no static state, so it may be called concurrently
+ * (e.g., on the subdomains of a nested dissection).
+ * </pre>
+ */
+
+#include <math.h>
+#include "superlu_defs.h"
+
+/* Encode a pointer to the parent of an absorbed node or element. */
+#define AMD_FLIP(i)   (-(i)-2)
+
+/*! \brief Make w[e] < mark for all e, resetting w[] when mark would
+ *  overflow.
+ */
+static int_t
+amd_wclear(int_t mark, int_t lemax, int_t *w, int_t n)
+{
+    int_t k;
+
+    if ( mark < 2 || mark + lemax < 0 ) {
+	for (k = 0; k < n; ++k) if ( w[k] != 0 ) w[k] = 1;
+	mark = 2;
+    }
+    return mark;
+}
+
+/*! \brief Garbage collection: move the lists of the live nodes and
+ *  elements to the front of iw[0:iwend-1], and return the new end.
+ */
+static int_t
+amd_compress(int_t n, int_t *pe, int_t *len, int_t *iw, int_t iwend)
+{
+    int_t j, k, p, q;
+
+    /* Mark the head of each object's list with the object's number. */
+    for (j = 0; j < n; ++j) {
+	if ( (p = pe[j]) >= 0 ) {
+	    pe[j] = iw[p];
+	    iw[p] = AMD_FLIP(j);
+	}
+    }
+    for (q = 0, p = 0; p < iwend; ) {
+	if ( (j = AMD_FLIP(iw[p++])) >= 0 ) {
+	    iw[q] = pe[j];
+	    pe[j] = q++;
+	    for (k = 0; k < len[j] - 1; ++k) iw[q++] = iw[p++];
+	}
+    }
+    return q;
+}
+
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *
+ * AMD_ORDER_DIST computes an approximate minimum degree ordering of a
+ * matrix with symmetric nonzero pattern.
+ *
+ * Arguments
+ * =========
+ *
+ * n       (input) int_t
+ *         Order of the matrix.
+ *
+ * colptr  (input) int_t*, of size n+1
+ * rowind  (input) int_t*, of size colptr[n]
+ *         The pattern, with both triangles stored and without the
+ *         diagonal, as returned by at_plus_a_dist().  Not modified.
+ *
+ * perm    (output) int_t*, of size n
+ *         perm[i] = j means that vertex i is the j-th to be eliminated;
+ *         this is the perm_c[] convention of get_perm_c_dist().
+ *
+ * Return value
+ * ============
+ *   = 0: successful exit
+ * </pre>
+ */
+int
+amd_order_dist(int_t n, int_t *colptr, int_t *rowind, int_t *perm)
+{
+    int_t *iw, *pe, *len, *nv, *next, *head, *elen, *degree, *w, *hhead;
+    int_t *last, *post, *work;
+    int_t nnz, iwlen, iwend, dense, nel = 0, mindeg = 0, lemax = 0, mark;
+    int_t i, j, k, e, d, dk, dext, elenk, eln, nvi, nvj, nvk, wnvi;
+    int_t p, p1, p2, p3, p4, pj, pk, pk1, pk2, pn, ln, jlast, k1, k2;
+    int_t h, top;
+    int ok;
+
+    if ( n <= 0 ) return 0;
+    nnz = colptr[n];
+    dense = SUPERLU_MAX(16, 10 * sqrt((double) n));
+    dense = SUPERLU_MIN(n - 2, dense);
+
+    /* Copy the pattern, with elbow room for the new elements. */
+    iwlen = nnz + nnz / 5 + 2 * n + 1;
+    if ( !(iw = intMalloc_dist(iwlen)) ) ABORT("Malloc fails for iw[]");
+    if ( !(work = intMalloc_dist(11 * (n+1))) )
+	ABORT("Malloc fails for work[]");
+    pe = work;
+    len = pe + (n+1);
+    nv = len + (n+1);
+    next = nv + (n+1);
+    head = next + (n+1);
+    elen = head + (n+1);
+    degree = elen + (n+1);
+    w = degree + (n+1);
+    hhead = w + (n+1);
+    last = hhead + (n+1);
+    post = last + (n+1);
+    for (p = 0; p < nnz; ++p) iw[p] = rowind[p];
+    iwend = nnz;
+
+    /* Initialize the quotient graph: every vertex is a node. */
+    for (i = 0; i < n; ++i) {
+	pe[i] = colptr[i];
+	len[i] = colptr[i+1] - colptr[i];
+    }
+    len[n] = 0;
+    for (i = 0; i <= n; ++i) {
+	head[i] = -1;
+	last[i] = -1;
+	next[i] = -1;
+	hhead[i] = -1;
+	nv[i] = 1;
+	w[i] = 1;
+	elen[i] = 0;
+	degree[i] = len[i];
+    }
+    mark = amd_wclear(0, 0, w, n);
+    elen[n] = -2;  /* n is the element that absorbs the dense nodes */
+    pe[n] = -1;
+    w[n] = 0;
+
+    /* Initialize the degree lists. */
+    for (i = 0; i < n; ++i) {
+	d = degree[i];
+	if ( d == 0 ) {         /* isolated node: eliminate now */
+	    elen[i] = -2;
+	    ++nel;
+	    pe[i] = -1;
+	    w[i] = 0;
+	} else if ( d > dense ) { /* dense node: order last */
+	    nv[i] = 0;
+	    elen[i] = -1;
+	    ++nel;
+	    pe[i] = AMD_FLIP(n);
+	    ++nv[n];
+	} else {
+	    if ( head[d] != -1 ) last[head[d]] = i;
+	    next[i] = head[d];
+	    head[d] = i;
+	}
+    }
+
+    while ( nel < n ) {
+	/* Select a node k of minimum approximate degree. */
+	for (k = -1; mindeg < n && (k = head[mindeg]) == -1; ++mindeg) ;
+	if ( next[k] != -1 ) last[next[k]] = -1;
+	head[mindeg] = next[k];
+	elenk = elen[k];
+	nvk = nv[k];
+	nel += nvk;
+
+	if ( elenk > 0 && iwend + mindeg >= iwlen )
+	    iwend = amd_compress(n, pe, len, iw, iwend);
+
+	/* Construct the new element Lk from the nodes adjacent to k and
+	   the nodes of the elements adjacent to k; those elements are
+	   absorbed into k. */
+	dk = 0;
+	nv[k] = -nvk;           /* flag k as being in Lk */
+	p = pe[k];
+	pk1 = (elenk == 0) ? p : iwend;  /* in place if k has no elements */
+	pk2 = pk1;
+	for (k1 = 1; k1 <= elenk + 1; ++k1) {
+	    if ( k1 > elenk ) { /* the nodes adjacent to k */
+		e = k;
+		pj = p;
+		ln = len[k] - elenk;
+	    } else {            /* the nodes of element e */
+		e = iw[p++];
+		pj = pe[e];
+		ln = len[e];
+	    }
+	    for (k2 = 1; k2 <= ln; ++k2) {
+		i = iw[pj++];
+		if ( (nvi = nv[i]) <= 0 ) continue; /* dead, or already in Lk */
+		dk += nvi;
+		nv[i] = -nvi;
+		iw[pk2++] = i;
+		/* Remove i from its degree list. */
+		if ( next[i] != -1 ) last[next[i]] = last[i];
+		if ( last[i] != -1 ) next[last[i]] = next[i];
+		else head[degree[i]] = next[i];
+	    }
+	    if ( e != k ) {
+		pe[e] = AMD_FLIP(k);
+		w[e] = 0;
+	    }
+	}
+	if ( elenk != 0 ) iwend = pk2;
+	degree[k] = dk;
+	pe[k] = pk1;
+	len[k] = pk2 - pk1;
+	elen[k] = -2;           /* k is now an element */
+
+	/* Compute w[e] - mark = |Le \ Lk| for the elements adjacent to the
+	   nodes of Lk. */
+	mark = amd_wclear(mark, lemax, w, n);
+	for (pk = pk1; pk < pk2; ++pk) {
+	    i = iw[pk];
+	    if ( (eln = elen[i]) <= 0 ) continue;
+	    nvi = -nv[i];
+	    wnvi = mark - nvi;
+	    for (p = pe[i]; p <= pe[i] + eln - 1; ++p) {
+		e = iw[p];
+		if ( w[e] >= mark ) w[e] -= nvi;
+		else if ( w[e] != 0 ) w[e] = degree[e] + wnvi;
+	    }
+	}
+
+	/* Update the approximate degrees of the nodes of Lk, prune their
+	   lists, and hash them for the supervariable detection. */
+	for (pk = pk1; pk < pk2; ++pk) {
+	    i = iw[pk];
+	    p1 = pe[i];
+	    p2 = p1 + elen[i] - 1;
+	    pn = p1;
+	    for (h = 0, d = 0, p = p1; p <= p2; ++p) {
+		e = iw[p];
+		if ( w[e] != 0 ) {
+		    dext = w[e] - mark;
+		    if ( dext > 0 ) {
+			d += dext;
+			iw[pn++] = e;
+			h += e;
+		    } else {    /* aggressive absorption: Le is in Lk */
+			pe[e] = AMD_FLIP(k);
+			w[e] = 0;
+		    }
+		}
+	    }
+	    elen[i] = pn - p1 + 1;
+	    p3 = pn;
+	    p4 = p1 + len[i];
+	    for (p = p2 + 1; p < p4; ++p) {
+		j = iw[p];
+		if ( (nvj = nv[j]) <= 0 ) continue;
+		d += nvj;
+		iw[pn++] = j;
+		h += j;
+	    }
+	    if ( d == 0 ) {     /* mass elimination: i only adjacent to k */
+		pe[i] = AMD_FLIP(k);
+		nvi = -nv[i];
+		dk -= nvi;
+		nvk += nvi;
+		nel += nvi;
+		nv[i] = 0;
+		elen[i] = -1;
+	    } else {
+		degree[i] = SUPERLU_MIN(degree[i], d);
+		/* Make k the first element of i. */
+		iw[pn] = iw[p3];
+		iw[p3] = iw[p1];
+		iw[p1] = k;
+		len[i] = pn - p1 + 1;
+		h = ((h < 0) ? -h : h) % n;
+		next[i] = hhead[h];
+		hhead[h] = i;
+		last[i] = h;
+	    }
+	}
+	degree[k] = dk;
+	lemax = SUPERLU_MAX(lemax, dk);
+	mark = amd_wclear(mark + lemax, lemax, w, n);
+
+	/* Merge the indistinguishable nodes of each hash bucket. */
+	for (pk = pk1; pk < pk2; ++pk) {
+	    i = iw[pk];
+	    if ( nv[i] >= 0 ) continue;
+	    h = last[i];
+	    i = hhead[h];
+	    hhead[h] = -1;
+	    for ( ; i != -1 && next[i] != -1; i = next[i], ++mark) {
+		ln = len[i];
+		eln = elen[i];
+		for (p = pe[i] + 1; p <= pe[i] + ln - 1; ++p) w[iw[p]] = mark;
+		jlast = i;
+		for (j = next[i]; j != -1; ) {
+		    ok = (len[j] == ln) && (elen[j] == eln);
+		    for (p = pe[j] + 1; ok && p <= pe[j] + ln - 1; ++p)
+			if ( w[iw[p]] != mark ) ok = 0;
+		    if ( ok ) {  /* absorb j into i */
+			pe[j] = AMD_FLIP(i);
+			nv[i] += nv[j];
+			nv[j] = 0;
+			elen[j] = -1;
+			j = next[j];
+			next[jlast] = j;
+		    } else {
+			jlast = j;
+			j = next[j];
+		    }
+		}
+	    }
+	}
+
+	/* Finalize Lk and put its nodes back in the degree lists. */
+	for (p = pk1, pk = pk1; pk < pk2; ++pk) {
+	    i = iw[pk];
+	    if ( (nvi = -nv[i]) <= 0 ) continue;
+	    nv[i] = nvi;
+	    d = degree[i] + dk - nvi;
+	    d = SUPERLU_MIN(d, n - nel - nvi);
+	    if ( head[d] != -1 ) last[head[d]] = i;
+	    next[i] = head[d];
+	    last[i] = -1;
+	    head[d] = i;
+	    mindeg = SUPERLU_MIN(mindeg, d);
+	    degree[i] = d;
+	    iw[p++] = i;
+	}
+	nv[k] = nvk;
+	if ( (len[k] = p - pk1) == 0 ) { /* k is a root of the assembly tree */
+	    pe[k] = -1;
+	    w[k] = 0;
+	}
+	if ( elenk != 0 ) iwend = p;
+    } /* while nel < n */
+
+    /* Postorder the assembly tree.  Within a parent, the child elements
+       come before the nodes absorbed into it. */
+    for (i = 0; i < n; ++i) pe[i] = AMD_FLIP(pe[i]);
+    for (j = 0; j <= n; ++j) head[j] = -1;
+    for (j = n; j >= 0; --j) {
+	if ( nv[j] > 0 ) continue;      /* an element */
+	next[j] = head[pe[j]];
+	head[pe[j]] = j;
+    }
+    for (e = n; e >= 0; --e) {
+	if ( nv[e] <= 0 ) continue;     /* not an element */
+	if ( pe[e] != -1 ) {
+	    next[e] = head[pe[e]];
+	    head[pe[e]] = e;
+	}
+    }
+    for (k = 0, i = 0; i <= n; ++i) {
+	if ( pe[i] != -1 ) continue;
+	top = 0;                        /* depth-first search from root i */
+	w[0] = i;
+	while ( top >= 0 ) {
+	    p = w[top];
+	    j = head[p];
+	    if ( j == -1 ) {
+		--top;
+		post[k++] = p;
+	    } else {
+		head[p] = next[j];
+		w[++top] = j;
+	    }
+	}
+    }
+
+    /* post[] lists the vertices in elimination order; n comes last. */
+    for (k = 0; k < n; ++k) perm[post[k]] = k;
+
+    SUPERLU_FREE(iw);
+    SUPERLU_FREE(work);
+    return 0;
+} /* amd_order_dist */
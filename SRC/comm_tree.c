@@ -2,6 +2,253 @@
 #include "dcomplex.h"
 #include "superlu_defs.h"
 
+/*
+ * Shapes of the solve trees.
+ *
+ * SUPERLU_TREE selects the shape of every broadcast and reduction tree:
+ *   BINARY    heap-ordered tree of degree DEG_TREE (the default)
+ *   FLAT      the root talks to every other rank
+ *   KARY      heap-ordered tree of degree SUPERLU_TREE_DEG (default 4)
+ *   BINOMIAL  binomial tree, ceil(log2 n) levels
+ *   NODE      a tree over one leader per node, and a tree inside each node
+ *   AUTO      per tree, the shape of least modeled latency for the
+ *             message size and the number of ranks
+ * NODE and AUTO use the node map of the communicator, see C_Tree_SetNodes();
+ * without one NODE falls back to KARY and AUTO to one-level shapes.
+ */
+#define C_TREE_ALPHA_INTER 2.0e-6  /* inter-node latency (s) */
+#define C_TREE_ALPHA_INTRA 5.0e-7  /* intra-node latency (s) */
+#define C_TREE_OVERHEAD    3.0e-7  /* sender overhead per message (s) */
+#define C_TREE_BETA        1.0e-10 /* inverse bandwidth (s/byte) */
+
+static int C_Tree_keyval = MPI_KEYVAL_INVALID;
+
+static int C_Tree_NodeFree(MPI_Comm comm, int keyval, void *attr, void *extra)
+{
+    SUPERLU_FREE(attr);
+    return MPI_SUCCESS;
+}
+
+static int C_Tree_EnvShape(int *deg)
+{
+    char *name = getenv("SUPERLU_TREE"), *ttemp = getenv("SUPERLU_TREE_DEG");
+
+    *deg = ttemp ? SUPERLU_MIN(SUPERLU_MAX(atoi(ttemp), 1), C_TREE_MAXDEST) : 4;
+    if ( !name ) name = "BINARY";
+    if ( !strcmp(name, "FLAT") ) return C_TREE_FLAT;
+    if ( !strcmp(name, "KARY") ) return C_TREE_KARY;
+    if ( !strcmp(name, "BINOMIAL") ) return C_TREE_BINOMIAL;
+    if ( !strcmp(name, "NODE") ) return C_TREE_NODE;
+    if ( !strcmp(name, "AUTO") ) return C_TREE_AUTO;
+    *deg = DEG_TREE;
+    return C_TREE_BINARY;
+}
+
+/*! \brief Attach the node of every rank to comm, for the NODE and AUTO
+ *  tree shapes.  Collective over comm; does nothing for other shapes.
+ */
+void C_Tree_SetNodes(MPI_Comm comm)
+{
+    MPI_Comm nodecomm;
+    int deg, rank, size, leader, *node, shape = C_Tree_EnvShape(&deg);
+
+    if ( comm == MPI_COMM_NULL
+	 || (shape != C_TREE_NODE && shape != C_TREE_AUTO) ) return;
+    if ( C_Tree_keyval == MPI_KEYVAL_INVALID )
+	MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, C_Tree_NodeFree,
+			       &C_Tree_keyval, NULL);
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+			&nodecomm);
+    MPI_Allreduce(&rank, &leader, 1, MPI_INT, MPI_MIN, nodecomm);
+    MPI_Comm_free(&nodecomm);
+    if ( !(node = SUPERLU_MALLOC(size * sizeof(int))) )
+	ABORT("Malloc fails for node[].");
+    MPI_Allgather(&leader, 1, MPI_INT, node, 1, MPI_INT, comm);
+    MPI_Comm_set_attr(comm, C_Tree_keyval, node);
+}
+
+/* Levels below the root of a tree of degree d over n ranks (d = 0:
+   binomial). */
+static int C_Tree_Height(int n, int d)
+{
+    int h = 0, m = 1, w = 1;
+
+    if ( d == 0 ) {
+	while ( m < n ) { m *= 2; ++h; }
+	return h;
+    }
+    while ( m < n ) { w *= d; m += w; ++h; }
+    return h;
+}
+
+/* Modeled latency of a broadcast of the given size; d = 0: binomial. */
+static double C_Tree_Cost(int n, int d, double bytes, double alpha)
+{
+    int h = C_Tree_Height(n, d);
+    double send = C_TREE_OVERHEAD + C_TREE_BETA * bytes;
+    return d == 0 ? h * (alpha + send) : h * (alpha + d * send);
+}
+
+/* Cheapest one-level shape over n ranks with at most maxd children per
+   rank: *deg gets its degree (0 for binomial).  Returns the cost. */
+static double C_Tree_Best(int n, double bytes, double alpha, int maxd,
+			  int *deg)
+{
+    static const int cand[] = {2, 4, 8, 0};
+    double c, best = 1e30;
+    int i;
+
+    *deg = 2;
+    if ( n - 1 <= maxd ) {                /* flat */
+	*deg = SUPERLU_MAX(n - 1, 1);
+	best = C_Tree_Cost(n, *deg, bytes, alpha);
+    }
+    for (i = 0; i < 4; ++i) {
+	if ( cand[i] >= n - 1 || cand[i] > maxd
+	     || (cand[i] == 0 && C_Tree_Height(n, 0) > maxd) ) continue;
+	c = C_Tree_Cost(n, cand[i], bytes, alpha);
+	if ( c < best ) { best = c; *deg = cand[i]; }
+    }
+    return best;
+}
+
+/* par[i] = position of the parent of position i in a one-level tree over
+   positions lo..lo+n-1 rooted at lo; degree d, d = 0: binomial. */
+static void C_Tree_Parents(int *par, int lo, int n, int d)
+{
+    for (int i = 1; i < n; ++i)
+	par[lo + i] = lo + ( d == 0 ? (i & (i - 1)) : (i - 1) / d );
+}
+
+/*! \brief Lay out the tree over ranks[0:rank_cnt-1] (ranks[0] is the root)
+ *  and set myRoot_, myDests_, destCnt_, depth_ and shape_.
+ *
+ *  myDests_ and sendRequests_ are allocated together here, with one
+ *  request per child in a broadcast tree (bcast = 1) and one for the
+ *  message to the parent in a reduction tree (bcast = 0).
+ */
+static void C_Tree_Build(C_Tree* tree, int* ranks, int rank_cnt, int bcast)
+{
+    int deg, d2, i, j, n = rank_cnt, me = 0, nnode = 0, shape, autosel, nreq;
+    int *order, *par, *depth, *node = NULL, *lead, flag;
+    double bytes;
+
+    shape = C_Tree_EnvShape(&deg);
+    d2 = deg;
+    autosel = ( shape == C_TREE_AUTO );
+    MPI_Type_size(tree->type_, &i);
+    bytes = (double) tree->msgSize_ * i;
+
+    if ( !(order = SUPERLU_MALLOC(4 * SUPERLU_MAX(n, 1) * sizeof(int))) )
+	ABORT("Malloc fails for order[].");
+    par = order + n;
+    depth = par + n;
+    lead = depth + n;
+    for (i = 0; i < n; ++i) order[i] = ranks[i];
+
+    if ( (shape == C_TREE_NODE || shape == C_TREE_AUTO)
+	 && C_Tree_keyval != MPI_KEYVAL_INVALID ) {
+	MPI_Comm_get_attr(tree->comm_, C_Tree_keyval, &node, &flag);
+	if ( !flag ) node = NULL;
+    }
+    if ( node ) {
+	/* One leader per node, the first of its ranks in the list. */
+	for (i = 0; i < n; ++i) {
+	    for (j = 0; j < nnode; ++j)
+		if ( node[ranks[lead[j]]] == node[ranks[i]] ) break;
+	    if ( j == nnode ) lead[nnode++] = i;
+	}
+	if ( autosel && (nnode == 1 || nnode == n) ) node = NULL;
+    }
+    if ( shape == C_TREE_NODE && !node ) shape = C_TREE_KARY;
+    if ( shape == C_TREE_NODE ) d2 = deg = SUPERLU_MIN(deg, C_TREE_MAXDEST / 2);
+
+    if ( autosel && node ) {
+	/* Two levels if they beat one level at the inter-node latency. */
+	int gmax = 0;
+	for (j = 0; j < nnode; ++j) {
+	    int g = 0;
+	    for (i = 0; i < n; ++i) g += node[ranks[i]] == node[ranks[lead[j]]];
+	    gmax = SUPERLU_MAX(gmax, g);
+	}
+	if ( C_Tree_Best(nnode, bytes, C_TREE_ALPHA_INTER, C_TREE_MAXDEST / 2,
+			 &deg)
+	     + C_Tree_Best(gmax, bytes, C_TREE_ALPHA_INTRA, C_TREE_MAXDEST / 2,
+			   &d2)
+	     < C_Tree_Best(n, bytes, C_TREE_ALPHA_INTER, C_TREE_MAXDEST, &i) )
+	    shape = C_TREE_NODE;
+	else
+	    node = NULL;
+    }
+
+    if ( shape == C_TREE_NODE ) {
+	/* Leaders first, then the other ranks of each node in turn;
+	   deg is the degree between nodes, d2 inside a node. */
+	int m = nnode, lo, p, q;
+	for (j = 0; j < nnode; ++j) order[j] = ranks[lead[j]];
+	C_Tree_Parents(par, 0, nnode, deg);
+	for (j = 0; j < nnode; ++j) {
+	    int g = node[order[j]];
+	    lo = m;
+	    for (i = 0; i < n; ++i)
+		if ( node[ranks[i]] == g && ranks[i] != order[j] )
+		    order[m++] = ranks[i];
+	    /* The leader heads the tree of its node. */
+	    for (i = lo; i < m; ++i) {
+		q = i - lo + 1;
+		p = d2 == 0 ? (q & (q - 1)) : (q - 1) / d2;
+		par[i] = p == 0 ? j : lo + p - 1;
+	    }
+	}
+    } else {
+	if ( autosel ) {
+	    C_Tree_Best(n, bytes, C_TREE_ALPHA_INTER, C_TREE_MAXDEST, &deg);
+	    shape = deg == n - 1 ? C_TREE_FLAT : deg == 0 ? C_TREE_BINOMIAL
+		: deg == 2 ? C_TREE_BINARY : C_TREE_KARY;
+	}
+	if ( shape == C_TREE_FLAT ) {
+	    if ( n - 1 > C_TREE_MAXDEST ) shape = C_TREE_KARY;
+	    deg = SUPERLU_MAX(SUPERLU_MIN(n - 1, C_TREE_MAXDEST), 1);
+	}
+	if ( shape == C_TREE_BINOMIAL ) deg = 0;
+	C_Tree_Parents(par, 0, n, deg);
+    }
+
+    /* Every parent precedes its children. */
+    par[0] = -1;
+    depth[0] = 0;
+    tree->depth_ = 0;
+    for (i = 0; i < n; ++i) {
+	if ( order[i] == tree->myRank_ ) me = i;
+	if ( i ) depth[i] = depth[par[i]] + 1;
+	tree->depth_ = SUPERLU_MAX(tree->depth_, depth[i]);
+    }
+    tree->shape_ = shape;
+    tree->myRoot_ = me ? order[par[me]] : tree->myRank_;
+    tree->destCnt_ = 0;
+    for (i = me + 1; i < n; ++i) tree->destCnt_ += ( par[i] == me );
+    nreq = bcast ? tree->destCnt_ : ( me ? 1 : 0 );
+    if ( nreq + tree->destCnt_ > 0 ) {
+	if ( !(tree->sendRequests_ = SUPERLU_MALLOC(nreq * sizeof(MPI_Request)
+					+ tree->destCnt_ * sizeof(int))) )
+	    ABORT("Malloc fails for sendRequests_[].");
+	tree->myDests_ = (int *) (tree->sendRequests_ + nreq);
+	for (i = 0; i < nreq; ++i) tree->sendRequests_[i] = MPI_REQUEST_NULL;
+    }
+    tree->destCnt_ = 0;
+    if ( shape == C_TREE_BINOMIAL ) {
+	/* The largest subtree first. */
+	for (i = n - 1; i > me; --i)
+	    if ( par[i] == me ) tree->myDests_[tree->destCnt_++] = order[i];
+    } else {
+	for (i = me + 1; i < n; ++i)
+	    if ( par[i] == me ) tree->myDests_[tree->destCnt_++] = order[i];
+    }
+    SUPERLU_FREE(order);
+}
+
 	void C_BcTree_Create(C_Tree* tree, MPI_Comm comm, int* ranks, int rank_cnt, int msgSize, char precision){
 		assert(msgSize>0);
 
@@ -13,10 +260,11 @@
       tree->myRoot_= -1; 
       tree->tag_=-1;
       tree->destCnt_=0;
-      tree->myDests_[0]=-1;
-      tree->myDests_[1]=-1;
-	  tree->sendRequests_[0]=MPI_REQUEST_NULL;
-	  tree->sendRequests_[1]=MPI_REQUEST_NULL;
+	  tree->myDests_=NULL;
+	  tree->sendRequests_=NULL;
+      tree->depth_=0;
+      tree->shape_=C_TREE_BINARY;
+      tree->wait_=0.0;
       tree->empty_= NO;  // non-empty if rank_cnt>1
 	  if(precision=='d'){
 	  tree->type_=MPI_DOUBLE;
@@ -32,25 +280,7 @@
 	     tree->type_=MPI_C_COMPLEX;
 	 }
 
-      int myIdx = 0;
-      int ii=0; 
-	  int child,root;
-	  for (ii=0;ii<rank_cnt;ii++)
-		  if(tree->myRank_ == ranks[ii]){
-			  myIdx = ii;
-			  break;
-		  }
-	  for (ii=0;ii<DEG_TREE;ii++){
-		  if(myIdx*DEG_TREE+1+ii<rank_cnt){
-			   child = ranks[myIdx*DEG_TREE+1+ii];
-			   tree->myDests_[tree->destCnt_++]=child;
-		  }		
-	  }
-	  if(myIdx!=0){
-		  tree->myRoot_ = ranks[(int)floor((double)(myIdx-1.0)/(double)DEG_TREE)];
-	  }else{
-		  tree->myRoot_ = tree->myRank_;
-	  } 
+	  C_Tree_Build(tree, ranks, rank_cnt, 1);
     }
 
 	void C_BcTree_Nullify(C_Tree* tree){
@@ -59,15 +289,22 @@
       tree->myRoot_= -1; 
       tree->tag_=-1;
       tree->destCnt_=0;
-      tree->myDests_[0]=-1;
-      tree->myDests_[1]=-1;
-	  tree->sendRequests_[0]=MPI_REQUEST_NULL;
-	  tree->sendRequests_[1]=MPI_REQUEST_NULL;
+	  tree->myDests_=NULL;
+	  tree->sendRequests_=NULL;
+      tree->depth_=0;
+      tree->shape_=C_TREE_BINARY;
+      tree->wait_=0.0;
       tree->empty_= YES; 
 	  tree->comm_=MPI_COMM_NULL;
 	  tree->type_=MPI_DATATYPE_NULL; 
 	}	
 
+	/* Free the arrays of a tree made by C_BcTree_Create(). */
+	void C_BcTree_Destroy(C_Tree* tree){
+	  if ( tree->sendRequests_ ) SUPERLU_FREE(tree->sendRequests_);
+	  C_BcTree_Nullify(tree);
+	}
+
 	yes_no_t C_BcTree_IsRoot(C_Tree* tree){
 		return tree->myRoot_ == tree->myRank_?YES:NO;
 	}
@@ -81,9 +318,11 @@
           int error_code = MPI_Isend( localBuffer, msgSize, tree->type_, 
               iProc, tree->tag_,tree->comm_, &tree->sendRequests_[idxRecv] );
 			  
-			  if(getenv("COMM_TREE_MPI_WAIT"))
+			  if(getenv("COMM_TREE_MPI_WAIT")){
+				  double t1 = SuperLU_timer_();
 			  	  MPI_Wait(&tree->sendRequests_[idxRecv],&status) ; 
-			  else
+				  tree->wait_ += SuperLU_timer_() - t1;
+			  }else
 				  MPI_Test(&tree->sendRequests_[idxRecv],&flag,&status) ; 
 				  
 			  
@@ -93,9 +332,11 @@
 
 	void C_BcTree_waitSendRequest(C_Tree* tree){
         MPI_Status status;
+		double t1 = SuperLU_timer_();
 		for( int idxRecv = 0; idxRecv < tree->destCnt_; ++idxRecv ){
 			  MPI_Wait(&tree->sendRequests_[idxRecv],&status) ; 
         } // for (iProc)
+		tree->wait_ += SuperLU_timer_() - t1;
 	}
 	
 	void C_RdTree_Create(C_Tree* tree, MPI_Comm comm, int* ranks, int rank_cnt, int msgSize, char precision){
@@ -109,10 +350,11 @@
       tree->myRoot_= -1; 
       tree->tag_=-1;
       tree->destCnt_=0;
-      tree->myDests_[0]=-1;
-      tree->myDests_[1]=-1;
-	  tree->sendRequests_[0]=MPI_REQUEST_NULL;
-	  tree->sendRequests_[1]=MPI_REQUEST_NULL;
+	  tree->myDests_=NULL;
+	  tree->sendRequests_=NULL;
+      tree->depth_=0;
+      tree->shape_=C_TREE_BINARY;
+      tree->wait_=0.0;
       tree->empty_= NO;  // non-empty if rank_cnt>1
 	  if(precision=='d'){
 		  tree->type_=MPI_DOUBLE;
@@ -127,28 +369,7 @@
 	  if(precision=='s'){
 	      tree->type_=MPI_FLOAT;
 	  }	  
-      int myIdx = 0;
-      int ii=0; 
-	  int child,root;
-	  for (ii=0;ii<rank_cnt;ii++)
-		  if(tree->myRank_ == ranks[ii]){
-			  myIdx = ii;
-			  break;
-		  }
-
-		  
-	  for (ii=0;ii<DEG_TREE;ii++){
-		  if(myIdx*DEG_TREE+1+ii<rank_cnt){
-			   child = ranks[myIdx*DEG_TREE+1+ii];
-			   tree->myDests_[tree->destCnt_++]=child;
-		  }		
-	  }		  
-		  
-	  if(myIdx!=0){
-		  tree->myRoot_ = ranks[(int)floor((double)(myIdx-1.0)/(double)DEG_TREE)];
-	  }else{
-		  tree->myRoot_ = tree->myRank_;
-	  }  
+	  C_Tree_Build(tree, ranks, rank_cnt, 0);
     }
 
 	void C_RdTree_Nullify(C_Tree* tree){
@@ -157,15 +378,22 @@
       tree->myRoot_= -1; 
       tree->tag_=-1;
       tree->destCnt_=0;
-      tree->myDests_[0]=-1;
-      tree->myDests_[1]=-1;
-	  tree->sendRequests_[0]=MPI_REQUEST_NULL;
-	  tree->sendRequests_[1]=MPI_REQUEST_NULL;
+	  tree->myDests_=NULL;
+	  tree->sendRequests_=NULL;
+      tree->depth_=0;
+      tree->shape_=C_TREE_BINARY;
+      tree->wait_=0.0;
       tree->empty_= YES; 
 	  tree->comm_=MPI_COMM_NULL;
 	  tree->type_=MPI_DATATYPE_NULL; 
 	}	
 
+	/* Free the arrays of a tree made by C_RdTree_Create(). */
+	void C_RdTree_Destroy(C_Tree* tree){
+	  if ( tree->sendRequests_ ) SUPERLU_FREE(tree->sendRequests_);
+	  C_RdTree_Nullify(tree);
+	}
+
 
 	yes_no_t C_RdTree_IsRoot(C_Tree* tree){
 		return tree->myRoot_ == tree->myRank_?YES:NO;
@@ -183,9 +411,11 @@
 			  int error_code = MPI_Isend(localBuffer, msgSize, Tree->type_, 
 				  iProc, Tree->tag_,Tree->comm_, &Tree->sendRequests_[0] );
 					
-					if(getenv("COMM_TREE_MPI_WAIT"))
+					if(getenv("COMM_TREE_MPI_WAIT")){
+						double t1 = SuperLU_timer_();
 						MPI_Wait(&Tree->sendRequests_[0],&status) ; 
-					else
+						Tree->wait_ += SuperLU_timer_() - t1;
+					}else
 						MPI_Test(&Tree->sendRequests_[0],&flag,&status) ; 					  
 						
 				  // std::cout<<Tree->myRank_<<" FWD to "<<iProc<<" on tag "<<Tree->tag_<<std::endl;
@@ -195,7 +425,43 @@
 	void C_RdTree_waitSendRequest(C_Tree* Tree){
         MPI_Status status;		
 		if(Tree->myRank_!=Tree->myRoot_){  // not sure about this if condition
+		  double t1 = SuperLU_timer_();
 		  MPI_Wait(&Tree->sendRequests_[0],&status) ; 
+		  Tree->wait_ += SuperLU_timer_() - t1;
         }			
 	}
 	
+
+/*! \brief Print the depth and send-wait time of a set of trees.
+ *
+ * Collective over comm.  Every tree is counted once, at its root; the
+ * wait time is the time spent completing sends, summed over all ranks.
+ */
+void C_Tree_Stats(char *name, C_Tree* trees, int ntrees, MPI_Comm comm)
+{
+    double loc[3 + C_TREE_AUTO] = {0.0}, sum[3 + C_TREE_AUTO];
+    double lmax[2] = {0.0, 0.0}, gmax[2];
+    int i, rank;
+
+    for (i = 0; i < ntrees; ++i) {
+	if ( trees[i].empty_ == YES ) continue;
+	loc[2] += trees[i].wait_;
+	lmax[1] = SUPERLU_MAX(lmax[1], trees[i].wait_);
+	if ( C_BcTree_IsRoot(&trees[i]) == NO ) continue;
+	loc[0] += 1.0;
+	loc[1] += trees[i].depth_;
+	loc[3 + trees[i].shape_] += 1.0;
+	lmax[0] = SUPERLU_MAX(lmax[0], trees[i].depth_);
+    }
+    MPI_Reduce(loc, sum, 3 + C_TREE_AUTO, MPI_DOUBLE, MPI_SUM, 0, comm);
+    MPI_Reduce(lmax, gmax, 2, MPI_DOUBLE, MPI_MAX, 0, comm);
+    MPI_Comm_rank(comm, &rank);
+    if ( rank == 0 && sum[0] > 0.0 )
+	printf(".. %-9s trees %8.0f, depth avg %5.2f max %2.0f,"
+	       " send wait %8.2e s (max per tree %8.2e s);"
+	       " binary %.0f flat %.0f k-ary %.0f binomial %.0f node %.0f\n",
+	       name, sum[0], sum[1] / sum[0], gmax[0], sum[2], gmax[1],
+	       sum[3 + C_TREE_BINARY], sum[3 + C_TREE_FLAT],
+	       sum[3 + C_TREE_KARY], sum[3 + C_TREE_BINOMIAL],
+	       sum[3 + C_TREE_NODE]);
+}
@@ -234,3 +234,1643 @@ int_t LDiagBlockRecvWait( int_t k,   int_t* factored_U,
     return 0;
 }
 
+
+/*
+ * Hierarchical panel broadcast through node-shared slots.
+ *
+ * The ranks of one scope (process row or column) are split into node
+ * groups.  The owner of a panel sends it once per group, to the lowest
+ * ranked reader in that group (the delegate), which receives it into a
+ * slot of a shared-memory window; the other readers of the group read the
+ * slot in place once the delegate has stamped it with the supernode number.
+ * All the ranks of a group go through the same sequence of panels in each
+ * slot, but not in step: a rank releases the panel it read from a slot when
+ * it reaches the next panel of that slot, and the delegate of a panel waits
+ * until the readers of all the earlier panels of the slot have released it.
+ *
+ * Slot layout: a 64-byte header of ints, the index part, the value part.
+ */
+#define SHM_READY 0   /* supernode held in the slot */
+#define SHM_DONE  1   /* releases so far, over all panels of the slot */
+#define SHM_NSUB  2   /* received length of the index part */
+#define SHM_NVAL  3   /* received length of the value part */
+#define SHM_HDR   64
+#define SHM_ALIGN(b) ( ((b) + SHM_HDR - 1) / SHM_HDR * SHM_HDR )
+
+/*! \brief Size of the node groups requested through SUPERLU_SHM_BCAST.
+ *
+ * 0 (the default) keeps the flat broadcast, 1 groups all the ranks of a
+ * node, n > 1 groups at most n ranks of a node, e.g. one socket.
+ */
+int shmBcastGroupSize(void)
+{
+    char *ttemp = getenv("SUPERLU_SHM_BCAST");
+    int g;
+
+    if ( !ttemp ) return 0;
+    g = atoi(ttemp);
+    return SUPERLU_MAX(g, 0);
+}
+
+static int shmBcastHdr(shmBcast_t *sh, int s, int i, int v, MPI_Op op)
+{
+    int old;
+    MPI_Fetch_and_op(&v, &old, MPI_INT, 0,
+		     (MPI_Aint) s * sh->slotsize + i * sizeof(int), op, sh->win);
+    MPI_Win_flush(0, sh->win);
+    return old;
+}
+
+/*! \brief Set up the node groups and the shared slots of a scope.
+ *
+ * Collective over scope.  need[k] = 1 if this rank reads panel k through
+ * the scope.  Returns NULL if the hierarchical broadcast is not requested
+ * or no group has more than one rank; the flat broadcast is used then.
+ */
+shmBcast_t *shmBcastInit(MPI_Comm scope, int nslots, int_t nsupers,
+			 int need[], int subcnt, MPI_Datatype tsub,
+			 int valcnt, MPI_Datatype tval)
+{
+    shmBcast_t *sh;
+    MPI_Comm node, grp;
+    MPI_Aint wsize, subbytes, valbytes;
+    int disp, g, iam, Np, nrank, gsize, maxsize, lead, s, subsize, valsize;
+    int_t k;
+    char *base;
+
+    if ( (g = shmBcastGroupSize()) == 0 || nslots <= 0 ) return NULL;
+    MPI_Comm_rank(scope, &iam);
+    MPI_Comm_size(scope, &Np);
+    MPI_Comm_split_type(scope, MPI_COMM_TYPE_SHARED, iam, MPI_INFO_NULL,
+			&node);
+    if ( g > 1 ) {
+	MPI_Comm_rank(node, &nrank);
+	MPI_Comm_split(node, nrank / g, nrank, &grp);
+	MPI_Comm_free(&node);
+    } else grp = node;
+    MPI_Comm_size(grp, &gsize);
+    MPI_Allreduce(&gsize, &maxsize, 1, MPI_INT, MPI_MAX, scope);
+    if ( maxsize == 1 ) {
+	MPI_Comm_free(&grp);
+	return NULL;
+    }
+
+    if ( !(sh = (shmBcast_t *) SUPERLU_MALLOC(sizeof(shmBcast_t))) )
+	ABORT("Malloc fails for shmBcast_t.");
+    sh->scope = scope;
+    sh->comm = grp;
+    sh->tsub = tsub;
+    sh->tval = tval;
+    sh->Np = Np;
+    sh->nslots = nslots;
+    sh->subcnt = subcnt;
+    sh->valcnt = valcnt;
+    sh->phase = COMM_PANEL_L;
+    MPI_Comm_rank(grp, &sh->rank);
+    lead = iam;
+    MPI_Bcast(&lead, 1, MPI_INT, 0, grp);
+    if ( !(sh->leader = SUPERLU_MALLOC(2 * Np * sizeof(int))) )
+	ABORT("Malloc fails for sh->leader[].");
+    sh->first = sh->leader + Np;
+    MPI_Allgather(&lead, 1, MPI_INT, sh->leader, 1, MPI_INT, scope);
+
+    /* The delegate of k is the lowest ranked reader of k in the group. */
+    k = SUPERLU_MAX(nsupers, 1);
+    if ( !(sh->dlg = SUPERLU_MALLOC(2 * k * sizeof(int))) )
+	ABORT("Malloc fails for sh->dlg[].");
+    sh->nrd = sh->dlg + nsupers;
+    for (k = 0; k < nsupers; ++k) {
+	sh->dlg[k] = need[k] ? sh->rank : INT_MAX;
+	sh->nrd[k] = need[k] ? 1 : 0;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, sh->dlg, nsupers, MPI_INT, MPI_MIN, grp);
+    MPI_Allreduce(MPI_IN_PLACE, sh->nrd, nsupers, MPI_INT, MPI_SUM, grp);
+    for (k = 0; k < nsupers; ++k)
+	if ( sh->dlg[k] == INT_MAX ) sh->dlg[k] = -1;
+
+    MPI_Type_size(tsub, &subsize);
+    MPI_Type_size(tval, &valsize);
+    subbytes = SHM_ALIGN((MPI_Aint) subcnt * subsize);
+    valbytes = SHM_ALIGN((MPI_Aint) valcnt * valsize);
+    sh->slotsize = SHM_HDR + subbytes + valbytes;
+    MPI_Win_allocate_shared(sh->rank == 0 ? nslots * sh->slotsize : 0, 1,
+			    MPI_INFO_NULL, grp, &base, &sh->win);
+    MPI_Win_shared_query(sh->win, 0, &wsize, &disp, &base);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, sh->win);
+    if ( sh->rank == 0 ) {
+	for (s = 0; s < nslots; ++s) {
+	    int *hdr = (int *) (base + s * sh->slotsize);
+	    hdr[SHM_READY] = -1;
+	    hdr[SHM_DONE] = hdr[SHM_NSUB] = hdr[SHM_NVAL] = 0;
+	}
+    }
+    MPI_Win_sync(sh->win);
+    MPI_Barrier(grp);
+    MPI_Win_sync(sh->win);
+
+    if ( !(sh->sub = SUPERLU_MALLOC(nslots * (sizeof(int_t *) + sizeof(void *)
+					      + 2 * sizeof(int_t)
+					      + 5 * sizeof(int)))) )
+	ABORT("Malloc fails for sh->sub[].");
+    sh->val = (void **) (sh->sub + nslots);
+    sh->held = (int_t *) (sh->val + nslots);
+    sh->pend = sh->held + nslots;
+    sh->psrc = (int *) (sh->pend + nslots);
+    sh->gate = sh->psrc + 3 * nslots;
+    sh->cum = sh->gate + nslots;
+    for (s = 0; s < nslots; ++s) {
+	sh->sub[s] = (int_t *) (base + s * sh->slotsize + SHM_HDR);
+	sh->val[s] = base + s * sh->slotsize + SHM_HDR + subbytes;
+	sh->held[s] = sh->pend[s] = -1;
+	sh->gate[s] = sh->cum[s] = 0;
+    }
+    return sh;
+}
+
+/*! \brief Free the shared slots.  Collective over the node group. */
+void shmBcastFree(shmBcast_t *sh)
+{
+    if ( !sh ) return;
+    MPI_Win_unlock_all(sh->win);
+    MPI_Win_free(&sh->win);
+    MPI_Comm_free(&sh->comm);
+    SUPERLU_FREE(sh->leader);
+    SUPERLU_FREE(sh->dlg);
+    SUPERLU_FREE(sh->sub);
+    SUPERLU_FREE(sh);
+}
+
+/*! \brief Slot whose index part is sub[], or -1 for a private buffer. */
+int shmBcastSlot(shmBcast_t *sh, void *sub)
+{
+    if ( sh )
+	for (int s = 0; s < sh->nslots; ++s)
+	    if ( sh->sub[s] == sub ) return s;
+    return -1;
+}
+
+/*! \brief Slot from which this rank reads supernode k, or -1. */
+int shmBcastHeld(shmBcast_t *sh, int_t k)
+{
+    if ( sh )
+	for (int s = 0; s < sh->nslots; ++s)
+	    if ( sh->held[s] == k ) return s;
+    return -1;
+}
+
+/*! \brief Move on to panel k in slot s.
+ *
+ * Every rank of the group calls this for every panel of the slot, in the
+ * same order.  It releases the previous panel, if this rank read it.
+ */
+void shmBcastNext(shmBcast_t *sh, int s, int_t k)
+{
+    if ( sh->held[s] >= 0 ) {
+	MPI_Win_sync(sh->win);
+	shmBcastHdr(sh, s, SHM_DONE, 1, MPI_SUM);
+	sh->held[s] = -1;
+    }
+    sh->gate[s] = sh->cum[s];
+    sh->cum[s] += sh->nrd[k];
+}
+
+/*! \brief Send a panel once per node group.
+ *
+ * Scope rank p reads the panel if p != self and to is NULL or
+ * to[p] != SLU_EMPTY.  The requests of the ranks that are served by their
+ * delegate are set to MPI_REQUEST_NULL.
+ */
+int_t shmBcastIsend(shmBcast_t *sh, int to[], int self,
+		    void *sub, int nsub, void *val, int nval,
+		    int tag0, int tag1, MPI_Request *send_req)
+{
+    int p, Np = sh->Np;
+
+    for (p = 0; p < Np; ++p) sh->first[p] = -1;
+    for (p = 0; p < Np; ++p) {
+	if ( p == self || (to && to[p] == SLU_EMPTY) ) continue;
+	if ( sh->first[sh->leader[p]] < 0 ) {
+	    sh->first[sh->leader[p]] = p;
+	    commProfSend(sh->phase, sh->scope, p, nsub, sh->tsub);
+	    commProfSend(sh->phase, sh->scope, p, nval, sh->tval);
+	    MPI_Isend(sub, nsub, sh->tsub, p, tag0, sh->scope, &send_req[p]);
+	    MPI_Isend(val, nval, sh->tval, p, tag1, sh->scope,
+		      &send_req[p + Np]);
+	} else {
+	    send_req[p] = send_req[p + Np] = MPI_REQUEST_NULL;
+	}
+    }
+    return 0;
+}
+
+static void shmBcastPost(shmBcast_t *sh, int s, MPI_Request *recv_req)
+{
+    int *src = &sh->psrc[3 * s];
+
+    MPI_Irecv(sh->sub[s], sh->subcnt, sh->tsub, src[0], src[1], sh->scope,
+	      &recv_req[0]);
+    MPI_Irecv(sh->val[s], sh->valcnt, sh->tval, src[0], src[2], sh->scope,
+	      &recv_req[1]);
+    sh->pend[s] = -1;
+}
+
+/*! \brief Register this rank as a reader of panel k in slot s.
+ *
+ * Called after shmBcastNext().  The delegate places the receives from src
+ * at once if the slot is free, and otherwise defers them to shmBcastWait().
+ */
+int_t shmBcastIrecv(shmBcast_t *sh, int s, int_t k, int src,
+		    int tag0, int tag1, MPI_Request *recv_req)
+{
+    sh->held[s] = k;
+    recv_req[0] = recv_req[1] = MPI_REQUEST_NULL;
+    if ( sh->dlg[k] != sh->rank ) return 0;
+    sh->pend[s] = k;
+    sh->psrc[3 * s] = src;
+    sh->psrc[3 * s + 1] = tag0;
+    sh->psrc[3 * s + 2] = tag1;
+    if ( shmBcastHdr(sh, s, SHM_DONE, 0, MPI_NO_OP) == sh->gate[s] )
+	shmBcastPost(sh, s, recv_req);
+    return 0;
+}
+
+/*! \brief Wait until panel k is in slot s; cnt[0:1] get its lengths. */
+int_t shmBcastWait(shmBcast_t *sh, int s, int_t k,
+		   MPI_Request *recv_req, int *cnt)
+{
+    MPI_Status status;
+    int flag;
+
+    if ( sh->dlg[k] == sh->rank ) {
+	if ( sh->pend[s] == k ) {
+	    while ( shmBcastHdr(sh, s, SHM_DONE, 0, MPI_NO_OP) != sh->gate[s] )
+		MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, sh->scope, &flag,
+			   &status);
+	    shmBcastPost(sh, s, recv_req);
+	}
+	MPI_Wait(&recv_req[0], &status);
+	MPI_Get_count(&status, sh->tsub, &cnt[0]);
+	MPI_Wait(&recv_req[1], &status);
+	MPI_Get_count(&status, sh->tval, &cnt[1]);
+	shmBcastHdr(sh, s, SHM_NSUB, cnt[0], MPI_REPLACE);
+	shmBcastHdr(sh, s, SHM_NVAL, cnt[1], MPI_REPLACE);
+	MPI_Win_sync(sh->win);
+	shmBcastHdr(sh, s, SHM_READY, (int) k, MPI_REPLACE);
+    } else {
+	while ( shmBcastHdr(sh, s, SHM_READY, 0, MPI_NO_OP) != k )
+	    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, sh->scope, &flag, &status);
+	MPI_Win_sync(sh->win);
+	cnt[0] = shmBcastHdr(sh, s, SHM_NSUB, 0, MPI_NO_OP);
+	cnt[1] = shmBcastHdr(sh, s, SHM_NVAL, 0, MPI_NO_OP);
+    }
+    return 0;
+}
+
+/*
+ * Segmented, pipelined tree broadcast of large panels.
+ *
+ * The readers of panel k are known to every rank of the scope, so each of
+ * them builds the same tree: the owner at the root, the readers in scope
+ * rank order starting after the owner, heap-ordered with degree deg.  The
+ * index part goes from the owner to every reader as in the flat broadcast;
+ * a reader learns the length of the value part from it.  A value part of
+ * at most one segment also goes flat from the owner, a longer one goes down
+ * the tree in segments.  A relay receives the segments of a panel in order
+ * from its parent and passes each on to its children before it waits for
+ * the next one.
+ */
+
+/*! \brief Segment length in bytes requested through SUPERLU_BCAST_SEG;
+ *  0 (the default) keeps the flat broadcast.
+ */
+static int segBcastSize(void)
+{
+    char *ttemp = getenv("SUPERLU_BCAST_SEG");
+    return ttemp ? SUPERLU_MAX(atoi(ttemp), 0) : 0;
+}
+
+/*! \brief Set up the tree broadcast of a scope.
+ *
+ * Collective over scope.  sub[s] and val[s] are the receive buffers of
+ * slot s, need[k] = 1 if this rank reads panel k through the scope.
+ * Returns NULL if the tree broadcast is not requested or the scope is too
+ * small for a tree.
+ */
+segBcast_t *segBcastInit(MPI_Comm scope, int nslots, int_t *sub[],
+			 void *val[], int_t nsupers, int need[], int subcnt,
+			 MPI_Datatype tsub, MPI_Datatype tval)
+{
+    segBcast_t *sb;
+    unsigned *mine;
+    char *ttemp;
+    int bytes, iam, Np, nwords, s, w;
+    int_t k;
+
+    if ( (bytes = segBcastSize()) == 0 || nslots <= 0 ) return NULL;
+    MPI_Comm_size(scope, &Np);
+    if ( Np < 3 ) return NULL;
+    MPI_Comm_rank(scope, &iam);
+
+    if ( !(sb = (segBcast_t *) SUPERLU_MALLOC(sizeof(segBcast_t))) )
+	ABORT("Malloc fails for segBcast_t.");
+    sb->scope = scope;
+    sb->iam = iam;
+    sb->Np = Np;
+    sb->tsub = tsub;
+    sb->tval = tval;
+    MPI_Type_size(tval, &sb->valsize);
+    sb->seg = SUPERLU_MAX(bytes / sb->valsize, 1);
+    ttemp = getenv("SUPERLU_BCAST_DEG");
+    sb->deg = ttemp ? SUPERLU_MAX(atoi(ttemp), 1) : 2;
+    sb->nslots = nslots;
+    sb->subcnt = subcnt;
+    sb->phase = COMM_PANEL_L;
+
+    /* Every rank learns the readers of every panel. */
+    nwords = sb->nwords = (Np + 31) / 32;
+    k = SUPERLU_MAX(nsupers, 1);
+    if ( !(sb->need = SUPERLU_MALLOC((size_t) k * nwords * sizeof(unsigned))) )
+	ABORT("Malloc fails for sb->need[].");
+    if ( !(mine = SUPERLU_MALLOC(2 * k * sizeof(unsigned))) )
+	ABORT("Malloc fails for mine[].");
+    for (w = 0; w < nwords; ++w) {
+	/* Word w of row k holds the flags of scope ranks 32w .. 32w+31. */
+	for (k = 0; k < nsupers; ++k)
+	    mine[k] = ( iam / 32 == w && need[k] ) ? 1u << (iam % 32) : 0;
+	MPI_Allreduce(mine, mine + nsupers, nsupers, MPI_UNSIGNED, MPI_BOR,
+		      scope);
+	for (k = 0; k < nsupers; ++k)
+	    sb->need[(size_t) k * nwords + w] = mine[nsupers + k];
+    }
+    SUPERLU_FREE(mine);
+
+    if ( !(sb->list = SUPERLU_MALLOC(Np * sizeof(int))) )
+	ABORT("Malloc fails for sb->list[].");
+    if ( !(sb->sub = SUPERLU_MALLOC(nslots * (sizeof(int_t *) + sizeof(void *)
+					      + sizeof(MPI_Request *)
+					      + 2 * sizeof(int_t)
+					      + 4 * sizeof(int)))) )
+	ABORT("Malloc fails for sb->sub[].");
+    sb->val = (void **) (sb->sub + nslots);
+    sb->req = (MPI_Request **) (sb->val + nslots);
+    sb->held = (int_t *) (sb->req + nslots);
+    sb->root = sb->held + nslots;
+    sb->nreq = (int *) (sb->root + nslots);
+    sb->maxreq = sb->nreq + nslots;
+    sb->psrc = sb->maxreq + nslots;
+    for (s = 0; s < nslots; ++s) {
+	sb->sub[s] = sub[s];
+	sb->val[s] = val[s];
+	sb->req[s] = NULL;
+	sb->held[s] = sb->root[s] = -1;
+	sb->nreq[s] = sb->maxreq[s] = 0;
+    }
+    return sb;
+}
+
+/*! \brief Free the tree broadcast of a scope. */
+void segBcastFree(segBcast_t *sb)
+{
+    if ( !sb ) return;
+    for (int s = 0; s < sb->nslots; ++s)
+	if ( sb->req[s] ) SUPERLU_FREE(sb->req[s]);
+    SUPERLU_FREE(sb->need);
+    SUPERLU_FREE(sb->list);
+    SUPERLU_FREE(sb->sub);
+    SUPERLU_FREE(sb);
+}
+
+/*! \brief Slot whose index part is sub[], or -1 for another buffer. */
+int segBcastSlot(segBcast_t *sb, void *sub)
+{
+    if ( sb )
+	for (int s = 0; s < sb->nslots; ++s)
+	    if ( sb->sub[s] == sub ) return s;
+    return -1;
+}
+
+/*! \brief Slot into which this rank receives supernode k, or -1. */
+int segBcastHeld(segBcast_t *sb, int_t k)
+{
+    if ( sb )
+	for (int s = 0; s < sb->nslots; ++s)
+	    if ( sb->held[s] == k ) return s;
+    return -1;
+}
+
+/*! \brief Place of scope rank p in the tree of panel k rooted at root.
+ *
+ * On return sb->list[0:n-1] are the readers in tree order, the root being
+ * position 0 and list[i] position i+1.  Returns the position of p.
+ */
+static int segBcastTree(segBcast_t *sb, int_t k, int root, int p, int *n)
+{
+    unsigned *row = &sb->need[(size_t) k * sb->nwords];
+    int i, q, pos = 0;
+
+    *n = 0;
+    for (i = 1; i < sb->Np; ++i) {
+	q = (root + i) % sb->Np;
+	if ( row[q / 32] & (1u << (q % 32)) ) {
+	    sb->list[(*n)++] = q;
+	    if ( q == p ) pos = *n;
+	}
+    }
+    return pos;
+}
+
+/* Scope rank at tree position pos. */
+#define SEG_RANK(sb, root, pos) ( (pos) == 0 ? (root) : (sb)->list[(pos) - 1] )
+
+/* Send segments of val[0:nval-1] to the children of position pos. */
+static void segBcastForward(segBcast_t *sb, int root, int pos, int n,
+			    void *val, int nval, int i0, int i1, int tag1,
+			    MPI_Request *req)
+{
+    int c, i, len;
+
+    for (i = i0; i < i1; ++i) {
+	len = SUPERLU_MIN(sb->seg, nval - i * sb->seg);
+	for (c = sb->deg * pos + 1; c <= SUPERLU_MIN(sb->deg * pos + sb->deg, n);
+	     ++c) {
+	    commProfSend(sb->phase, sb->scope, SEG_RANK(sb, root, c), len,
+			 sb->tval);
+	    MPI_Isend((char *) val + (size_t) i * sb->seg * sb->valsize, len,
+		      sb->tval, SEG_RANK(sb, root, c), tag1, sb->scope, req++);
+	}
+    }
+}
+
+/*! \brief Send panel k from slot s to its readers.
+ *
+ * The index part and a short value part go to every reader through
+ * send_req[p] and send_req[p + Np]; the segments of a long value part go
+ * to the children of the root and are completed by segBcastWaitSend().
+ */
+int_t segBcastIsend(segBcast_t *sb, int s, int_t k,
+		    void *sub, int nsub, void *val, int nval,
+		    int tag0, int tag1, MPI_Request *send_req)
+{
+    int i, n, nseg, nchild, Np = sb->Np;
+
+    segBcastTree(sb, k, sb->iam, -1, &n);
+    for (i = 0; i < Np; ++i) send_req[i] = send_req[i + Np] = MPI_REQUEST_NULL;
+    for (i = 0; i < n; ++i) {
+	commProfSend(sb->phase, sb->scope, sb->list[i], nsub, sb->tsub);
+	MPI_Isend(sub, nsub, sb->tsub, sb->list[i], tag0, sb->scope,
+		  &send_req[sb->list[i]]);
+    }
+    if ( nval <= sb->seg ) {
+	for (i = 0; i < n; ++i) {
+	    commProfSend(sb->phase, sb->scope, sb->list[i], nval, sb->tval);
+	    MPI_Isend(val, nval, sb->tval, sb->list[i], tag1, sb->scope,
+		      &send_req[sb->list[i] + Np]);
+	}
+	return 0;
+    }
+
+    nseg = (nval + sb->seg - 1) / sb->seg;
+    nchild = SUPERLU_MIN(sb->deg, n);
+    if ( nseg * nchild > sb->maxreq[s] ) {
+	if ( sb->req[s] ) SUPERLU_FREE(sb->req[s]);
+	sb->maxreq[s] = nseg * nchild;
+	if ( !(sb->req[s] = SUPERLU_MALLOC(sb->maxreq[s] * sizeof(MPI_Request))) )
+	    ABORT("Malloc fails for sb->req[].");
+    }
+    segBcastForward(sb, sb->iam, 0, n, val, nval, 0, nseg, tag1, sb->req[s]);
+    sb->nreq[s] = nseg * nchild;
+    sb->root[s] = k;
+    return 0;
+}
+
+/*! \brief Complete the segment sends of panel k, if this rank is its root. */
+int_t segBcastWaitSend(segBcast_t *sb, int_t k)
+{
+    if ( sb )
+	for (int s = 0; s < sb->nslots; ++s)
+	    if ( sb->root[s] == k ) {
+		MPI_Waitall(sb->nreq[s], sb->req[s], MPI_STATUSES_IGNORE);
+		sb->nreq[s] = 0;
+		sb->root[s] = -1;
+	    }
+    return 0;
+}
+
+/*! \brief Post the receive of the index part of panel k into slot s.
+ *
+ * The value part is received in segBcastWaitValue(), once its length is
+ * known from the index part.
+ */
+int_t segBcastIrecv(segBcast_t *sb, int s, int_t k, int src,
+		    int tag0, int tag1, MPI_Request *recv_req)
+{
+    sb->held[s] = k;
+    sb->psrc[2 * s] = src;
+    sb->psrc[2 * s + 1] = tag1;
+    MPI_Irecv(sb->sub[s], sb->subcnt, sb->tsub, src, tag0, sb->scope,
+	      &recv_req[0]);
+    recv_req[1] = MPI_REQUEST_NULL;
+    return 0;
+}
+
+/*! \brief Wait for the index part in slot s; cnt[0] gets its length. */
+int_t segBcastWaitIndex(segBcast_t *sb, int s, MPI_Request *recv_req,
+			int *cnt)
+{
+    MPI_Status status;
+
+    MPI_Wait(&recv_req[0], &status);
+    MPI_Get_count(&status, sb->tsub, &cnt[0]);
+    return 0;
+}
+
+/*! \brief Receive the nval values of panel k into slot s, passing the
+ *  segments on to the children of this rank; cnt[1] = nval.
+ */
+int_t segBcastWaitValue(segBcast_t *sb, int s, int_t k, int nval, int *cnt)
+{
+    MPI_Request *rreq, *sreq;
+    MPI_Status status;
+    char *val = sb->val[s];
+    int src = sb->psrc[2 * s], tag1 = sb->psrc[2 * s + 1];
+    int i, n, pos, nseg, nchild;
+
+    sb->held[s] = -1;
+    cnt[1] = nval;
+    if ( nval <= sb->seg ) {
+	MPI_Recv(val, nval, sb->tval, src, tag1, sb->scope, &status);
+	return 0;
+    }
+
+    pos = segBcastTree(sb, k, src, sb->iam, &n);
+    nseg = (nval + sb->seg - 1) / sb->seg;
+    nchild = SUPERLU_MAX(SUPERLU_MIN(sb->deg * pos + sb->deg, n)
+			 - sb->deg * pos, 0);
+    if ( !(rreq = SUPERLU_MALLOC(nseg * (nchild + 1) * sizeof(MPI_Request))) )
+	ABORT("Malloc fails for rreq[].");
+    sreq = rreq + nseg;
+    for (i = 0; i < nseg; ++i)
+	MPI_Irecv(val + (size_t) i * sb->seg * sb->valsize,
+		  SUPERLU_MIN(sb->seg, nval - i * sb->seg), sb->tval,
+		  SEG_RANK(sb, src, (pos - 1) / sb->deg), tag1, sb->scope,
+		  &rreq[i]);
+    for (i = 0; i < nseg; ++i) {
+	MPI_Wait(&rreq[i], &status);
+	segBcastForward(sb, src, pos, n, val, nval, i, i + 1, tag1,
+			&sreq[i * nchild]);
+    }
+    MPI_Waitall(nseg * nchild, sreq, MPI_STATUSES_IGNORE);
+    SUPERLU_FREE(rreq);
+    return 0;
+}
+
+/*
+ * Coalesced broadcast of small panels.
+ *
+ * aggBcastPlan() cuts each level of a forest into batches: maximal runs of
+ * at most nslots consecutive supernodes of at most maxw columns.  The
+ * factorization posts the members of a batch one by one as before; they
+ * are only recorded here, and when the last one is posted each owner packs
+ * the members a reader needs into one message to that reader.  Ranks wait
+ * for the members in factorization order, so the whole batch is completed
+ * when its head is waited for.
+ *
+ * A message holds nrec, then (k, nsub, nval) per member, then the index
+ * parts, then the value parts from the next 16-byte boundary on.
+ */
+
+/*! \brief Widest supernode batched, requested through SUPERLU_BCAST_AGG;
+ *  0 (the default) sends every panel on its own.
+ */
+static int aggBcastWidth(void)
+{
+    char *ttemp = getenv("SUPERLU_BCAST_AGG");
+    return ttemp ? SUPERLU_MAX(atoi(ttemp), 0) : 0;
+}
+
+#define AGG_ALIGN(x) ( ((x) + 15) & ~((size_t) 15) )
+
+/* Whether slot s holds a member of the batch headed by h. */
+#define AGG_MEMBER(ab, s, h) \
+    ( (ab)->mk[s] >= 0 && (ab)->head[(ab)->mk[s]] == (h) )
+
+/*! \brief Set up the coalesced broadcast of a scope.
+ *
+ * sub[s] and val[s] are the receive buffers of slot s; batches are at most
+ * nslots long.  Returns NULL if coalescing is not requested.
+ */
+aggBcast_t *aggBcastInit(MPI_Comm scope, int nslots, int_t *sub[],
+			 void *val[], int_t nsupers, MPI_Datatype tval)
+{
+    aggBcast_t *ab;
+    int maxw, Np, s;
+    int_t k;
+
+    if ( (maxw = aggBcastWidth()) == 0 || nslots < 2 ) return NULL;
+    MPI_Comm_size(scope, &Np);
+    if ( Np < 2 ) return NULL;
+
+    if ( !(ab = (aggBcast_t *) SUPERLU_MALLOC(sizeof(aggBcast_t))) )
+	ABORT("Malloc fails for aggBcast_t.");
+    ab->scope = scope;
+    MPI_Comm_rank(scope, &ab->iam);
+    ab->Np = Np;
+    MPI_Type_size(tval, &ab->valsize);
+    ab->maxw = maxw;
+    ab->nslots = nslots;
+    ab->phase = COMM_PANEL_L;
+
+    k = SUPERLU_MAX(nsupers, 1);
+    if ( !(ab->head = SUPERLU_MALLOC(k * sizeof(int_t))) )
+	ABORT("Malloc fails for ab->head[].");
+    if ( !(ab->len = SUPERLU_MALLOC(2 * k * sizeof(int))) )
+	ABORT("Malloc fails for ab->len[].");
+    ab->nadd = ab->len + k;
+    for (k = 0; k < nsupers; ++k) {
+	ab->head[k] = -1;
+	ab->len[k] = ab->nadd[k] = 0;
+    }
+
+    if ( !(ab->sub = SUPERLU_MALLOC(nslots * 7 * sizeof(void *))) )
+	ABORT("Malloc fails for ab->sub[].");
+    ab->val = (void **) (ab->sub + nslots);
+    ab->mcnt = (int **) (ab->val + nslots);
+    ab->mto = ab->mcnt + nslots;
+    ab->msub = (void **) (ab->mto + nslots);
+    ab->mval = ab->msub + nslots;
+    ab->buf = (char **) (ab->mval + nslots);
+    if ( !(ab->mk = SUPERLU_MALLOC(nslots * sizeof(int_t))) )
+	ABORT("Malloc fails for ab->mk[].");
+    if ( !(ab->msrc = SUPERLU_MALLOC(5 * nslots * sizeof(int))) )
+	ABORT("Malloc fails for ab->msrc[].");
+    ab->mread = ab->msrc + nslots;
+    ab->mtag = ab->mread + nslots;
+    ab->mnsub = ab->mtag + nslots;
+    ab->mnval = ab->mnsub + nslots;
+    if ( !(ab->bufsize = SUPERLU_MALLOC(nslots * sizeof(size_t))) )
+	ABORT("Malloc fails for ab->bufsize[].");
+    if ( !(ab->req = SUPERLU_MALLOC(nslots * Np * sizeof(MPI_Request))) )
+	ABORT("Malloc fails for ab->req[].");
+    for (s = 0; s < nslots; ++s) {
+	ab->sub[s] = sub[s];
+	ab->val[s] = val[s];
+	ab->mk[s] = -1;
+	ab->buf[s] = NULL;
+	ab->bufsize[s] = 0;
+    }
+    for (s = 0; s < nslots * Np; ++s) ab->req[s] = MPI_REQUEST_NULL;
+    ab->rbuf = NULL;
+    ab->rsize = 0;
+    return ab;
+}
+
+/*! \brief Free the coalesced broadcast of a scope. */
+void aggBcastFree(aggBcast_t *ab)
+{
+    if ( !ab ) return;
+    for (int s = 0; s < ab->nslots; ++s)
+	if ( ab->buf[s] ) SUPERLU_FREE(ab->buf[s]);
+    if ( ab->rbuf ) SUPERLU_FREE(ab->rbuf);
+    SUPERLU_FREE(ab->head);
+    SUPERLU_FREE(ab->len);
+    SUPERLU_FREE(ab->sub);
+    SUPERLU_FREE(ab->mk);
+    SUPERLU_FREE(ab->msrc);
+    SUPERLU_FREE(ab->bufsize);
+    SUPERLU_FREE(ab->req);
+    SUPERLU_FREE(ab);
+}
+
+/*! \brief Cut the levels perm[lims[l]:lims[l+1]-1], l < nlvl, of a forest
+ *  into batches.  Every rank of the scope passes the same forest.
+ */
+void aggBcastPlan(aggBcast_t *ab, int_t *perm, int_t *lims, int_t nlvl,
+		  int_t *xsup)
+{
+    int_t l, k0, i, n = 0;
+
+    if ( !ab ) return;
+    for (l = 0; l < nlvl; ++l)
+	for (k0 = lims[l]; k0 < lims[l + 1]; k0 += SUPERLU_MAX(n, 1)) {
+	    for (n = 0; k0 + n < lims[l + 1] && n < ab->nslots
+		     && xsup[perm[k0 + n] + 1] - xsup[perm[k0 + n]] <= ab->maxw;
+		 ++n) ;
+	    if ( n < 2 ) continue;
+	    for (i = 0; i < n; ++i) ab->head[perm[k0 + i]] = perm[k0];
+	    ab->len[perm[k0]] = n;
+	    ab->nadd[perm[k0]] = 0;
+	}
+}
+
+/*! \brief Slot whose index part is sub[] if supernode k is batched,
+ *  or -1.
+ */
+int aggBcastSlot(aggBcast_t *ab, void *sub, int_t k)
+{
+    if ( ab && ab->head[k] >= 0 )
+	for (int s = 0; s < ab->nslots; ++s)
+	    if ( ab->sub[s] == sub ) return s;
+    return -1;
+}
+
+/* Whether scope rank p reads the member in slot s that I own. */
+#define AGG_READS(ab, s, p) \
+    ( (ab)->msrc[s] == (ab)->iam && (p) != (ab)->iam \
+      && (!(ab)->mto[s] || (ab)->mto[s][p] != SLU_EMPTY) )
+
+/* Pack my members of the batch headed by h that rank p reads into buf, or
+   only measure them if buf is NULL.  Returns the message length. */
+static size_t aggBcastPack(aggBcast_t *ab, int_t h, int p, char *buf)
+{
+    int s, nrec = 0;
+    size_t nint = 1, nbytes = 0, off;
+    int_t *hdr, *isub;
+    char *v;
+
+    for (s = 0; s < ab->nslots; ++s)
+	if ( AGG_MEMBER(ab, s, h) && AGG_READS(ab, s, p) ) {
+	    ++nrec;
+	    nint += 3 + ab->mnsub[s];
+	    nbytes += (size_t) ab->mnval[s] * ab->valsize;
+	}
+    if ( nrec == 0 ) return 0;
+    off = AGG_ALIGN(nint * sizeof(int_t));
+    if ( !buf ) return off + nbytes;
+
+    hdr = (int_t *) buf;
+    *hdr++ = nrec;
+    isub = hdr + 3 * nrec;
+    v = buf + off;
+    for (s = 0; s < ab->nslots; ++s) {
+	if ( !AGG_MEMBER(ab, s, h) || !AGG_READS(ab, s, p) ) continue;
+	*hdr++ = ab->mk[s];
+	*hdr++ = ab->mnsub[s];
+	*hdr++ = ab->mnval[s];
+	if ( ab->mnsub[s] )
+	    memcpy(isub, ab->msub[s], ab->mnsub[s] * sizeof(int_t));
+	if ( ab->mnval[s] )
+	    memcpy(v, ab->mval[s], (size_t) ab->mnval[s] * ab->valsize);
+	isub += ab->mnsub[s];
+	v += (size_t) ab->mnval[s] * ab->valsize;
+    }
+    return off + nbytes;
+}
+
+/* Send every reader my members of the batch headed by h, in one message. */
+static void aggBcastFlush(aggBcast_t *ab, int_t h)
+{
+    int hs, p, Np = ab->Np;
+    size_t len, total = 0;
+    char *buf;
+
+    for (hs = 0; ab->mk[hs] != h; ++hs) ;
+    for (p = 0; p < Np; ++p) total += AGG_ALIGN(aggBcastPack(ab, h, p, NULL));
+    if ( total > ab->bufsize[hs] ) {
+	if ( ab->buf[hs] ) SUPERLU_FREE(ab->buf[hs]);
+	ab->bufsize[hs] = total;
+	if ( !(ab->buf[hs] = SUPERLU_MALLOC(total)) )
+	    ABORT("Malloc fails for ab->buf[].");
+    }
+    for (p = 0, buf = ab->buf[hs]; p < Np; ++p) {
+	if ( (len = aggBcastPack(ab, h, p, buf)) == 0 ) continue;
+	commProfSend(ab->phase, ab->scope, p, len, MPI_BYTE);
+	MPI_Isend(buf, len, MPI_BYTE, p, ab->mtag[hs], ab->scope,
+		  &ab->req[hs * Np + p]);
+	buf += AGG_ALIGN(len);
+    }
+}
+
+/* Count member k of its batch in, and send the batch once it is complete. */
+static void aggBcastPost(aggBcast_t *ab, int_t k)
+{
+    int_t h = ab->head[k];
+
+    if ( ++ab->nadd[h] == ab->len[h] ) aggBcastFlush(ab, h);
+}
+
+/*! \brief Post a batched panel k that I own, from slot s.
+ *
+ * Scope rank p reads it if p is not me and to is NULL or
+ * to[p] != SLU_EMPTY.  sub and val must stay valid until the batch is
+ * complete.
+ */
+int_t aggBcastIsend(aggBcast_t *ab, int s, int_t k, int to[],
+		    void *sub, int nsub, void *val, int nval, int tag)
+{
+    ab->mk[s] = k;
+    ab->msrc[s] = ab->iam;
+    ab->mread[s] = 0;
+    ab->mtag[s] = tag;
+    ab->mcnt[s] = NULL;
+    ab->mto[s] = to;
+    ab->msub[s] = sub;
+    ab->mval[s] = val;
+    ab->mnsub[s] = nsub;
+    ab->mnval[s] = nval;
+    aggBcastPost(ab, k);
+    return 0;
+}
+
+/*! \brief Post a batched panel k owned by scope rank src into slot s.
+ *
+ * If read is 0, this rank does not read it but still counts it in; else
+ * the panel lands in slot s and cnt[0], cnt[1] get its lengths.
+ */
+int_t aggBcastIrecv(aggBcast_t *ab, int s, int_t k, int src, int read,
+		    int tag, int *cnt)
+{
+    ab->mk[s] = k;
+    ab->msrc[s] = src;
+    ab->mread[s] = read;
+    ab->mtag[s] = tag;
+    ab->mcnt[s] = cnt;
+    if ( read ) cnt[0] = cnt[1] = 0;
+    aggBcastPost(ab, k);
+    return 0;
+}
+
+/* Copy the members I read out of the message in ab->rbuf. */
+static void aggBcastUnpack(aggBcast_t *ab)
+{
+    int_t *hdr = (int_t *) ab->rbuf, *isub, i, k, nrec = hdr[0];
+    size_t nint = 1 + 3 * nrec;
+    char *v;
+    int s, nsub, nval;
+
+    for (i = 0; i < nrec; ++i) nint += hdr[3 * i + 2];
+    isub = hdr + 1 + 3 * nrec;
+    v = ab->rbuf + AGG_ALIGN(nint * sizeof(int_t));
+    for (i = 0; i < nrec; ++i) {
+	k = hdr[3 * i + 1];
+	nsub = hdr[3 * i + 2];
+	nval = hdr[3 * i + 3];
+	for (s = 0; s < ab->nslots && !(ab->mk[s] == k && ab->mread[s]); ++s) ;
+	if ( s < ab->nslots ) {
+	    if ( nsub ) memcpy(ab->sub[s], isub, nsub * sizeof(int_t));
+	    if ( nval ) memcpy(ab->val[s], v, (size_t) nval * ab->valsize);
+	    ab->mcnt[s][0] = nsub;
+	    ab->mcnt[s][1] = nval;
+	}
+	isub += nsub;
+	v += (size_t) nval * ab->valsize;
+    }
+}
+
+/*! \brief Wait for supernode k if it is batched.
+ *
+ * Returns 0 if k is not batched, and the caller waits for it as usual.
+ * Otherwise, if k heads its batch, receives one message from each owner of
+ * a member I read, unpacks the members and completes my sends; the other
+ * members need nothing more.
+ */
+int aggBcastWait(aggBcast_t *ab, int_t k)
+{
+    MPI_Status status;
+    int s, t, hs, n, src;
+
+    if ( !ab || ab->head[k] < 0 ) return 0;
+    if ( ab->head[k] != k ) return 1;
+    for (hs = 0; hs < ab->nslots && ab->mk[hs] != k; ++hs) ;
+    if ( hs == ab->nslots ) ABORT("aggBcastWait: batch head not posted.");
+
+    for (s = 0; s < ab->nslots; ++s) {
+	if ( !AGG_MEMBER(ab, s, k) || !ab->mread[s] ) continue;
+	src = ab->msrc[s];
+	for (t = 0; t < s; ++t)
+	    if ( AGG_MEMBER(ab, t, k) && ab->mread[t] && ab->msrc[t] == src )
+		break;
+	if ( t < s ) continue;
+	MPI_Probe(src, ab->mtag[hs], ab->scope, &status);
+	MPI_Get_count(&status, MPI_BYTE, &n);
+	if ( (size_t) n > ab->rsize ) {
+	    if ( ab->rbuf ) SUPERLU_FREE(ab->rbuf);
+	    ab->rsize = n;
+	    if ( !(ab->rbuf = SUPERLU_MALLOC(ab->rsize)) )
+		ABORT("Malloc fails for ab->rbuf[].");
+	}
+	MPI_Recv(ab->rbuf, n, MPI_BYTE, src, ab->mtag[hs], ab->scope, &status);
+	aggBcastUnpack(ab);
+    }
+    MPI_Waitall(ab->Np, &ab->req[hs * ab->Np], MPI_STATUSES_IGNORE);
+
+    for (s = 0; s < ab->nslots; ++s)
+	if ( AGG_MEMBER(ab, s, k) ) ab->mk[s] = -1;
+    return 1;
+}
+
+/*
+ * One-sided panel delivery.
+ *
+ * Each rank of the scope allocates its receive slots in a window that all
+ * ranks keep locked for the whole factorization.  Slot s starts with an
+ * RMA_HDR-byte header: the arrival flag (k + 1 once panel k is in) and the
+ * lengths of the two parts.  When a reader is ready to receive panel k in
+ * slot s, where it would post the receives, it sets free[s * Np + me] to
+ * k + 1 in the owner's window.  The owner puts the panel into every reader
+ * whose flag is up, flushes, and raises the reader's arrival flag.
+ * Readers that are not ready yet are served from later calls, at the
+ * latest when the owner waits for the panel.
+ */
+#define RMA_ARRIVED 0   /* k + 1 once panel k is in the slot */
+#define RMA_NSUB    1   /* length of the index part */
+#define RMA_NVAL    2   /* length of the value part */
+#define RMA_HDR     64
+#define RMA_ALIGN(b) ( ((b) + RMA_HDR - 1) / RMA_HDR * RMA_HDR )
+
+/*! \brief Set up the window of receive slots of a scope.
+ *
+ * Collective over scope.  Each slot holds subcnt index and valcnt value
+ * entries.  Returns NULL if SUPERLU_BCAST_RMA is not set, or if the MPI
+ * library cannot provide the window (e.g. no suitable osc component), in
+ * which case the caller keeps the two-sided broadcasts.
+ */
+rmaBcast_t *rmaBcastInit(MPI_Comm scope, int nslots, int subcnt,
+			 MPI_Datatype tsub, int valcnt, MPI_Datatype tval)
+{
+    rmaBcast_t *rb;
+    char *ttemp = getenv("SUPERLU_BCAST_RMA"), *base;
+    int subsize, valsize, Np, s, ok, allok;
+    MPI_Errhandler errh;
+    MPI_Aint winsize;
+
+    if ( !ttemp || !atoi(ttemp) || nslots <= 0 ) return NULL;
+    MPI_Comm_size(scope, &Np);
+    if ( Np < 2 ) return NULL;
+
+    if ( !(rb = (rmaBcast_t *) SUPERLU_MALLOC(sizeof(rmaBcast_t))) )
+	ABORT("Malloc fails for rmaBcast_t.");
+    rb->scope = scope;
+    MPI_Comm_rank(scope, &rb->iam);
+    rb->Np = Np;
+    rb->tsub = tsub;
+    rb->tval = tval;
+    rb->nslots = nslots;
+    rb->phase = COMM_PANEL_L;
+    MPI_Type_size(tsub, &subsize);
+    MPI_Type_size(tval, &valsize);
+    rb->valoff = RMA_HDR + RMA_ALIGN((MPI_Aint) subcnt * subsize);
+    rb->slotsize = rb->valoff + RMA_ALIGN((MPI_Aint) valcnt * valsize);
+    rb->freeoff = nslots * rb->slotsize;
+    winsize = rb->freeoff + (MPI_Aint) nslots * Np * sizeof(int);
+
+    /* A failure must not abort the job: return the error instead. */
+    MPI_Comm_get_errhandler(scope, &errh);
+    MPI_Comm_set_errhandler(scope, MPI_ERRORS_RETURN);
+    ok = MPI_Win_allocate(winsize, 1, MPI_INFO_NULL, scope, &base,
+			  &rb->win) == MPI_SUCCESS;
+    MPI_Comm_set_errhandler(scope, errh);
+    MPI_Errhandler_free(&errh);
+    if ( ok ) {
+	MPI_Win_set_errhandler(rb->win, MPI_ERRORS_RETURN);
+	ok = MPI_Win_lock_all(MPI_MODE_NOCHECK, rb->win) == MPI_SUCCESS;
+	MPI_Win_set_errhandler(rb->win, MPI_ERRORS_ARE_FATAL);
+	if ( !ok ) MPI_Win_free(&rb->win);
+    }
+    MPI_Allreduce(&ok, &allok, 1, MPI_INT, MPI_MIN, scope);
+    if ( !allok ) {
+	/* The window is collective: it cannot be freed on some ranks only. */
+	if ( ok ) ABORT("MPI_Win_allocate failed on part of the scope.");
+	if ( rb->iam == 0 )
+	    printf(".. SUPERLU_BCAST_RMA: no MPI window, using two-sided"
+		   " panel broadcasts\n");
+	SUPERLU_FREE(rb);
+	return NULL;
+    }
+    for (s = 0; s < nslots; ++s) {
+	int *hdr = (int *) (base + s * rb->slotsize);
+	hdr[RMA_ARRIVED] = hdr[RMA_NSUB] = hdr[RMA_NVAL] = 0;
+    }
+    for (s = 0; s < nslots * Np; ++s)
+	((int *) (base + rb->freeoff))[s] = 0;
+    MPI_Win_sync(rb->win);
+    MPI_Barrier(scope);
+    MPI_Win_sync(rb->win);
+
+    if ( !(rb->sub = SUPERLU_MALLOC(nslots * 4 * sizeof(void *))) )
+	ABORT("Malloc fails for rb->sub[].");
+    rb->val = (void **) (rb->sub + nslots);
+    rb->psub = rb->val + nslots;
+    rb->pval = rb->psub + nslots;
+    if ( !(rb->held = SUPERLU_MALLOC(2 * nslots * sizeof(int_t))) )
+	ABORT("Malloc fails for rb->held[].");
+    rb->root = rb->held + nslots;
+    if ( !(rb->pnsub = SUPERLU_MALLOC(2 * nslots * sizeof(int))) )
+	ABORT("Malloc fails for rb->pnsub[].");
+    rb->pnval = rb->pnsub + nslots;
+    if ( !(rb->pend = SUPERLU_MALLOC(nslots * Np)) )
+	ABORT("Malloc fails for rb->pend[].");
+    for (s = 0; s < nslots; ++s) {
+	rb->sub[s] = (int_t *) (base + s * rb->slotsize + RMA_HDR);
+	rb->val[s] = base + s * rb->slotsize + rb->valoff;
+	rb->held[s] = rb->root[s] = -1;
+    }
+    for (s = 0; s < nslots * Np; ++s) rb->pend[s] = 0;
+    return rb;
+}
+
+/*! \brief Free the window.  Collective over the scope. */
+void rmaBcastFree(rmaBcast_t *rb)
+{
+    if ( !rb ) return;
+    MPI_Win_unlock_all(rb->win);
+    MPI_Win_free(&rb->win);
+    SUPERLU_FREE(rb->sub);
+    SUPERLU_FREE(rb->held);
+    SUPERLU_FREE(rb->pnsub);
+    SUPERLU_FREE(rb->pend);
+    SUPERLU_FREE(rb);
+}
+
+/*! \brief Slot whose index part is sub[], or -1 for another buffer. */
+int rmaBcastSlot(rmaBcast_t *rb, void *sub)
+{
+    if ( rb )
+	for (int s = 0; s < rb->nslots; ++s)
+	    if ( rb->sub[s] == sub ) return s;
+    return -1;
+}
+
+/*! \brief Slot into which this rank receives supernode k, or -1. */
+int rmaBcastHeld(rmaBcast_t *rb, int_t k)
+{
+    if ( rb )
+	for (int s = 0; s < rb->nslots; ++s)
+	    if ( rb->held[s] == k ) return s;
+    return -1;
+}
+
+/* Atomically read the int at disp in the window of rank p. */
+static int rmaBcastGet(rmaBcast_t *rb, int p, MPI_Aint disp)
+{
+    int v;
+    MPI_Fetch_and_op(NULL, &v, MPI_INT, p, disp, MPI_NO_OP, rb->win);
+    MPI_Win_flush(p, rb->win);
+    return v;
+}
+
+/* Atomically set the int at disp in the window of rank p to v. */
+static void rmaBcastSet(rmaBcast_t *rb, int p, MPI_Aint disp, int v)
+{
+    MPI_Accumulate(&v, 1, MPI_INT, p, disp, 1, MPI_INT, MPI_REPLACE, rb->win);
+    MPI_Win_flush(p, rb->win);
+}
+
+/* Put my panels into the readers that have marked their slot free. */
+static void rmaBcastProgress(rmaBcast_t *rb)
+{
+    MPI_Aint disp;
+    int s, p, cnt[2], Np = rb->Np;
+
+    for (s = 0; s < rb->nslots; ++s) {
+	if ( rb->root[s] < 0 ) continue;
+	for (p = 0; p < Np; ++p) {
+	    if ( !rb->pend[s * Np + p] ) continue;
+	    if ( rmaBcastGet(rb, rb->iam, rb->freeoff
+			     + (MPI_Aint) (s * Np + p) * sizeof(int))
+		 != rb->root[s] + 1 ) continue;
+	    disp = s * rb->slotsize;
+	    cnt[0] = rb->pnsub[s];
+	    cnt[1] = rb->pnval[s];
+	    commProfSend(rb->phase, rb->scope, p, cnt[0], rb->tsub);
+	    commProfSend(rb->phase, rb->scope, p, cnt[1], rb->tval);
+	    MPI_Put(rb->psub[s], cnt[0], rb->tsub, p, disp + RMA_HDR,
+		    cnt[0], rb->tsub, rb->win);
+	    MPI_Put(rb->pval[s], cnt[1], rb->tval, p, disp + rb->valoff,
+		    cnt[1], rb->tval, rb->win);
+	    MPI_Put(cnt, 2, MPI_INT, p, disp + RMA_NSUB * sizeof(int),
+		    2, MPI_INT, rb->win);
+	    MPI_Win_flush(p, rb->win);
+	    rmaBcastSet(rb, p, disp + RMA_ARRIVED * sizeof(int),
+			rb->root[s] + 1);
+	    rb->pend[s * Np + p] = 0;
+	}
+    }
+}
+
+/*! \brief Deliver panel k, which I own, from slot s.
+ *
+ * Scope rank p reads it if p is not me and to is NULL or
+ * to[p] != SLU_EMPTY.  sub and val must stay valid until
+ * rmaBcastWaitSend().
+ */
+int_t rmaBcastIsend(rmaBcast_t *rb, int s, int_t k, int to[],
+		    void *sub, int nsub, void *val, int nval)
+{
+    for (int p = 0; p < rb->Np; ++p)
+	rb->pend[s * rb->Np + p] =
+	    p != rb->iam && (!to || to[p] != SLU_EMPTY);
+    rb->root[s] = k;
+    rb->psub[s] = sub;
+    rb->pval[s] = val;
+    rb->pnsub[s] = nsub;
+    rb->pnval[s] = nval;
+    rmaBcastProgress(rb);
+    return 0;
+}
+
+/*! \brief Mark slot s free for panel k of scope rank src. */
+int_t rmaBcastIrecv(rmaBcast_t *rb, int s, int_t k, int src)
+{
+    rb->held[s] = k;
+    rmaBcastSet(rb, src, rb->freeoff
+		+ (MPI_Aint) (s * rb->Np + rb->iam) * sizeof(int), k + 1);
+    rmaBcastProgress(rb);
+    return 0;
+}
+
+/*! \brief Wait until panel k is in slot s; cnt[0:1] get its lengths. */
+int_t rmaBcastWait(rmaBcast_t *rb, int s, int_t k, int *cnt)
+{
+    MPI_Aint disp = s * rb->slotsize;
+
+    while ( rmaBcastGet(rb, rb->iam, disp + RMA_ARRIVED * sizeof(int))
+	    != k + 1 )
+	rmaBcastProgress(rb);
+    MPI_Win_sync(rb->win);
+    cnt[0] = rmaBcastGet(rb, rb->iam, disp + RMA_NSUB * sizeof(int));
+    cnt[1] = rmaBcastGet(rb, rb->iam, disp + RMA_NVAL * sizeof(int));
+    rb->held[s] = -1;
+    return 0;
+}
+
+/*! \brief Deliver panel k to its remaining readers, if I put it.
+ *  Returns 1 if k went through the window, 0 otherwise.
+ */
+int rmaBcastWaitSend(rmaBcast_t *rb, int_t k)
+{
+    int s, p;
+
+    if ( !rb ) return 0;
+    for (s = 0; s < rb->nslots && rb->root[s] != k; ++s) ;
+    if ( s == rb->nslots ) return 0;
+    for (;;) {
+	for (p = 0; p < rb->Np && !rb->pend[s * rb->Np + p]; ++p) ;
+	if ( p == rb->Np ) break;
+	rmaBcastProgress(rb);
+    }
+    rb->root[s] = -1;
+    return 1;
+}
+
+/*
+ * Communication progress thread (SUPERLU_PROGRESS_THREAD).
+ *
+ * The look-ahead of the factorization and the asynchronous trees of the
+ * solve only move messages along when the computing thread calls into
+ * MPI, so a long GEMM holds up the panels and the tree forwarding behind
+ * it.  With SUPERLU_PROGRESS_THREAD=1, and MPI_THREAD_MULTIPLE granted, a
+ * POSIX thread of its own drives the communication of a phase: in the
+ * factorization it polls the process row and column communicators until
+ * commProgressStop(); in the solve it receives the nrecv messages of the phase, forwards each broadcast one
+ * through fwd() as soon as it is in, and queues them all for the caller.
+ * One core per rank should be left to it (OMP_NUM_THREADS one lower).
+ *
+ * commProgressStop() prints, over comm, how long the thread got the
+ * forwarded messages out before the caller would have received them,
+ * and how long the caller still waited.
+ */
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+
+#define PROG_RING 16
+
+typedef struct
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} progSync_t;
+
+static void *commProgressLoop(void *arg)
+{
+    commProgress_t *cp = (commProgress_t *) arg;
+    progSync_t *ps = (progSync_t *) cp->sync;
+    MPI_Message m;
+    MPI_Status st;
+    void *buf;
+    double t;
+    int i, flag, f;
+
+    if ( cp->nrecv < 0 ) {
+	for (;;) {
+	    pthread_mutex_lock(&ps->lock);
+	    flag = cp->stop;
+	    pthread_mutex_unlock(&ps->lock);
+	    if ( flag ) break;
+	    for (i = 0; i < cp->nprobe; ++i) {
+		MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, cp->probe[i], &flag,
+			   MPI_STATUS_IGNORE);
+		cp->nhit += flag;
+	    }
+	    cp->npoll += 1.0;
+	    sched_yield();
+	}
+	return NULL;
+    }
+
+    for (i = 0; i < cp->nrecv; ++i) {
+	MPI_Mprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, cp->comm, &m, &st);
+	if ( !cp->keep || !(buf = cp->keep(cp->arg, &st)) ) {
+	    pthread_mutex_lock(&ps->lock);
+	    while ( cp->nused - cp->nfree == cp->nring )
+		pthread_cond_wait(&ps->cond, &ps->lock);
+	    pthread_mutex_unlock(&ps->lock);
+	    buf = cp->ring + (cp->nused++ % cp->nring) * cp->slotsize;
+	}
+	MPI_Mrecv(buf, cp->maxcnt, cp->type, &m, &st);
+	t = SuperLU_timer_();
+	f = cp->fwd ? cp->fwd(cp->arg, buf, &st) : 0;
+
+	pthread_mutex_lock(&ps->lock);
+	cp->msg[i] = buf;
+	cp->st[i] = st;
+	cp->tin[i] = f ? t : -1.0;
+	cp->nin = i + 1;
+	pthread_cond_broadcast(&ps->cond);
+	pthread_mutex_unlock(&ps->lock);
+    }
+    return NULL;
+}
+#endif
+
+#ifndef _WIN32
+/* Set up a progress thread reporting over comm, or return NULL. */
+static commProgress_t *commProgressNew(char *name, MPI_Comm comm)
+{
+    commProgress_t *cp;
+    progSync_t *ps;
+    char *ttemp = getenv("SUPERLU_PROGRESS_THREAD");
+    int level;
+    static int warned = 0;
+
+    if ( !ttemp || !atoi(ttemp) ) return NULL;
+    MPI_Query_thread(&level);
+    if ( level < MPI_THREAD_MULTIPLE ) {
+	int rank;
+	MPI_Comm_rank(comm, &rank);
+	if ( !rank && !warned )
+	    printf(".. SUPERLU_PROGRESS_THREAD ignored:"
+		   " MPI_THREAD_MULTIPLE not provided\n");
+	warned = 1;
+	return NULL;
+    }
+
+    if ( !(cp = (commProgress_t *) SUPERLU_MALLOC(sizeof(commProgress_t))) )
+	ABORT("Malloc fails for commProgress_t.");
+    if ( !(ps = (progSync_t *) SUPERLU_MALLOC(sizeof(progSync_t))) )
+	ABORT("Malloc fails for progSync_t.");
+    pthread_mutex_init(&ps->lock, NULL);
+    pthread_cond_init(&ps->cond, NULL);
+    cp->sync = ps;
+    cp->name = name;
+    cp->comm = comm;
+    cp->nprobe = 0;
+    cp->nrecv = -1;
+    cp->keep = NULL;
+    cp->fwd = NULL;
+    cp->nin = cp->nout = cp->nused = cp->nfree = cp->stop = 0;
+    cp->lead = cp->wait = cp->npoll = cp->nhit = 0.0;
+    cp->ring = NULL;
+    cp->nring = PROG_RING;
+    return cp;
+}
+
+static commProgress_t *commProgressRun(commProgress_t *cp)
+{
+    cp->t0 = SuperLU_timer_();
+    if ( pthread_create(&((progSync_t *) cp->sync)->thread, NULL,
+			commProgressLoop, cp) )
+	ABORT("pthread_create fails for the progress thread.");
+    return cp;
+}
+#endif
+
+/*! \brief Start a progress thread that polls the nprobe (at most 3)
+ *  communicators in probe[] until commProgressStop(), and reports over
+ *  comm.  Returns NULL if SUPERLU_PROGRESS_THREAD is not set or
+ *  MPI_THREAD_MULTIPLE is missing.
+ */
+commProgress_t *commProgressPoll(char *name, MPI_Comm comm, int nprobe,
+				 MPI_Comm probe[])
+{
+#ifdef _WIN32
+    return NULL;
+#else
+    commProgress_t *cp = commProgressNew(name, comm);
+    int i;
+
+    if ( !cp ) return NULL;
+    cp->nprobe = SUPERLU_MIN(nprobe, 3);
+    for (i = 0; i < cp->nprobe; ++i) cp->probe[i] = probe[i];
+    return commProgressRun(cp);
+#endif
+}
+
+/*! \brief Start a progress thread that receives the nrecv messages of a
+ *  phase on comm.
+ *
+ * Each message, of at most maxcnt entries of type, goes into keep(arg,
+ * status) if that is not NULL, else into a ring of the thread's own whose
+ * slots the caller gives back by taking the next message.  fwd(arg, buf,
+ * status) is called on each arrival.  Returns NULL as commProgressPoll().
+ */
+commProgress_t *commProgressStart(char *name, MPI_Comm comm, int nrecv,
+				  int maxcnt, MPI_Datatype type,
+				  void *(*keep)(void *, MPI_Status *),
+				  int (*fwd)(void *, void *, MPI_Status *),
+				  void *arg)
+{
+#ifdef _WIN32
+    return NULL;
+#else
+    commProgress_t *cp = commProgressNew(name, comm);
+    int size;
+
+    if ( !cp ) return NULL;
+    cp->type = type;
+    cp->maxcnt = maxcnt;
+    cp->nrecv = nrecv;
+    cp->keep = keep;
+    cp->fwd = fwd;
+    cp->arg = arg;
+    if ( nrecv > 0 ) {
+	MPI_Type_size(type, &size);
+	cp->slotsize = (size_t) maxcnt * size;
+	if ( !(cp->ring = SUPERLU_MALLOC(cp->nring * cp->slotsize)) )
+	    ABORT("Malloc fails for cp->ring[].");
+	if ( !(cp->msg = SUPERLU_MALLOC(nrecv * sizeof(void *))) )
+	    ABORT("Malloc fails for cp->msg[].");
+	if ( !(cp->st = SUPERLU_MALLOC(nrecv * sizeof(MPI_Status))) )
+	    ABORT("Malloc fails for cp->st[].");
+	if ( !(cp->tin = SUPERLU_MALLOC(nrecv * sizeof(double))) )
+	    ABORT("Malloc fails for cp->tin[].");
+    }
+    return commProgressRun(cp);
+#endif
+}
+
+/*! \brief Take the next message received by the progress thread.
+ *
+ * Gives back the ring slot of the previous message, so that must be done
+ * with.  Returns the buffer holding the message.
+ */
+void *commProgressRecv(commProgress_t *cp, MPI_Status *status)
+{
+#ifdef _WIN32
+    return NULL;
+#else
+    progSync_t *ps = (progSync_t *) cp->sync;
+    double t = SuperLU_timer_();
+    void *buf;
+    int i = cp->nout;
+
+    pthread_mutex_lock(&ps->lock);
+    if ( i > 0 && (char *) cp->msg[i - 1] >= cp->ring
+	 && (char *) cp->msg[i - 1] < cp->ring + cp->nring * cp->slotsize ) {
+	++cp->nfree;
+	pthread_cond_broadcast(&ps->cond);
+    }
+    while ( cp->nin == i ) pthread_cond_wait(&ps->cond, &ps->lock);
+    buf = cp->msg[i];
+    *status = cp->st[i];
+    pthread_mutex_unlock(&ps->lock);
+
+    cp->nout = i + 1;
+    if ( cp->tin[i] >= 0.0 && cp->tin[i] < t ) cp->lead += t - cp->tin[i];
+    cp->wait += SuperLU_timer_() - t;
+    return buf;
+#endif
+}
+
+/*! \brief Join the progress thread and report on its phase.
+ *  Collective over cp->comm.
+ */
+void commProgressStop(commProgress_t *cp)
+{
+#ifndef _WIN32
+    progSync_t *ps;
+    double loc[5], sum[5], max[5];
+    int i, rank;
+
+    if ( !cp ) return;
+    ps = (progSync_t *) cp->sync;
+    pthread_mutex_lock(&ps->lock);
+    cp->stop = 1;
+    pthread_mutex_unlock(&ps->lock);
+    pthread_join(ps->thread, NULL);
+
+    loc[0] = SuperLU_timer_() - cp->t0;
+    if ( cp->nrecv < 0 ) {
+	loc[1] = cp->npoll;
+	loc[2] = cp->nhit;
+	loc[3] = loc[4] = 0.0;
+    } else {
+	loc[1] = cp->nrecv;
+	for (loc[2] = 0.0, i = 0; i < cp->nrecv; ++i)
+	    loc[2] += cp->tin[i] >= 0.0;
+	loc[3] = cp->lead;
+	loc[4] = cp->wait;
+    }
+    MPI_Reduce(loc, sum, 5, MPI_DOUBLE, MPI_SUM, 0, cp->comm);
+    MPI_Reduce(loc, max, 5, MPI_DOUBLE, MPI_MAX, 0, cp->comm);
+    MPI_Comm_rank(cp->comm, &rank);
+    if ( !rank ) {
+	if ( cp->nrecv < 0 )
+	    printf(".. Progress thread, %s: %.0f polls, %.0f found a message"
+		   " in flight, over %.3f s (max)\n",
+		   cp->name, sum[1], sum[2], max[0]);
+	else
+	    printf(".. Progress thread, %s: %.0f messages, %.0f forwarded on"
+		   " arrival, %.2e s ahead of the caller (sum, max rank %.2e);"
+		   " caller waited %.2e s (max)\n",
+		   cp->name, sum[1], sum[2], sum[3], max[3], max[4]);
+	fflush(stdout);
+    }
+
+    pthread_mutex_destroy(&ps->lock);
+    pthread_cond_destroy(&ps->cond);
+    SUPERLU_FREE(ps);
+    if ( cp->nrecv > 0 ) {
+	SUPERLU_FREE(cp->ring);
+	SUPERLU_FREE(cp->msg);
+	SUPERLU_FREE(cp->st);
+	SUPERLU_FREE(cp->tin);
+    }
+    SUPERLU_FREE(cp);
+#endif
+}
+
+/*
+ * Communication profile (SUPERLU_COMM_PROFILE).
+ *
+ * The send sites of the factorization and solve phases record every
+ * message by phase and destination.  Destinations are kept as ranks of
+ * MPI_COMM_WORLD, found through a rank map cached on each communicator,
+ * so that messages on process rows, columns and layers add up in one
+ * P x P matrix.  commProfDump() writes the matrices and the message-size
+ * histograms to <prefix>.<name>.txt, prints a summary and restarts the
+ * profile.  The prefix is the value of SUPERLU_COMM_PROFILE, or
+ * "superlu_comm" if the value is 1.
+ */
+#define COMM_NBINS 9   /* <=64, <=256, ..., <=1M, >1M bytes */
+
+static const char *commProfName[COMM_NPHASE] =
+    {"L-panel", "U-panel", "diag", "3D-z", "spmv", "redist"};
+
+static struct {
+    int    on;          /* -1: SUPERLU_COMM_PROFILE not read yet */
+    int    Pw;          /* size of MPI_COMM_WORLD */
+    int    keyval;      /* rank map attribute */
+    double *cnt, *vol;  /* [phase * Pw + world rank] */
+    double hist[COMM_NPHASE][COMM_NBINS];
+} commProf = {-1, 0, MPI_KEYVAL_INVALID, NULL, NULL, {{0.0}}};
+
+static int commProfMapFree(MPI_Comm comm, int keyval, void *attr, void *extra)
+{
+    SUPERLU_FREE(attr);
+    return MPI_SUCCESS;
+}
+
+/*! \brief Whether the communication profile is on. */
+int commProfOn(void)
+{
+    if ( commProf.on < 0 ) {
+	int flag;
+	MPI_Initialized(&flag);
+	commProf.on = flag && getenv("SUPERLU_COMM_PROFILE") != NULL;
+	if ( commProf.on ) {
+	    MPI_Comm_size(MPI_COMM_WORLD, &commProf.Pw);
+	    if ( !(commProf.cnt = SUPERLU_MALLOC(2 * COMM_NPHASE * commProf.Pw
+						 * sizeof(double))) )
+		ABORT("Malloc fails for commProf.cnt[].");
+	    commProf.vol = commProf.cnt + COMM_NPHASE * commProf.Pw;
+	    for (int i = 0; i < 2 * COMM_NPHASE * commProf.Pw; ++i)
+		commProf.cnt[i] = 0.0;
+	    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, commProfMapFree,
+				   &commProf.keyval, NULL);
+	}
+    }
+    return commProf.on;
+}
+
+/* World ranks of the ranks of comm. */
+static int *commProfMap(MPI_Comm comm)
+{
+    MPI_Group grp, wgrp;
+    int *map, flag, i, size;
+
+    MPI_Comm_get_attr(comm, commProf.keyval, &map, &flag);
+    if ( flag ) return map;
+    MPI_Comm_size(comm, &size);
+    if ( !(map = SUPERLU_MALLOC(2 * size * sizeof(int))) )
+	ABORT("Malloc fails for map[].");
+    for (i = 0; i < size; ++i) map[size + i] = i;
+    MPI_Comm_group(comm, &grp);
+    MPI_Comm_group(MPI_COMM_WORLD, &wgrp);
+    MPI_Group_translate_ranks(grp, size, map + size, wgrp, map);
+    MPI_Group_free(&grp);
+    MPI_Group_free(&wgrp);
+    MPI_Comm_set_attr(comm, commProf.keyval, map);
+    return map;
+}
+
+/*! \brief Record a message of count items of type to rank dest of comm. */
+void commProfSend(int phase, MPI_Comm comm, int dest, int count,
+		  MPI_Datatype type)
+{
+    double bytes;
+    int size, b, w;
+
+    if ( !commProfOn() || dest < 0 ) return;
+    MPI_Type_size(type, &size);
+    bytes = (double) count * size;
+    w = commProfMap(comm)[dest];
+    commProf.cnt[phase * commProf.Pw + w] += 1.0;
+    commProf.vol[phase * commProf.Pw + w] += bytes;
+    for (b = 0; b < COMM_NBINS - 1 && bytes > (64 << (2 * b)); ++b) ;
+    commProf.hist[phase][b] += 1.0;
+}
+
+/*! \brief Write the profile gathered over comm and restart it.
+ *  Collective over comm.
+ */
+void commProfDump(MPI_Comm comm, char *name)
+{
+    double *row, *all = NULL, tot[2], hot;
+    double hist[COMM_NPHASE][COMM_NBINS];
+    int *map, rank, P, ph, i, j, hi = 0, hj = 0;
+    char *prefix, fname[256];
+    FILE *fp = NULL;
+
+    if ( !commProfOn() ) return;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &P);
+    map = commProfMap(comm);
+    if ( !(row = SUPERLU_MALLOC(2 * P * sizeof(double))) )
+	ABORT("Malloc fails for row[].");
+    if ( rank == 0 ) {
+	if ( !(all = SUPERLU_MALLOC(2 * (size_t) P * P * sizeof(double))) )
+	    ABORT("Malloc fails for all[].");
+	prefix = getenv("SUPERLU_COMM_PROFILE");
+	snprintf(fname, sizeof(fname), "%s.%s.txt",
+		 strcmp(prefix, "1") ? prefix : "superlu_comm", name);
+	if ( !(fp = fopen(fname, "w")) )
+	    fprintf(stderr, "commProfDump: cannot open %s\n", fname);
+	else
+	    fprintf(fp, "# %s communication profile, P = %d; row = sender, "
+		    "column = receiver, ranks of the grid\n", name, P);
+	printf(".. Communication profile of %s (%s):\n", name, fname);
+    }
+    MPI_Reduce(commProf.hist, hist, COMM_NPHASE * COMM_NBINS, MPI_DOUBLE,
+	       MPI_SUM, 0, comm);
+
+    for (ph = 0; ph < COMM_NPHASE; ++ph) {
+	for (j = 0; j < P; ++j) {
+	    row[j] = commProf.cnt[ph * commProf.Pw + map[j]];
+	    row[P + j] = commProf.vol[ph * commProf.Pw + map[j]];
+	}
+	MPI_Gather(row, 2 * P, MPI_DOUBLE, all, 2 * P, MPI_DOUBLE, 0, comm);
+	if ( rank ) continue;
+
+	tot[0] = tot[1] = hot = 0.0;
+	for (i = 0; i < P; ++i)
+	    for (j = 0; j < P; ++j) {
+		tot[0] += all[2 * (size_t) i * P + j];
+		tot[1] += all[2 * (size_t) i * P + P + j];
+		if ( all[2 * (size_t) i * P + P + j] > hot ) {
+		    hot = all[2 * (size_t) i * P + P + j];
+		    hi = i;
+		    hj = j;
+		}
+	    }
+	if ( tot[0] == 0.0 ) continue;
+	printf("   %-8s %10.0f msgs %10.3f MB, hottest link %d -> %d %10.3f MB\n",
+	       commProfName[ph], tot[0], tot[1] * 1e-6, hi, hj, hot * 1e-6);
+	if ( !fp ) continue;
+	fprintf(fp, "\n# phase %s: %.0f messages, %.0f bytes\n",
+		commProfName[ph], tot[0], tot[1]);
+	fprintf(fp, "# message sizes <=64 <=256 <=1K <=4K <=16K <=64K <=256K"
+		" <=1M >1M:\n");
+	for (i = 0; i < COMM_NBINS; ++i) fprintf(fp, " %.0f", hist[ph][i]);
+	fprintf(fp, "\n# bytes\n");
+	for (i = 0; i < P; ++i) {
+	    for (j = 0; j < P; ++j)
+		fprintf(fp, " %.0f", all[2 * (size_t) i * P + P + j]);
+	    fprintf(fp, "\n");
+	}
+	fprintf(fp, "# messages\n");
+	for (i = 0; i < P; ++i) {
+	    for (j = 0; j < P; ++j)
+		fprintf(fp, " %.0f", all[2 * (size_t) i * P + j]);
+	    fprintf(fp, "\n");
+	}
+    }
+    if ( fp ) fclose(fp);
+    if ( all ) SUPERLU_FREE(all);
+    SUPERLU_FREE(row);
+    for (i = 0; i < 2 * COMM_NPHASE * commProf.Pw; ++i) commProf.cnt[i] = 0.0;
+    for (ph = 0; ph < COMM_NPHASE; ++ph)
+	for (i = 0; i < COMM_NBINS; ++i) commProf.hist[ph][i] = 0.0;
+}
@@ -51,9 +51,11 @@ int_t dIBcast_LPanel
         {
 
 
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
             MPI_Isend (lsub, msgcnt[0], mpi_int_t, pj,
                        SLU_MPI_TAG (0, k0) /* 0 */ ,
                        scp->comm, &send_req[pj]);
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], MPI_DOUBLE);
             MPI_Isend (lusup, msgcnt[1], MPI_DOUBLE, pj,
                        SLU_MPI_TAG (1, k0) /* 1 */ ,
                        scp->comm, &send_req[pj + Pc]);
@@ -93,9 +95,11 @@ int_t dBcast_LPanel
         {
 
 
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
             MPI_Send (lsub, msgcnt[0], mpi_int_t, pj,
                        SLU_MPI_TAG (0, k0) /* 0 */ ,
                        scp->comm);
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], MPI_DOUBLE);
             MPI_Send (lusup, msgcnt[1], MPI_DOUBLE, pj,
                        SLU_MPI_TAG (1, k0) /* 1 */ ,
                        scp->comm);
@@ -137,10 +141,12 @@ int_t dIBcast_UPanel
             if (pi != myrow)
             {
 
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[2], mpi_int_t);
                 MPI_Isend (usub, msgcnt[2], mpi_int_t, pi,
                            SLU_MPI_TAG (2, k0) /* (4*k0+2)%tag_ub */ ,
                            scp->comm,
                            &send_req_u[pi]);
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[3], MPI_DOUBLE);
                 MPI_Isend (uval, msgcnt[3], MPI_DOUBLE,
                            pi, SLU_MPI_TAG (3, k0) /* (4*kk0+3)%tag_ub */ ,
                            scp->comm,
@@ -181,9 +187,11 @@ int_t dBcast_UPanel(int_t k, int_t k0, int_t* usub,
         {
             if (pi != myrow)
             {
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[2], mpi_int_t);
                 MPI_Send (usub, msgcnt[2], mpi_int_t, pi,
                           SLU_MPI_TAG (2, k0) /* (4*k0+2)%tag_ub */ ,
                           scp->comm);
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[3], MPI_DOUBLE);
                 MPI_Send (uval, msgcnt[3], MPI_DOUBLE, pi,
                           SLU_MPI_TAG (3, k0) /* (4*k0+3)%tag_ub */ ,
                           scp->comm);
@@ -297,6 +305,7 @@ int_t dISend_UDiagBlock(int_t k0, double *ublk_ptr, /*pointer for the diagonal b
         {
             /* tag = ((k0<<2)+2) % tag_ub;        */
             /* tag = (4*(nsupers+k0)+2) % tag_ub; */
+            commProfSend(COMM_DIAG, comm, pr, size, MPI_DOUBLE);
             MPI_Isend (ublk_ptr, size, MPI_DOUBLE, pr,
                        SLU_MPI_TAG (4, k0) /* tag */ ,
                        comm, U_diag_blk_send_req + pr);
@@ -368,6 +377,7 @@ int_t dISend_LDiagBlock(int_t k0, double *lblk_ptr, /*pointer for the diagonal b
         {
             /* tag = ((k0<<2)+2) % tag_ub;        */
             /* tag = (4*(nsupers+k0)+2) % tag_ub; */
+            commProfSend(COMM_DIAG, comm, pc, size, MPI_DOUBLE);
             MPI_Isend (lblk_ptr, size, MPI_DOUBLE, pc,
                        SLU_MPI_TAG (5, k0) /* tag */ ,
                        comm, L_diag_blk_send_req + pc);
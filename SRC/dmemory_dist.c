@@ -75,13 +75,11 @@ int_t dQuerySpace_dist(int_t n, dLUstruct_t *LUstruct, gridinfo_t *grid,
 {
     register int_t dword, gb, iword, k, nb, nsupers;
     int_t *index, *xsup;
-    int iam, mycol, myrow;
+    int iam;
     Glu_persist_t *Glu_persist = LUstruct->Glu_persist;
     dLocalLU_t *Llu = LUstruct->Llu;
 
     iam = grid->iam;
-    myrow = MYROW( iam, grid );
-    mycol = MYCOL( iam, grid );
     iword = sizeof(int_t);
     dword = sizeof(double);
     nsupers = Glu_persist->supno[n-1] + 1;
@@ -89,9 +87,9 @@ int_t dQuerySpace_dist(int_t n, dLUstruct_t *LUstruct, gridinfo_t *grid,
     mem_usage->for_lu = 0.;
 
     /* For L factor */
-    nb = CEILING( nsupers, grid->npcol ); /* Number of local column blocks */
+    nb = NLBj( nsupers, grid ); /* Number of local column blocks */
     for (k = 0; k < nb; ++k) {
-	gb = k * grid->npcol + mycol; /* Global block number. */
+	gb = GBj( k, grid ); /* Global block number. */
 	if ( gb < nsupers ) {
 	    index = Llu->Lrowind_bc_ptr[k];
 	    if ( index ) {
@@ -103,9 +101,9 @@ int_t dQuerySpace_dist(int_t n, dLUstruct_t *LUstruct, gridinfo_t *grid,
     }
 
     /* For U factor */
-    nb = CEILING( nsupers, grid->nprow ); /* Number of local row blocks */
+    nb = NLBi( nsupers, grid ); /* Number of local row blocks */
     for (k = 0; k < nb; ++k) {
-	gb = k * grid->nprow + myrow; /* Global block number. */
+	gb = GBi( k, grid ); /* Global block number. */
 	if ( gb < nsupers ) {
 	    index = Llu->Ufstnz_br_ptr[k];
 	    if ( index ) {
@@ -125,7 +123,7 @@ int_t dQuerySpace_dist(int_t n, dLUstruct_t *LUstruct, gridinfo_t *grid,
     mem_usage->total +=
 	(float)( Llu->bufmax[0] * iword +  Llu->bufmax[1] * dword );
     mem_usage->total += (float)( maxsup * maxsup + maxsup) * iword;
-    k = CEILING( nsupers, grid->nprow );
+    k = NLBi( nsupers, grid );
     mem_usage->total += (float)(2 * k * iword);
 #else
     /*mem_usage->total += stat->current_buffer;*/
@@ -183,7 +181,7 @@ double dgetLUMem(int_t nodeId, dLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
     int_t** Lrowind_bc_ptr = Llu->Lrowind_bc_ptr;
     double** Lnzval_bc_ptr = Llu->Lnzval_bc_ptr;
     int_t** Ufstnz_br_ptr = Llu->Ufstnz_br_ptr;
-    // double** Unzval_br_ptr = Llu->Unzval_br_ptr;
+    double** Unzval_br_ptr = Llu->Unzval_br_ptr;
     int_t iam = grid->iam;
 
     int_t myrow = MYROW (iam, grid);
@@ -204,7 +202,9 @@ double dgetLUMem(int_t nodeId, dLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
             int_t  len   = lsub[1];       /* LDA of the nzval[] */
             int_t len1  = len + BC_HEADER + nrbl * LB_DESCRIPTOR;
             int_t len2  = SuperSize(nodeId) * len;
-            memlu += 1.0 * (len1 * sizeof(int_t)  + len2 * sizeof(double));
+            memlu += 1.0 * len1 * sizeof(int_t);
+            /* values may be unallocated with lazy ancestor storage */
+            if (lnzval) memlu += 1.0 * len2 * sizeof(double);
         }
     }
 
@@ -220,7 +220,8 @@ double dgetLUMem(int_t nodeId, dLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
         {
             int_t lenv = usub[1];
             int_t lens = usub[2];
-            memlu += 1.0 * (lenv * sizeof(int_t)  + lens * sizeof(double));
+            memlu += 1.0 * lens * sizeof(int_t);
+            if (Unzval_br_ptr[lib]) memlu += 1.0 * lenv * sizeof(double);
         }
     }
     return memlu;
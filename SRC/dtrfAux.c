@@ -572,6 +572,10 @@ dtrf3Dpartition_t* dinitTrf3Dpartition(int_t nsupers,
 		  grid3d);
 
     calcTreeWeight(nsupers, setree, treeList, LUstruct->Glu_persist->xsup);
+    /* balance by the times of the previous factorization, if timed */
+    if ( LUstruct->Llu->nodeCost && LUstruct->Llu->nodeCostN == nsupers
+	 && getenv("SUPERLU_LBS_COST") )
+	setMeasuredWeight(nsupers, setree, treeList, LUstruct->Llu->nodeCost);
 
     gEtreeInfo_t gEtreeInfo;
     gEtreeInfo.setree = setree;
@@ -583,7 +587,7 @@ dtrf3Dpartition_t* dinitTrf3Dpartition(int_t nsupers,
     }
 
     int_t maxLvl = log2i(grid3d->zscp.Np) + 1;
-    sForest_t**  sForests = getForests( maxLvl, nsupers, setree, treeList);
+    sForest_t**  sForests = getForests( maxLvl, grid3d->zscp.Np, nsupers, setree, treeList);
     /*indexes of trees for my process grid in gNodeList size(maxLvl)*/
     int_t* myTreeIdxs = getGridTrees(grid3d);
     int_t* myZeroTrIdxs = getReplicatedTrees(grid3d);
@@ -635,6 +639,24 @@ dtrf3Dpartition_t* dinitTrf3Dpartition(int_t nsupers,
     return trf3Dpartition;
 } /* dinitTrf3Dpartition */
 
+/* Make the partition of the previous factorization ready for another one
+   of the same structure (SamePattern_SameRowPerm): restore what the
+   factorization consumed and reset the ancestor copies. */
+void dresetTrf3Dpartition(int_t nsupers, dtrf3Dpartition_t *trf3Dpartition,
+			  dLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
+{
+    gEtreeInfo_t *gEtreeInfo = &trf3Dpartition->gEtreeInfo;
+
+    for (int_t i = 0; i < nsupers; ++i) gEtreeInfo->numChildLeft[i] = 0;
+    for (int_t i = 0; i < nsupers; ++i)
+	if ( gEtreeInfo->setree[i] < nsupers )
+	    gEtreeInfo->numChildLeft[gEtreeInfo->setree[i]]++;
+
+    dinit3DLUstructForest(trf3Dpartition->myTreeIdxs,
+			  trf3Dpartition->myZeroTrIdxs,
+			  trf3Dpartition->sForests, LUstruct, grid3d);
+} /* dresetTrf3Dpartition */
+
 /* Free memory allocated for trf3Dpartition structure. Sherry added this routine */
 void dDestroy_trf3Dpartition(dtrf3Dpartition_t *trf3Dpartition, gridinfo3d_t *grid3d)
 {
@@ -443,6 +443,7 @@ int dDeAllocGlu_3d(dLUstruct_t * LUstruct)
 {
     SUPERLU_FREE(LUstruct->Glu_persist->xsup);
     SUPERLU_FREE(LUstruct->Glu_persist->supno);
+    LUstruct->Glu_persist->xsup = LUstruct->Glu_persist->supno = NULL;
     return 0;
 }
 
@@ -458,16 +459,19 @@ int dDeAllocLlu_3d(int_t n, dLUstruct_t * LUstruct, gridinfo3d_t* grid3d)
     for (i = 0; i < nbc; ++i) 
 	if ( Llu->Lrowind_bc_ptr[i] ) {
 	    SUPERLU_FREE (Llu->Lrowind_bc_ptr[i]);
-	    SUPERLU_FREE (Llu->Lnzval_bc_ptr[i]);
+	    /* may be unallocated with lazy ancestor storage */
+	    if ( Llu->Lnzval_bc_ptr[i] ) SUPERLU_FREE (Llu->Lnzval_bc_ptr[i]);
 	}
     SUPERLU_FREE (Llu->Lrowind_bc_ptr);
     SUPERLU_FREE (Llu->Lnzval_bc_ptr);
+    Llu->Lrowind_bc_ptr = NULL; /* tells pdgssvx3d() the structure is gone */
+    Llu->Lnzval_bc_ptr = NULL;
 
     nbr = CEILING(nsupers, grid3d->nprow);
     for (i = 0; i < nbr; ++i)
 	if ( Llu->Ufstnz_br_ptr[i] ) {
 	    SUPERLU_FREE (Llu->Ufstnz_br_ptr[i]);
-	    SUPERLU_FREE (Llu->Unzval_br_ptr[i]);
+	    if ( Llu->Unzval_br_ptr[i] ) SUPERLU_FREE (Llu->Unzval_br_ptr[i]);
 	}
     SUPERLU_FREE (Llu->Ufstnz_br_ptr);
     SUPERLU_FREE (Llu->Unzval_br_ptr);
@@ -591,24 +595,21 @@ int file_Printdouble5(FILE *fp, char *name, int_t len, double *x)
 void dPrintLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, dLocalLU_t *Llu)
 {
-    register int c, extra, gb, j, lb, nsupc, nsupr, len, nb, ncb;
-    register int_t k, mycol, r;
+    register int c, gb, j, lb, nsupc, nsupr, len, nb, ncb;
+    register int_t k, r;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
     double *nzval;
 
     printf("\n[%d] L BLOCKS IN COLUMN-MAJOR ORDER -->\n", iam);
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nb = index[0];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    printf("[%d] block column %d (local # %d), nsupc %d, # row blocks %d\n",
 		   iam, gb, lb, nsupc, nb);
@@ -629,7 +630,7 @@ void dPrintLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 	PrintInt32("fsendx_plist[]", grid->nprow, Llu->fsendx_plist[lb]);
     }
     printf("nfrecvx %d\n", Llu->nfrecvx);
-    k = CEILING( nsupers, grid->nprow );
+    k = NLBi( nsupers, grid );
     PrintInt32("fmod", k, Llu->fmod);
 
 } /* DPRINTLBLOCKS */
@@ -640,8 +641,8 @@ void dPrintLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void dZeroLblocks(int iam, int n, gridinfo_t *grid, dLUstruct_t *LUstruct)
 {
     double zero = 0.0;
-    register int extra, gb, j, lb, nsupc, nsupr, ncb;
-    register int_t k, mycol, r;
+    register int gb, j, lb, nsupc, nsupr, ncb;
+    register int_t k, r;
     dLocalLU_t *Llu = LUstruct->Llu;
     Glu_persist_t *Glu_persist = LUstruct->Glu_persist;
     int_t *xsup = Glu_persist->xsup;
@@ -649,16 +650,13 @@ void dZeroLblocks(int iam, int n, gridinfo_t *grid, dLUstruct_t *LUstruct)
     double *nzval;
     int_t nsupers = Glu_persist->supno[n-1] + 1;
 
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (j = 0; j < nsupc; ++j) {
                 for (r = 0; r < nsupr; ++r) {
@@ -675,8 +673,8 @@ void dZeroLblocks(int iam, int n, gridinfo_t *grid, dLUstruct_t *LUstruct)
 void dDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, dLocalLU_t *Llu)
 {
-    register int c, extra, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
-    int k, mycol, r, n, nmax;
+    register int c, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
+    int k, r, n, nmax;
     int_t nnzL;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
@@ -689,17 +687,14 @@ void dDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 	// count nonzeros in the first pass
 	nnzL = 0;
 	n = 0;
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nb = index[0];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -733,17 +728,14 @@ void dDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		fprintf(fp, "%d %d " IFMT "\n", n,n,nnzL);
 	}
 
-     ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+     ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nb = index[0];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -773,8 +765,8 @@ void dDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void dComputeLevelsets(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, dLocalLU_t *Llu, int_t *levels)
 {
-    register int c, extra, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
-    register int_t k, mycol, r;
+    register int c, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
+    register int_t k, r;
 	int_t nnzL, n,nmax,lk;
     int_t *xsup = Glu_persist->xsup;
     int_t *index,*lloc;
@@ -787,10 +779,7 @@ void dComputeLevelsets(int iam, int_t nsupers, gridinfo_t *grid,
 	// count nonzeros in the first pass
 	nnzL = 0;
 	n = 0;
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
@@ -815,8 +804,8 @@ void dComputeLevelsets(int iam, int_t nsupers, gridinfo_t *grid,
 void dGenCOOLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, dLocalLU_t *Llu, int_t** cooRows, int_t** cooCols, double ** cooVals, int_t* n, int_t* nnzL)
 {
-    register int c, extra, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
-    register int_t k, mycol, r;
+    register int c, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
+    register int_t k, r;
 	int_t nmax,cnt;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
@@ -829,10 +818,7 @@ void dGenCOOLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 	// count nonzeros in the first pass
 	*nnzL = 0;
 	*n = 0;
-	ncb = nsupers / grid->npcol;
-	extra = nsupers % grid->npcol;
-	mycol = MYCOL( iam, grid );
-	if ( mycol < extra ) ++ncb;
+	ncb = MyNLBj( nsupers, grid );
 	for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
@@ -840,7 +826,7 @@ void dGenCOOLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		nzval = Llu->Lnzval_bc_ptr[lb];
 		nb = index[0];
 		nsupr = index[1];
-		gb = lb * grid->npcol + mycol;
+		gb = GBj( lb, grid );
 		nsupc = SuperSize( gb );
 		for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -871,10 +857,7 @@ void dGenCOOLblocks(int iam, int_t nsupers, gridinfo_t *grid,
         ABORT("Malloc fails for cooVals[].");
 	*nnzL = 0;
 	*n = 0;
-	ncb = nsupers / grid->npcol;
-	extra = nsupers % grid->npcol;
-	mycol = MYCOL( iam, grid );
-	if ( mycol < extra ) ++ncb;
+	ncb = MyNLBj( nsupers, grid );
 	for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
@@ -882,7 +865,7 @@ void dGenCOOLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		nzval = Llu->Lnzval_bc_ptr[lb];
 		nb = index[0];
 		nsupr = index[1];
-		gb = lb * grid->npcol + mycol;
+		gb = GBj( lb, grid );
 		nsupc = SuperSize( gb );
 		for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -922,8 +905,8 @@ void dGenCOOLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void dGenCSCLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, dLocalLU_t *Llu, double **nzval, int_t **rowind, int_t **colptr, int_t* n, int_t* nnzL)
 {
-    register int c, extra, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
-    register int_t k, mycol, r;
+    register int c, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
+    register int_t k, r;
 	int_t nmax,cnt, jsize;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
@@ -943,10 +926,7 @@ void dGenCSCLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 	// count nonzeros in the first pass
 	*nnzL = 0;
 	*n = 0;
-	ncb = nsupers / grid->npcol;
-	extra = nsupers % grid->npcol;
-	mycol = MYCOL( iam, grid );
-	if ( mycol < extra ) ++ncb;
+	ncb = MyNLBj( nsupers, grid );
 	for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
@@ -954,7 +934,7 @@ void dGenCSCLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		nzval0 = Llu->Lnzval_bc_ptr[lb];
 		nb = index[0];
 		nsupr = index[1];
-		gb = lb * grid->npcol + mycol;
+		gb = GBj( lb, grid );
 		nsupc = SuperSize( gb );
 		for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -985,10 +965,7 @@ void dGenCSCLblocks(int iam, int_t nsupers, gridinfo_t *grid,
         ABORT("Malloc fails for col[]");
 	*nnzL = 0;
 	*n = 0;
-	ncb = nsupers / grid->npcol;
-	extra = nsupers % grid->npcol;
-	mycol = MYCOL( iam, grid );
-	if ( mycol < extra ) ++ncb;
+	ncb = MyNLBj( nsupers, grid );
 	for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
@@ -996,7 +973,7 @@ void dGenCSCLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		nzval0 = Llu->Lnzval_bc_ptr[lb];
 		nb = index[0];
 		nsupr = index[1];
-		gb = lb * grid->npcol + mycol;
+		gb = GBj( lb, grid );
 		nsupc = SuperSize( gb );
 		for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -1075,8 +1052,8 @@ void dGenCSCLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void dGenCSRLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, dLocalLU_t *Llu, double **nzval, int_t **colind, int_t **rowptr, int_t* n, int_t* nnzL)
 {
-    register int c, extra, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
-    register int_t k, mycol, r;
+    register int c, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
+    register int_t k, r;
 	int_t nmax,cnt, isize;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
@@ -1096,10 +1073,7 @@ void dGenCSRLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 	// count nonzeros in the first pass
 	*nnzL = 0;
 	*n = 0;
-	ncb = nsupers / grid->npcol;
-	extra = nsupers % grid->npcol;
-	mycol = MYCOL( iam, grid );
-	if ( mycol < extra ) ++ncb;
+	ncb = MyNLBj( nsupers, grid );
 	for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
@@ -1107,7 +1081,7 @@ void dGenCSRLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		nzval0 = Llu->Lnzval_bc_ptr[lb];
 		nb = index[0];
 		nsupr = index[1];
-		gb = lb * grid->npcol + mycol;
+		gb = GBj( lb, grid );
 		nsupc = SuperSize( gb );
 		for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -1138,10 +1112,7 @@ void dGenCSRLblocks(int iam, int_t nsupers, gridinfo_t *grid,
         ABORT("Malloc fails for col[]");
 	*nnzL = 0;
 	*n = 0;
-	ncb = nsupers / grid->npcol;
-	extra = nsupers % grid->npcol;
-	mycol = MYCOL( iam, grid );
-	if ( mycol < extra ) ++ncb;
+	ncb = MyNLBj( nsupers, grid );
 	for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
@@ -1149,7 +1120,7 @@ void dGenCSRLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		nzval0 = Llu->Lnzval_bc_ptr[lb];
 		nb = index[0];
 		nsupr = index[1];
-		gb = lb * grid->npcol + mycol;
+		gb = GBj( lb, grid );
 		nsupc = SuperSize( gb );
 		for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -1229,24 +1200,21 @@ void dGenCSRLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void dPrintUblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, dLocalLU_t *Llu)
 {
-    register int c, extra, jb, k, lb, len, nb, nrb, nsupc;
-    register int_t myrow, r;
+    register int c, jb, k, lb, len, nb, nrb, nsupc;
+    register int_t r;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
     double *nzval;
 
     printf("\n[%d] U BLOCKS IN ROW-MAJOR ORDER -->\n", iam);
-    nrb = nsupers / grid->nprow;
-    extra = nsupers % grid->nprow;
-    myrow = MYROW( iam, grid );
-    if ( myrow < extra ) ++nrb;
+    nrb = MyNLBi( nsupers, grid );
     for (lb = 0; lb < nrb; ++lb) {
 	index = Llu->Ufstnz_br_ptr[lb];
 	if ( index ) { /* Not an empty row */
 	    nzval = Llu->Unzval_br_ptr[lb];
 	    nb = index[0];
 	    printf("[%d] block row " IFMT " (local # %d), # column blocks %d\n",
-		   iam, lb*grid->nprow+myrow, lb, nb);
+		   iam, GBi( lb, grid ), lb, nb);
 	    r  = 0;
 	    for (c = 0, k = BR_HEADER; c < nb; ++c) {
 		jb = index[k];
@@ -1270,8 +1238,8 @@ void dPrintUblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void dZeroUblocks(int iam, int n, gridinfo_t *grid, dLUstruct_t *LUstruct)
 {
     double zero = 0.0;
-    register int i, extra, lb, len, nrb;
-    register int myrow, r;
+    register int i, lb, len, nrb;
+    register int r;
     dLocalLU_t *Llu = LUstruct->Llu;
     Glu_persist_t *Glu_persist = LUstruct->Glu_persist;
     int_t *xsup = Glu_persist->xsup;
@@ -1279,10 +1247,7 @@ void dZeroUblocks(int iam, int n, gridinfo_t *grid, dLUstruct_t *LUstruct)
     double *nzval;
     int nsupers = Glu_persist->supno[n-1] + 1;
 
-    nrb = nsupers / grid->nprow;
-    extra = nsupers % grid->nprow;
-    myrow = MYROW( iam, grid );
-    if ( myrow < extra ) ++nrb;
+    nrb = MyNLBi( nsupers, grid );
     for (lb = 0; lb < nrb; ++lb) {
 	index = Llu->Ufstnz_br_ptr[lb];
 	if ( index ) { /* Not an empty row */
@@ -1333,7 +1298,7 @@ dGenXtrueRHS(int nrhs, SuperMatrix *A, Glu_persist_t *Glu_persist,
     myrow = MYROW( iam, grid );
     Astore = (NCformat *) A->Store;
     aval = Astore->nzval;
-    lb = CEILING( nsupers, grid->nprow ) + 1;
+    lb = NLBi( nsupers, grid ) + 1;
     if ( !(lxsup = intMalloc_dist(lb)) )
 	ABORT("Malloc fails for lxsup[].");
 
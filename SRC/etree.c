@@ -429,3 +429,93 @@ int_t *TreePostorder_dist(
 	return post;
 }
 
+
+/*! \brief Column counts of the Cholesky factor of a symmetric pattern
+ *
+ * <pre>
+ *      Compute the number of nonzeros in each column of the Cholesky
+ *      factor L of a symmetric matrix A, without forming L.  This is
+ *      the row-subtree algorithm of Gilbert, Ng and Peyton, which runs
+ *      in time O(nz(A)*alpha(nz(A),n)).
+ *
+ *      Input:
+ *        Sparse matrix A with both triangles stored (e.g., as returned
+ *        by at_plus_a_dist()); the diagonal may be absent.
+ *        The etree of A, with n meaning a root of the forest.
+ *      Output:
+ *        colcnt[j] = nnz(L(:,j)), including the diagonal.
+ *
+ *      For an unsymmetric A ordered on A'+A, nnz(L+U) is bounded by
+ *      2*sum(colcnt) - n, which is what the pre-analysis routines use
+ *      to compare orderings and blocking parameters cheaply.
+ * </pre>
+ */
+int
+sp_symcolcnt_dist(
+	    int_t *acolst, int_t *acolend, /* column starts and ends past 1 */
+	    int_t *arow,            /* row indices of A */
+	    int_t n,                /* dimension of A */
+	    int_t *parent,          /* parent in elim tree */
+	    int_t *colcnt           /* column counts of L (output) */
+	    )
+{
+	int_t	*post, *order, *ancestor, *maxfirst, *prevleaf, *first;
+	int_t	i, j, k, p, q, s, jprev, sparent;
+
+	if ( n <= 0 ) return 0;
+	if ( !(order = intMalloc_dist(5*n)) )
+	    ABORT("Malloc fails for order[]");
+	ancestor = order + n;
+	maxfirst = ancestor + n;
+	prevleaf = maxfirst + n;
+	first    = prevleaf + n;
+
+	/* post[v] is the postorder number of vertex v. */
+	post = TreePostorder_dist(n, parent);
+	for (j = 0; j < n; ++j) order[post[j]] = j;
+	SUPERLU_FREE(post);
+
+	for (j = 0; j < n; ++j) {
+		first[j] = maxfirst[j] = prevleaf[j] = -1;
+		ancestor[j] = j;
+	}
+
+	/* first[j] is the postorder number of the first descendant of j;
+	   leaves start with a count of one. */
+	for (k = 0; k < n; ++k) {
+		j = order[k];
+		colcnt[j] = (first[j] == -1) ? 1 : 0;
+		for ( ; j != n && first[j] == -1; j = parent[j]) first[j] = k;
+	}
+
+	for (k = 0; k < n; ++k) {
+		j = order[k];
+		if ( parent[j] != n ) colcnt[parent[j]]--;
+		for (p = acolst[j]; p < acolend[j]; p++) {
+			i = arow[p];
+			/* Is j a leaf of the i-th row subtree? */
+			if ( i <= j || first[j] <= maxfirst[i] ) continue;
+			maxfirst[i] = first[j];
+			jprev = prevleaf[i];
+			prevleaf[i] = j;
+			colcnt[j]++;
+			if ( jprev != -1 ) {
+				/* Subsequent leaf: q = lca(jprev, j). */
+				for (q = jprev; q != ancestor[q]; q = ancestor[q]) ;
+				for (s = jprev; s != q; s = sparent) {
+					sparent = ancestor[s];
+					ancestor[s] = q;
+				}
+				colcnt[q]--;
+			}
+		}
+		if ( parent[j] != n ) ancestor[j] = parent[j];
+	}
+
+	/* Sum up the deltas; parent[j] > j in an elimination tree. */
+	for (j = 0; j < n; ++j)
+		if ( parent[j] != n ) colcnt[parent[j]] += colcnt[j];
+
+	SUPERLU_FREE(order);
+	return 0;
+} /* SP_SYMCOLCNT_DIST */
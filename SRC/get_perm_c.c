@@ -452,6 +452,8 @@ at_plus_a_dist(
  *         = MMD_AT_PLUS_A: minimum degree ordering on structure of A'+A
  *         = MMD_ATA: minimum degree ordering on structure of A'*A
  *         = METIS_AT_PLUS_A: MeTis on A'+A
+ *         = AMD_AT_PLUS_A: approximate minimum degree on A'+A
+ *         = ND_AT_PLUS_A: nested dissection on A'+A
  * 
  * A       (input) SuperMatrix*
  *         Matrix A in A*X=B, of dimension (A->nrow, A->ncol). The number
@@ -541,6 +543,29 @@ get_perm_c_dist(int_t pnum, int_t ispec, SuperMatrix *A, int_t *perm_c)
 	      return;
 #endif
 
+        case AMD_AT_PLUS_A: /* Approximate minimum degree on A'+A */
+        case ND_AT_PLUS_A:  /* Nested dissection on A'+A */
+	      if ( m != n ) ABORT("Matrix is not square");
+	      at_plus_a_dist(n, Astore->nnz, Astore->colptr, Astore->rowind,
+			     &bnz, &b_colptr, &b_rowind);
+
+	      if ( bnz ) { /* non-empty adjacency structure */
+		  if ( ispec == AMD_AT_PLUS_A )
+		      amd_order_dist(n, b_colptr, b_rowind, perm_c);
+		  else
+		      nd_order_dist(n, b_colptr, b_rowind, perm_c);
+		  SUPERLU_FREE(b_rowind);
+	      } else { /* e.g., diagonal matrix */
+		  for (i = 0; i < n; ++i) perm_c[i] = i;
+	      }
+	      SUPERLU_FREE(b_colptr);
+
+#if ( PRNTlevel>=1 )
+	      if ( !pnum ) printf(".. Use %s ordering on A'+A\n",
+			ispec == AMD_AT_PLUS_A ? "AMD" : "nested dissection");
+#endif
+	      return;
+
         default:
 	      ABORT("Invalid ISPEC");
     }
@@ -593,3 +618,187 @@ get_perm_c_dist(int_t pnum, int_t ispec, SuperMatrix *A, int_t *perm_c)
     CHECK_MALLOC((int) pnum, "Exit get_perm_c_dist()");
 #endif
 } /* get_perm_c_dist */
+
+/*! \brief Orderings compared by get_perm_c_race_dist(). */
+static const colperm_t race_orderings[] = {
+    MMD_AT_PLUS_A, MMD_ATA, AMD_AT_PLUS_A, ND_AT_PLUS_A,
+#ifdef HAVE_COLAMD
+    COLAMD,
+#endif
+#ifdef HAVE_PARMETIS
+    METIS_AT_PLUS_A,
+#endif
+};
+
+/*! \brief Predicted cost of the factorization of Pc*(A'+A)*Pc'.
+ *
+ * <pre>
+ * (b_colptr, b_rowind) is the structure of A'+A as returned by
+ * at_plus_a_dist().  The cost is computed from the column counts of the
+ * Cholesky factor, without a symbolic factorization, for the supernode
+ * partition the factorization uses: relaxed supernodes of at most relax
+ * columns at the leaves, as in relax_snode(), and fundamental supernodes
+ * of at most maxsup columns elsewhere.  A supernode is stored dense, so
+ * its columns are counted with the rows of the whole supernode:
+ *     metric = 0: the flops of the LU factorization,
+ *     metric = 1: nnz(L+U).
+ * work[] is of size 7*n + 1 + bnz.
+ * </pre>
+ */
+static double
+race_cost(int_t n, int_t bnz, int_t *b_colptr, int_t *b_rowind,
+	  int_t *perm_c, int metric, int relax, int maxsup, int_t *work)
+{
+    int_t *colbeg = work, *colend = work + n, *par = work + 2*n;
+    int_t *cnt = work + 3*n, *parent = work + 4*n, *colcnt = work + 5*n;
+    int_t *desc = work + 6*n, *rowind = work + 7*n + 1;
+    int_t *relax_end = colbeg, *post, i, j, k, nsupc, nrow;
+    double l, cost = 0.0;
+
+    for (j = 0; j < n; ++j) {
+	colbeg[perm_c[j]] = b_colptr[j];
+	colend[perm_c[j]] = b_colptr[j+1];
+    }
+    for (i = 0; i < bnz; ++i) rowind[i] = perm_c[b_rowind[i]];
+
+    sp_symetree_dist(colbeg, colend, rowind, n, par);
+    sp_symcolcnt_dist(colbeg, colend, rowind, n, par, cnt);
+
+    /* Renumber in postorder, so that subtrees are contiguous. */
+    post = TreePostorder_dist(n, par);
+    for (j = 0; j < n; ++j) {
+	parent[post[j]] = ( par[j] == n ) ? n : post[par[j]];
+	colcnt[post[j]] = cnt[j];
+    }
+    SUPERLU_FREE(post);
+
+    /* Relaxed supernodes at the leaves. */
+    relax = SUPERLU_MIN(relax, maxsup);
+    ifill_dist(relax_end, n, SLU_EMPTY);
+    ifill_dist(desc, n+1, 0);
+    for (j = 0; j < n; j++)
+	if ( parent[j] != n ) desc[parent[j]] += desc[j] + 1;
+    for (j = 0; j < n; ) {
+	k = j;
+	while ( parent[j] != n && desc[parent[j]] < relax ) j = parent[j];
+	relax_end[k] = j;
+	++j;
+	while ( j < n && desc[j] != 0 ) ++j;
+    }
+
+    for (j = 0; j < n; j = k + 1) {
+	if ( relax_end[j] != SLU_EMPTY ) {
+	    k = relax_end[j];
+	    for (nrow = 0, i = j; i <= k; ++i)
+		nrow = SUPERLU_MAX(nrow, colcnt[i] + i - j);
+	} else {
+	    k = j;
+	    while ( k+1 < n && k+1-j < maxsup && relax_end[k+1] == SLU_EMPTY
+		    && parent[k] == k+1 && colcnt[k] == colcnt[k+1] + 1 ) ++k;
+	    nrow = colcnt[j];
+	}
+	nsupc = k - j + 1;
+
+	for (i = 0; i < nsupc; ++i) {
+	    l = (double) (nrow - i - 1);
+	    cost += metric ? 2.0 * l + 1.0 : l + 2.0 * l * l;
+	}
+    }
+    return cost;
+}
+
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *
+ * GET_PERM_C_RACE_DIST computes the orderings in race_orderings[] on
+ * different processes of the grid, predicts the cost of each from the
+ * column counts of Pc*(A'+A)*Pc' and the supernode partition given by
+ * sp_ienv_dist(2) and sp_ienv_dist(3), and returns the cheapest in perm_c[]
+ * on all processes.  If there are fewer processes than orderings, a
+ * process computes several of them in turn.
+ *
+ * All processes in grid must call this routine with the same A.
+ *
+ * Arguments
+ * =========
+ *
+ * options (input) superlu_dist_options_t*
+ *         The cost to minimize is sp_ienv_dist(12, options): 0 for flops,
+ *         1 for nnz(L+U).
+ *
+ * A       (input) SuperMatrix*
+ *         Global matrix Pr*A in NC format; only the structure is used.
+ *
+ * perm_c  (output) int_t*
+ *         Column permutation vector of size A->ncol, as in
+ *         get_perm_c_dist().
+ *
+ * grid    (input) gridinfo_t*
+ *         The processes that share the work.
+ * </pre>
+ */
+void
+get_perm_c_race_dist(superlu_dist_options_t *options, SuperMatrix *A,
+		     int_t *perm_c, gridinfo_t *grid)
+{
+    NCformat *Astore = A->Store;
+    int_t n = A->ncol, bnz = 0, *b_colptr = NULL, *b_rowind = NULL;
+    int_t *perm, *work, i;
+    int c, ncand, nprocs = grid->nprow * grid->npcol, iam = grid->iam;
+    int metric = sp_ienv_dist(12, options);
+    int relax = sp_ienv_dist(2, options), maxsup = sp_ienv_dist(3, options);
+    double cost;
+    struct { double cost; int cand; } mine, best;
+
+#if ( DEBUGlevel>=1 )
+    CHECK_MALLOC(iam, "Enter get_perm_c_race_dist()");
+#endif
+
+    ncand = sizeof(race_orderings) / sizeof(race_orderings[0]);
+    mine.cost = 1.0e300;
+    mine.cand = ncand;
+
+    if ( iam < ncand ) {
+	if ( A->nrow != n ) ABORT("Matrix is not square");
+	at_plus_a_dist(n, Astore->nnz, Astore->colptr, Astore->rowind,
+		       &bnz, &b_colptr, &b_rowind);
+	if ( !(perm = intMalloc_dist(n)) ) ABORT("Malloc fails for perm[]");
+	if ( !(work = intMalloc_dist(7*n + 1 + bnz)) )
+	    ABORT("Malloc fails for work[]");
+
+	for (c = iam; c < ncand; c += nprocs) {
+	    get_perm_c_dist(iam, race_orderings[c], A, perm);
+	    cost = race_cost(n, bnz, b_colptr, b_rowind, perm, metric,
+			     relax, maxsup, work);
+#if ( PRNTlevel>=1 )
+	    printf("(%d) .. ordering race: ColPerm %d, cost %e\n",
+		   iam, (int) race_orderings[c], cost);
+#endif
+	    if ( cost < mine.cost ) {
+		mine.cost = cost;
+		mine.cand = c;
+		for (i = 0; i < n; ++i) perm_c[i] = perm[i];
+	    }
+	}
+
+	SUPERLU_FREE(perm);
+	SUPERLU_FREE(work);
+	SUPERLU_FREE(b_colptr);
+	if ( bnz ) SUPERLU_FREE(b_rowind);
+    }
+
+    /* Ties go to the earlier candidate in race_orderings[]. */
+    MPI_Allreduce(&mine, &best, 1, MPI_DOUBLE_INT, MPI_MINLOC, grid->comm);
+    MPI_Bcast(perm_c, n, mpi_int_t, best.cand % nprocs, grid->comm);
+
+#if ( PRNTlevel>=1 )
+    if ( !iam ) printf(".. ordering race: ColPerm %d selected, cost %e\n",
+		       (int) race_orderings[best.cand], best.cost);
+#endif
+#if ( DEBUGlevel>=1 )
+    CHECK_MALLOC(iam, "Exit get_perm_c_race_dist()");
+#endif
+} /* get_perm_c_race_dist */
@@ -365,6 +365,592 @@ get_perm_c_parmetis (SuperMatrix *A, int_t *perm_r, int_t *perm_c,
   return (-mem);
 } /* get_perm_c_parmetis */
 
+/*
+ * Distributed nested dissection, used when ParMETIS is not available.
+ */
+
+/* Tree node index of subdomain g at depth d of a separator tree with
+   2^L leaves, in the layout of ParMETIS_V3_NodeND. */
+#define DND_NODE(L, d, g)  (((int_t) 2 << (L)) - ((int_t) 2 << (d)) + (g))
+/* part[v] of a vertex in the separator of node t */
+#define DND_SEP(t)         (-(t) - 2)
+
+/*! \brief The part of A'+A owned by one process during the distributed
+ *  nested dissection.  The local vertices vert[0:nv-1] are in increasing
+ *  order, and vertex vert[k] has the neighbors adj[xadj[k]:xadj[k+1]-1],
+ *  in the global numbering.  The neighbors owned by other processes are
+ *  the ghosts ghost[0:ng-1], also in increasing order.  part[] and
+ *  level[] have one entry per local vertex followed by one per ghost;
+ *  nbr[] is that position for each entry of adj[].  Across the processes
+ *  of a group, the local vertices are in increasing order of the ranks.
+ */
+typedef struct {
+    int_t nv, ng;
+    int_t *vert, *xadj, *adj;
+    int_t *ghost, *nbr;
+    int_t *part;   /* tree node of each vertex, or DND_SEP(node) */
+    int_t *level;  /* BFS level; owner during redistribution */
+    int_t *gbuf;   /* receive buffer of the BFS, of size szgbuf */
+    int_t szgbuf;
+} dnd_graph_t;
+
+static int
+dnd_cmp(const void *a, const void *b)
+{
+    int_t x = *(const int_t *) a, y = *(const int_t *) b;
+    return (x > y) - (x < y);
+}
+
+/*! \brief Position of v in the increasing list[0:len-1], or SLU_EMPTY. */
+static int_t
+dnd_search(const int_t *list, int_t len, int_t v)
+{
+    int_t lo = 0, hi = len - 1, mid;
+
+    while ( lo <= hi ) {
+        mid = lo + (hi - lo) / 2;
+	if ( list[mid] < v ) lo = mid + 1;
+	else if ( list[mid] > v ) hi = mid - 1;
+	else return mid;
+    }
+    return SLU_EMPTY;
+}
+
+/*! \brief Position of vertex v in part[] and level[], or SLU_EMPTY if v
+ *  is neither local nor a ghost.
+ */
+static int_t
+dnd_position(dnd_graph_t *g, int_t v)
+{
+    int_t k = dnd_search(g->vert, g->nv, v);
+
+    if ( k == SLU_EMPTY && (k = dnd_search(g->ghost, g->ng, v)) != SLU_EMPTY )
+        k += g->nv;
+    return k;
+}
+
+/*! \brief Find the ghosts of the local subgraph and set nbr[]; part[]
+ *  is set to t for all the vertices.
+ */
+static void
+dnd_ghosts(dnd_graph_t *g, int_t t)
+{
+    int_t i, k, ng, nnz = g->xadj[g->nv];
+
+    if ( !(g->ghost = intMalloc_dist(nnz + 1)) ) ABORT("Malloc fails for ghost[]");
+    for (i = 0, ng = 0; i < nnz; ++i)
+        if ( dnd_search(g->vert, g->nv, g->adj[i]) == SLU_EMPTY )
+	    g->ghost[ng++] = g->adj[i];
+    qsort(g->ghost, (size_t) ng, sizeof(int_t), dnd_cmp);
+    for (i = 0, k = 0; i < ng; ++i)
+        if ( k == 0 || g->ghost[i] != g->ghost[k-1] ) g->ghost[k++] = g->ghost[i];
+    g->ng = k;
+
+    if ( !(g->nbr = intMalloc_dist(nnz + 2 * (g->nv + g->ng) + 1)) )
+        ABORT("Malloc fails for nbr[]");
+    g->part = g->nbr + nnz;
+    g->level = g->part + g->nv + g->ng;
+    for (i = 0; i < nnz; ++i) g->nbr[i] = dnd_position(g, g->adj[i]);
+    for (k = 0; k < g->nv + g->ng; ++k) g->part[k] = t;
+} /* dnd_ghosts */
+
+/*! \brief Breadth-first search of the subgraph of nS vertices held by
+ *  the processes of comm, from vertex start.
+ *
+ * <pre>
+ * The components not reached from start are searched in turn, each
+ * starting a new level from the smallest vertex not reached.  On return,
+ * level[] is set for the local vertices and the ghosts, lptr[l] is the
+ * number of vertices in the levels before l over all processes, and
+ * fr[] holds the positions of the local vertices in the order of their
+ * levels, level l being fr[lfr[l]:lfr[l+1]-1], and *last is the first
+ * vertex found in the last level.  lptr[] and lfr[] are grown as needed,
+ * to *szlev entries.  Each step gathers the vertices found by all
+ * processes.  Returns the number of levels.
+ * </pre>
+ */
+static int_t
+dnd_bfs(dnd_graph_t *g, int_t n, int_t nS, int_t start, int_t *fr,
+        int_t **lptr, int_t **lfr, int_t *szlev, int_t *last, int_t *cand,
+	int *cnts, int *displs, MPI_Comm comm)
+{
+    int_t v, k, i, p, nf, nc, nlev, scan, total, cnt, ncur, *tmp;
+    int   q, gsize;
+
+    MPI_Comm_size(comm, &gsize);
+    for (k = 0; k < g->nv + g->ng; ++k) g->level[k] = SLU_EMPTY;
+    nf = nlev = scan = ncur = 0;
+    (*lptr)[0] = (*lfr)[0] = 0;
+    for (;;) {
+        if ( ncur == 0 ) { /* empty level, start a new component */
+	    if ( (*lptr)[nlev] == nS ) break;
+	    if ( nlev == 0 ) v = start;
+	    else {
+	        while ( scan < g->nv && g->level[scan] != SLU_EMPTY ) ++scan;
+		v = scan < g->nv ? g->vert[scan] : n;
+		MPI_Allreduce(MPI_IN_PLACE, &v, 1, mpi_int_t, MPI_MIN, comm);
+	    }
+	    *last = v;
+	    if ( (p = dnd_position(g, v)) != SLU_EMPTY ) {
+	        g->level[p] = nlev;
+		if ( p < g->nv ) fr[nf++] = p;
+	    }
+	    ncur = 1;
+	}
+
+	/* Neighbors of the local vertices of level nlev. */
+	nc = 0;
+	for (k = (*lfr)[nlev]; k < nf; ++k)
+	    for (i = g->xadj[fr[k]]; i < g->xadj[fr[k]+1]; ++i) {
+	        p = g->nbr[i];
+		if ( g->level[p] == SLU_EMPTY ) {
+		    g->level[p] = -2; /* local mark */
+		    cand[nc++] = p;
+		}
+	    }
+	for (k = 0; k < nc; ++k) {
+	    p = cand[k];
+	    g->level[p] = SLU_EMPTY;
+	    cand[k] = p < g->nv ? g->vert[p] : g->ghost[p - g->nv];
+	}
+
+	q = (int) nc;
+	MPI_Allgather(&q, 1, MPI_INT, cnts, 1, MPI_INT, comm);
+	for (q = 0, total = 0; q < gsize; ++q) {
+	    displs[q] = (int) total;
+	    total += cnts[q];
+	}
+	if ( total > g->szgbuf ) {
+	    if ( g->gbuf ) SUPERLU_FREE(g->gbuf);
+	    g->szgbuf = SUPERLU_MAX(total, 2 * g->szgbuf);
+	    if ( !(g->gbuf = intMalloc_dist(g->szgbuf)) )
+	        ABORT("Malloc fails for gbuf[]");
+	}
+	MPI_Allgatherv(cand, (int) nc, mpi_int_t, g->gbuf, cnts, displs,
+	               mpi_int_t, comm);
+
+	if ( nlev + 2 > *szlev ) {
+	    *szlev *= 2;
+	    if ( !(tmp = intMalloc_dist(2 * *szlev)) ) ABORT("Malloc fails for lptr[]");
+	    for (k = 0; k <= nlev; ++k) {
+	        tmp[k] = (*lptr)[k];
+		tmp[*szlev + k] = (*lfr)[k];
+	    }
+	    SUPERLU_FREE(*lptr);
+	    *lptr = tmp;
+	    *lfr = tmp + *szlev;
+	}
+	(*lptr)[nlev+1] = (*lptr)[nlev] + ncur;
+	(*lfr)[++nlev] = nf;
+	if ( total ) *last = g->gbuf[0];
+	for (k = 0, cnt = 0; k < total; ++k) {
+	    p = dnd_position(g, g->gbuf[k]);
+	    if ( p != SLU_EMPTY && g->level[p] == SLU_EMPTY ) {
+	        g->level[p] = nlev;
+		if ( p < g->nv ) {
+		    fr[nf++] = p;
+		    ++cnt;
+		}
+	    }
+	}
+	MPI_Allreduce(&cnt, &ncur, 1, mpi_int_t, MPI_SUM, comm);
+    }
+    return nlev;
+} /* dnd_bfs */
+
+/*! \brief Split the subgraph of node t into the subgraphs of its
+ *  children tl and tr and a vertex separator.
+ *
+ * <pre>
+ * The level structure rooted at a pseudo-peripheral vertex is cut at
+ * a thin level L with enough vertices on both sides of it; the
+ * vertices of level L adjacent to level L+1 form the separator, and the
+ * rest of level L joins the left part.  part[] is updated for the local
+ * vertices and the ghosts.  On return, sep[] holds the separator in
+ * increasing order, the same on all the processes of comm.  Returns the
+ * size of the separator.
+ * </pre>
+ */
+static int_t
+dnd_split(dnd_graph_t *g, int_t n, int_t t, int_t tl, int_t tr, int_t nS,
+          int_t **sep, MPI_Comm comm)
+{
+    int_t *fr, *lptr, *lfr, *cand, v, k, i, l, L, nlev, nsep, best, sz,
+          total, szlev = 64;
+    int   *cnts, *displs, gsize, p;
+
+    MPI_Comm_size(comm, &gsize);
+    if ( !(fr = intMalloc_dist(2 * g->nv + g->ng + 1)) )
+        ABORT("Malloc fails for fr[]");
+    cand = fr + g->nv;
+    if ( !(lptr = intMalloc_dist(2 * szlev)) ) ABORT("Malloc fails for lptr[]");
+    lfr = lptr + szlev;
+    if ( !(cnts = (int *) SUPERLU_MALLOC(2 * gsize * sizeof(int))) )
+        ABORT("Malloc fails for cnts[]");
+    displs = cnts + gsize;
+
+    /* Two sweeps: from the first vertex of t, then from the first vertex
+       of the last level found. */
+    v = g->nv ? g->vert[0] : n;
+    MPI_Allreduce(MPI_IN_PLACE, &v, 1, mpi_int_t, MPI_MIN, comm);
+    nlev = dnd_bfs(g, n, nS, v, fr, &lptr, &lfr, &szlev, &v, cand, cnts,
+                   displs, comm);
+    nlev = dnd_bfs(g, n, nS, v, fr, &lptr, &lfr, &szlev, &v, cand, cnts,
+                   displs, comm);
+
+    /* Size of the separator cut at each level l: the vertices of level l
+       with a neighbor in level l+1.  It is 0 between two components. */
+    if ( nlev > g->nv + g->ng ) {
+        SUPERLU_FREE(fr);
+	if ( !(fr = intMalloc_dist(2 * g->nv + nlev + 1)) )
+	    ABORT("Malloc fails for fr[]");
+	cand = fr + g->nv;
+    }
+    for (l = 0; l < nlev; ++l) cand[l] = 0;
+    for (k = 0; k < g->nv; ++k)
+	for (i = g->xadj[k]; i < g->xadj[k+1]; ++i)
+	    if ( g->level[g->nbr[i]] == g->level[k] + 1 ) {
+	        ++cand[g->level[k]];
+		break;
+	    }
+    MPI_Allreduce(MPI_IN_PLACE, cand, (int) nlev, mpi_int_t, MPI_SUM, comm);
+
+    /* The smallest cut leaving at least a quarter of the vertices on
+       each side, or else the most balanced one. */
+    for (l = 0, L = SLU_EMPTY, best = nS + 1; l < nlev; ++l) {
+        if ( 4 * (lptr[l+1] - cand[l]) < nS || 4 * (nS - lptr[l+1]) < nS )
+	    continue;
+	if ( cand[l] < best ) {
+	    best = cand[l];
+	    L = l;
+	}
+    }
+    for (l = 0, best = nS + 1; L == SLU_EMPTY && l < nlev; ++l) {
+        sz = SUPERLU_MAX(lptr[l+1] - cand[l], nS - lptr[l+1]);
+	if ( sz < best ) {
+	    best = sz;
+	    L = l;
+	}
+    }
+    if ( L == SLU_EMPTY ) L = 0;
+
+    /* Separator: the vertices of level L with a neighbor in level L+1. */
+    for (k = 0, nsep = 0; k < g->nv; ++k) {
+        if ( g->level[k] != L ) continue;
+	for (i = g->xadj[k]; i < g->xadj[k+1]; ++i)
+	    if ( g->level[g->nbr[i]] == L + 1 ) {
+	        cand[nsep++] = g->vert[k];
+		break;
+	    }
+    }
+    p = (int) nsep;
+    MPI_Allgather(&p, 1, MPI_INT, cnts, 1, MPI_INT, comm);
+    for (p = 0, total = 0; p < gsize; ++p) {
+        displs[p] = (int) total;
+	total += cnts[p];
+    }
+    if ( !(*sep = intMalloc_dist(total + 1)) ) ABORT("Malloc fails for sep[]");
+    MPI_Allgatherv(cand, (int) nsep, mpi_int_t, *sep, cnts, displs,
+                   mpi_int_t, comm);
+    for (k = 0; k < g->nv + g->ng; ++k)
+        g->part[k] = g->level[k] > L ? tr : tl;
+    for (k = 0; k < total; ++k)
+        if ( (i = dnd_position(g, (*sep)[k])) != SLU_EMPTY )
+	    g->part[i] = DND_SEP(t);
+
+    SUPERLU_FREE(fr);
+    SUPERLU_FREE(lptr);
+    SUPERLU_FREE(cnts);
+    return total;
+} /* dnd_split */
+
+/*! \brief Move the subgraphs of tl and tr to the first and the second
+ *  half of the processes of comm, in block distribution of the vertices
+ *  in increasing order.  Edges to the separator are dropped; the ghosts
+ *  are to be set up again with dnd_ghosts.
+ */
+static void
+dnd_redistribute(dnd_graph_t *g, int_t tl, int_t tr, MPI_Comm comm)
+{
+    int_t k, i, j, c, s, cnt[2], nS[2], base[2], nv, *sbuf, *rbuf, *xadj,
+          *adj, *vert, nrecv, nsend;
+    int   gsize, grank, half, q, *scnts, *sdispls, *rcnts, *rdispls;
+
+    MPI_Comm_size(comm, &gsize);
+    MPI_Comm_rank(comm, &grank);
+    half = gsize / 2;
+
+    /* New owners (in level[]): the positions of the local vertices among
+       those of tl and tr follow from the counts on the lower ranks. */
+    cnt[0] = cnt[1] = 0;
+    for (k = 0; k < g->nv; ++k) {
+        if ( g->part[k] == tl ) ++cnt[0];
+	else if ( g->part[k] == tr ) ++cnt[1];
+    }
+    MPI_Allreduce(cnt, nS, 2, mpi_int_t, MPI_SUM, comm);
+    MPI_Exscan(cnt, base, 2, mpi_int_t, MPI_SUM, comm);
+    if ( grank == 0 ) base[0] = base[1] = 0;
+
+    if ( !(scnts = (int *) SUPERLU_MALLOC(4 * gsize * sizeof(int))) )
+        ABORT("Malloc fails for scnts[]");
+    sdispls = scnts + gsize;
+    rcnts = sdispls + gsize;
+    rdispls = rcnts + gsize;
+    for (q = 0; q < gsize; ++q) scnts[q] = 0;
+    for (k = 0; k < g->nv; ++k) {
+        if ( g->part[k] == tl ) s = 0;
+	else if ( g->part[k] == tr ) s = 1;
+	else continue;
+	q = (int) (base[s]++ * half / nS[s]) + s * half;
+	g->level[k] = q;
+	for (i = g->xadj[k], c = 0; i < g->xadj[k+1]; ++i)
+	    if ( g->part[g->nbr[i]] == g->part[k] ) ++c;
+	scnts[q] += 2 + c;
+    }
+    MPI_Alltoall(scnts, 1, MPI_INT, rcnts, 1, MPI_INT, comm);
+    for (q = 0, nsend = nrecv = 0; q < gsize; ++q) {
+        sdispls[q] = (int) nsend;
+	nsend += scnts[q];
+	rdispls[q] = (int) nrecv;
+	nrecv += rcnts[q];
+    }
+    if ( !(sbuf = intMalloc_dist(nsend + nrecv + 1)) )
+        ABORT("Malloc fails for sbuf[]");
+    rbuf = sbuf + nsend;
+    for (k = 0; k < g->nv; ++k) {
+	if ( g->part[k] != tl && g->part[k] != tr ) continue;
+	j = sdispls[g->level[k]];
+	sbuf[j] = g->vert[k];
+	for (i = g->xadj[k], c = j + 2; i < g->xadj[k+1]; ++i)
+	    if ( g->part[g->nbr[i]] == g->part[k] ) sbuf[c++] = g->adj[i];
+	sbuf[j+1] = c - j - 2;
+	sdispls[g->level[k]] = (int) c;
+    }
+    for (q = 0, j = 0; q < gsize; ++q) {
+        sdispls[q] = (int) j;
+	j += scnts[q];
+    }
+    MPI_Alltoallv(sbuf, scnts, sdispls, mpi_int_t, rbuf, rcnts, rdispls,
+                  mpi_int_t, comm);
+
+    /* Assemble the new local graph.  The records come in increasing
+       order of the vertices. */
+    for (j = 0, nv = 0; j < nrecv; j += 2 + rbuf[j+1]) ++nv;
+    if ( !(vert = intMalloc_dist(2 * nv + 1)) ) ABORT("Malloc fails for vert[]");
+    xadj = vert + nv;
+    xadj[0] = 0;
+    for (j = 0, k = 0; j < nrecv; j += 2 + rbuf[j+1], ++k) {
+        vert[k] = rbuf[j];
+	xadj[k+1] = xadj[k] + rbuf[j+1];
+    }
+    if ( !(adj = intMalloc_dist(SUPERLU_MAX(xadj[nv], 1))) )
+        ABORT("Malloc fails for adj[]");
+    for (j = 0, k = 0; j < nrecv; j += 2 + rbuf[j+1], ++k)
+	for (c = 0; c < rbuf[j+1]; ++c) adj[xadj[k] + c] = rbuf[j + 2 + c];
+
+    SUPERLU_FREE(g->vert); /* xadj[] is in the same block */
+    SUPERLU_FREE(g->adj);
+    SUPERLU_FREE(g->ghost);
+    SUPERLU_FREE(g->nbr); /* part[] and level[] are in the same block */
+    g->nv = nv;
+    g->ng = 0;
+    g->vert = vert;
+    g->xadj = xadj;
+    g->adj = adj;
+    SUPERLU_FREE(sbuf);
+    SUPERLU_FREE(scnts);
+} /* dnd_redistribute */
+
+/*! \brief Number the subtree of the separator tree rooted at subdomain g
+ *  of depth d from first on, in postorder; set fstVtxSep[] of its nodes.
+ *  Returns the first number after the subtree.
+ */
+static int_t
+dnd_first_vertex(int L, int d, int_t g, int_t *sizes, int_t *fstVtxSep,
+                 int_t first)
+{
+    int_t t = DND_NODE(L, d, g);
+    if ( d < L ) {
+        first = dnd_first_vertex(L, d+1, 2*g, sizes, fstVtxSep, first);
+	first = dnd_first_vertex(L, d+1, 2*g+1, sizes, fstVtxSep, first);
+    }
+    fstVtxSep[t] = first;
+    return first + sizes[t];
+}
+
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *
+ * GET_PERM_C_DND obtains a nested dissection ordering Pc of the
+ * symmetrized graph Pr*A+A'*Pr' and its separator tree, like
+ * get_perm_c_parmetis, without ParMETIS and without gathering the graph
+ * on any process.
+ *
+ * The graph is formed by a_plus_at_CompRow_loc() on the first noDomains
+ * processes.  At each of the log2(noDomains) top levels of the tree,
+ * every group of processes holding a subgraph finds a vertex separator
+ * from a distributed breadth-first level structure (see dnd_split), and
+ * moves the two parts to the two halves of the group.  Each process then
+ * orders its subdomain with nd_order_dist().  Separators are numbered
+ * after their subdomains, in increasing vertex order.
+ *
+ * A process keeps the state of its own block of vertices and of their
+ * neighbors only; the first process of each group also keeps the
+ * separator of its group until the end.
+ *
+ * The arguments are those of get_perm_c_parmetis; noDomains must be a
+ * power of 2, and nd_comm holds the first noDomains processes of grid.
+ * On return, perm_c, sizes and fstVtxSep are the same on all processes.
+ * </pre>
+ */
+float
+get_perm_c_dnd(SuperMatrix *A, int_t *perm_r, int_t *perm_c, int nprocs_i,
+               int noDomains, int_t **sizes, int_t **fstVtxSep,
+	       gridinfo_t *grid, MPI_Comm *nd_comm)
+{
+    NRformat_loc *Astore = (NRformat_loc *) A->Store;
+    dnd_graph_t g;
+    MPI_Comm gcomm;
+    int_t *vtxdist_i, *vtxdist_o, *lperm = NULL, **seps = NULL;
+    int_t n = A->ncol, bnz, i, k, v, t, nS, nsep, *sep;
+    int   iam, p, L, d, gs;
+    float mem, apat_mem_l;
+
+    MPI_Comm_rank(grid->comm, &iam);
+    if ( A->nrow != n ) ABORT("Matrix is not square");
+#if ( DEBUGlevel>=1 )
+    CHECK_MALLOC(iam, "Enter get_perm_c_dnd()");
+#endif
+    for (L = 0; (1 << L) < noDomains; ++L) ;
+#if ( PRNTlevel>=1 )
+    if ( !iam ) printf(".. Use distributed nested dissection on A'+A with %d sub-domains\n",
+		       noDomains);
+#endif
+
+    /* Distributed A'+A on the first noDomains processes, in block rows. */
+    if ( !(vtxdist_i = intMalloc_dist(2 * (nprocs_i + 1))) )
+        ABORT("Malloc fails for vtxdist_i[]");
+    vtxdist_o = vtxdist_i + nprocs_i + 1;
+    MPI_Allgather(&Astore->fst_row, 1, mpi_int_t, vtxdist_i, 1, mpi_int_t,
+                  grid->comm);
+    vtxdist_i[nprocs_i] = n;
+    for (k = 0, p = 0; p < noDomains; ++p) {
+        vtxdist_o[p] = k;
+	k += n / noDomains + (p < n % noDomains);
+    }
+    for (p = noDomains; p <= nprocs_i; ++p) vtxdist_o[p] = n;
+
+    if ( (apat_mem_l = a_plus_at_CompRow_loc(iam, perm_r, nprocs_i, vtxdist_i,
+			   n, Astore->rowptr, Astore->colind, noDomains,
+			   vtxdist_o, &bnz, &g.xadj, &g.adj, grid)) > 0 )
+        return apat_mem_l;
+    mem = -apat_mem_l;
+
+    if ( !(*sizes = intMalloc_dist(2 * noDomains)) )
+        ABORT("Malloc fails for sizes[]");
+    if ( !(*fstVtxSep = intMalloc_dist(2 * noDomains)) )
+        ABORT("Malloc fails for fstVtxSep[]");
+    for (k = 0; k < 2 * noDomains; ++k) (*sizes)[k] = 0;
+
+    if ( iam < noDomains ) {
+	g.gbuf = NULL;
+	g.szgbuf = 0;
+	g.nv = vtxdist_o[iam+1] - vtxdist_o[iam];
+	/* vert[] and xadj[] share one block, as after dnd_redistribute. */
+	if ( !(g.vert = intMalloc_dist(2 * g.nv + 1)) )
+	    ABORT("Malloc fails for vert[]");
+	g.vert[g.nv] = 0;
+	for (k = 1; k <= g.nv; ++k) g.vert[g.nv + k] = g.xadj[k];
+	SUPERLU_FREE(g.xadj);
+	g.xadj = g.vert + g.nv;
+	if ( !bnz ) {
+	    if ( !(g.adj = intMalloc_dist(1)) ) ABORT("Malloc fails for adj[]");
+	}
+	for (k = 0; k < g.nv; ++k) g.vert[k] = vtxdist_o[iam] + k;
+	dnd_ghosts(&g, DND_NODE(L, 0, 0));
+	if ( L && !(seps = (int_t **) SUPERLU_MALLOC(L * sizeof(int_t *))) )
+	    ABORT("Malloc fails for seps[]");
+
+	/* Dissect the top L levels, halving the group at each level. */
+	for (d = 0; d < L; ++d) {
+	    gs = noDomains >> d;
+	    t = DND_NODE(L, d, iam / gs);
+	    MPI_Comm_split(*nd_comm, iam / gs, iam, &gcomm);
+	    MPI_Allreduce(&g.nv, &nS, 1, mpi_int_t, MPI_SUM, gcomm);
+	    nsep = 0;
+	    sep = NULL;
+	    if ( nS ) nsep = dnd_split(&g, n, t, DND_NODE(L, d+1, 2*(iam/gs)),
+	                               DND_NODE(L, d+1, 2*(iam/gs)+1), nS,
+				       &sep, gcomm);
+	    dnd_redistribute(&g, DND_NODE(L, d+1, 2*(iam/gs)),
+	                     DND_NODE(L, d+1, 2*(iam/gs)+1), gcomm);
+	    dnd_ghosts(&g, DND_NODE(L, d+1, iam / (gs/2)));
+	    if ( iam % gs == 0 ) (*sizes)[t] = nsep;
+	    else if ( sep ) {
+	        SUPERLU_FREE(sep);
+		sep = NULL;
+	    }
+	    seps[d] = sep;
+	    MPI_Comm_free(&gcomm);
+	}
+
+	/* Order the local subdomain; all the neighbors are local now. */
+	(*sizes)[DND_NODE(L, L, iam)] = g.nv;
+	if ( !(lperm = intMalloc_dist(g.nv + 1)) )
+	    ABORT("Malloc fails for lperm[]");
+	if ( g.xadj[g.nv] )
+	    nd_order_dist(g.nv, g.xadj, g.nbr, lperm);
+	else
+	    for (k = 0; k < g.nv; ++k) lperm[k] = k;
+    } else {
+        SUPERLU_FREE(g.xadj);
+	if ( bnz ) SUPERLU_FREE(g.adj);
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, *sizes, 2 * noDomains, mpi_int_t, MPI_MAX,
+                  grid->comm);
+    dnd_first_vertex(L, 0, 0, *sizes, *fstVtxSep, 0);
+
+    for (v = 0; v < n; ++v) perm_c[v] = SLU_EMPTY;
+    if ( iam < noDomains ) {
+        /* Shift the subdomain, and number the separators this process
+	   was the first of the group for. */
+        for (k = 0; k < g.nv; ++k)
+	    perm_c[g.vert[k]] = lperm[k] + (*fstVtxSep)[DND_NODE(L, L, iam)];
+	for (d = 0; d < L; ++d) {
+	    if ( !(sep = seps[d]) ) continue;
+	    t = DND_NODE(L, d, iam / (noDomains >> d));
+	    for (i = 0; i < (*sizes)[t]; ++i)
+	        perm_c[sep[i]] = (*fstVtxSep)[t] + i;
+	    SUPERLU_FREE(sep);
+	}
+	if ( seps ) SUPERLU_FREE(seps);
+	SUPERLU_FREE(lperm);
+	SUPERLU_FREE(g.vert);
+	SUPERLU_FREE(g.adj);
+	SUPERLU_FREE(g.ghost);
+	SUPERLU_FREE(g.nbr);
+	if ( g.gbuf ) SUPERLU_FREE(g.gbuf);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, perm_c, n, mpi_int_t, MPI_MAX, grid->comm);
+
+    SUPERLU_FREE(vtxdist_i);
+
+#if ( PRNTlevel>=2 )
+    if ( !iam ) {
+        PrintInt10("Sizes of separators", 2 * noDomains-1, *sizes);
+	PrintInt10("First Vertex Separator", 2 * noDomains-1, *fstVtxSep);
+    }
+#endif
+#if ( DEBUGlevel>=1 )
+    CHECK_MALLOC(iam, "Exit get_perm_c_dnd()");
+#endif
+    return (-mem);
+} /* get_perm_c_dnd */
+
 /*! \brief
  *
  * <pre>
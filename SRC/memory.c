@@ -447,6 +447,20 @@ int_t symbfact_SubXpand
 	   ", MemType %d\n", jcol, next, *maxlen, mem_type);
 #endif    
 
+#ifdef _OPENMP
+    if ( omp_in_parallel() ) {
+	/* Private storage of an etree subtree in symbfact(); expand()
+	   keeps its bookkeeping in static variables. */
+	int_t *old = ( mem_type == LSUB ) ? Glu_freeable->lsub
+	                                  : Glu_freeable->usub;
+	int_t new_len = 1.5 * *maxlen, i;
+	if ( (new_mem = intMalloc_dist(new_len)) ) {
+	    for (i = 0; i < next; ++i) ((int_t *) new_mem)[i] = old[i];
+	    SUPERLU_FREE(old);
+	    *maxlen = new_len;
+	}
+    } else
+#endif
     new_mem = expand(maxlen, mem_type, next, 0, Glu_freeable);
     
     if ( !new_mem ) {
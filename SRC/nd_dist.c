@@ -0,0 +1,550 @@
+/*! \file
+Copyright (c) 2003, The Regents of the University of California, through
+Lawrence Berkeley National Laboratory (subject to receipt of any required
+approvals from U.S. Dept. of Energy)
+
+All rights reserved.
+
+The source code is distributed under BSD license, see the file License.txt
+at the top-level directory.
+*/
+/*! @file
+ * \brief Nested dissection ordering of a symmetric pattern
+ *
+ * <pre>
+ * -- Distributed SuperLU routine (version 8.1.2) --
+ * Lawrence Berkeley National Lab, Univ. of California Berkeley.
+ * October 18, 2026
+ *
+ * The graph is split recursively by vertex separators; the two parts are
+ * ordered first and the separator last.  Each bisection is multilevel:
+ *   1. coarsen the graph by heavy-edge matching,
+ *   2. bisect the coarsest graph by greedy graph growing from a few seeds,
+ *   3. project the bisection back to the finer graphs, refining it at
+ *      each level with greedy boundary moves that reduce the edge cut
+ *      under a balance constraint,
+ *   4. turn the edge separator into a vertex separator with a greedy
+ *      vertex cover of the cut edges.
+ * Subgraphs smaller than ND_LEAF are ordered by approximate minimum
+ * degree (amd_order_dist).  The two halves of each dissection are ordered
+ * in OpenMP tasks.
+ * </pre>
+ */
+
+#include <math.h>
+#include "superlu_defs.h"
+
+#define ND_LEAF       200   /* order smaller subgraphs by AMD */
+#define ND_COARSEST   100   /* stop coarsening below this size */
+#define ND_TASK_MIN   2000  /* order smaller subgraphs in the same task */
+#define ND_NTRIES     4     /* seeds of the initial bisection */
+#define ND_NPASS      8     /* refinement passes per level */
+#define ND_MAXLEVEL   64
+
+/* A graph with vertex and edge weights, in compressed adjacency format. */
+typedef struct {
+    int_t n;
+    int_t *xadj, *adj;
+    int_t *vwgt, *ewgt;
+    int   own;     /* whether xadj and adj are to be freed */
+} nd_graph_t;
+
+static void
+nd_free(nd_graph_t *g)
+{
+    if ( g->own ) {
+	SUPERLU_FREE(g->xadj);
+	if ( g->adj ) SUPERLU_FREE(g->adj);
+    }
+    SUPERLU_FREE(g->vwgt);
+    if ( g->ewgt ) SUPERLU_FREE(g->ewgt);
+}
+
+/*! \brief A deterministic pseudo-random visiting order of 0..n-1. */
+static void
+nd_randperm(int_t n, int_t *order, unsigned long seed)
+{
+    int_t i, j, t;
+
+    for (i = 0; i < n; ++i) order[i] = i;
+    for (i = n - 1; i > 0; --i) {
+	seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+	j = (int_t) ((seed >> 33) % (unsigned long) (i + 1));
+	t = order[i]; order[i] = order[j]; order[j] = t;
+    }
+}
+
+/*! \brief Coarsen g by heavy-edge matching; cmap[v] is the coarse vertex
+ *  of v.  Returns the coarse graph in *cg.
+ */
+static void
+nd_coarsen(nd_graph_t *g, int_t *cmap, nd_graph_t *cg)
+{
+    int_t n = g->n, *xadj = g->xadj, *adj = g->adj, *ewgt = g->ewgt;
+    int_t *match, *order, *pos, *rep, nc = 0, i, j, k, v, u, c, best, nnz;
+
+    if ( !(match = intMalloc_dist(4 * n)) ) ABORT("Malloc fails for match[]");
+    order = match + n;
+    pos = order + n;
+    rep = pos + n;
+    for (v = 0; v < n; ++v) match[v] = -1;
+    nd_randperm(n, order, (unsigned long) n);
+
+    for (k = 0; k < n; ++k) {
+	v = order[k];
+	if ( match[v] != -1 ) continue;
+	best = v;
+	for (j = xadj[v], i = -1; j < xadj[v+1]; ++j) {
+	    u = adj[j];
+	    if ( match[u] == -1 && u != v && (i == -1 || ewgt[j] > ewgt[i]) ) {
+		i = j;
+		best = u;
+	    }
+	}
+	match[v] = best;
+	match[best] = v;
+	rep[nc] = v;
+	cmap[v] = cmap[best] = nc++;
+    }
+
+    cg->n = nc;
+    cg->own = 1;
+    if ( !(cg->xadj = intMalloc_dist(nc + 1)) ) ABORT("Malloc fails for xadj[]");
+    if ( !(cg->vwgt = intMalloc_dist(nc)) ) ABORT("Malloc fails for vwgt[]");
+    nnz = SUPERLU_MAX(xadj[n], 1);
+    if ( !(cg->adj = intMalloc_dist(nnz)) ) ABORT("Malloc fails for adj[]");
+    if ( !(cg->ewgt = intMalloc_dist(nnz)) ) ABORT("Malloc fails for ewgt[]");
+
+    /* Merge the adjacency lists of each matched pair. */
+    for (c = 0; c < nc; ++c) pos[c] = -1;
+    nnz = 0;
+    for (c = 0; c < nc; ++c) {
+	v = rep[c];
+	cg->xadj[c] = nnz;
+	cg->vwgt[c] = g->vwgt[v] + (match[v] != v ? g->vwgt[match[v]] : 0);
+	for (u = v; ; u = match[v]) {
+	    for (j = xadj[u]; j < xadj[u+1]; ++j) {
+		k = cmap[adj[j]];
+		if ( k == c ) continue;
+		if ( pos[k] == -1 ) {
+		    pos[k] = nnz;
+		    cg->adj[nnz] = k;
+		    cg->ewgt[nnz++] = ewgt[j];
+		} else {
+		    cg->ewgt[pos[k]] += ewgt[j];
+		}
+	    }
+	    if ( u == match[v] ) break;
+	}
+	for (j = cg->xadj[c]; j < nnz; ++j) pos[cg->adj[j]] = -1;
+    }
+    cg->xadj[nc] = nnz;
+
+    SUPERLU_FREE(match);
+}
+
+/*! \brief Weight of the edges cut by the bisection part[]. */
+static int_t
+nd_cut(nd_graph_t *g, int_t *part)
+{
+    int_t v, j, cut = 0;
+
+    for (v = 0; v < g->n; ++v)
+	for (j = g->xadj[v]; j < g->xadj[v+1]; ++j)
+	    if ( part[g->adj[j]] != part[v] ) cut += g->ewgt[j];
+    return cut / 2;
+}
+
+/*! \brief Greedy boundary refinement of the bisection part[].
+ *
+ * <pre>
+ * A boundary vertex is moved to the other side when this reduces the
+ * cut without exceeding the maximum part weight, when the cut is
+ * unchanged and the balance improves, or when its side is overweight.
+ * </pre>
+ */
+static void
+nd_refine(nd_graph_t *g, int_t *part, int npass)
+{
+    int_t n = g->n, *xadj = g->xadj, *adj = g->adj, *ewgt = g->ewgt;
+    int_t *vwgt = g->vwgt, *ed, *id, *order, pwgt[2] = {0, 0};
+    int_t v, u, j, k, from, to, gain, maxpw, maxvw = 0, nmoves;
+    int pass;
+
+    if ( !(ed = intMalloc_dist(3 * n)) ) ABORT("Malloc fails for ed[]");
+    id = ed + n;
+    order = id + n;
+    for (v = 0; v < n; ++v) {
+	pwgt[part[v]] += vwgt[v];
+	maxvw = SUPERLU_MAX(maxvw, vwgt[v]);
+	ed[v] = id[v] = 0;
+	for (j = xadj[v]; j < xadj[v+1]; ++j)
+	    if ( part[adj[j]] == part[v] ) id[v] += ewgt[j];
+	    else ed[v] += ewgt[j];
+    }
+    maxpw = SUPERLU_MAX(0.53 * (pwgt[0] + pwgt[1]),
+			(pwgt[0] + pwgt[1]) / 2 + maxvw);
+    nd_randperm(n, order, (unsigned long) (n + 1));
+
+    for (pass = 0; pass < npass; ++pass) {
+	nmoves = 0;
+	for (k = 0; k < n; ++k) {
+	    v = order[k];
+	    from = part[v];
+	    to = 1 - from;
+	    if ( ed[v] == 0 && pwgt[from] <= maxpw ) continue;
+	    gain = ed[v] - id[v];
+	    if ( pwgt[to] + vwgt[v] > maxpw ) continue;
+	    if ( !( gain > 0
+		    || (gain == 0 && pwgt[from] - pwgt[to] > vwgt[v])
+		    || (pwgt[from] > maxpw && ed[v] > 0) ) ) continue;
+
+	    part[v] = to;
+	    pwgt[from] -= vwgt[v];
+	    pwgt[to] += vwgt[v];
+	    j = ed[v]; ed[v] = id[v]; id[v] = j;
+	    for (j = xadj[v]; j < xadj[v+1]; ++j) {
+		u = adj[j];
+		if ( part[u] == to ) {
+		    id[u] += ewgt[j];
+		    ed[u] -= ewgt[j];
+		} else {
+		    ed[u] += ewgt[j];
+		    id[u] -= ewgt[j];
+		}
+	    }
+	    ++nmoves;
+	}
+	if ( nmoves == 0 ) break;
+    }
+
+    SUPERLU_FREE(ed);
+}
+
+/*! \brief Initial bisection of a small graph by greedy graph growing.
+ *
+ * <pre>
+ * Part 0 is grown breadth-first from a seed until it holds half the
+ * weight; the first seed is a pseudo-peripheral vertex, the others are
+ * random.  The bisection with the smallest cut after refinement is kept.
+ * </pre>
+ */
+static void
+nd_initpart(nd_graph_t *g, int_t *part)
+{
+    int_t n = g->n, *xadj = g->xadj, *adj = g->adj;
+    int_t *queue, *trial, *order, half = 0, w0, head, tail, next, v, u, j;
+    int_t seed = 0, cut, bestcut = -1;
+    int t, sweep;
+
+    for (v = 0; v < n; ++v) half += g->vwgt[v];
+    half /= 2;
+    if ( !(queue = intMalloc_dist(3 * n)) ) ABORT("Malloc fails for queue[]");
+    trial = queue + n;
+    order = trial + n;
+    nd_randperm(n, order, (unsigned long) (n + 2));
+
+    /* A pseudo-peripheral vertex: the last one reached by two BFS. */
+    for (sweep = 0; sweep < 2; ++sweep) {
+	for (v = 0; v < n; ++v) trial[v] = 1;
+	queue[0] = seed;
+	trial[seed] = 0;
+	for (head = 0, tail = 1; head < tail; ++head)
+	    for (j = xadj[queue[head]]; j < xadj[queue[head]+1]; ++j)
+		if ( trial[u = adj[j]] ) {
+		    trial[u] = 0;
+		    queue[tail++] = u;
+		}
+	seed = queue[tail - 1];
+    }
+
+    for (t = 0; t < ND_NTRIES; ++t) {
+	if ( t > 0 ) seed = order[t % n];
+	for (v = 0; v < n; ++v) trial[v] = 1;
+	w0 = 0;
+	head = tail = 0;
+	next = 0;
+	queue[tail++] = seed;
+	trial[seed] = 0;
+	w0 += g->vwgt[seed];
+	while ( w0 < half ) {
+	    if ( head == tail ) { /* disconnected: start a new component */
+		while ( next < n && trial[order[next]] == 0 ) ++next;
+		if ( next == n ) break;
+		v = order[next];
+		trial[v] = 0;
+		w0 += g->vwgt[v];
+		queue[tail++] = v;
+		continue;
+	    }
+	    v = queue[head++];
+	    for (j = xadj[v]; j < xadj[v+1] && w0 < half; ++j)
+		if ( trial[u = adj[j]] ) {
+		    trial[u] = 0;
+		    w0 += g->vwgt[u];
+		    queue[tail++] = u;
+		}
+	}
+	nd_refine(g, trial, ND_NPASS);
+	cut = nd_cut(g, trial);
+	if ( bestcut < 0 || cut < bestcut ) {
+	    bestcut = cut;
+	    for (v = 0; v < n; ++v) part[v] = trial[v];
+	}
+    }
+
+    SUPERLU_FREE(queue);
+}
+
+/*! \brief Multilevel bisection of g; on return part[v] is 0 or 1 for the
+ *  two parts and 2 for the vertex separator.
+ */
+static void
+nd_bisect(nd_graph_t *g, int_t *part)
+{
+    nd_graph_t level[ND_MAXLEVEL];
+    int_t *cmap[ND_MAXLEVEL], *cpart, *ed, *cand, *side, *cnt;
+    int_t n = g->n, v, u, j, k, nsep, nsep1, nb[2] = {0, 0}, maxed = 0;
+    int l, nlev = 0;
+
+    /* Coarsen. */
+    level[0] = *g;
+    while ( nlev + 1 < ND_MAXLEVEL && level[nlev].n > ND_COARSEST ) {
+	if ( !(cmap[nlev] = intMalloc_dist(level[nlev].n)) )
+	    ABORT("Malloc fails for cmap[]");
+	nd_coarsen(&level[nlev], cmap[nlev], &level[nlev+1]);
+	++nlev;
+	if ( level[nlev].n > 0.9 * level[nlev-1].n ) break;
+    }
+
+    /* Bisect the coarsest graph, then project and refine. */
+    if ( !(cpart = intMalloc_dist(level[nlev].n)) )
+	ABORT("Malloc fails for cpart[]");
+    nd_initpart(&level[nlev], cpart);
+    for (l = nlev - 1; l >= 0; --l) {
+	int_t *fpart = (l == 0) ? part : intMalloc_dist(level[l].n);
+	if ( !fpart ) ABORT("Malloc fails for fpart[]");
+	for (v = 0; v < level[l].n; ++v) fpart[v] = cpart[cmap[l][v]];
+	SUPERLU_FREE(cpart);
+	SUPERLU_FREE(cmap[l]);
+	nd_free(&level[l+1]);
+	nd_refine(&level[l], fpart, ND_NPASS);
+	cpart = fpart;
+    }
+    if ( nlev == 0 ) {
+	for (v = 0; v < n; ++v) part[v] = cpart[v];
+	SUPERLU_FREE(cpart);
+    }
+
+    /* Vertex separator: a greedy cover of the cut edges, taking the
+       vertices with most cut edges first, then dropping the vertices
+       whose cut edges are all covered by others.  The one-sided cover
+       by the boundary of the part with fewer boundary vertices is used
+       if it is smaller. */
+    if ( !(ed = intMalloc_dist(4 * n + 1)) ) ABORT("Malloc fails for ed[]");
+    cand = ed + n;
+    side = cand + n;
+    cnt = side + n;
+    for (v = 0; v < n; ++v) {
+	ed[v] = 0;
+	for (j = g->xadj[v]; j < g->xadj[v+1]; ++j)
+	    if ( part[g->adj[j]] != part[v] ) ++ed[v];
+	if ( ed[v] ) ++nb[part[v]];
+	maxed = SUPERLU_MAX(maxed, ed[v]);
+	side[v] = part[v];
+    }
+    /* Sort the cut vertices by decreasing number of cut edges. */
+    for (j = 0; j <= maxed; ++j) cnt[j] = 0;
+    for (v = 0; v < n; ++v) if ( ed[v] ) ++cnt[maxed - ed[v]];
+    for (k = 0, j = 0; j <= maxed; ++j) {
+	u = cnt[j];
+	cnt[j] = k;
+	k += u;
+    }
+    for (v = 0; v < n; ++v) if ( ed[v] ) cand[cnt[maxed - ed[v]]++] = v;
+    nsep = 0;
+    for (j = 0; j < k; ++j) {
+	v = cand[j];
+	for (u = g->xadj[v]; u < g->xadj[v+1]; ++u)
+	    if ( side[g->adj[u]] == 1 - part[v] ) {
+		side[v] = 2;
+		++nsep;
+		break;
+	    }
+    }
+    for (j = k - 1; j >= 0; --j) {
+	v = cand[j];
+	if ( side[v] != 2 ) continue;
+	for (u = g->xadj[v]; u < g->xadj[v+1]; ++u)
+	    if ( side[g->adj[u]] == 1 - part[v] ) break;
+	if ( u == g->xadj[v+1] ) {
+	    side[v] = part[v];
+	    --nsep;
+	}
+    }
+    nsep1 = SUPERLU_MIN(nb[0], nb[1]);
+    for (v = 0; v < n; ++v)
+	if ( nsep1 < nsep )
+	    part[v] = ( ed[v] && part[v] == (nb[0] <= nb[1] ? 0 : 1) )
+		? 2 : part[v];
+	else
+	    part[v] = side[v];
+
+    SUPERLU_FREE(ed);
+}
+
+/*! \brief The subgraph induced by the vertices v with part[v] == which;
+ *  label[] maps its vertices to those of g.
+ */
+static void
+nd_subgraph(nd_graph_t *g, int_t *part, int_t which, int_t *map,
+	    nd_graph_t *sg, int_t *label)
+{
+    int_t v, j, ns = 0, nnz = 0;
+
+    for (v = 0; v < g->n; ++v)
+	if ( part[v] == which ) {
+	    map[v] = ns;
+	    label[ns++] = v;
+	    for (j = g->xadj[v]; j < g->xadj[v+1]; ++j)
+		if ( part[g->adj[j]] == which ) ++nnz;
+	}
+    sg->n = ns;
+    sg->own = 1;
+    if ( !(sg->xadj = intMalloc_dist(ns + 1)) ) ABORT("Malloc fails for xadj[]");
+    if ( !(sg->vwgt = intMalloc_dist(SUPERLU_MAX(ns, 1))) )
+	ABORT("Malloc fails for vwgt[]");
+    if ( !(sg->adj = intMalloc_dist(SUPERLU_MAX(nnz, 1))) )
+	ABORT("Malloc fails for adj[]");
+    if ( !(sg->ewgt = intMalloc_dist(SUPERLU_MAX(nnz, 1))) )
+	ABORT("Malloc fails for ewgt[]");
+    for (nnz = 0, ns = 0; ns < sg->n; ++ns) {
+	v = label[ns];
+	sg->xadj[ns] = nnz;
+	sg->vwgt[ns] = 1;
+	for (j = g->xadj[v]; j < g->xadj[v+1]; ++j)
+	    if ( part[g->adj[j]] == which ) {
+		sg->adj[nnz] = map[g->adj[j]];
+		sg->ewgt[nnz++] = 1;
+	    }
+    }
+    sg->xadj[sg->n] = nnz;
+}
+
+/*! \brief Order the vertices of g at positions first, first+1, ... of the
+ *  global ordering; label[v] is the global number of vertex v.  g and
+ *  label are freed on return.
+ */
+static void
+nd_recurse(int_t *perm, nd_graph_t *g, int_t *label, int_t first)
+{
+    nd_graph_t *sg;
+    int_t *part, *map, *slabel[2], n = g->n, nn[2] = {0, 0}, pos, v;
+    int s;
+
+    if ( n > ND_LEAF ) {
+	if ( !(part = intMalloc_dist(2 * n)) ) ABORT("Malloc fails for part[]");
+	map = part + n;
+	nd_bisect(g, part);
+	for (v = 0; v < n; ++v) if ( part[v] < 2 ) ++nn[part[v]];
+	if ( nn[0] && nn[1] ) {
+	    if ( !(sg = (nd_graph_t *) SUPERLU_MALLOC(2 * sizeof(nd_graph_t))) )
+		ABORT("Malloc fails for sg[]");
+	    for (s = 0; s < 2; ++s) {
+		if ( !(slabel[s] = intMalloc_dist(nn[s])) )
+		    ABORT("Malloc fails for slabel[]");
+		nd_subgraph(g, part, s, map, &sg[s], slabel[s]);
+		for (v = 0; v < nn[s]; ++v) slabel[s][v] = label[slabel[s][v]];
+	    }
+	    /* The separator is ordered last. */
+	    pos = first + nn[0] + nn[1];
+	    for (v = 0; v < n; ++v)
+		if ( part[v] == 2 ) perm[label[v]] = pos++;
+	    SUPERLU_FREE(part);
+	    nd_free(g);
+	    SUPERLU_FREE(label);
+
+#ifdef _OPENMP
+#pragma omp task if ( nn[0] > ND_TASK_MIN ) firstprivate(sg, slabel, first)
+#endif
+	    nd_recurse(perm, &sg[0], slabel[0], first);
+#ifdef _OPENMP
+#pragma omp task if ( nn[1] > ND_TASK_MIN ) firstprivate(sg, slabel, first, nn)
+#endif
+	    nd_recurse(perm, &sg[1], slabel[1], first + nn[0]);
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+	    SUPERLU_FREE(sg);
+	    return;
+	}
+	SUPERLU_FREE(part);
+    }
+
+    /* A small subgraph, or one that cannot be split: order it by AMD. */
+    if ( !(part = intMalloc_dist(SUPERLU_MAX(n, 1))) )
+	ABORT("Malloc fails for part[]");
+    amd_order_dist(n, g->xadj, g->adj, part);
+    for (v = 0; v < n; ++v) perm[label[v]] = first + part[v];
+    SUPERLU_FREE(part);
+    nd_free(g);
+    SUPERLU_FREE(label);
+}
+
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *
+ * ND_ORDER_DIST computes a nested dissection ordering of a matrix with
+ * symmetric nonzero pattern.
+ *
+ * Arguments
+ * =========
+ *
+ * n       (input) int_t
+ *         Order of the matrix.
+ *
+ * colptr  (input) int_t*, of size n+1
+ * rowind  (input) int_t*, of size colptr[n]
+ *         The pattern, with both triangles stored and without the
+ *         diagonal, as returned by at_plus_a_dist().  Not modified.
+ *
+ * perm    (output) int_t*, of size n
+ *         perm[i] = j means that vertex i is the j-th to be eliminated;
+ *         this is the perm_c[] convention of get_perm_c_dist().
+ *
+ * Return value
+ * ============
+ *   = 0: successful exit
+ * </pre>
+ */
+int
+nd_order_dist(int_t n, int_t *colptr, int_t *rowind, int_t *perm)
+{
+    nd_graph_t g;
+    int_t *label, i;
+
+    if ( n <= 0 ) return 0;
+
+    g.n = n;
+    g.xadj = colptr;
+    g.adj = rowind;
+    g.own = 0;
+    if ( !(g.vwgt = intMalloc_dist(n)) ) ABORT("Malloc fails for vwgt[]");
+    if ( !(g.ewgt = intMalloc_dist(SUPERLU_MAX(colptr[n], 1))) )
+	ABORT("Malloc fails for ewgt[]");
+    for (i = 0; i < n; ++i) g.vwgt[i] = 1;
+    for (i = 0; i < colptr[n]; ++i) g.ewgt[i] = 1;
+    if ( !(label = intMalloc_dist(n)) ) ABORT("Malloc fails for label[]");
+    for (i = 0; i < n; ++i) label[i] = i;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+    nd_recurse(perm, &g, label, 0);
+
+    return 0;
+} /* nd_order_dist */
@@ -549,7 +549,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 	ldaspa = Llu->ldalsum;
 	if ( !(dense = doubleCalloc_dist(ldaspa * sp_ienv_dist(3, options))) )
 	    ABORT("Calloc fails for SPA dense[].");
-	nrbu = CEILING( nsupers, grid->nprow ); /* No. of local block rows */
+	nrbu = NLBi( nsupers, grid ); /* No. of local block rows */
 	if ( !(Urb_length = intCalloc_dist(nrbu)) )
 	    ABORT("Calloc fails for Urb_length[].");
 	if ( !(Urb_indptr = intMalloc_dist(nrbu)) )
@@ -686,7 +686,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 	    ABORT("Malloc fails for ToRecv[].");
 	for (i = 0; i < nsupers; ++i) ToRecv[i] = 0;
 
-	k = CEILING( nsupers, grid->npcol );/* Number of local column blocks */
+	k = NLBj( nsupers, grid );/* Number of local column blocks */
 	if ( !(ToSendR = (int **) SUPERLU_MALLOC(k*sizeof(int*))) )
 	    ABORT("Malloc fails for ToSendR[].");
 	j = k * grid->npcol;
@@ -697,7 +697,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 
 	for (i = 0; i < j; ++i) index1[i] = SLU_EMPTY;
 	for (i = 0,j = 0; i < k; ++i, j += grid->npcol) ToSendR[i] = &index1[j];
-	k = CEILING( nsupers, grid->nprow ); /* Number of local block rows */
+	k = NLBi( nsupers, grid ); /* Number of local block rows */
 
 	/* Pointers to the beginning of each block row of U. */
 	if ( !(Unzval_br_ptr =
@@ -748,6 +748,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 		ilsum[lb + 1] = ilsum[lb] + i;
 	    }
 	}
+	for (lb = MyNLBi( nsupers, grid ); lb < k; ++lb) ilsum[lb + 1] = ilsum[lb];
 
 #if ( PROFlevel>=1 )
 	t = SuperLU_timer_();
@@ -795,7 +796,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 	} /* for jb ... */
 
 	/* Set up the initial pointers for each block row in U. */
-	nrbu = CEILING( nsupers, grid->nprow );/* Number of local block rows */
+	nrbu = NLBi( nsupers, grid );/* Number of local block rows */
 	for (lb = 0; lb < nrbu; ++lb) {
 	    len = Urb_length[lb];
 	    rb_marker[lb] = 0; /* Reset block marker. */
@@ -861,36 +862,30 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 	/* ------------------------------------------------ */
 	mem_use += 6.0*k*iword + ldaspa*sp_ienv_dist(3, options)*dword;
 
-	k = CEILING( nsupers, grid->npcol );/* Number of local block columns */
+	k = NLBj( nsupers, grid );/* Number of local block columns */
 
 	/* Pointers to the beginning of each block column of L. */
 	if ( !(Lnzval_bc_ptr =
               (double**)SUPERLU_MALLOC(k * sizeof(double*))) )
 	    ABORT("Malloc fails for Lnzval_bc_ptr[].");
-	Lnzval_bc_ptr[k-1] = NULL;	
 	if ( !(Lrowind_bc_ptr = (int_t**)SUPERLU_MALLOC(k * sizeof(int_t*))) )
 	    ABORT("Malloc fails for Lrowind_bc_ptr[].");
-	Lrowind_bc_ptr[k-1] = NULL;
 	if ( !(Lrowind_bc_offset =
 				(long int*)SUPERLU_MALLOC(k * sizeof(long int))) ) {
 		fprintf(stderr, "Malloc fails for Lrowind_bc_offset[].");
 	}
-	Lrowind_bc_offset[k-1] = -1;	
 	if ( !(Lnzval_bc_offset =
 				(long int*)SUPERLU_MALLOC(k * sizeof(long int))) ) {
 		fprintf(stderr, "Malloc fails for Lnzval_bc_offset[].");
 	}
-	Lnzval_bc_offset[k-1] = -1;			
 
 	if ( !(Lindval_loc_bc_ptr =
 				(int_t**)SUPERLU_MALLOC(k * sizeof(int_t*))) )
 		ABORT("Malloc fails for Lindval_loc_bc_ptr[].");
-	Lindval_loc_bc_ptr[k-1] = NULL;
 	if ( !(Lindval_loc_bc_offset =
 				(long int*)SUPERLU_MALLOC(k * sizeof(long int))) ) {
 		fprintf(stderr, "Malloc fails for Lindval_loc_bc_offset[].");
 	}
-	Lindval_loc_bc_offset[k-1] = -1;	
 
 	if ( !(Linv_bc_ptr =
 		(double**)SUPERLU_MALLOC(k * sizeof(double*))) ) {
@@ -908,10 +903,19 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 		(long int*)SUPERLU_MALLOC(k * sizeof(long int))) ) {
 		fprintf(stderr, "Malloc fails for Uinv_bc_offset[].");
 	}		
-	Linv_bc_ptr[k-1] = NULL;
-	Uinv_bc_ptr[k-1] = NULL;
-	Linv_bc_offset[k-1] = -1;
-	Uinv_bc_offset[k-1] = -1;
+	/* Local block columns past my own are never filled in below. */
+	for (lb = MyNLBj( nsupers, grid ); lb < k; ++lb) {
+	    Lnzval_bc_ptr[lb] = NULL;
+	    Lrowind_bc_ptr[lb] = NULL;
+	    Lindval_loc_bc_ptr[lb] = NULL;
+	    Linv_bc_ptr[lb] = NULL;
+	    Uinv_bc_ptr[lb] = NULL;
+	    Lrowind_bc_offset[lb] = -1;
+	    Lnzval_bc_offset[lb] = -1;
+	    Lindval_loc_bc_offset[lb] = -1;
+	    Linv_bc_offset[lb] = -1;
+	    Uinv_bc_offset[lb] = -1;
+	}
 
 	if ( !(Unnz =
 			(int_t*)SUPERLU_MALLOC(k * sizeof(int_t))) )
@@ -1276,7 +1280,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 	}	
 
 	/* use contingous memory for Linv_bc_ptr, Uinv_bc_ptr, Lrowind_bc_ptr, Lnzval_bc_ptr*/
-	k = CEILING( nsupers, grid->npcol );/* Number of local block columns */
+	k = NLBj( nsupers, grid );/* Number of local block columns */
 	Linv_bc_cnt=0;
 	Uinv_bc_cnt=0;
 	Lrowind_bc_cnt=0;
@@ -1344,7 +1348,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 
 	/* Set up additional pointers for the index and value arrays of U.
 	   nub is the number of local block columns. */
-	nub = CEILING( nsupers, grid->npcol); /* Number of local block columns. */
+	nub = NLBj( nsupers, grid ); /* Number of local block columns. */
 	if ( !(Urbs = (int_t *) intCalloc_dist(2*nub)) )
 		ABORT("Malloc fails for Urbs[]"); /* Record number of nonzero
 							 blocks in a block column. */
@@ -1364,7 +1368,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 	}
 	Ucb_indoffset[nub-1] = -1;
 
-	nlb = CEILING( nsupers, grid->nprow ); /* Number of local block rows. */
+	nlb = NLBi( nsupers, grid ); /* Number of local block rows. */
 
 	/* Count number of row blocks in a block column.
 	   One pass of the skeleton graph of U. */
@@ -1426,13 +1430,13 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 /* Count the nnzs per block column */
 	for (lb = 0; lb < nub; ++lb) {
 		Unnz[lb] = 0;
-		k = lb * grid->npcol + mycol;/* Global block number, column-wise. */
+		k = GBj( lb, grid );/* Global block number, column-wise. */
 		knsupc = SuperSize( k );
 		for (ub = 0; ub < Urbs[lb]; ++ub) {
 			ik = Ucb_indptr[lb][ub].lbnum; /* Local block number, row-wise. */
 			i = Ucb_indptr[lb][ub].indpos; /* Start of the block in usub[]. */
 			i += UB_DESCRIPTOR;
-			gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+			gik = GBi( ik, grid );/* Global block number, row-wise. */
 			iklrow = FstBlockC( gik+1 );
 			for (jj = 0; jj < knsupc; ++jj) {
 				fnz = Ufstnz_br_ptr[ik][i + jj];
@@ -1465,7 +1469,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 	}	
 
 	/* use contingous memory for Unzval_br_ptr, Ufstnz_br_ptr, Ucb_valptr */
-	k = CEILING( nsupers, grid->nprow );/* Number of local block rows */
+	k = NLBi( nsupers, grid );/* Number of local block rows */
 	Unzval_br_cnt=0;
 	Ufstnz_br_cnt=0;
 	for (lb = 0; lb < k; ++lb) { /* for each block row ... */
@@ -1492,7 +1496,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 		}
 	}
 
-	k = CEILING( nsupers, grid->npcol );/* Number of local block columns */
+	k = NLBj( nsupers, grid );/* Number of local block columns */
 	Ucb_valcnt=0;
 	Ucb_indcnt=0;
 	for (lb = 0; lb < k; ++lb) { /* for each block row ... */
@@ -1525,7 +1529,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 #endif
 	/* construct the Bcast tree for L ... */
 
-	k = CEILING( nsupers, grid->npcol );/* Number of local block columns */
+	k = NLBj( nsupers, grid );/* Number of local block columns */
 	if ( !(LBtree_ptr = (C_Tree*)SUPERLU_MALLOC(k * sizeof(C_Tree))) )
 		ABORT("Malloc fails for LBtree_ptr[].");
 	if ( !(ActiveFlag = intCalloc_dist(grid->nprow*2)) )
@@ -1552,7 +1556,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 	memTRS += k*sizeof(C_Tree) + k*dword + grid->nprow*k*iword;  //acount for LBtree_ptr, SeedSTD_BC, ActiveFlagAll
 	for (j=0;j<grid->nprow*k;++j)ActiveFlagAll[j]=3*nsupers;
 	for (ljb = 0; ljb < k; ++ljb) { /* for each local block column ... */
-		jb = mycol+ljb*grid->npcol;  /* not sure */
+		jb = GBj( ljb, grid );  /* not sure */
 		if(jb<nsupers){
 		pc = PCOL( jb, grid );
 		fsupc = FstBlockC( jb );
@@ -1570,7 +1574,7 @@ pddistribute(superlu_dist_options_t *options, int_t n, SuperMatrix *A,
 
 	for (ljb = 0; ljb < k; ++ljb) { /* for each local block column ... */
 
-		jb = mycol+ljb*grid->npcol;  /* not sure */
+		jb = GBj( ljb, grid );  /* not sure */
 		if(jb<nsupers){
 		pc = PCOL( jb, grid );
 
@@ -1666,7 +1670,7 @@ if ( !iam) printf(".. Construct Bcast tree for L: %.2f\t\n", t);
 #endif
 	/* construct the Reduce tree for L ... */
 	/* the following is used as reference */
-	nlb = CEILING( nsupers, grid->nprow );/* Number of local block rows */
+	nlb = NLBi( nsupers, grid );/* Number of local block rows */
 	if ( !(mod_bit = int32Malloc_dist(nlb)) )
 		ABORT("Malloc fails for mod_bit[].");
 	if ( !(frecv = int32Malloc_dist(nlb)) )
@@ -1691,7 +1695,7 @@ if ( !iam) printf(".. Construct Bcast tree for L: %.2f\t\n", t);
 #endif
 
 
-	k = CEILING( nsupers, grid->nprow );/* Number of local block rows */
+	k = NLBi( nsupers, grid );/* Number of local block rows */
 	if ( !(LRtree_ptr = (C_Tree*)SUPERLU_MALLOC(k * sizeof(C_Tree))) )
 		ABORT("Malloc fails for LRtree_ptr[].");
 	if ( !(ActiveFlag = intCalloc_dist(grid->npcol*2)) )
@@ -1759,7 +1763,7 @@ if ( !iam) printf(".. Construct Bcast tree for L: %.2f\t\n", t);
 
 
 	for (lib=0;lib<k;++lib){
-		ib = myrow+lib*grid->nprow;  /* not sure */
+		ib = GBi( lib, grid );  /* not sure */
 		if(ib<nsupers){
 			pr = PROW( ib, grid );
 			for (j=0;j<grid->npcol;++j)ActiveFlag[j]=ActiveFlagAll[j+lib*grid->npcol];;
@@ -1859,7 +1863,7 @@ if ( !iam) printf(".. Construct Reduce tree for L: %.2f\t\n", t);
 
 	/* construct the Bcast tree for U ... */
 
-	k = CEILING( nsupers, grid->npcol );/* Number of local block columns */
+	k = NLBj( nsupers, grid );/* Number of local block columns */
 	if ( !(UBtree_ptr = (C_Tree*)SUPERLU_MALLOC(k * sizeof(C_Tree))) )
 		ABORT("Malloc fails for UBtree_ptr[].");
 	if ( !(ActiveFlag = intCalloc_dist(grid->nprow*2)) )
@@ -1886,7 +1890,7 @@ if ( !iam) printf(".. Construct Reduce tree for L: %.2f\t\n", t);
 	memTRS += k*sizeof(C_Tree) + k*dword + grid->nprow*k*iword;  //acount for UBtree_ptr, SeedSTD_BC, ActiveFlagAll
 
 	for (ljb = 0; ljb < k; ++ljb) { /* for each local block column ... */
-		jb = mycol+ljb*grid->npcol;  /* not sure */
+		jb = GBj( ljb, grid );  /* not sure */
 		if(jb<nsupers){
 		pc = PCOL( jb, grid );
 
@@ -1917,7 +1921,7 @@ if ( !iam) printf(".. Construct Reduce tree for L: %.2f\t\n", t);
 
 
 	for (ljb = 0; ljb < k; ++ljb) { /* for each block column ... */
-		jb = mycol+ljb*grid->npcol;  /* not sure */
+		jb = GBj( ljb, grid );  /* not sure */
 		if(jb<nsupers){
 		pc = PCOL( jb, grid );
 		// if ( mycol == pc ) { /* Block column jb in my process column */
@@ -2002,7 +2006,7 @@ if ( !iam) printf(".. Construct Bcast tree for U: %.2f\t\n", t);
 #endif
 	/* construct the Reduce tree for U ... */
 	/* the following is used as reference */
-	nlb = CEILING( nsupers, grid->nprow );/* Number of local block rows */
+	nlb = NLBi( nsupers, grid );/* Number of local block rows */
 	if ( !(mod_bit = int32Malloc_dist(nlb)) )
 		ABORT("Malloc fails for mod_bit[].");
 	if ( !(brecv = int32Malloc_dist(nlb)) )
@@ -2022,7 +2026,7 @@ if ( !iam) printf(".. Construct Bcast tree for U: %.2f\t\n", t);
 	   diagonal processes.  */
 	MPI_Allreduce( mod_bit, brecv, nlb, MPI_INT, MPI_SUM, grid->rscp.comm);
 
-	k = CEILING( nsupers, grid->nprow );/* Number of local block rows */
+	k = NLBi( nsupers, grid );/* Number of local block rows */
 	if ( !(URtree_ptr = (C_Tree*)SUPERLU_MALLOC(k * sizeof(C_Tree))) )
 		ABORT("Malloc fails for URtree_ptr[].");
 	if ( !(ActiveFlag = intCalloc_dist(grid->npcol*2)) )
@@ -2123,7 +2127,7 @@ if ( !iam) printf(".. Construct Bcast tree for U: %.2f\t\n", t);
 
 
 	for (lib=0;lib<k;++lib){
-		ib = myrow+lib*grid->nprow;  /* not sure */
+		ib = GBi( lib, grid );  /* not sure */
 		if(ib<nsupers){
 			pr = PROW( ib, grid );
 			for (j=0;j<grid->npcol;++j)ActiveFlag[j]=ActiveFlagAll[j+lib*grid->npcol];;
@@ -2278,24 +2282,24 @@ if ( !iam) printf(".. Construct Reduce tree for U: %.2f\t\n", t);
 
 	checkGPU(gpuMalloc( (void**)&Llu->d_xsup, (n+1) * sizeof(int_t)));
 	checkGPU(gpuMemcpy(Llu->d_xsup, xsup, (n+1) * sizeof(int_t), gpuMemcpyHostToDevice));
-	checkGPU(gpuMalloc( (void**)&Llu->d_LRtree_ptr, CEILING( nsupers, grid->nprow ) * sizeof(C_Tree)));
-	checkGPU(gpuMalloc( (void**)&Llu->d_LBtree_ptr, CEILING( nsupers, grid->npcol ) * sizeof(C_Tree)));
-	checkGPU(gpuMalloc( (void**)&Llu->d_URtree_ptr, CEILING( nsupers, grid->nprow ) * sizeof(C_Tree)));
-	checkGPU(gpuMalloc( (void**)&Llu->d_UBtree_ptr, CEILING( nsupers, grid->npcol ) * sizeof(C_Tree)));	
-	checkGPU(gpuMemcpy(Llu->d_LRtree_ptr, Llu->LRtree_ptr, CEILING( nsupers, grid->nprow ) * sizeof(C_Tree), gpuMemcpyHostToDevice));	
-	checkGPU(gpuMemcpy(Llu->d_LBtree_ptr, Llu->LBtree_ptr, CEILING( nsupers, grid->npcol ) * sizeof(C_Tree), gpuMemcpyHostToDevice));			
-	checkGPU(gpuMemcpy(Llu->d_URtree_ptr, Llu->URtree_ptr, CEILING( nsupers, grid->nprow ) * sizeof(C_Tree), gpuMemcpyHostToDevice));	
-	checkGPU(gpuMemcpy(Llu->d_UBtree_ptr, Llu->UBtree_ptr, CEILING( nsupers, grid->npcol ) * sizeof(C_Tree), gpuMemcpyHostToDevice));		
+	checkGPU(gpuMalloc( (void**)&Llu->d_LRtree_ptr, NLBi( nsupers, grid ) * sizeof(C_Tree)));
+	checkGPU(gpuMalloc( (void**)&Llu->d_LBtree_ptr, NLBj( nsupers, grid ) * sizeof(C_Tree)));
+	checkGPU(gpuMalloc( (void**)&Llu->d_URtree_ptr, NLBi( nsupers, grid ) * sizeof(C_Tree)));
+	checkGPU(gpuMalloc( (void**)&Llu->d_UBtree_ptr, NLBj( nsupers, grid ) * sizeof(C_Tree)));	
+	checkGPU(gpuMemcpy(Llu->d_LRtree_ptr, Llu->LRtree_ptr, NLBi( nsupers, grid ) * sizeof(C_Tree), gpuMemcpyHostToDevice));	
+	checkGPU(gpuMemcpy(Llu->d_LBtree_ptr, Llu->LBtree_ptr, NLBj( nsupers, grid ) * sizeof(C_Tree), gpuMemcpyHostToDevice));			
+	checkGPU(gpuMemcpy(Llu->d_URtree_ptr, Llu->URtree_ptr, NLBi( nsupers, grid ) * sizeof(C_Tree), gpuMemcpyHostToDevice));	
+	checkGPU(gpuMemcpy(Llu->d_UBtree_ptr, Llu->UBtree_ptr, NLBj( nsupers, grid ) * sizeof(C_Tree), gpuMemcpyHostToDevice));		
 	checkGPU(gpuMalloc( (void**)&Llu->d_Lrowind_bc_dat, (Llu->Lrowind_bc_cnt) * sizeof(int_t)));
 	checkGPU(gpuMemcpy(Llu->d_Lrowind_bc_dat, Llu->Lrowind_bc_dat, (Llu->Lrowind_bc_cnt) * sizeof(int_t), gpuMemcpyHostToDevice));	
 	checkGPU(gpuMalloc( (void**)&Llu->d_Lindval_loc_bc_dat, (Llu->Lindval_loc_bc_cnt) * sizeof(int_t)));
 	checkGPU(gpuMemcpy(Llu->d_Lindval_loc_bc_dat, Llu->Lindval_loc_bc_dat, (Llu->Lindval_loc_bc_cnt) * sizeof(int_t), gpuMemcpyHostToDevice));	
-	checkGPU(gpuMalloc( (void**)&Llu->d_Lrowind_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int)));
-	checkGPU(gpuMemcpy(Llu->d_Lrowind_bc_offset, Llu->Lrowind_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int), gpuMemcpyHostToDevice));	
-	checkGPU(gpuMalloc( (void**)&Llu->d_Lindval_loc_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int)));
-	checkGPU(gpuMemcpy(Llu->d_Lindval_loc_bc_offset, Llu->Lindval_loc_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int), gpuMemcpyHostToDevice));	
-	checkGPU(gpuMalloc( (void**)&Llu->d_Lnzval_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int)));
-	checkGPU(gpuMemcpy(Llu->d_Lnzval_bc_offset, Llu->Lnzval_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int), gpuMemcpyHostToDevice));	
+	checkGPU(gpuMalloc( (void**)&Llu->d_Lrowind_bc_offset, NLBj( nsupers, grid ) * sizeof(long int)));
+	checkGPU(gpuMemcpy(Llu->d_Lrowind_bc_offset, Llu->Lrowind_bc_offset, NLBj( nsupers, grid ) * sizeof(long int), gpuMemcpyHostToDevice));	
+	checkGPU(gpuMalloc( (void**)&Llu->d_Lindval_loc_bc_offset, NLBj( nsupers, grid ) * sizeof(long int)));
+	checkGPU(gpuMemcpy(Llu->d_Lindval_loc_bc_offset, Llu->Lindval_loc_bc_offset, NLBj( nsupers, grid ) * sizeof(long int), gpuMemcpyHostToDevice));	
+	checkGPU(gpuMalloc( (void**)&Llu->d_Lnzval_bc_offset, NLBj( nsupers, grid ) * sizeof(long int)));
+	checkGPU(gpuMemcpy(Llu->d_Lnzval_bc_offset, Llu->Lnzval_bc_offset, NLBj( nsupers, grid ) * sizeof(long int), gpuMemcpyHostToDevice));	
 	
 	// some dummy allocation to avoid checking whether they are null pointers later
 	checkGPU(gpuMalloc( (void**)&Llu->d_Ucolind_bc_dat, sizeof(int_t)));
@@ -2306,12 +2310,12 @@ if ( !iam) printf(".. Construct Reduce tree for U: %.2f\t\n", t);
 	checkGPU(gpuMalloc( (void**)&Llu->d_Uindval_loc_bc_offset, sizeof(int_t)));
 
 
-	checkGPU(gpuMalloc( (void**)&Llu->d_Linv_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int)));
-	checkGPU(gpuMemcpy(Llu->d_Linv_bc_offset, Llu->Linv_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int), gpuMemcpyHostToDevice));	
-	checkGPU(gpuMalloc( (void**)&Llu->d_Uinv_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int)));
-	checkGPU(gpuMemcpy(Llu->d_Uinv_bc_offset, Llu->Uinv_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(long int), gpuMemcpyHostToDevice));		
-	checkGPU(gpuMalloc( (void**)&Llu->d_ilsum, (CEILING( nsupers, grid->nprow )+1) * sizeof(int_t)));
-	checkGPU(gpuMemcpy(Llu->d_ilsum, Llu->ilsum, (CEILING( nsupers, grid->nprow )+1) * sizeof(int_t), gpuMemcpyHostToDevice));
+	checkGPU(gpuMalloc( (void**)&Llu->d_Linv_bc_offset, NLBj( nsupers, grid ) * sizeof(long int)));
+	checkGPU(gpuMemcpy(Llu->d_Linv_bc_offset, Llu->Linv_bc_offset, NLBj( nsupers, grid ) * sizeof(long int), gpuMemcpyHostToDevice));	
+	checkGPU(gpuMalloc( (void**)&Llu->d_Uinv_bc_offset, NLBj( nsupers, grid ) * sizeof(long int)));
+	checkGPU(gpuMemcpy(Llu->d_Uinv_bc_offset, Llu->Uinv_bc_offset, NLBj( nsupers, grid ) * sizeof(long int), gpuMemcpyHostToDevice));		
+	checkGPU(gpuMalloc( (void**)&Llu->d_ilsum, (NLBi( nsupers, grid )+1) * sizeof(int_t)));
+	checkGPU(gpuMemcpy(Llu->d_ilsum, Llu->ilsum, (NLBi( nsupers, grid )+1) * sizeof(int_t), gpuMemcpyHostToDevice));
 
 
 	/* gpuMemcpy for the following is performed in pxgssvx */
@@ -2341,7 +2345,7 @@ if ( !iam) printf(".. Construct Reduce tree for U: %.2f\t\n", t);
 	MPI_Allreduce(mybufmax, Llu->bufmax, NBUFFERS, mpi_int_t,
 		      MPI_MAX, grid->comm);
 
-	k = CEILING( nsupers, grid->nprow );/* Number of local block rows */
+	k = NLBi( nsupers, grid );/* Number of local block rows */
 	if ( !(Llu->mod_bit = int32Malloc_dist(k)) )
 	    ABORT("Malloc fails for mod_bit[].");
 
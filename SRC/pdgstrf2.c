@@ -281,6 +281,7 @@ pdgstrf2_trsm
                 if (pr != krow) {
                     /* tag = ((k0<<2)+2) % tag_ub;        */
                     /* tag = (4*(nsupers+k0)+2) % tag_ub; */
+                    commProfSend(COMM_DIAG, comm, pr, nsupc * nsupc, MPI_DOUBLE);
                     MPI_Isend (ublk_ptr, nsupc * nsupc, MPI_DOUBLE, pr,
                                SLU_MPI_TAG (4, k0) /* tag */ ,
                                comm, U_diag_blk_send_req + pr);
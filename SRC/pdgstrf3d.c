@@ -201,6 +201,22 @@ int_t pdgstrf3d(superlu_dist_options_t *options, int m, int n, double anorm,
 
     int_t numLA = getNumLookAhead(options);
     dLUValSubBuf_t** LUvsbs = dLluBufInitArr( SUPERLU_MAX( numLA, grid3d->zscp.Np ), LUstruct);
+    dLluBufShmInit(numLA, LUvsbs, nsupers, grid, LUstruct);
+    dancReduceInit(nsupers, LUstruct);
+
+    /* time the supernodes for the partition of the next factorization,
+       or for the critical path report */
+    int timeNodes = getenv("SUPERLU_LBS_COST") || getenv("SUPERLU_CP_SCHED");
+    if ( Llu->nodeCost && (!timeNodes || Llu->nodeCostN != nsupers) ) {
+	SUPERLU_FREE(Llu->nodeCost);
+	Llu->nodeCost = NULL;
+    }
+    if ( timeNodes ) {
+	if ( !Llu->nodeCost )
+	    Llu->nodeCost = SUPERLU_MALLOC(nsupers * sizeof(double));
+	for (int_t i = 0; i < nsupers; ++i) Llu->nodeCost[i] = 0.0;
+	Llu->nodeCostN = nsupers;
+    }
     msgs_t**msgss = initMsgsArr(numLA);
     int_t mxLeafNode    = 0;
     for (int ilvl = 0; ilvl < maxLvl; ++ilvl) {
@@ -288,6 +304,10 @@ int_t pdgstrf3d(superlu_dist_options_t *options, int m, int n, double anorm,
     allinea_start_sampling();
 #endif
     SCT->pdgstrfTimer = SuperLU_timer_();
+    MPI_Comm probe[3] = {grid3d->grid2d.rscp.comm,
+			 grid3d->grid2d.cscp.comm, grid3d->zscp.comm};
+    commProgress_t *prog = commProgressPoll("3D factorization", grid3d->comm,
+					    3, probe);
 
     for (int ilvl = 0; ilvl < maxLvl; ++ilvl)
     {
@@ -342,6 +362,11 @@ int_t pdgstrf3d(superlu_dist_options_t *options, int m, int n, double anorm,
         SCT->tSchCompUdt3d[ilvl] = ilvl == 0 ? SCT->NetSchurUpTimer
 	    : SCT->NetSchurUpTimer - SCT->tSchCompUdt3d[ilvl - 1];
     } /* end for (int ilvl = 0; ilvl < maxLvl; ++ilvl) */
+    dancReduceFree(LUstruct, grid3d, SCT);
+    /* each supernode was timed on the layer that factored it */
+    if ( Llu->nodeCost )
+	MPI_Allreduce(MPI_IN_PLACE, Llu->nodeCost, nsupers, MPI_DOUBLE,
+		      MPI_MAX, grid3d->comm);
 
     /* Prepare error message - find the smallesr index i that U(i,i)==0 */
     int iinfo;
@@ -351,7 +376,12 @@ int_t pdgstrf3d(superlu_dist_options_t *options, int m, int n, double anorm,
     else *info = iinfo;
     //printf("After factorization: INFO = %d\n", *info); fflush(stdout);
 
+    commProgressStop(prog);
     SCT->pdgstrfTimer = SuperLU_timer_() - SCT->pdgstrfTimer;
+    if ( getenv("SUPERLU_CP_SCHED") && Llu->nodeCost )
+	printCriticalPath(nsupers, gEtreeInfo.setree, Llu->nodeCost,
+			  LUstruct->Glu_persist->xsup, Llu->Lrowind_bc_ptr,
+			  Llu->Ufstnz_br_ptr, SCT->pdgstrfTimer, grid3d);
 
 #ifdef ITAC_PROF
     VT_traceoff();
@@ -380,6 +410,7 @@ int_t pdgstrf3d(superlu_dist_options_t *options, int m, int n, double anorm,
     freeFactNodelists(&fNlists);
     freeMsgsArr(numLA, msgss);
     freeCommRequestsArr(SUPERLU_MAX(mxLeafNode, numLA), comReqss);
+    dLluBufShmFree(numLA, LUvsbs, LUstruct);
     dLluBufFreeArr(numLA, LUvsbs);
     dfreeDiagFactBufsArr(mxLeafNode, dFBufs);
     Free_HyP(HyP);
@@ -499,6 +499,7 @@ pdReDistribute_B_to_X(double *B, int_t m_loc, int nrhs, int_t ldb,
 		if(ppr<0)ppr+=procs;
 
 		if(SendCnt[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt[pps], mpi_int_t);
 			MPI_Isend(&send_ibuf[sdispls[pps]], SendCnt[pps], mpi_int_t, pps, 0, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -525,6 +526,7 @@ pdReDistribute_B_to_X(double *B, int_t m_loc, int nrhs, int_t ldb,
 		if(ppr>=procs)ppr-=procs;
 		if(ppr<0)ppr+=procs;
 		if(SendCnt_nrhs[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt_nrhs[pps], MPI_DOUBLE);
 			MPI_Isend(&send_dbuf[sdispls_nrhs[pps]], SendCnt_nrhs[pps], MPI_DOUBLE, pps, 1, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -616,7 +618,6 @@ pdReDistribute_X_to_B(int_t n, double *B, int_t m_loc, int_t ldb, int_t fst_row,
     int_t  *row_to_proc = SOLVEstruct->row_to_proc; /* row-process mapping */
     pxgstrs_comm_t *gstrs_comm = SOLVEstruct->gstrs_comm;
     int  iam, p, q, pkk, procs;
-    int_t  num_diag_procs, *diag_procs;
 	MPI_Request req_i, req_d, *req_send, *req_recv;
 	MPI_Status status, *status_send, *status_recv;
 	int Nreq_recv, Nreq_send, pp,pps,ppr;
@@ -693,12 +694,9 @@ pdReDistribute_X_to_B(int_t n, double *B, int_t m_loc, int_t ldb, int_t fst_row,
 			ptr_to_ibuf[p] = sdispls[p];
 			ptr_to_dbuf[p] = sdispls_nrhs[p];
 		}
-		num_diag_procs = SOLVEstruct->num_diag_procs;
-		diag_procs = SOLVEstruct->diag_procs;
- 		for (p = 0; p < num_diag_procs; ++p) {  /* For all diagonal processes. */
-		pkk = diag_procs[p];
+		for (k = 0; k < nsupers; ++k) { /* For my diagonal blocks. */
+		pkk = PNUM( PROW(k,grid), PCOL(k,grid), grid );
 		if ( iam == pkk ) {
-			for (k = p; k < nsupers; k += num_diag_procs) {
 			knsupc = SuperSize( k );
 			lk = LBi( k, grid ); /* Local block number */
 			irow = FstBlockC( k );
@@ -720,7 +718,6 @@ pdReDistribute_X_to_B(int_t n, double *B, int_t m_loc, int_t ldb, int_t fst_row,
 				ptr_to_dbuf[q] += nrhs;
 				++irow;
 			}
-			}
 		}
 		}
 
@@ -756,6 +753,7 @@ pdReDistribute_X_to_B(int_t n, double *B, int_t m_loc, int_t ldb, int_t fst_row,
 		if(ppr>=procs)ppr-=procs;
 		if(ppr<0)ppr+=procs;
 		if(SendCnt[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt[pps], mpi_int_t);
 			MPI_Isend(&send_ibuf[sdispls[pps]], SendCnt[pps], mpi_int_t, pps, 0, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -782,6 +780,7 @@ pdReDistribute_X_to_B(int_t n, double *B, int_t m_loc, int_t ldb, int_t fst_row,
 		if(ppr>=procs)ppr-=procs;
 		if(ppr<0)ppr+=procs;
 		if(SendCnt_nrhs[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt_nrhs[pps], MPI_DOUBLE);
 			MPI_Isend(&send_dbuf[sdispls_nrhs[pps]], SendCnt_nrhs[pps], MPI_DOUBLE, pps, 1, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -894,7 +893,7 @@ pdCompute_Diag_Inv(int_t n, dLUstruct_t *LUstruct,gridinfo_t *grid,
     Linv_bc_ptr = Llu->Linv_bc_ptr;
     Uinv_bc_ptr = Llu->Uinv_bc_ptr;
     Lnzval_bc_ptr = Llu->Lnzval_bc_ptr;
-    nlb = CEILING( nsupers, Pr ); /* Number of local block rows. */
+    nlb = NLBi( nsupers, grid ); /* Number of local block rows. */
 
     Llu->inv = 1;
 
@@ -956,6 +955,42 @@ pdCompute_Diag_Inv(int_t n, dLUstruct_t *LUstruct,gridinfo_t *grid,
 }
 
 
+/*
+ * The broadcast messages of a triangular solve, as seen by the progress
+ * thread (SUPERLU_PROGRESS_THREAD): it receives them into recvbuf_BC_fwd[]
+ * and forwards them down their trees on arrival.
+ */
+typedef struct
+{
+    C_Tree     *tree;
+    gridinfo_t *grid;
+    double *buf;
+    int        maxrecvsz, nbuf, nrhs, tag;
+} dSolveFwd_t;
+
+static void *dSolveKeep(void *arg, MPI_Status *status)
+{
+    dSolveFwd_t *f = (dSolveFwd_t *) arg;
+
+    if ( status->MPI_TAG != f->tag ) return NULL;
+    return &f->buf[(f->nbuf++) * f->maxrecvsz];
+}
+
+static int dSolveFwd(void *arg, void *buf, MPI_Status *status)
+{
+    dSolveFwd_t *f = (dSolveFwd_t *) arg;
+    gridinfo_t *grid = f->grid;
+    int_t k, lk;
+
+    if ( status->MPI_TAG != f->tag ) return 0;
+    k = *(double *) buf;
+    lk = LBj( k, grid );
+    if ( f->tree[lk].destCnt_ <= 0 ) return 0;
+    C_BcTree_forwardMessageSimple(&f->tree[lk], buf,
+				  f->tree[lk].msgSize_*f->nrhs+XK_H);
+    return 1;
+}
+
 /*! \brief
  *
  * <pre>
@@ -1073,7 +1108,7 @@ pdgstrs(superlu_dist_options_t *options, int_t n, dLUstruct_t *LUstruct,
     int_t  nb, nlb,nlb_nodiag, nub, nsupers, nsupers_j, nsupers_i,maxsuper;
     int_t  *xsup, *supno, *lsub, *usub;
     int_t  *ilsum;    /* Starting position of each supernode in lsum (LOCAL)*/
-    int    Pc, Pr, iam;
+    int    iam;
     int    knsupc, nsupr, nprobe;
     int    nbtree, nrtree, outcount;
     int    ldalsum;   /* Number of lsum entries locally owned. */
@@ -1100,6 +1135,8 @@ pdgstrs(superlu_dist_options_t *options, int_t n, dLUstruct_t *LUstruct,
     int  **fsendx_plist = Llu->fsendx_plist;
     int  nfrecvx = Llu->nfrecvx; /* Number of X components to be recv'd. */
     int  nfrecvx_buf=0;
+    commProgress_t *prog; /* progress thread of the L- or U-solve */
+    dSolveFwd_t pfwd;
     int *frecv;        /* Count of lsum[lk] contributions to be received
     			 from processes in this row.
     			 It is only valid on the diagonal processes. */
@@ -1269,8 +1306,6 @@ pdgstrs(superlu_dist_options_t *options, int_t n, dLUstruct_t *LUstruct,
      * Initialization.
      */
     iam = grid->iam;
-    Pc = grid->npcol;
-    Pr = grid->nprow;
     myrow = MYROW( iam, grid );
     mycol = MYCOL( iam, grid );
     xsup = Glu_persist->xsup;
@@ -1280,7 +1315,7 @@ pdgstrs(superlu_dist_options_t *options, int_t n, dLUstruct_t *LUstruct,
     Lnzval_bc_ptr = Llu->Lnzval_bc_ptr;
     Linv_bc_ptr = Llu->Linv_bc_ptr;
     Uinv_bc_ptr = Llu->Uinv_bc_ptr;
-    nlb = CEILING( nsupers, Pr ); /* Number of local block rows. */
+    nlb = NLBi( nsupers, grid ); /* Number of local block rows. */
 
     stat->utime[SOL_COMM] = 0.0;
     stat->utime[SOL_GEMM] = 0.0;
@@ -1353,10 +1388,10 @@ pdgstrs(superlu_dist_options_t *options, int_t n, dLUstruct_t *LUstruct,
 	ABORT("Calloc fails for frecv[].");
     Llu->frecv = frecv;
 
-    if ( !(leaf_send = intMalloc_dist((CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i)) )
+    if ( !(leaf_send = intMalloc_dist((NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i)) )
 	ABORT("Malloc fails for leaf_send[].");
     nleaf_send=0;
-    if ( !(root_send = intMalloc_dist((CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i)) )
+    if ( !(root_send = intMalloc_dist((NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i)) )
 	ABORT("Malloc fails for root_send[].");
     nroot_send=0;
 
@@ -1454,7 +1489,7 @@ pdgstrs(superlu_dist_options_t *options, int_t n, dLUstruct_t *LUstruct,
 	/* ---------------------------------------------------------
 	   Initialize the async Bcast trees on all processes.
 	   --------------------------------------------------------- */
-	nsupers_j = CEILING( nsupers, grid->npcol ); /* Number of local block columns */
+	nsupers_j = NLBj( nsupers, grid ); /* Number of local block columns */
 
 	nbtree = 0;
 	for (lk=0;lk<nsupers_j;++lk){
@@ -1467,7 +1502,7 @@ pdgstrs(superlu_dist_options_t *options, int_t n, dLUstruct_t *LUstruct,
 		}
 	}
 
-	nsupers_i = CEILING( nsupers, grid->nprow ); /* Number of local block rows */
+	nsupers_i = NLBi( nsupers, grid ); /* Number of local block rows */
 	if ( !(	leafsups = (int_t*)intCalloc_dist(nsupers_i)) )
 		ABORT("Calloc fails for leafsups.");
 
@@ -1479,7 +1514,7 @@ pdgstrs(superlu_dist_options_t *options, int_t n, dLUstruct_t *LUstruct,
 
 if(procs==1){
 	for (lk=0;lk<nsupers_i;++lk){
-		gb = myrow+lk*grid->nprow;  /* not sure */
+		gb = GBi( lk, grid );  /* not sure */
 		if(gb<nsupers){
 			if (fmod[lk*aln_i]==0){
 				leafsups[nleaf]=gb;
@@ -1495,7 +1530,7 @@ if(procs==1){
 			frecv[lk] = LRtree_ptr[lk].destCnt_;
 			nfrecvmod += frecv[lk];
 		}else{
-			gb = myrow+lk*grid->nprow;  /* not sure */
+			gb = GBi( lk, grid );  /* not sure */
 			if(gb<nsupers){
 				kcol = PCOL( gb, grid );
 				if(mycol==kcol) { /* Diagonal process */
@@ -1516,7 +1551,7 @@ if(procs==1){
 		ABORT("Malloc fails for recvbuf_BC_fwd[].");
 	nfrecvx_buf=0;
 
-	log_memory(nlb*aln_i*iword+nlb*iword+(CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i*2.0*iword+ nsupers_i*iword + sizelsum*num_thread * dword + (ldalsum * nrhs + nlb * XK_H) *dword + (sizertemp*num_thread + 1)*dword+maxrecvsz*(nfrecvx+1)*dword, stat);	//account for fmod, frecv, leaf_send, root_send, leafsups, recvbuf_BC_fwd	, lsum, x, rtemp
+	log_memory(nlb*aln_i*iword+nlb*iword+(NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i*2.0*iword+ nsupers_i*iword + sizelsum*num_thread * dword + (ldalsum * nrhs + nlb * XK_H) *dword + (sizertemp*num_thread + 1)*dword+maxrecvsz*(nfrecvx+1)*dword, stat);	//account for fmod, frecv, leaf_send, root_send, leafsups, recvbuf_BC_fwd	, lsum, x, rtemp
 
 
 #if ( DEBUGlevel>=2 )
@@ -1883,8 +1918,8 @@ t1 = SuperLU_timer_();
 
 	checkGPU(gpuMalloc( (void**)&d_grid, sizeof(gridinfo_t)));
 	
-	checkGPU(gpuMalloc( (void**)&recvbuf_BC_gpu, maxrecvsz*  CEILING( nsupers, grid->npcol) * sizeof(double))); // used for receiving and forwarding x on each thread
-	checkGPU(gpuMalloc( (void**)&recvbuf_RD_gpu, 2*maxrecvsz*  CEILING( nsupers, grid->nprow) * sizeof(double))); // used for receiving and forwarding lsum on each thread
+	checkGPU(gpuMalloc( (void**)&recvbuf_BC_gpu, maxrecvsz*  NLBj( nsupers, grid ) * sizeof(double))); // used for receiving and forwarding x on each thread
+	checkGPU(gpuMalloc( (void**)&recvbuf_RD_gpu, 2*maxrecvsz*  NLBi( nsupers, grid ) * sizeof(double))); // used for receiving and forwarding lsum on each thread
 	checkGPU(gpuMalloc( (void**)&d_lsum, sizelsum*num_thread * sizeof(double)));
 	checkGPU(gpuMalloc( (void**)&d_x, (ldalsum * nrhs + nlb * XK_H) * sizeof(double)));
 	checkGPU(gpuMalloc( (void**)&d_fmod, (nlb*aln_i) * sizeof(int_t)));
@@ -1895,7 +1930,7 @@ t1 = SuperLU_timer_();
 	checkGPU(gpuMemcpy(d_x, x, (ldalsum * nrhs + nlb * XK_H) * sizeof(double), gpuMemcpyHostToDevice));	
 	checkGPU(gpuMemcpy(d_fmod, fmod, (nlb*aln_i) * sizeof(int_t), gpuMemcpyHostToDevice));
 
-	k = CEILING( nsupers, grid->npcol);/* Number of local block columns divided by #warps per block used as number of thread blocks*/
+	k = NLBj( nsupers, grid );/* Number of local block columns divided by #warps per block used as number of thread blocks*/
 	knsupc = sp_ienv_dist(3, options);
 	dlsum_fmod_inv_gpu_wrap(k,nlb,DIM_X,DIM_Y,d_lsum,d_x,nrhs,knsupc,nsupers,d_fmod,Llu->d_LBtree_ptr,Llu->d_LRtree_ptr,Llu->d_ilsum,Llu->d_Lrowind_bc_dat, Llu->d_Lrowind_bc_offset, Llu->d_Lnzval_bc_dat, Llu->d_Lnzval_bc_offset, Llu->d_Linv_bc_dat, Llu->d_Linv_bc_offset, Llu->d_Lindval_loc_bc_dat, Llu->d_Lindval_loc_bc_offset,Llu->d_xsup,d_grid,recvbuf_BC_gpu,recvbuf_RD_gpu,maxrecvsz);
 
@@ -1913,6 +1948,18 @@ t1 = SuperLU_timer_();
 
 #else  /* CPU trisolve*/
 
+	/* Hand the messages of the L-solve to the progress thread, if any. */
+	pfwd.tree = LBtree_ptr;
+	pfwd.grid = grid;
+	pfwd.buf = recvbuf_BC_fwd;
+	pfwd.maxrecvsz = maxrecvsz;
+	pfwd.nbuf = 0;
+	pfwd.nrhs = nrhs;
+	pfwd.tag = BC_L;
+	prog = commProgressStart("L-solve", grid->comm, nfrecvx+nfrecvmod, maxrecvsz,
+				 MPI_DOUBLE, dSolveKeep, dSolveFwd, &pfwd);
+
+
 #ifdef _OPENMP
 #pragma omp parallel default (shared)
 {
@@ -2126,7 +2173,7 @@ thread_id=0;
 			for (i=0;i<nleaf_send;i++){
 				lk = leaf_send[i*aln_i];
 				if(lk>=0){ // this is a bcast forwarding
-					gb = mycol+lk*grid->npcol;  /* not sure */
+					gb = GBj( lk, grid );  /* not sure */
 					lib = LBi( gb, grid ); /* Local block number, row-wise. */
 					ii = X_BLK( lib );
 					// BcTree_forwardMessageSimple(LBtree_ptr[lk],&x[ii - XK_H],BcTree_GetMsgSize(LBtree_ptr[lk],'d')*nrhs+XK_H,'d');
@@ -2174,7 +2221,8 @@ thread_id=0;
 						recvbuf0 = &recvbuf_BC_fwd[nfrecvx_buf*maxrecvsz];
 
 						/* Receive a message. */
-						MPI_Recv( recvbuf0, maxrecvsz, MPI_DOUBLE,
+						if ( prog ) recvbuf0 = commProgressRecv(prog, &status);
+						else MPI_Recv( recvbuf0, maxrecvsz, MPI_DOUBLE,
 								MPI_ANY_SOURCE, MPI_ANY_TAG, grid->comm, &status );
 						// MPI_Irecv(recvbuf0,maxrecvsz,MPI_DOUBLE,MPI_ANY_SOURCE,MPI_ANY_TAG,grid->comm,&req);
 						// ready=0;
@@ -2205,7 +2253,7 @@ thread_id=0;
 								{
 									lk = LBj( k, grid );    /* local block number */
 										
-									if(LBtree_ptr[lk].destCnt_>0){
+									if(LBtree_ptr[lk].destCnt_>0 && !prog){
 
 										// BcTree_forwardMessageSimple(LBtree_ptr[lk],recvbuf0,BcTree_GetMsgSize(LBtree_ptr[lk],'d')*nrhs+XK_H,'d');
 										C_BcTree_forwardMessageSimple(&LBtree_ptr[lk], recvbuf0, LBtree_ptr[lk].msgSize_*nrhs+XK_H);
@@ -2374,6 +2422,7 @@ thread_id=0;
 
 			}
 		} // end of parallel
+		commProgressStop(prog);
 	
 #endif  /* end CPU trisolve */
 
@@ -2425,7 +2474,7 @@ thread_id=0;
 		SUPERLU_FREE(leaf_send);
 		SUPERLU_FREE(leafsups);
 		SUPERLU_FREE(recvbuf_BC_fwd);
-		log_memory(-nlb*aln_i*iword-nlb*iword-(CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i*iword- nsupers_i*iword -maxrecvsz*(nfrecvx+1)*dword, stat);	//account for fmod, frecv, leaf_send, leafsups, recvbuf_BC_fwd
+		log_memory(-nlb*aln_i*iword-nlb*iword-(NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i*iword- nsupers_i*iword -maxrecvsz*(nfrecvx+1)*dword, stat);	//account for fmod, frecv, leaf_send, leafsups, recvbuf_BC_fwd
 
 		for (lk=0;lk<nsupers_j;++lk){
 			if(LBtree_ptr[lk].empty_==NO){
@@ -2444,6 +2493,10 @@ thread_id=0;
 			}
 		}
 		MPI_Barrier( grid->comm );
+		if ( getenv("SUPERLU_TREE_STATS") ) {
+			C_Tree_Stats("L-bcast", LBtree_ptr, nsupers_j, grid->comm);
+			C_Tree_Stats("L-reduce", LRtree_ptr, nsupers_i, grid->comm);
+		}
 
 #if ( VAMPIR>=1 )
 		VT_traceoff();
@@ -2509,7 +2562,7 @@ thread_id=0;
 #endif
 
 #if ( DEBUGlevel>=2 )
-		for (p = 0; p < Pr*Pc; ++p) {
+		for (p = 0; p < grid->nprow * grid->npcol; ++p) {
 			if (iam == p) {
 				printf("(%2d) .. Ublocks %d\n", iam, Ublocks);
 				for (lb = 0; lb < nub; ++lb) {
@@ -2528,12 +2581,12 @@ thread_id=0;
 			}
 			MPI_Barrier( grid->comm );
 		}
-		for (p = 0; p < Pr*Pc; ++p) {
+		for (p = 0; p < grid->nprow * grid->npcol; ++p) {
 			if ( iam == p ) {
 				printf("\n(%d) bsendx_plist[][]", iam);
 				for (lb = 0; lb < nub; ++lb) {
 					printf("\n(%d) .. local col %2d: ", iam, lb);
-					for (i = 0; i < Pr; ++i)
+					for (i = 0; i < grid->nprow; ++i)
 						printf("%4d", bsendx_plist[lb][i]);
 				}
 				printf("\n");
@@ -2546,7 +2599,7 @@ thread_id=0;
 	/* ---------------------------------------------------------
 	   Initialize the async Bcast trees on all processes.
 	   --------------------------------------------------------- */
-	nsupers_j = CEILING( nsupers, grid->npcol ); /* Number of local block columns */
+	nsupers_j = NLBj( nsupers, grid ); /* Number of local block columns */
 
 	nbtree = 0;
 	for (lk=0;lk<nsupers_j;++lk){
@@ -2560,7 +2613,7 @@ thread_id=0;
 		}
 	}
 
-	nsupers_i = CEILING( nsupers, grid->nprow ); /* Number of local block rows */
+	nsupers_i = NLBi( nsupers, grid ); /* Number of local block rows */
 	if ( !(	rootsups = (int_t*)intCalloc_dist(nsupers_i)) )
 		ABORT("Calloc fails for rootsups.");
 
@@ -2575,7 +2628,7 @@ thread_id=0;
 			brecv[lk] = URtree_ptr[lk].destCnt_;
 			nbrecvmod += brecv[lk];
 		}else{
-			gb = myrow+lk*grid->nprow;  /* not sure */
+			gb = GBi( lk, grid );  /* not sure */
 			if(gb<nsupers){
 				kcol = PCOL( gb, grid );
 				if(mycol==kcol) { /* Diagonal process */
@@ -2644,7 +2697,7 @@ thread_id=0;
 	checkGPU(gpuMemcpy(d_x, x, (ldalsum * nrhs + nlb * XK_H) * sizeof(double), gpuMemcpyHostToDevice));	
 	checkGPU(gpuMemcpy(d_bmod, bmod, (nlb*aln_i) * sizeof(int_t), gpuMemcpyHostToDevice));
 
-	k = CEILING( nsupers, grid->npcol);/* Number of local block columns divided by #warps per block used as number of thread blocks*/
+	k = NLBj( nsupers, grid );/* Number of local block columns divided by #warps per block used as number of thread blocks*/
 	knsupc = sp_ienv_dist(3, options);
  
     
@@ -2661,6 +2714,18 @@ thread_id=0;
 
 #else  /* CPU trisolve*/
 
+	/* Hand the messages of the U-solve to the progress thread, if any. */
+	pfwd.tree = UBtree_ptr;
+	pfwd.grid = grid;
+	pfwd.buf = recvbuf_BC_fwd;
+	pfwd.maxrecvsz = maxrecvsz;
+	pfwd.nbuf = 0;
+	pfwd.nrhs = nrhs;
+	pfwd.tag = BC_U;
+	prog = commProgressStart("U-solve", grid->comm, nbrecvx+nbrecvmod, maxrecvsz,
+				 MPI_DOUBLE, dSolveKeep, dSolveFwd, &pfwd);
+
+
 
 
 
@@ -2803,7 +2868,7 @@ thread_id=0;
 for (i=0;i<nroot_send;i++){
 	lk = root_send[(i)*aln_i];
 	if(lk>=0){ // this is a bcast forwarding
-		gb = mycol+lk*grid->npcol;  /* not sure */
+		gb = GBj( lk, grid );  /* not sure */
 		lib = LBi( gb, grid ); /* Local block number, row-wise. */
 		ii = X_BLK( lib );
 		// BcTree_forwardMessageSimple(UBtree_ptr[lk],&x[ii - XK_H],BcTree_GetMsgSize(UBtree_ptr[lk],'d')*nrhs+XK_H,'d');
@@ -2847,7 +2912,8 @@ for (i=0;i<nroot_send;i++){
 			recvbuf0 = &recvbuf_BC_fwd[nbrecvx_buf*maxrecvsz];
 
 			/* Receive a message. */
-			MPI_Recv( recvbuf0, maxrecvsz, MPI_DOUBLE,
+			if ( prog ) recvbuf0 = commProgressRecv(prog, &status);
+			else MPI_Recv( recvbuf0, maxrecvsz, MPI_DOUBLE,
 					MPI_ANY_SOURCE, MPI_ANY_TAG, grid->comm, &status );
 
 #if ( PROFlevel>=1 )
@@ -2870,7 +2936,7 @@ for (i=0;i<nroot_send;i++){
 
 				lk = LBj( k, grid );    /* local block number */
 
-				if(UBtree_ptr[lk].destCnt_>0){
+				if(UBtree_ptr[lk].destCnt_>0 && !prog){
 
 					// BcTree_forwardMessageSimple(UBtree_ptr[lk],recvbuf0,BcTree_GetMsgSize(UBtree_ptr[lk],'d')*nrhs+XK_H,'d');
 					C_BcTree_forwardMessageSimple(&UBtree_ptr[lk], recvbuf0, UBtree_ptr[lk].msgSize_*nrhs+XK_H);
@@ -2999,6 +3065,7 @@ for (i=0;i<nroot_send;i++){
 			}
 		} /* while not finished ... */
 	}
+	commProgressStop(prog);
 
 #endif
 
@@ -3094,7 +3161,7 @@ for (i=0;i<nroot_send;i++){
 		SUPERLU_FREE(rootsups);
 		SUPERLU_FREE(recvbuf_BC_fwd);
 
-		log_memory(-nlb*aln_i*iword-nlb*iword - nsupers_i*iword - (CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i*iword - maxrecvsz*(nbrecvx+1)*dword - sizelsum*num_thread * dword - (ldalsum * nrhs + nlb * XK_H) *dword - (sizertemp*num_thread + 1)*dword, stat);	//account for bmod, brecv, root_send, rootsups, recvbuf_BC_fwd,rtemp,lsum,x
+		log_memory(-nlb*aln_i*iword-nlb*iword - nsupers_i*iword - (NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i*iword - maxrecvsz*(nbrecvx+1)*dword - sizelsum*num_thread * dword - (ldalsum * nrhs + nlb * XK_H) *dword - (sizertemp*num_thread + 1)*dword, stat);	//account for bmod, brecv, root_send, rootsups, recvbuf_BC_fwd,rtemp,lsum,x
 
 		for (lk=0;lk<nsupers_j;++lk){
 			if(UBtree_ptr[lk].empty_==NO){
@@ -3112,6 +3179,10 @@ for (i=0;i<nroot_send;i++){
 			}
 		}
 		MPI_Barrier( grid->comm );
+		if ( getenv("SUPERLU_TREE_STATS") ) {
+			C_Tree_Stats("U-bcast", UBtree_ptr, nsupers_j, grid->comm);
+			C_Tree_Stats("U-reduce", URtree_ptr, nsupers_i, grid->comm);
+		}
 
 
 #if ( PROFlevel>=2 )
@@ -366,7 +366,8 @@ __device__ void C_BcTree_forwardMessageSimple_Device(C_Tree* tree, void* localBu
 	MPI_Status status;
 	int flag;
 	for( int idxRecv = 0; idxRecv < tree->destCnt_; ++idxRecv ){
-	  int iProc = tree->myDests_[idxRecv];
+	  // myDests_ is in host memory
+	  // int iProc = tree->myDests_[idxRecv];
 	  // YL: Use NVSHMEM to send to multiple targets
 	//   int error_code = MPI_Isend( localBuffer, msgSize, tree->type_, 
 	// 	  iProc, tree->tag_,tree->comm_, &tree->sendRequests_[idxRecv] );
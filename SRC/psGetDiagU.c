@@ -91,7 +91,8 @@ void psGetDiagU(int_t n, sLUstruct_t *LUstruct, gridinfo_t *grid,
 	if ( iam == pkk ) {
 	    /* Copy diagonal into buffer dwork[]. */
 	    lwork = 0;
-	    for (k = p; k < nsupers; k += num_diag_procs) {
+	    for (k = 0; k < nsupers; ++k) {
+		if ( PNUM( PROW(k,grid), PCOL(k,grid), grid ) != pkk ) continue;
 		knsupc = SuperSize( k );
 		lk = LBj( k, grid );
 		nsupr = Llu->Lrowind_bc_ptr[lk][1]; /* LDA of lusup[] */
@@ -107,7 +108,8 @@ void psGetDiagU(int_t n, sLUstruct_t *LUstruct, gridinfo_t *grid,
 
 	/* Scatter swork[] into global diagU vector. */
 	lwork = 0;
-	for (k = p; k < nsupers; k += num_diag_procs) {
+	for (k = 0; k < nsupers; ++k) {
+	    if ( PNUM( PROW(k,grid), PCOL(k,grid), grid ) != pkk ) continue;
 	    knsupc = SuperSize( k );
 	    sblock = &diagU[FstBlockC( k )];
 	    for (i = 0; i < knsupc; ++i) sblock[i] = swork[lwork+i];
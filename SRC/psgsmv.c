@@ -180,6 +180,7 @@ void psgsmv_init
     for (p = 0; p < procs; ++p) {
         ptr_ind_tosend[p] -= SendCounts[p]; /* Reset pointer to beginning */
         if ( SendCounts[p] ) {
+	    commProfSend(COMM_SPMV, grid->comm, p, SendCounts[p], mpi_int_t);
 	    MPI_Isend(&ind_tosend[ptr_ind_tosend[p]], SendCounts[p],
 		      mpi_int_t, p, iam, grid->comm, &send_req[p]);
 	}
@@ -301,6 +302,7 @@ psgsmv
     recv_req = send_req + procs;
     for (p = 0; p < procs; ++p) {
         if ( RecvCounts[p] ) {
+	    commProfSend(COMM_SPMV, grid->comm, p, RecvCounts[p], MPI_FLOAT);
 	    MPI_Isend(&val_tosend[ptr_ind_torecv[p]], RecvCounts[p],
                       MPI_FLOAT, p, iam,
                       grid->comm, &send_req[p]);
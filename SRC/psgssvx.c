@@ -328,6 +328,10 @@ at the top-level directory.
  *                        matching to permute rows of the original matrix
  *                        to make the diagonal large relative to the
  *                        off-diagonal.
+ *           = LargeDiag_LDM: use a parallel locally dominant matching on
+ *                        the distributed matrix, with equilibration, to
+ *                        make the diagonal large relative to the
+ *                        off-diagonal; the values of A are not gathered.
  *           = MY_PERMR:  use the ordering given in ScalePermstruct->perm_r
  *                        input by the user.
  *
@@ -336,6 +340,10 @@ at the top-level directory.
  *           = NATURAL:       natural ordering.
  *           = MMD_AT_PLUS_A: minimum degree ordering on structure of A'+A.
  *           = MMD_ATA:       minimum degree ordering on structure of A'*A.
+ *           = AMD_AT_PLUS_A: approximate minimum degree ordering on A'+A.
+ *           = ND_AT_PLUS_A:  nested dissection ordering on A'+A.
+ *           = BEST_ORDERING: the cheapest of several orderings computed
+ *                            on different processes (see sp_ienv(12)).
  *           = MY_PERMC:      the ordering given in ScalePermstruct->perm_c.
  *
  *         o ReplaceTinyPivot (yes_no_t)
@@ -530,7 +538,7 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 	      structures are not used.                                  */
     fact_t  Fact;
     float *a;
-    int_t   *colptr, *rowind;
+    int_t   *colptr = NULL, *rowind = NULL;
     int_t   *perm_r; /* row permutations from partial pivoting */
     int_t   *perm_c; /* column permutation vector */
     int_t   *etree;  /* elimination tree */
@@ -549,6 +557,7 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
     float    GA_mem_use = 0.0;    /* memory usage by global A */
     float    dist_mem_use = 0.0;  /* memory usage during distribution */
     superlu_dist_mem_usage_t num_mem_usage, symb_mem_usage;
+    superlu_autotune_t tune; /* features and setting chosen by autotuning */
     int64_t  nnzLU;
     int_t    nnz_tot;
     float *nzval_a;
@@ -586,15 +595,16 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
     symb_comm = MPI_COMM_NULL;
     num_mem_usage.for_lu = num_mem_usage.total = 0.0;
     symb_mem_usage.for_lu = symb_mem_usage.total = 0.0;
+    tune.mode = 0;
 
     /* Test the input parameters. */
     *info = 0;
     Fact = options->Fact;
     if ( Fact < DOFACT || Fact > FACTORED )
 	*info = -1;
-    else if ( options->RowPerm < NOROWPERM || options->RowPerm > MY_PERMR )
+    else if ( options->RowPerm < NOROWPERM || options->RowPerm > LargeDiag_LDM )
 	*info = -1;
-    else if ( options->ColPerm < NATURAL || options->ColPerm > MY_PERMC )
+    else if ( options->ColPerm < NATURAL || options->ColPerm > ND_AT_PLUS_A )
 	*info = -1;
     else if ( options->IterRefine < NOREFINE || options->IterRefine > SLU_EXTRA )
 	*info = -1;
@@ -764,9 +774,11 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 	 * compressed row format to global A in compressed column format.
          * Numerical values are gathered only when a row permutation
          * for large diagonal is sought after.
+         * With ParSymbFact, only MC64 needs A gathered; otherwise
+         * colptr and rowind stay NULL.
          */
 	if ( Fact != SamePattern_SameRowPerm &&
-             (parSymbFact == NO || options->RowPerm != NO) ) {
+             (parSymbFact == NO || options->RowPerm == LargeDiag_MC64) ) {
              /* Performs serial symbolic factorzation and/or MC64 */
 
             need_value = (options->RowPerm == LargeDiag_MC64);
@@ -794,12 +806,13 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 	    if ( Fact != SamePattern_SameRowPerm ) {
 	        if ( options->RowPerm == MY_PERMR ) { /* Use user's perm_r. */
 	            /* Permute the global matrix GA for symbfact() */
-	            for (i = 0; i < colptr[n]; ++i) {
+	            for (i = 0; colptr && i < colptr[n]; ++i) {
 	            	irow = rowind[i];
 		    	rowind[i] = perm_r[irow];
 	            }
-	        } else if ( options->RowPerm == LargeDiag_MC64 ) {
-	            /* Get a new perm_r[] from MC64 */
+	        } else if ( options->RowPerm == LargeDiag_MC64
+	                   || options->RowPerm == LargeDiag_LDM ) {
+	            /* Get a new perm_r[] from MC64 or the distributed matching */
 	            if ( job == 5 ) {
 		        /* Allocate storage for scaling factors. */
 		        if ( !(R1 = floatMalloc_dist(m)) )
@@ -808,7 +821,9 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 		            ABORT("SUPERLU_MALLOC fails for C1[]");
 	            }
 
-	            if ( !iam ) { /* Process 0 finds a row permutation */
+	            if ( options->RowPerm == LargeDiag_LDM ) {
+	                iinfo = psldperm_dist(A, grid, colptr, rowind, perm_r, R1, C1);
+	            } else if ( !iam ) { /* Process 0 finds a row permutation */
 		        iinfo = sldperm_dist(job, m, nnz, colptr, rowind, a_GA,
 		                perm_r, R1, C1);
 
@@ -882,7 +897,7 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 		        } /* end Equil */
 
                         /* Now permute global GA to prepare for symbfact() */
-                        for (j = 0; j < n; ++j) {
+                        for (j = 0; colptr && j < n; ++j) {
 		            for (i = colptr[j]; i < colptr[j+1]; ++i) {
 	                        irow = rowind[i];
 		                rowind[i] = perm_r[irow];
@@ -891,7 +906,7 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 		        SUPERLU_FREE (R1);
 		        SUPERLU_FREE (C1);
 	              } else { /* job = 2,3,4 */
-		        for (j = 0; j < n; ++j) {
+		        for (j = 0; colptr && j < n; ++j) {
 		            for (i = colptr[j]; i < colptr[j+1]; ++i) {
 			        irow = rowind[i];
 			        rowind[i] = perm_r[irow];
@@ -964,6 +979,9 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 	 *   permc_spec = METIS_AT_PLUS_A: METIS on structure of A'+A
 	 *   permc_spec = PARMETIS: parallel METIS on structure of A'+A
 	 *   permc_spec = MY_PERMC: the ordering already supplied in perm_c[]
+	 * With ParSymbFact = YES, ND_AT_PLUS_A is a distributed nested
+	 * dissection (get_perm_c_dnd), which also stands in for PARMETIS
+	 * when ParMETIS is not available.
 	 */
 	permc_spec = options->ColPerm;
 
@@ -992,7 +1010,7 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 		}
 		sizes[2*noDomains - 2] = m;
 		fstVtxSep[2*noDomains - 2] = 0;
-	    } else if ( permc_spec != PARMETIS ) {   /* same as before */
+	    } else if ( permc_spec != PARMETIS && permc_spec != ND_AT_PLUS_A ) {   /* same as before */
 		printf("{" IFMT "," IFMT "}: psgssvx: invalid ColPerm option when ParSymbfact is used\n",
 		       MYROW(grid->iam, grid), MYCOL(grid->iam, grid));
 	    }
@@ -1000,7 +1018,8 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 
 	if ( permc_spec != MY_PERMC && Fact == DOFACT ) {
           /* Reuse perm_c if Fact == SamePattern, or SamePattern_SameRowPerm */
-	  if ( permc_spec == PARMETIS ) {
+	  if ( permc_spec == PARMETIS ||
+	       (parSymbFact == YES && permc_spec == ND_AT_PLUS_A) ) {
 	// #pragma omp parallel
     // {
 	// #pragma omp master
@@ -1010,9 +1029,17 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 	       * and does not modify it.  It also allocates memory for       *
 	       * sizes[] and fstVtxSep[] arrays, that contain information    *
 	       * on the separator tree computed by ParMETIS.                 */
-	      flinfo = get_perm_c_parmetis(A, perm_r, perm_c, nprocs_num,
-                                  	   noDomains, &sizes, &fstVtxSep,
-                                           grid, &symb_comm);
+#ifdef HAVE_PARMETIS
+	      if ( permc_spec == PARMETIS )
+	          flinfo = get_perm_c_parmetis(A, perm_r, perm_c, nprocs_num,
+                                  	       noDomains, &sizes, &fstVtxSep,
+                                               grid, &symb_comm);
+	      else
+#endif
+	      /* Distributed nested dissection, no global A is formed. */
+	      flinfo = get_perm_c_dnd(A, perm_r, perm_c, nprocs_num,
+                                      noDomains, &sizes, &fstVtxSep,
+                                      grid, &symb_comm);
 	// }
 	// }
 	      if (flinfo > 0) {
@@ -1020,6 +1047,10 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 		  *info = flinfo;
 		  return;
      	      }
+	  } else if ( parSymbFact == YES && permc_spec == NATURAL ) {
+	      /* NATURAL: perm_c[] and the trivial tree are set above. */
+	  } else if ( permc_spec == BEST_ORDERING ) {
+	      get_perm_c_race_dist(options, &GA, perm_c, grid);
 	  } else {
 	      get_perm_c_dist(iam, permc_spec, &GA, perm_c);
           }
@@ -1052,6 +1083,10 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 	            }
 	        }
 
+	        /* Take the blocking parameters from the tuning database or
+		   the symbolic cost model, if autotuning is requested. */
+	        superlu_autotune_dist(options, &GA, perm_c, grid, &tune);
+
 	        /* Perform a symbolic factorization on Pc*Pr*A*Pc^T and set up
                    the nonzero data structures for L & U. */
 #if ( PRNTlevel>=1 )
@@ -1066,9 +1101,9 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 		      SUPERLU_MALLOC(sizeof(Glu_freeable_t))) )
 		    ABORT("Malloc fails for Glu_freeable.");
 
-	    	/* Every process does this.
+	    	/* Every process does this, or one per node (sp_ienv(13)).
 		   returned value (-iinfo) is the size of lsub[], incuding pruned graph.*/
-	    	iinfo = symbfact(options, iam, &GAC, perm_c, etree,
+	    	iinfo = symbfact_shared(options, grid, &GAC, perm_c, etree,
 			     	 Glu_persist, Glu_freeable);
 		nnzLU = Glu_freeable->nnzLU;
 	    	stat->utime[SYMBFAC] = SuperLU_timer_() - t;
@@ -1113,7 +1148,7 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 	    }
 
             /* Destroy global GA */
-            if ( parSymbFact == NO || options->RowPerm != NO )
+            if ( parSymbFact == NO || options->RowPerm == LargeDiag_MC64 )
                 Destroy_CompCol_Matrix_dist(&GA);
             if ( parSymbFact == NO )
  	        Destroy_CompCol_Permuted_dist(&GAC);
@@ -1126,6 +1161,15 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 
 	/* Distribute entries of A into L & U data structures. */
 	//if (parSymbFact == NO || ???? Fact == SamePattern_SameRowPerm) {
+	/* Map the supernodes to the grid before distributing them; the
+	   proportional map needs the serial symbolic factorization. */
+	if ( Fact != SamePattern_SameRowPerm ) {
+	    if ( parSymbFact == NO && getenv("SUPERLU_PROP_MAP") )
+		superlu_smap_init(n, etree, Glu_persist, Glu_freeable, grid);
+	    else
+		superlu_smap_free(grid);
+	}
+
 	if ( parSymbFact == NO ) {
 	    /* CASE OF SERIAL SYMBOLIC */
   	    /* Apply column permutation to the original distributed A */
@@ -1134,6 +1178,7 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 	    /* Distribute Pc*Pr*diag(R)*A*diag(C)*Pc^T into L and U storage.
 	       NOTE: the row permutation Pc*Pr is applied internally in the
   	       distribution routine. */
+
 	    t = SuperLU_timer_();
 	    dist_mem_use = psdistribute(options, n, A, ScalePermstruct,
                                       Glu_freeable, LUstruct, grid);
@@ -1172,6 +1217,7 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
 	// {
 	psgstrf(options, m, n, anorm, LUstruct, grid, stat, info);
 	stat->utime[FACT] = SuperLU_timer_() - t;
+	superlu_autotune_record(options, &tune, stat->utime[FACT], grid);
 	// }
 	// }
 
@@ -1193,7 +1239,7 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
     }
 
 	nsupers = Glu_persist->supno[n-1] + 1;
-	nsupers_j = CEILING( nsupers, grid->npcol ); /* Number of local block columns */
+	nsupers_j = NLBj( nsupers, grid ); /* Number of local block columns */
 
 
 
@@ -1651,6 +1697,8 @@ psgssvx(superlu_dist_options_t *options, SuperMatrix *A,
     if ( !factored && Fact != SamePattern_SameRowPerm && !parSymbFact)
  	Destroy_CompCol_Permuted_dist(&GAC);
 #endif
+    commProfDump(grid->comm, "psgssvx");
+
 #if ( DEBUGlevel>=1 )
     CHECK_MALLOC(iam, "Exit psgssvx()");
 #endif
@@ -1689,7 +1737,7 @@ int_t next_lind;      /* next available position in index[*] */
 int_t next_lval;      /* next available position in nzval[*] */
 
 nsupers = Glu_persist->supno[n-1] + 1;
-nsupers_j = CEILING( nsupers, grid->npcol ); /* Number of local block columns */
+nsupers_j = NLBj( nsupers, grid ); /* Number of local block columns */
 
 if ( !(Llu->Ucolind_bc_ptr = (int_t**)SUPERLU_MALLOC(nsupers_j * sizeof(int_t*))) )
 	ABORT("Malloc fails for Llu->Ucolind_bc_ptr[].");
@@ -1724,7 +1772,7 @@ if ( !(Llu->Unzval_bc_offset =
 Llu->Unzval_bc_offset[nsupers_j-1] = -1;		
 
 for (lk=0;lk<nsupers_j;++lk){
-	k = lk * grid->npcol + mycol;/* Global block number, col-wise. */	
+	k = GBj( lk, grid );/* Global block number, col-wise. */	
 	knsupc = SuperSize( k );
 	nub = Urbs[lk];      /* Number of U blocks in block column lk */
 
@@ -1740,7 +1788,7 @@ for (lk=0;lk<nsupers_j;++lk){
 		uval = Llu->Unzval_br_ptr[ik];
 		i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 		i += UB_DESCRIPTOR;
-		gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+		gik = GBi( ik, grid );/* Global block number, row-wise. */
 		iknsupc = SuperSize( gik );
 		nrow += iknsupc;
 		ikfrow = FstBlockC( gik );
@@ -1794,7 +1842,7 @@ for (lk=0;lk<nsupers_j;++lk){
 		uval = Llu->Unzval_br_ptr[ik];
 		i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 		i += UB_DESCRIPTOR;
-		gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+		gik = GBi( ik, grid );/* Global block number, row-wise. */
 		iknsupc = SuperSize( gik );
 		ikfrow = FstBlockC( gik );
 		iklrow = FstBlockC( gik+1 );
@@ -1862,7 +1910,7 @@ for (lk=0;lk<nsupers_j;++lk){
 	}		
 
 	/* use contingous memory for Ucolind_bc_ptr, Unzval_bc_ptr, Uindval_loc_bc_ptr*/
-	k = CEILING( nsupers, grid->npcol );/* Number of local block columns */
+	k = NLBj( nsupers, grid );/* Number of local block columns */
 	Ucolind_bc_cnt=0;
 	Unzval_bc_cnt=0;
 	Uindval_loc_bc_cnt=0;
@@ -1920,17 +1968,17 @@ for (lk=0;lk<nsupers_j;++lk){
 
 	checkGPU(gpuMalloc( (void**)&Llu->d_Ucolind_bc_dat, (Llu->Ucolind_bc_cnt) * sizeof(int_t)));
 	checkGPU(gpuMemcpy(Llu->d_Ucolind_bc_dat, Llu->Ucolind_bc_dat, (Llu->Ucolind_bc_cnt) * sizeof(int_t), gpuMemcpyHostToDevice));	
-	checkGPU(gpuMalloc( (void**)&Llu->d_Ucolind_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(int64_t)));
-	checkGPU(gpuMemcpy(Llu->d_Ucolind_bc_offset, Llu->Ucolind_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(int64_t), gpuMemcpyHostToDevice));	
-	checkGPU(gpuMalloc( (void**)&Llu->d_Unzval_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(int64_t)));
-	checkGPU(gpuMemcpy(Llu->d_Unzval_bc_offset, Llu->Unzval_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(int64_t), gpuMemcpyHostToDevice));	
+	checkGPU(gpuMalloc( (void**)&Llu->d_Ucolind_bc_offset, NLBj( nsupers, grid ) * sizeof(int64_t)));
+	checkGPU(gpuMemcpy(Llu->d_Ucolind_bc_offset, Llu->Ucolind_bc_offset, NLBj( nsupers, grid ) * sizeof(int64_t), gpuMemcpyHostToDevice));	
+	checkGPU(gpuMalloc( (void**)&Llu->d_Unzval_bc_offset, NLBj( nsupers, grid ) * sizeof(int64_t)));
+	checkGPU(gpuMemcpy(Llu->d_Unzval_bc_offset, Llu->Unzval_bc_offset, NLBj( nsupers, grid ) * sizeof(int64_t), gpuMemcpyHostToDevice));	
 	checkGPU(gpuMalloc( (void**)&Llu->d_Unzval_bc_dat, (Llu->Unzval_bc_cnt) * sizeof(float)));
 	checkGPU(gpuMemcpy(LUstruct->Llu->d_Unzval_bc_dat, LUstruct->Llu->Unzval_bc_dat,(LUstruct->Llu->Unzval_bc_cnt) * sizeof(float), gpuMemcpyHostToDevice));
 	
 	checkGPU(gpuMalloc( (void**)&Llu->d_Uindval_loc_bc_dat, (Llu->Uindval_loc_bc_cnt) * sizeof(int_t)));
 	checkGPU(gpuMemcpy(Llu->d_Uindval_loc_bc_dat, Llu->Uindval_loc_bc_dat, (Llu->Uindval_loc_bc_cnt) * sizeof(int_t), gpuMemcpyHostToDevice));		
-	checkGPU(gpuMalloc( (void**)&Llu->d_Uindval_loc_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(int64_t)));
-	checkGPU(gpuMemcpy(Llu->d_Uindval_loc_bc_offset, Llu->Uindval_loc_bc_offset, CEILING( nsupers, grid->npcol ) * sizeof(int64_t), gpuMemcpyHostToDevice));	
+	checkGPU(gpuMalloc( (void**)&Llu->d_Uindval_loc_bc_offset, NLBj( nsupers, grid ) * sizeof(int64_t)));
+	checkGPU(gpuMemcpy(Llu->d_Uindval_loc_bc_offset, Llu->Uindval_loc_bc_offset, NLBj( nsupers, grid ) * sizeof(int64_t), gpuMemcpyHostToDevice));	
 
 	SUPERLU_FREE (Llu->Ucolind_bc_dat);
 	SUPERLU_FREE (Llu->Ucolind_bc_offset);
@@ -296,6 +296,7 @@ at the top-level directory.
  *                        matching to permute rows of the original matrix
  *                        to make the diagonal large relative to the
  *                        off-diagonal.
+ *           = LargeDiag_LDM: not supported by this routine.
  *           = MY_PERMR:  use the ordering given in ScalePermstruct->perm_r
  *                        input by the user.
  *
@@ -304,6 +305,10 @@ at the top-level directory.
  *           = NATURAL:       natural ordering.
  *           = MMD_AT_PLUS_A: minimum degree ordering on structure of A'+A.
  *           = MMD_ATA:       minimum degree ordering on structure of A'*A.
+ *           = AMD_AT_PLUS_A: approximate minimum degree ordering on A'+A.
+ *           = ND_AT_PLUS_A:  nested dissection ordering on A'+A.
+ *           = BEST_ORDERING: the cheapest of several orderings computed
+ *                            on different processes (see sp_ienv(12)).
  *           = MY_PERMC:      the ordering given in ScalePermstruct->perm_c.
  *
  *         o ReplaceTinyPivot (yes_no_t)
@@ -517,8 +522,8 @@ psgssvx_ABglobal(superlu_dist_options_t *options, SuperMatrix *A,
     if ( Fact < 0 || Fact > FACTORED )
 	*info = -1;
     else if ( options->RowPerm < 0 || options->RowPerm > MY_PERMR )
-	*info = -1;
-    else if ( options->ColPerm < 0 || options->ColPerm > MY_PERMC )
+	*info = -1; /* LargeDiag_LDM needs the distributed A of psgssvx() */
+    else if ( options->ColPerm < 0 || options->ColPerm > ND_AT_PLUS_A )
 	*info = -1;
     else if ( options->IterRefine < 0 || options->IterRefine > SLU_EXTRA )
 	*info = -1;
@@ -853,7 +858,9 @@ psgssvx_ABglobal(superlu_dist_options_t *options, SuperMatrix *A,
 	 *   permc_spec = MY_PERMC: the ordering already supplied in perm_c[]
 	 */
 	permc_spec = options->ColPerm;
-	if ( permc_spec != MY_PERMC && Fact == DOFACT )
+	if ( permc_spec == BEST_ORDERING && Fact == DOFACT )
+	    get_perm_c_race_dist(options, A, perm_c, grid);
+	else if ( permc_spec != MY_PERMC && Fact == DOFACT )
 	    /* Use an ordering provided by SuperLU */
 	    get_perm_c_dist(iam, permc_spec, A, perm_c);
 
@@ -885,7 +892,7 @@ psgssvx_ABglobal(superlu_dist_options_t *options, SuperMatrix *A,
 		   SUPERLU_MALLOC(sizeof(Glu_freeable_t))) )
 		ABORT("Malloc fails for Glu_freeable.");
 
-	    iinfo = symbfact(options, iam, &AC, perm_c, etree,
+	    iinfo = symbfact_shared(options, grid, &AC, perm_c, etree,
 			     Glu_persist, Glu_freeable);
 
 	    stat->utime[SYMBFAC] = SuperLU_timer_() - t;
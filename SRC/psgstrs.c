@@ -307,6 +307,7 @@ psReDistribute_B_to_X(float *B, int_t m_loc, int nrhs, int_t ldb,
 		if(ppr<0)ppr+=procs;
 
 		if(SendCnt[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt[pps], mpi_int_t);
 			MPI_Isend(&send_ibuf[sdispls[pps]], SendCnt[pps], mpi_int_t, pps, 0, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -333,6 +334,7 @@ psReDistribute_B_to_X(float *B, int_t m_loc, int nrhs, int_t ldb,
 		if(ppr>=procs)ppr-=procs;
 		if(ppr<0)ppr+=procs;
 		if(SendCnt_nrhs[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt_nrhs[pps], MPI_FLOAT);
 			MPI_Isend(&send_dbuf[sdispls_nrhs[pps]], SendCnt_nrhs[pps], MPI_FLOAT, pps, 1, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -424,7 +426,6 @@ psReDistribute_X_to_B(int_t n, float *B, int_t m_loc, int_t ldb, int_t fst_row,
     int_t  *row_to_proc = SOLVEstruct->row_to_proc; /* row-process mapping */
     pxgstrs_comm_t *gstrs_comm = SOLVEstruct->gstrs_comm;
     int  iam, p, q, pkk, procs;
-    int_t  num_diag_procs, *diag_procs;
 	MPI_Request req_i, req_d, *req_send, *req_recv;
 	MPI_Status status, *status_send, *status_recv;
 	int Nreq_recv, Nreq_send, pp,pps,ppr;
@@ -502,12 +503,9 @@ psReDistribute_X_to_B(int_t n, float *B, int_t m_loc, int_t ldb, int_t fst_row,
 			ptr_to_ibuf[p] = sdispls[p];
 			ptr_to_dbuf[p] = sdispls_nrhs[p];
 		}
-		num_diag_procs = SOLVEstruct->num_diag_procs;
-		diag_procs = SOLVEstruct->diag_procs;
- 		for (p = 0; p < num_diag_procs; ++p) {  /* For all diagonal processes. */
-		pkk = diag_procs[p];
+		for (k = 0; k < nsupers; ++k) { /* For my diagonal blocks. */
+		pkk = PNUM( PROW(k,grid), PCOL(k,grid), grid );
 		if ( iam == pkk ) {
-			for (k = p; k < nsupers; k += num_diag_procs) {
 			knsupc = SuperSize( k );
 			lk = LBi( k, grid ); /* Local block number */
 			irow = FstBlockC( k );
@@ -529,7 +527,6 @@ psReDistribute_X_to_B(int_t n, float *B, int_t m_loc, int_t ldb, int_t fst_row,
 				ptr_to_dbuf[q] += nrhs;
 				++irow;
 			}
-			}
 		}
 		}
 
@@ -565,6 +562,7 @@ psReDistribute_X_to_B(int_t n, float *B, int_t m_loc, int_t ldb, int_t fst_row,
 		if(ppr>=procs)ppr-=procs;
 		if(ppr<0)ppr+=procs;
 		if(SendCnt[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt[pps], mpi_int_t);
 			MPI_Isend(&send_ibuf[sdispls[pps]], SendCnt[pps], mpi_int_t, pps, 0, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -591,6 +589,7 @@ psReDistribute_X_to_B(int_t n, float *B, int_t m_loc, int_t ldb, int_t fst_row,
 		if(ppr>=procs)ppr-=procs;
 		if(ppr<0)ppr+=procs;
 		if(SendCnt_nrhs[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt_nrhs[pps], MPI_FLOAT);
 			MPI_Isend(&send_dbuf[sdispls_nrhs[pps]], SendCnt_nrhs[pps], MPI_FLOAT, pps, 1, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -703,7 +702,7 @@ psCompute_Diag_Inv(int_t n, sLUstruct_t *LUstruct,gridinfo_t *grid,
     Linv_bc_ptr = Llu->Linv_bc_ptr;
     Uinv_bc_ptr = Llu->Uinv_bc_ptr;
     Lnzval_bc_ptr = Llu->Lnzval_bc_ptr;
-    nlb = CEILING( nsupers, Pr ); /* Number of local block rows. */
+    nlb = NLBi( nsupers, grid ); /* Number of local block rows. */
 
     Llu->inv = 1;
 
@@ -765,6 +764,42 @@ psCompute_Diag_Inv(int_t n, sLUstruct_t *LUstruct,gridinfo_t *grid,
 }
 
 
+/*
+ * The broadcast messages of a triangular solve, as seen by the progress
+ * thread (SUPERLU_PROGRESS_THREAD): it receives them into recvbuf_BC_fwd[]
+ * and forwards them down their trees on arrival.
+ */
+typedef struct
+{
+    C_Tree     *tree;
+    gridinfo_t *grid;
+    float *buf;
+    int        maxrecvsz, nbuf, nrhs, tag;
+} sSolveFwd_t;
+
+static void *sSolveKeep(void *arg, MPI_Status *status)
+{
+    sSolveFwd_t *f = (sSolveFwd_t *) arg;
+
+    if ( status->MPI_TAG != f->tag ) return NULL;
+    return &f->buf[(f->nbuf++) * f->maxrecvsz];
+}
+
+static int sSolveFwd(void *arg, void *buf, MPI_Status *status)
+{
+    sSolveFwd_t *f = (sSolveFwd_t *) arg;
+    gridinfo_t *grid = f->grid;
+    int_t k, lk;
+
+    if ( status->MPI_TAG != f->tag ) return 0;
+    k = *(float *) buf;
+    lk = LBj( k, grid );
+    if ( f->tree[lk].destCnt_ <= 0 ) return 0;
+    C_BcTree_forwardMessageSimple(&f->tree[lk], buf,
+				  f->tree[lk].msgSize_*f->nrhs+XK_H);
+    return 1;
+}
+
 /*! \brief
  *
  * <pre>
@@ -883,7 +918,7 @@ psgstrs(superlu_dist_options_t *options, int_t n,
     int_t  nb, nlb,nlb_nodiag, nub, nsupers, nsupers_j, nsupers_i,maxsuper;
     int_t  *xsup, *supno, *lsub, *usub;
     int_t  *ilsum;    /* Starting position of each supernode in lsum (LOCAL)*/
-    int    Pc, Pr, iam;
+    int    iam;
     int    knsupc, nsupr, nprobe;
     int    nbtree, nrtree, outcount;
     int    ldalsum;   /* Number of lsum entries locally owned. */
@@ -906,6 +941,8 @@ psgstrs(superlu_dist_options_t *options, int_t n,
     int  **fsendx_plist = Llu->fsendx_plist;
     int  nfrecvx = Llu->nfrecvx; /* Number of X components to be recv'd. */
     int  nfrecvx_buf=0;
+    commProgress_t *prog; /* progress thread of the L- or U-solve */
+    sSolveFwd_t pfwd;
     int  *frecv;        /* Count of lsum[lk] contributions to be received
     			     from processes in this row.
     			     It is only valid on the diagonal processes. */
@@ -1008,8 +1045,6 @@ psgstrs(superlu_dist_options_t *options, int_t n,
      * Initialization.
      */
     iam = grid->iam;
-    Pc = grid->npcol;
-    Pr = grid->nprow;
     myrow = MYROW( iam, grid );
     mycol = MYCOL( iam, grid );
     xsup = Glu_persist->xsup;
@@ -1019,7 +1054,7 @@ psgstrs(superlu_dist_options_t *options, int_t n,
     Lnzval_bc_ptr = Llu->Lnzval_bc_ptr;
     Linv_bc_ptr = Llu->Linv_bc_ptr;
     Uinv_bc_ptr = Llu->Uinv_bc_ptr;
-    nlb = CEILING( nsupers, Pr ); /* Number of local block rows. */
+    nlb = NLBi( nsupers, grid ); /* Number of local block rows. */
 
     stat->utime[SOL_COMM] = 0.0;
     stat->utime[SOL_GEMM] = 0.0;
@@ -1042,10 +1077,10 @@ psgstrs(superlu_dist_options_t *options, int_t n,
 	ABORT("Calloc fails for frecv[].");
     Llu->frecv = frecv;
 
-    if ( !(leaf_send = intMalloc_dist((CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i)) )
+    if ( !(leaf_send = intMalloc_dist((NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i)) )
 	ABORT("Malloc fails for leaf_send[].");
     nleaf_send=0;
-    if ( !(root_send = intMalloc_dist((CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i)) )
+    if ( !(root_send = intMalloc_dist((NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i)) )
 	ABORT("Malloc fails for root_send[].");
     nroot_send=0;
 
@@ -1141,7 +1176,7 @@ psgstrs(superlu_dist_options_t *options, int_t n,
 	/* ---------------------------------------------------------
 	   Initialize the async Bcast trees on all processes.
 	   --------------------------------------------------------- */
-	nsupers_j = CEILING( nsupers, grid->npcol ); /* Number of local block columns */
+	nsupers_j = NLBj( nsupers, grid ); /* Number of local block columns */
 
 	nbtree = 0;
 	for (lk=0;lk<nsupers_j;++lk){
@@ -1157,7 +1192,7 @@ psgstrs(superlu_dist_options_t *options, int_t n,
 		}
 	}
 
-	nsupers_i = CEILING( nsupers, grid->nprow ); /* Number of local block rows */
+	nsupers_i = NLBi( nsupers, grid ); /* Number of local block rows */
 	if ( !(	leafsups = (int_t*)intCalloc_dist(nsupers_i)) )
 		ABORT("Calloc fails for leafsups.");
 
@@ -1167,7 +1202,7 @@ psgstrs(superlu_dist_options_t *options, int_t n,
 
 if(procs==1){
 	for (lk=0;lk<nsupers_i;++lk){
-		gb = myrow+lk*grid->nprow;  /* not sure */
+		gb = GBi( lk, grid );  /* not sure */
 		if(gb<nsupers){
 			if (fmod[lk*aln_i]==0){
 				leafsups[nleaf]=gb;
@@ -1184,7 +1219,7 @@ if(procs==1){
 			frecv[lk] = LRtree_ptr[lk].destCnt_;
 			nfrecvmod += frecv[lk];
 		}else{
-			gb = myrow+lk*grid->nprow;  /* not sure */
+			gb = GBi( lk, grid );  /* not sure */
 			if(gb<nsupers){
 				kcol = PCOL( gb, grid );
 				if(mycol==kcol) { /* Diagonal process */
@@ -1207,7 +1242,7 @@ if(procs==1){
 		ABORT("Malloc fails for recvbuf_BC_fwd[].");
 	nfrecvx_buf=0;
 
-	log_memory(nlb*aln_i*iword+nlb*iword+(CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i*2.0*iword+ nsupers_i*iword + sizelsum*num_thread * dword + (ldalsum * nrhs + nlb * XK_H) *dword + (sizertemp*num_thread + 1)*dword+maxrecvsz*(nfrecvx+1)*dword, stat);	//account for fmod, frecv, leaf_send, root_send, leafsups, recvbuf_BC_fwd	, lsum, x, rtemp
+	log_memory(nlb*aln_i*iword+nlb*iword+(NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i*2.0*iword+ nsupers_i*iword + sizelsum*num_thread * dword + (ldalsum * nrhs + nlb * XK_H) *dword + (sizertemp*num_thread + 1)*dword+maxrecvsz*(nfrecvx+1)*dword, stat);	//account for fmod, frecv, leaf_send, root_send, leafsups, recvbuf_BC_fwd	, lsum, x, rtemp
 
 #if ( DEBUGlevel>=2 )
 	printf("(%2d) nfrecvx %4d,  nfrecvmod %4d,  nleaf %4d\n,  nbtree %4d\n,  nrtree %4d\n",
@@ -1233,6 +1268,17 @@ if(procs==1){
 	__itt_resume(); // start VTune, again use 2 underscores
 #endif
 
+	/* Hand the messages of the L-solve to the progress thread, if any. */
+	pfwd.tree = LBtree_ptr;
+	pfwd.grid = grid;
+	pfwd.buf = recvbuf_BC_fwd;
+	pfwd.maxrecvsz = maxrecvsz;
+	pfwd.nbuf = 0;
+	pfwd.nrhs = nrhs;
+	pfwd.tag = BC_L;
+	prog = commProgressStart("L-solve", grid->comm, nfrecvx+nfrecvmod, maxrecvsz,
+				 MPI_FLOAT, sSolveKeep, sSolveFwd, &pfwd);
+
 	/* ---------------------------------------------------------
 	   Solve the leaf nodes first by all the diagonal processes.
 	   --------------------------------------------------------- */
@@ -1438,7 +1484,7 @@ if(procs==1){
 	for (i=0;i<nleaf_send;i++){
 		lk = leaf_send[i*aln_i];
 		if(lk>=0){ // this is a bcast forwarding
-			gb = mycol+lk*grid->npcol;  /* not sure */
+			gb = GBj( lk, grid );  /* not sure */
 			lib = LBi( gb, grid ); /* Local block number, row-wise. */
 			ii = X_BLK( lib );
 			//BcTree_forwardMessageSimple(LBtree_ptr[lk],&x[ii - XK_H],BcTree_GetMsgSize(LBtree_ptr[lk],'s')*nrhs+XK_H,'s');
@@ -1485,7 +1531,8 @@ if(procs==1){
 			recvbuf0 = &recvbuf_BC_fwd[nfrecvx_buf*maxrecvsz];
 
 			/* Receive a message. */
-			MPI_Recv( recvbuf0, maxrecvsz, MPI_FLOAT,
+			if ( prog ) recvbuf0 = commProgressRecv(prog, &status);
+			else MPI_Recv( recvbuf0, maxrecvsz, MPI_FLOAT,
 				MPI_ANY_SOURCE, MPI_ANY_TAG, grid->comm, &status );
 			// MPI_Irecv(recvbuf0,maxrecvsz,MPI_FLOAT,MPI_ANY_SOURCE,MPI_ANY_TAG,grid->comm,&req);
 			// ready=0;
@@ -1516,7 +1563,7 @@ if(procs==1){
 				{
 				lk = LBj( k, grid );    /* local block number */
 
-				if(LBtree_ptr[lk].destCnt_>0){
+				if(LBtree_ptr[lk].destCnt_>0 && !prog){
 
 					//BcTree_forwardMessageSimple(LBtree_ptr[lk],recvbuf0,BcTree_GetMsgSize(LBtree_ptr[lk],'s')*nrhs+XK_H,'s');
 					C_BcTree_forwardMessageSimple(&LBtree_ptr[lk], recvbuf0, LBtree_ptr[lk].msgSize_*nrhs+XK_H);
@@ -1680,6 +1727,7 @@ if(procs==1){
                     } /* while not finished ... */
        	    }
         } // end of parallel
+	commProgressStop(prog);
 
 #if ( PRNTlevel>=2 )
 	t = SuperLU_timer_() - t;
@@ -1721,7 +1769,7 @@ if(procs==1){
 	SUPERLU_FREE(leaf_send);
 	SUPERLU_FREE(leafsups);
 	SUPERLU_FREE(recvbuf_BC_fwd);
-	log_memory(-nlb*aln_i*iword-nlb*iword-(CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i*iword- nsupers_i*iword -maxrecvsz*(nfrecvx+1)*dword, stat);	//account for fmod, frecv, leaf_send, leafsups, recvbuf_BC_fwd
+	log_memory(-nlb*aln_i*iword-nlb*iword-(NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i*iword- nsupers_i*iword -maxrecvsz*(nfrecvx+1)*dword, stat);	//account for fmod, frecv, leaf_send, leafsups, recvbuf_BC_fwd
 
 	for (lk=0;lk<nsupers_j;++lk){
 		if(LBtree_ptr[lk].empty_==NO){
@@ -1740,6 +1788,10 @@ if(procs==1){
 		}
 	}
 	MPI_Barrier( grid->comm );
+	if ( getenv("SUPERLU_TREE_STATS") ) {
+		C_Tree_Stats("L-bcast", LBtree_ptr, nsupers_j, grid->comm);
+		C_Tree_Stats("L-reduce", LRtree_ptr, nsupers_i, grid->comm);
+	}
 
 #if ( VAMPIR>=1 )
 	VT_traceoff();
@@ -1805,8 +1857,8 @@ if(procs==1){
 #endif
 
 #if ( DEBUGlevel>=2 )
-        nub = CEILING( nsupers, Pc ); /* Number of local block columns. */
-        for (p = 0; p < Pr*Pc; ++p) {
+        nub = NLBj( nsupers, grid ); /* Number of local block columns. */
+        for (p = 0; p < grid->nprow * grid->npcol; ++p) {
 	    if (iam == p) {
 		printf("(%2d) .. Ublocks %d, nub %d\n",iam,Ublocks,nub); fflush(stdout);
 		for (lb = 0; lb < nub; ++lb) {
@@ -1825,12 +1877,12 @@ if(procs==1){
 	    }
 	    MPI_Barrier( grid->comm );
 	}
-	for (p = 0; p < Pr*Pc; ++p) {
+	for (p = 0; p < grid->nprow * grid->npcol; ++p) {
 		if ( iam == p ) {
 			printf("\n(%d) bsendx_plist[][]", iam);
 			for (lb = 0; lb < nub; ++lb) {
 				printf("\n(%d) .. local col %2d: ", iam, lb);
-				for (i = 0; i < Pr; ++i)
+				for (i = 0; i < grid->nprow; ++i)
 					printf("%4d", bsendx_plist[lb][i]);
 			}
 			printf("\n");
@@ -1842,7 +1894,7 @@ if(procs==1){
 	/* ---------------------------------------------------------
 	   Initialize the async Bcast trees on all processes.
 	   --------------------------------------------------------- */
-	nsupers_j = CEILING( nsupers, grid->npcol ); /* Number of local block columns */
+	nsupers_j = NLBj( nsupers, grid ); /* Number of local block columns */
 
 	nbtree = 0;
 	for (lk=0;lk<nsupers_j;++lk){
@@ -1856,7 +1908,7 @@ if(procs==1){
 	    }
 	}
 
-	nsupers_i = CEILING( nsupers, grid->nprow ); /* Number of local block rows */
+	nsupers_i = NLBi( nsupers, grid ); /* Number of local block rows */
 	if ( !(	rootsups = (int_t*)intCalloc_dist(nsupers_i)) )
 		ABORT("Calloc fails for rootsups.");
 
@@ -1871,7 +1923,7 @@ if(procs==1){
 			brecv[lk] = URtree_ptr[lk].destCnt_;
 			nbrecvmod += brecv[lk];
 		}else{
-			gb = myrow+lk*grid->nprow;  /* not sure */
+			gb = GBi( lk, grid );  /* not sure */
 			if(gb<nsupers){
 				kcol = PCOL( gb, grid );
 				if(mycol==kcol) { /* Diagonal process */
@@ -1908,6 +1960,17 @@ if(procs==1){
 	t = SuperLU_timer_();
 #endif
 
+	/* Hand the messages of the U-solve to the progress thread, if any. */
+	pfwd.tree = UBtree_ptr;
+	pfwd.grid = grid;
+	pfwd.buf = recvbuf_BC_fwd;
+	pfwd.maxrecvsz = maxrecvsz;
+	pfwd.nbuf = 0;
+	pfwd.nrhs = nrhs;
+	pfwd.tag = BC_U;
+	prog = commProgressStart("U-solve", grid->comm, nbrecvx+nbrecvmod, maxrecvsz,
+				 MPI_FLOAT, sSolveKeep, sSolveFwd, &pfwd);
+
 	/*
 	 * Solve the roots first by all the diagonal processes.
 	 */
@@ -2045,7 +2108,7 @@ if(procs==1){
 for (i=0;i<nroot_send;i++){
 	lk = root_send[(i)*aln_i];
 	if(lk>=0){ // this is a bcast forwarding
-		gb = mycol+lk*grid->npcol;  /* not sure */
+		gb = GBj( lk, grid );  /* not sure */
 		lib = LBi( gb, grid ); /* Local block number, row-wise. */
 		ii = X_BLK( lib );
 		//BcTree_forwardMessageSimple(UBtree_ptr[lk],&x[ii - XK_H],BcTree_GetMsgSize(UBtree_ptr[lk],'s')*nrhs+XK_H,'s');
@@ -2085,7 +2148,8 @@ for (i=0;i<nroot_send;i++){
 		recvbuf0 = &recvbuf_BC_fwd[nbrecvx_buf*maxrecvsz];
 
 		/* Receive a message. */
-		MPI_Recv( recvbuf0, maxrecvsz, MPI_FLOAT,
+		if ( prog ) recvbuf0 = commProgressRecv(prog, &status);
+		else MPI_Recv( recvbuf0, maxrecvsz, MPI_FLOAT,
 			MPI_ANY_SOURCE, MPI_ANY_TAG, grid->comm, &status );
 
 #if ( PROFlevel>=1 )
@@ -2104,7 +2168,7 @@ for (i=0;i<nroot_send;i++){
 		    // --nfrecvx;
 		    nbrecvx_buf++;
 		    lk = LBj( k, grid );    /* local block number */
-		    if(UBtree_ptr[lk].destCnt_>0){
+		    if(UBtree_ptr[lk].destCnt_>0 && !prog){
 
 			// BcTree_forwardMessageSimple(UBtree_ptr[lk],recvbuf0,BcTree_GetMsgSize(UBtree_ptr[lk],'d')*nrhs+XK_H,'d');
 			C_BcTree_forwardMessageSimple(&UBtree_ptr[lk], recvbuf0, UBtree_ptr[lk].msgSize_*nrhs+XK_H);
@@ -2233,6 +2297,7 @@ for (i=0;i<nroot_send;i++){
 		    } /* end if MPI_TAG==RD_U */
 		} /* while not finished ... */
 	} /* end parallel region */
+	commProgressStop(prog);
 
 #if ( PRNTlevel>=2 )
 	t = SuperLU_timer_() - t;
@@ -2318,7 +2383,7 @@ for (i=0;i<nroot_send;i++){
 	SUPERLU_FREE(rootsups);
 	SUPERLU_FREE(recvbuf_BC_fwd);
 
-	log_memory(-nlb*aln_i*iword-nlb*iword - nsupers_i*iword - (CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i*iword - maxrecvsz*(nbrecvx+1)*dword - sizelsum*num_thread * dword - (ldalsum * nrhs + nlb * XK_H) *dword - (sizertemp*num_thread + 1)*dword, stat);	//account for bmod, brecv, root_send, rootsups, recvbuf_BC_fwd,rtemp,lsum,x
+	log_memory(-nlb*aln_i*iword-nlb*iword - nsupers_i*iword - (NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i*iword - maxrecvsz*(nbrecvx+1)*dword - sizelsum*num_thread * dword - (ldalsum * nrhs + nlb * XK_H) *dword - (sizertemp*num_thread + 1)*dword, stat);	//account for bmod, brecv, root_send, rootsups, recvbuf_BC_fwd,rtemp,lsum,x
 
 	for (lk=0;lk<nsupers_j;++lk){
 		if(UBtree_ptr[lk].empty_==NO){
@@ -2336,6 +2401,10 @@ for (i=0;i<nroot_send;i++){
 		}
 	}
 	MPI_Barrier( grid->comm );
+	if ( getenv("SUPERLU_TREE_STATS") ) {
+		C_Tree_Stats("U-bcast", UBtree_ptr, nsupers_j, grid->comm);
+		C_Tree_Stats("U-reduce", URtree_ptr, nsupers_i, grid->comm);
+	}
 
 
 #if ( PROFlevel>=2 )
@@ -292,7 +292,7 @@ void slsum_bmod
 	i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 	i += UB_DESCRIPTOR;
 	il = LSUM_BLK( ik );
-	gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+	gik = GBi( ik, grid );/* Global block number, row-wise. */
 	iknsupc = SuperSize( gik );
 	ikfrow = FstBlockC( gik );
 	iklrow = FstBlockC( gik+1 );
@@ -1462,7 +1462,7 @@ void slsum_bmod_inv
 				i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 				i += UB_DESCRIPTOR;
 				il = LSUM_BLK( ik );
-				gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+				gik = GBi( ik, grid );/* Global block number, row-wise. */
 				iknsupc = SuperSize( gik );
 				ikfrow = FstBlockC( gik );
 				iklrow = FstBlockC( gik+1 );
@@ -1644,7 +1644,7 @@ void slsum_bmod_inv
 			i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 			i += UB_DESCRIPTOR;
 			il = LSUM_BLK( ik );
-			gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+			gik = GBi( ik, grid );/* Global block number, row-wise. */
 			iknsupc = SuperSize( gik );
 			ikfrow = FstBlockC( gik );
 			iklrow = FstBlockC( gik+1 );
@@ -1931,7 +1931,7 @@ void slsum_bmod_inv_master
 				i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 				i += UB_DESCRIPTOR;
 				il = LSUM_BLK( ik );
-				gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+				gik = GBi( ik, grid );/* Global block number, row-wise. */
 				iknsupc = SuperSize( gik );
 				ikfrow = FstBlockC( gik );
 				iklrow = FstBlockC( gik+1 );
@@ -1973,7 +1973,7 @@ void slsum_bmod_inv_master
 			i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 			i += UB_DESCRIPTOR;
 			il = LSUM_BLK( ik );
-			gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+			gik = GBi( ik, grid );/* Global block number, row-wise. */
 			iknsupc = SuperSize( gik );
 			ikfrow = FstBlockC( gik );
 			iklrow = FstBlockC( gik+1 );
@@ -2008,7 +2008,7 @@ void slsum_bmod_inv_master
 	for (ub = 0; ub < nub; ++ub){
 		ik = Ucb_indptr[lk][ub].lbnum; /* Local block number, row-wise. */
 		il = LSUM_BLK( ik );
-		gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+		gik = GBi( ik, grid );/* Global block number, row-wise. */
 		iknsupc = SuperSize( gik );
 
 	// #ifdef _OPENMP
@@ -291,6 +291,82 @@ int psCompRow_loc_to_CompCol_global
 } /* psCompRow_loc_to_CompCol_global */
 
 
+/*! \brief Predict nnz(L+U), flops, per-process memory and panel message
+ *  volume of the factorization of A for the candidate process grids,
+ *  without distributing or factoring A.
+ *
+ * <pre>
+ * The row permutation and the column ordering are computed as in
+ * psgssvx, then superlu_symbfact_predict() does the serial symbolic
+ * factorization and the cost model.  A is not modified.  The perm_r[]
+ * and perm_c[] of ScalePermstruct are read only when options->RowPerm
+ * is MY_PERMR or options->ColPerm is MY_PERMC.  Equilibration does not
+ * change the structure and is skipped; LargeDiag_HWPM is approximated
+ * by MC64, LargeDiag_LDM computes its matching from the local rows.
+ *
+ * All processes in grid must call this routine; on exit pred[] is the
+ * same on all of them.  Returns 0 on success, or the error of the
+ * symbolic factorization.
+ * </pre>
+ */
+int
+pssymbfact_predict(superlu_dist_options_t *options, SuperMatrix *A,
+                   sScalePermstruct_t *ScalePermstruct, gridinfo_t *grid,
+                   int ncand, superlu_predict_t *pred)
+{
+    SuperMatrix GA;
+    NCformat *GAstore;
+    int_t *perm_r, *perm_c, *rowind, i, m = A->nrow, n = A->ncol;
+    float *R1, *C1;
+    int need_value, iinfo = 0, info;
+
+    need_value = (options->RowPerm == LargeDiag_MC64
+                  || options->RowPerm == LargeDiag_HWPM);
+    psCompRow_loc_to_CompCol_global(need_value, A, grid, &GA);
+    GAstore = (NCformat *) GA.Store;
+    rowind = GAstore->rowind;
+
+    if ( !(perm_r = intMalloc_dist(m)) ) ABORT("Malloc fails for perm_r[].");
+    if ( !(perm_c = intMalloc_dist(n)) ) ABORT("Malloc fails for perm_c[].");
+
+    for (i = 0; i < m; ++i) perm_r[i] = i;
+    if ( options->RowPerm == MY_PERMR ) {
+        for (i = 0; i < m; ++i) perm_r[i] = ScalePermstruct->perm_r[i];
+    } else if ( options->RowPerm == LargeDiag_LDM ) {
+	if ( !(R1 = floatMalloc_dist(m)) ) ABORT("Malloc fails for R1[].");
+	if ( !(C1 = floatMalloc_dist(n)) ) ABORT("Malloc fails for C1[].");
+	iinfo = psldperm_dist(A, grid, GAstore->colptr, rowind, perm_r, R1, C1);
+	if ( iinfo ) for (i = 0; i < m; ++i) perm_r[i] = i;
+	SUPERLU_FREE(R1);
+	SUPERLU_FREE(C1);
+    } else if ( need_value ) {
+        if ( !grid->iam ) { /* Process 0 finds a row permutation */
+	    if ( !(R1 = floatMalloc_dist(m)) ) ABORT("Malloc fails for R1[].");
+	    if ( !(C1 = floatMalloc_dist(n)) ) ABORT("Malloc fails for C1[].");
+	    iinfo = sldperm_dist(5, m, GAstore->nnz, GAstore->colptr, rowind,
+	                         (float *) GAstore->nzval, perm_r, R1, C1);
+	    SUPERLU_FREE(R1);
+	    SUPERLU_FREE(C1);
+	}
+	MPI_Bcast( &iinfo, 1, MPI_INT, 0, grid->comm );
+	if ( iinfo == 0 ) MPI_Bcast( perm_r, m, mpi_int_t, 0, grid->comm );
+	else for (i = 0; i < m; ++i) perm_r[i] = i;
+    }
+    for (i = 0; i < GAstore->nnz; ++i) rowind[i] = perm_r[rowind[i]];
+
+    if ( options->ColPerm == MY_PERMC )
+        for (i = 0; i < n; ++i) perm_c[i] = ScalePermstruct->perm_c[i];
+
+    info = superlu_symbfact_predict(options, &GA, perm_c, sizeof(float),
+                                    grid, ncand, pred);
+
+    SUPERLU_FREE(perm_r);
+    SUPERLU_FREE(perm_c);
+    Destroy_CompCol_Matrix_dist(&GA);
+    return info;
+} /* pssymbfact_predict */
+
+
 /*! \brief Permute the distributed dense matrix: B <= perm(X). perm[i] = j means the i-th row of X is in the j-th row of B.
  */
 int psPermute_Dense_Matrix
@@ -416,6 +492,11 @@ void sLUstructInit(const int_t n, sLUstruct_t *LUstruct)
 	   SUPERLU_MALLOC(sizeof(sLocalLU_t))) )
 	ABORT("Malloc fails for LocalLU_t.");
 	LUstruct->Llu->inv = 0;
+	LUstruct->Llu->shmL = LUstruct->Llu->shmU = NULL;
+	LUstruct->Llu->segL = LUstruct->Llu->segU = NULL;
+	LUstruct->Llu->aggL = LUstruct->Llu->aggU = NULL;
+	LUstruct->Llu->rmaL = LUstruct->Llu->rmaU = NULL;
+	LUstruct->Llu->nodeCost = NULL;
 }
 
 /*! \brief Deallocate LUstruct */
@@ -429,6 +510,7 @@ void sLUstructFree(sLUstruct_t *LUstruct)
 
     SUPERLU_FREE(LUstruct->etree);
     SUPERLU_FREE(LUstruct->Glu_persist);
+    if ( LUstruct->Llu->nodeCost ) SUPERLU_FREE(LUstruct->Llu->nodeCost);
     SUPERLU_FREE(LUstruct->Llu);
 
 #if ( DEBUGlevel>=1 )
@@ -455,7 +537,7 @@ sDestroy_LU(int_t n, gridinfo_t *grid, sLUstruct_t *LUstruct)
     nsupers = Glu_persist->supno[n-1] + 1;
 
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->npcol);
+    // nb = NLBj( nsupers, grid );
     // for (i = 0; i < nb; ++i) 
     //	if ( Llu->Lrowind_bc_ptr[i] ) {
     //	    SUPERLU_FREE (Llu->Lrowind_bc_ptr[i]);
@@ -474,7 +556,7 @@ sDestroy_LU(int_t n, gridinfo_t *grid, sLUstruct_t *LUstruct)
     SUPERLU_FREE (Llu->Lnzval_bc_offset);
     
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->nprow);
+    // nb = NLBi( nsupers, grid );
     // for (i = 0; i < nb; ++i)
     //	if ( Llu->Ufstnz_br_ptr[i] ) {
     //	    SUPERLU_FREE (Llu->Ufstnz_br_ptr[i]);
@@ -504,7 +586,7 @@ sDestroy_LU(int_t n, gridinfo_t *grid, sLUstruct_t *LUstruct)
     SUPERLU_FREE(Llu->mod_bit);
 
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->npcol);
+    // nb = NLBj( nsupers, grid );
     // for (i = 0; i < nb; ++i) 
     //	if ( Llu->Lindval_loc_bc_ptr[i]!=NULL) {
     //	    SUPERLU_FREE (Llu->Lindval_loc_bc_ptr[i]);
@@ -514,7 +596,7 @@ sDestroy_LU(int_t n, gridinfo_t *grid, sLUstruct_t *LUstruct)
     SUPERLU_FREE(Llu->Lindval_loc_bc_offset);
 	
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->npcol);
+    // nb = NLBj( nsupers, grid );
     // for (i=0; i<nb; ++i) {
     //	if(Llu->Linv_bc_ptr[i]!=NULL) {
     //	    SUPERLU_FREE(Llu->Linv_bc_ptr[i]);
@@ -532,7 +614,7 @@ sDestroy_LU(int_t n, gridinfo_t *grid, sLUstruct_t *LUstruct)
     SUPERLU_FREE(Llu->Unnz);
 	
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->npcol);
+    // nb = NLBj( nsupers, grid );
     // for (i = 0; i < nb; ++i)
     //	if ( Llu->Urbs[i] ) {
     //	    SUPERLU_FREE(Llu->Ucb_indptr[i]);
@@ -548,6 +630,7 @@ sDestroy_LU(int_t n, gridinfo_t *grid, sLUstruct_t *LUstruct)
     
     SUPERLU_FREE(Glu_persist->xsup);
     SUPERLU_FREE(Glu_persist->supno);
+    superlu_smap_free(grid);
 
 #ifdef GPU_ACC
     checkGPU (gpuFree (Llu->d_xsup));
@@ -623,7 +706,7 @@ psgstrs_init(int_t n, int_t m_loc, int_t nrhs, int_t fst_row,
     int *sdispls, *sdispls_nrhs, *rdispls, *rdispls_nrhs;
     int *itemp, *ptr_to_ibuf, *ptr_to_dbuf;
     int_t *row_to_proc;
-    int_t i, gbi, k, l, num_diag_procs, *diag_procs;
+    int_t i, gbi, k, l;
     int_t irow, q, knsupc, nsupers, *xsup, *supno;
     int   iam, p, pkk, procs;
     pxgstrs_comm_t *gstrs_comm;
@@ -693,24 +776,19 @@ psgstrs_init(int_t n, int_t m_loc, int_t nrhs, int_t fst_row,
 
     /* Count the number of X entries to be sent to each process.*/
     for (p = 0; p < procs; ++p) SendCnt[p] = 0;
-    num_diag_procs = SOLVEstruct->num_diag_procs;
-    diag_procs = SOLVEstruct->diag_procs;
-
-    for (p = 0; p < num_diag_procs; ++p) { /* for all diagonal processes */
-	pkk = diag_procs[p];
+    for (k = 0; k < nsupers; ++k) { /* for my diagonal blocks */
+	pkk = PNUM( PROW(k,grid), PCOL(k,grid), grid );
 	if ( iam == pkk ) {
-	    for (k = p; k < nsupers; k += num_diag_procs) {
-		knsupc = SuperSize( k );
-		irow = FstBlockC( k );
-		for (i = 0; i < knsupc; ++i) {
+	    knsupc = SuperSize( k );
+	    irow = FstBlockC( k );
+	    for (i = 0; i < knsupc; ++i) {
 #if 0
-		    q = row_to_proc[inv_perm_c[irow]];
+		q = row_to_proc[inv_perm_c[irow]];
 #else
-		    q = row_to_proc[irow];
+		q = row_to_proc[irow];
 #endif
-		    ++SendCnt[q];
-		    ++irow;
-		}
+		++SendCnt[q];
+		++irow;
 	    }
 	}
     }
@@ -874,6 +952,8 @@ void sDestroy_A3d_gathered_on_2d(sSOLVEstruct_t *SOLVEstruct, gridinfo3d_t *grid
         SUPERLU_FREE(A3d->procs_recv_from_list);
         SUPERLU_FREE(A3d->recv_count_list);
     }
+    if ( A3d->trf3Dpart )        // 3D partition of the last factorization
+	sDestroy_trf3Dpartition(A3d->trf3Dpart, grid3d);
     SUPERLU_FREE( A2d );         // free 2D structure
     SUPERLU_FREE( A3d );         // free 3D structure
 } /* sDestroy_A3d_gathered_on_2d */
@@ -932,29 +1012,29 @@ sDestroy_Tree(int_t n, gridinfo_t *grid, sLUstruct_t *LUstruct)
 
     nsupers = Glu_persist->supno[n-1] + 1;
 
-    nb = CEILING(nsupers, grid->npcol);
+    nb = NLBj( nsupers, grid );
     for (i=0;i<nb;++i){
         if(Llu->LBtree_ptr[i].empty_==NO){    
 			// BcTree_Destroy(Llu->LBtree_ptr[i],LUstruct->dt);
-            C_BcTree_Nullify(&Llu->LBtree_ptr[i]);
+            C_BcTree_Destroy(&Llu->LBtree_ptr[i]);
 	}
         if(Llu->UBtree_ptr[i].empty_==NO){  
 			// BcTree_Destroy(Llu->UBtree_ptr[i],LUstruct->dt);
-            C_BcTree_Nullify(&Llu->UBtree_ptr[i]);
+            C_BcTree_Destroy(&Llu->UBtree_ptr[i]);
 	}
     }
     SUPERLU_FREE(Llu->LBtree_ptr);
     SUPERLU_FREE(Llu->UBtree_ptr);
 	
-    nb = CEILING(nsupers, grid->nprow);
+    nb = NLBi( nsupers, grid );
     for (i=0;i<nb;++i){
         if(Llu->LRtree_ptr[i].empty_==NO){             
 			// RdTree_Destroy(Llu->LRtree_ptr[i],LUstruct->dt);
-            C_RdTree_Nullify(&Llu->LRtree_ptr[i]);
+            C_RdTree_Destroy(&Llu->LRtree_ptr[i]);
 	}
         if(Llu->URtree_ptr[i].empty_==NO){ 
 			// RdTree_Destroy(Llu->URtree_ptr[i],LUstruct->dt);
-            C_RdTree_Nullify(&Llu->URtree_ptr[i]);
+            C_RdTree_Destroy(&Llu->URtree_ptr[i]);
 	}
     }
     SUPERLU_FREE(Llu->LRtree_ptr);
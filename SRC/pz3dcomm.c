@@ -200,6 +200,7 @@ int_t zzSendLPanel(int_t k, int_t receiver,
 		    int_t len   = lsub[1];       /* LDA of the nzval[] */
 		    int_t len2  = SuperSize(k) * len; /* size of nzval of L panel */
 		    
+		    commProfSend(COMM_Z, grid3d->zscp.comm, receiver, len2, SuperLU_MPI_DOUBLE_COMPLEX);
 		    MPI_Send(lnzval, len2, SuperLU_MPI_DOUBLE_COMPLEX, receiver, k, grid3d->zscp.comm);
 		    SCT->commVolRed += len2 * sizeof(doublecomplex);
 		}
@@ -274,6 +275,7 @@ int_t zzSendUPanel(int_t k, int_t receiver,
 		    int lenv = usub[1];
 		    
 		    /* code */
+		    commProfSend(COMM_Z, grid3d->zscp.comm, receiver, lenv, SuperLU_MPI_DOUBLE_COMPLEX);
 		    MPI_Send(unzval, lenv, SuperLU_MPI_DOUBLE_COMPLEX, receiver, k, grid3d->zscp.comm);
 		    SCT->commVolRed += lenv * sizeof(doublecomplex);
 		}
@@ -577,6 +579,7 @@ int_t zcollect3dLpanels(int_t layer, int_t nsupers, zLUstruct_t * LUstruct,
 			    
 	        if (grid3d->zscp.Iam == layer)
 		{
+		    commProfSend(COMM_Z, grid3d->zscp.comm, 0, len2, SuperLU_MPI_DOUBLE_COMPLEX);
 		    MPI_Send(lnzval, len2, SuperLU_MPI_DOUBLE_COMPLEX, 0, jb, grid3d->zscp.comm);
 		}
 		if (!grid3d->zscp.Iam)
@@ -611,6 +614,7 @@ int_t zcollect3dUpanels(int_t layer, int_t nsupers, zLUstruct_t * LUstruct,
 	    int lenv = usub[1];
 	    if (grid3d->zscp.Iam == layer)
 		{
+		    commProfSend(COMM_Z, grid3d->zscp.comm, 0, lenv, SuperLU_MPI_DOUBLE_COMPLEX);
 		    MPI_Send(uval, lenv, SuperLU_MPI_DOUBLE_COMPLEX, 0, lb, grid3d->zscp.comm);
 		}
 		    
@@ -666,7 +670,7 @@ int_t zzeroSetLU(int_t nnodes, int_t* nodeList, zLUstruct_t *LUstruct,
 		    lsub = Lrowind_bc_ptr[ljb];
 		    lnzval = Lnzval_bc_ptr[ljb];
 		    
-		    if (lsub != NULL)
+		    if (lsub != NULL && lnzval != NULL)
 			{
 			    int_t len   = lsub[1];       /* LDA of the nzval[] */
 			    int_t len2  = SuperSize(jb) * len;	/*size of nzval of L panel */
@@ -688,7 +692,7 @@ int_t zzeroSetLU(int_t nnodes, int_t* nodeList, zLUstruct_t *LUstruct,
 		    usub = Ufstnz_br_ptr[lib];
 		    unzval = Unzval_br_ptr[lib];
 		    
-		    if (usub != NULL)
+		    if (usub != NULL && unzval != NULL)
 			{
 			    int lenv = usub[1];
 			    memset( unzval, 0, lenv * sizeof(doublecomplex) );
@@ -699,6 +703,46 @@ int_t zzeroSetLU(int_t nnodes, int_t* nodeList, zLUstruct_t *LUstruct,
     return 0;
 }
 
+/* Whether SUPERLU_ANC_LAZY asks for the copies of the ancestors a layer
+   does not own to be allocated only where a Schur update touches them. */
+static int zancLazy(void)
+{
+#ifdef GPU_ACC
+    return 0;
+#else
+    char *ttemp = getenv("SUPERLU_ANC_LAZY");
+    return ttemp ? atoi(ttemp) : 0;
+#endif
+}
+
+/* Release the L and U values of the nodes instead of zeroing them; the
+   index arrays are kept.  See zancLazyAlloc(). */
+static void zlazySetLU(int_t nnodes, int_t* nodeList, zLUstruct_t *LUstruct,
+		       gridinfo3d_t* grid3d)
+{
+    zLocalLU_t *Llu = LUstruct->Llu;
+    gridinfo_t* grid = &(grid3d->grid2d);
+    int_t iam = grid->iam;
+
+    for (int_t node = 0; node < nnodes; ++node) {
+	int_t k = nodeList[node];
+	if ( MYCOL(iam, grid) == PCOL(k, grid) ) {
+	    int_t ljb = LBj(k, grid);
+	    if ( Llu->Lnzval_bc_ptr[ljb] ) {
+		SUPERLU_FREE(Llu->Lnzval_bc_ptr[ljb]);
+		Llu->Lnzval_bc_ptr[ljb] = NULL;
+	    }
+	}
+	if ( MYROW(iam, grid) == PROW(k, grid) ) {
+	    int_t lib = LBi(k, grid);
+	    if ( Llu->Unzval_br_ptr[lib] ) {
+		SUPERLU_FREE(Llu->Unzval_br_ptr[lib]);
+		Llu->Unzval_br_ptr[lib] = NULL;
+	    }
+	}
+    }
+}
+
 
 int_t zreduceAncestors3d(int_t sender, int_t receiver,
                         int_t nnodes, int_t* nodeList,
@@ -767,6 +811,7 @@ int_t zinit3DLUstruct( int_t* myTreeIdxs, int_t* myZeroTrIdxs,
 		      gridinfo3d_t* grid3d)
 {
     int_t maxLvl = log2i(grid3d->zscp.Np) + 1;
+    int lazy = zancLazy();
     
     for (int_t lvl = 0; lvl < maxLvl; lvl++)
 	{
@@ -774,7 +819,10 @@ int_t zinit3DLUstruct( int_t* myTreeIdxs, int_t* myZeroTrIdxs,
 		{
 		    /* code */
 		    int_t treeId = myTreeIdxs[lvl];
-		    zzeroSetLU(nodeCount[treeId], nodeList[treeId], LUstruct, grid3d);
+		    if ( lazy )
+			zlazySetLU(nodeCount[treeId], nodeList[treeId], LUstruct, grid3d);
+		    else
+			zzeroSetLU(nodeCount[treeId], nodeList[treeId], LUstruct, grid3d);
 		}
 	}
     
@@ -782,6 +830,630 @@ int_t zinit3DLUstruct( int_t* myTreeIdxs, int_t* myZeroTrIdxs,
 }
 
 
+/*
+ * Set up the nonblocking ancestor reduction if SUPERLU_ANC_ASYNC gives the
+ * number of pieces in flight; see zreduceAllAncestors3d().  Lazy ancestor
+ * storage needs it, with one piece in flight by default, and so does the
+ * hybrid partition (SUPERLU_LBS_HYBRID), whose idle layers then send
+ * nothing.  The GPU code keeps the blocking reduction.
+ */
+void zancReduceInit(int_t nsupers, zLUstruct_t *LUstruct)
+{
+    zLocalLU_t *Llu = LUstruct->Llu;
+    char *ttemp = getenv("SUPERLU_ANC_ASYNC");
+    int nslots = ttemp ? atoi(ttemp) : 0;
+    int lazy = zancLazy();
+    ancReduce_t *ar;
+
+    Llu->ancRed = NULL;
+#ifndef GPU_ACC
+    if ( (lazy || getenv("SUPERLU_LBS_HYBRID")) && nslots < 1 ) nslots = 1;
+    if ( nslots < 1 ) return;
+
+    if ( !(ar = SUPERLU_MALLOC(sizeof(ancReduce_t))) )
+	ABORT("Malloc fails for ancRed.");
+    int_t size = SUPERLU_MAX(Llu->bufmax[1], Llu->bufmax[3]);
+    ar->nslots = nslots;
+    ar->peer = -1;
+    ar->n = ar->nposted = ar->ndone = 0;
+    ar->node = intMalloc_dist(2 * nsupers);
+    ar->part = SUPERLU_MALLOC(2 * nsupers * sizeof(char));
+    ar->left = intCalloc_dist(nsupers);
+    ar->buf = SUPERLU_MALLOC(nslots * sizeof(void *));
+    for (int s = 0; s < nslots; ++s)
+	ar->buf[s] = doublecomplexMalloc_dist(size);
+    ar->req = SUPERLU_MALLOC(nslots * sizeof(MPI_Request));
+    ar->nsend = 0;
+    ar->sreq = SUPERLU_MALLOC(2 * nsupers * sizeof(MPI_Request));
+    ar->nskip = 0;
+    ar->lazy = lazy;
+    Llu->ancRed = ar;
+#endif
+}
+
+/* Where my piece 'L' or 'U' of supernode k is stored, and its length;
+   NULL if I have none.  The values are NULL if not allocated yet. */
+static doublecomplex **zancPiece(int_t k, char part, int *len,
+				 zLUstruct_t *LUstruct, gridinfo_t *grid)
+{
+    zLocalLU_t *Llu = LUstruct->Llu;
+    int_t *xsup = LUstruct->Glu_persist->xsup;
+    int_t iam = grid->iam;
+
+    if ( part == 'L' ) {
+	if ( MYCOL(iam, grid) != PCOL(k, grid) ) return NULL;
+	int_t *lsub = Llu->Lrowind_bc_ptr[LBj(k, grid)];
+	if ( !lsub ) return NULL;
+	*len = SuperSize(k) * lsub[1];
+	return &Llu->Lnzval_bc_ptr[LBj(k, grid)];
+    } else {
+	if ( MYROW(iam, grid) != PROW(k, grid) ) return NULL;
+	int_t *usub = Llu->Ufstnz_br_ptr[LBi(k, grid)];
+	if ( !usub ) return NULL;
+	*len = usub[1];
+	return &Llu->Unzval_br_ptr[LBi(k, grid)];
+    }
+}
+
+/* A layer's copy of an ancestor starts at zero or unallocated
+   (zinit3DLUstruct()), so such a piece received no update and need not
+   be sent. */
+static int zancTouched(int len, doublecomplex *val)
+{
+    if ( !val ) return 0;
+    for (int i = 0; i < len; ++i)
+	if ( val[i].r != 0.0 || val[i].i != 0.0 ) return 1;
+    return 0;
+}
+
+/* Keep nslots receives posted. */
+static void zancReducePost(ancReduce_t *ar, zLUstruct_t *LUstruct,
+			   gridinfo3d_t *grid3d)
+{
+    int len;
+    while ( ar->nposted < ar->n && ar->nposted < ar->ndone + ar->nslots ) {
+	int_t i = ar->nposted++;
+	zancPiece(ar->node[i], ar->part[i], &len, LUstruct, &grid3d->grid2d);
+	MPI_Irecv(ar->buf[i % ar->nslots], len, SuperLU_MPI_DOUBLE_COMPLEX,
+		  ar->peer, ar->node[i], grid3d->zscp.comm,
+		  &ar->req[i % ar->nslots]);
+    }
+}
+
+/* Add in the piece received in the oldest slot, and refill the slot. */
+static void zancReduceAdd(ancReduce_t *ar, zLUstruct_t *LUstruct,
+			  gridinfo3d_t *grid3d)
+{
+    int_t i = ar->ndone++;
+    int len;
+    doublecomplex **val = zancPiece(ar->node[i], ar->part[i], &len,
+				     LUstruct, &grid3d->grid2d);
+    doublecomplex one = {1.0, 0.0};
+    if ( *val ) {
+	superlu_zaxpy(len, one, ar->buf[i % ar->nslots], 1, *val, 1);
+    } else {
+	*val = doublecomplexMalloc_dist(len);
+	memcpy(*val, ar->buf[i % ar->nslots], len * sizeof(doublecomplex));
+    }
+    --ar->left[ar->node[i]];
+    zancReducePost(ar, LUstruct, grid3d);
+}
+
+/* Add in the pieces that have arrived, in order. */
+void zancReduceProgress(zLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
+{
+    ancReduce_t *ar = LUstruct->Llu->ancRed;
+    int flag;
+
+    if ( !ar ) return;
+    while ( ar->ndone < ar->nposted ) {
+	MPI_Test(&ar->req[ar->ndone % ar->nslots], &flag, MPI_STATUS_IGNORE);
+	if ( !flag ) break;
+	zancReduceAdd(ar, LUstruct, grid3d);
+    }
+}
+
+static void zancReduceDrain(ancReduce_t *ar, int_t k, zLUstruct_t *LUstruct,
+			    gridinfo3d_t *grid3d)
+{
+    while ( ar->ndone < ar->n && (k < 0 || ar->left[k]) ) {
+	MPI_Wait(&ar->req[ar->ndone % ar->nslots], MPI_STATUS_IGNORE);
+	zancReduceAdd(ar, LUstruct, grid3d);
+    }
+}
+
+/* Wait until the pieces of supernode k are added in; all if k < 0. */
+void zancReduceWait(int_t k, zLUstruct_t *LUstruct, gridinfo3d_t *grid3d,
+		    SCT_t *SCT)
+{
+    ancReduce_t *ar = LUstruct->Llu->ancRed;
+
+    if ( !ar || ar->ndone == ar->n || (k >= 0 && !ar->left[k]) ) return;
+    double t = SuperLU_timer_();
+    zancReduceDrain(ar, k, LUstruct, grid3d);
+    SCT->ancsReduce += SuperLU_timer_() - t;
+}
+
+void zancReduceFree(zLUstruct_t *LUstruct, gridinfo3d_t *grid3d, SCT_t *SCT)
+{
+    ancReduce_t *ar = LUstruct->Llu->ancRed;
+
+    if ( !ar ) return;
+    zancReduceWait(-1, LUstruct, grid3d, SCT);
+    MPI_Waitall(ar->nsend, ar->sreq, MPI_STATUSES_IGNORE);
+#if ( PRNTlevel>=1 )
+    int_t nskip;
+    MPI_Reduce(&ar->nskip, &nskip, 1, mpi_int_t, MPI_SUM, 0, grid3d->comm);
+    if ( !grid3d->iam )
+	printf(".. Ancestor reduction: " IFMT " untouched pieces not sent\n",
+	       nskip);
+#endif
+    for (int s = 0; s < ar->nslots; ++s) SUPERLU_FREE(ar->buf[s]);
+    SUPERLU_FREE(ar->buf);
+    SUPERLU_FREE(ar->req);
+    SUPERLU_FREE(ar->sreq);
+    SUPERLU_FREE(ar->node);
+    SUPERLU_FREE(ar->part);
+    SUPERLU_FREE(ar->left);
+    SUPERLU_FREE(ar);
+    LUstruct->Llu->ancRed = NULL;
+}
+
+/*
+ * With lazy ancestor storage, allocate zeroed the pieces the Schur update
+ * of the current supernode scatters into (zblock_gemm_scatter()): block
+ * (ib,jb) goes to the L panel of jb if ib >= jb, to the U row of ib if not.
+ */
+void zancLazyAlloc(HyP_t *HyP, zLUstruct_t *LUstruct, gridinfo_t *grid)
+{
+    ancReduce_t *ar = LUstruct->Llu->ancRed;
+    Remain_info_t *linfo[2] = {HyP->lookAhead_info, HyP->Remain_info};
+    int_t nl[2] = {HyP->lookAheadBlk, HyP->RemainBlk};
+    Ublock_info_t *uinfo[2] = {HyP->Ublock_info, HyP->Ublock_info_Phi};
+    int_t nu[2] = {HyP->num_u_blks, HyP->num_u_blks_Phi};
+    int_t maxib = -1, maxjb = -1;
+    int len;
+    doublecomplex **val;
+
+    if ( !ar || !ar->lazy ) return;
+    for (int s = 0; s < 2; ++s) {
+	for (int_t lb = 0; lb < nl[s]; ++lb)
+	    maxib = SUPERLU_MAX(maxib, linfo[s][lb].ib);
+	for (int_t j = 0; j < nu[s]; ++j)
+	    maxjb = SUPERLU_MAX(maxjb, uinfo[s][j].jb);
+    }
+    for (int s = 0; s < 2; ++s) {
+	for (int_t lb = 0; lb < nl[s]; ++lb) {
+	    int_t ib = linfo[s][lb].ib;
+	    if ( ib < maxjb && (val = zancPiece(ib, 'U', &len, LUstruct, grid))
+		 && !*val )
+		*val = doublecomplexCalloc_dist(len);
+	}
+	for (int_t j = 0; j < nu[s]; ++j) {
+	    int_t jb = uinfo[s][j].jb;
+	    if ( jb <= maxib && (val = zancPiece(jb, 'L', &len, LUstruct, grid))
+		 && !*val )
+		*val = doublecomplexCalloc_dist(len);
+	}
+    }
+}
+
+/* Give back the value storage that lazy ancestor storage released, except
+   to the ancestor copies this layer starts from zero if still lazy. */
+static void zrestoreLU(int_t nsupers, ztrf3Dpartition_t *trf3Dpartition,
+		       zLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
+{
+    gridinfo_t *grid = &(grid3d->grid2d);
+    sForest_t **sForests = trf3Dpartition->sForests;
+    int_t *myTreeIdxs = trf3Dpartition->myTreeIdxs;
+    int_t *myZeroTrIdxs = trf3Dpartition->myZeroTrIdxs;
+    int_t maxLvl = log2i(grid3d->zscp.Np) + 1;
+    int lazy = zancLazy();
+    char part[2] = {'L', 'U'};
+    int len;
+    doublecomplex **val;
+
+    char *zero = SUPERLU_MALLOC(nsupers * sizeof(char));
+    memset(zero, 0, nsupers * sizeof(char));
+    for (int_t lvl = 0; lvl < maxLvl; ++lvl) {
+	sForest_t *sf = sForests[myTreeIdxs[lvl]];
+	if ( myZeroTrIdxs[lvl] && sf )
+	    for (int_t nd = 0; nd < sf->nNodes; ++nd)
+		zero[sf->nodeList[nd]] = 1;
+    }
+    for (int_t k = 0; k < nsupers; ++k)
+	for (int p = 0; p < 2; ++p)
+	    if ( !(lazy && zero[k])
+		 && (val = zancPiece(k, part[p], &len, LUstruct, grid))
+		 && !*val )
+		*val = doublecomplexCalloc_dist(len);
+    SUPERLU_FREE(zero);
+}
+
+/*
+ * Value-only form of zp3dScatter() for a SamePattern_SameRowPerm
+ * factorization, when the other layers still hold the LU structure of the
+ * previous one: layer 0 sends each layer the values of the forests that
+ * layer owns, i.e. the ones it factors starting from A.  The copies of
+ * the ancestors are set by zinit3DLUstruct(); storage that lazy ancestor
+ * storage released is given back to the other supernodes.
+ */
+int_t zp3dScatterValues(int_t nsupers, ztrf3Dpartition_t *trf3Dpartition,
+			zLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
+{
+    gridinfo_t *grid = &(grid3d->grid2d);
+    sForest_t **sForests = trf3Dpartition->sForests;
+    int_t *myTreeIdxs = trf3Dpartition->myTreeIdxs;
+    int_t *myZeroTrIdxs = trf3Dpartition->myZeroTrIdxs;
+    int_t Np = grid3d->zscp.Np, myGrid = grid3d->zscp.Iam;
+    int_t maxLvl = log2i(Np) + 1;
+    char part[2] = {'L', 'U'};
+    int len;
+    doublecomplex **val;
+
+    zrestoreLU(nsupers, trf3Dpartition, LUstruct, grid3d);
+
+    if ( myGrid == 0 ) {
+	MPI_Request *req = SUPERLU_MALLOC(2 * nsupers * sizeof(MPI_Request));
+	int nreq = 0;
+	for (int_t z = 1; z < Np; ++z)
+	    for (int_t lvl = 0; lvl < maxLvl && z % (1 << lvl) == 0; ++lvl) {
+		/* the level-lvl tree on the path of layer z */
+		sForest_t *sf = sForests[(1 << (maxLvl - 1 - lvl)) - 1 + (z >> lvl)];
+		if ( !sf ) continue;
+		for (int_t nd = 0; nd < sf->nNodes; ++nd) {
+		    int_t k = sf->nodeList[nd];
+		    for (int p = 0; p < 2; ++p)
+			if ( (val = zancPiece(k, part[p], &len, LUstruct, grid)) ) {
+			    commProfSend(COMM_Z, grid3d->zscp.comm, z, len, SuperLU_MPI_DOUBLE_COMPLEX);
+			    MPI_Isend(*val, len, SuperLU_MPI_DOUBLE_COMPLEX, z, k,
+				      grid3d->zscp.comm, &req[nreq++]);
+			}
+		}
+	    }
+	MPI_Waitall(nreq, req, MPI_STATUSES_IGNORE);
+	SUPERLU_FREE(req);
+    } else {
+	for (int_t lvl = 0; lvl < maxLvl; ++lvl) {
+	    sForest_t *sf = sForests[myTreeIdxs[lvl]];
+	    if ( myZeroTrIdxs[lvl] || !sf ) continue;
+	    for (int_t nd = 0; nd < sf->nNodes; ++nd) {
+		int_t k = sf->nodeList[nd];
+		for (int p = 0; p < 2; ++p)
+		    if ( (val = zancPiece(k, part[p], &len, LUstruct, grid)) )
+			MPI_Recv(*val, len, SuperLU_MPI_DOUBLE_COMPLEX, 0, k,
+				 grid3d->zscp.comm, MPI_STATUS_IGNORE);
+	    }
+	}
+    }
+    return 0;
+} /* zp3dScatterValues */
+
+/*
+ * Distribute A straight into the L and U storage of all the layers
+ * (SUPERLU_A3D_DIRECT), instead of gathering it on layer 0 with
+ * zGatherNRformat_loc3d() and going through pzdistribute().  This is for
+ * a SamePattern_SameRowPerm factorization, when the other layers still
+ * hold the LU structure: every process scales and permutes its own rows of
+ * A, and a single all-to-all over the 3D grid sends each entry to the
+ * process of the layer that owns its supernode.  The input A is not
+ * modified.  On return, anorm is the norm of the scaled A used by
+ * pzgstrf3d().
+ */
+int_t zp3dDistributeA(superlu_dist_options_t *options, int_t n,
+		      NRformat_loc *Astore, zScalePermstruct_t *ScalePermstruct,
+		      double *anorm, ztrf3Dpartition_t *trf3Dpartition,
+		      zLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
+{
+    gridinfo_t *grid = &(grid3d->grid2d);
+    zLocalLU_t *Llu = LUstruct->Llu;
+    int_t *xsup = LUstruct->Glu_persist->xsup;
+    int_t *supno = LUstruct->Glu_persist->supno;
+    int_t nsupers = supno[n-1] + 1;
+    int_t iam = grid->iam;
+    int_t myrow = MYROW(iam, grid), mycol = MYCOL(iam, grid);
+    int_t myGrid = grid3d->zscp.Iam;
+    int_t maxLvl = log2i(grid3d->zscp.Np) + 1;
+    int_t nfirst = (1 << (maxLvl - 1)) - 1; /* heap index of layer 0's leaf */
+    int procs2d = grid->nprow * grid->npcol, procs;
+    int_t nbc = CEILING(nsupers, grid->npcol);
+    int_t nbr = CEILING(nsupers, grid->nprow);
+    int_t *perm_r, *perm_c, i, j, k;
+    double *R = NULL, *C = NULL;
+    char part[2] = {'L', 'U'};
+    int len;
+    doublecomplex **val;
+
+    MPI_Comm_size(grid3d->comm, &procs);
+
+    /* The permutations and the scalings are on layer 0. */
+    int diag = ScalePermstruct->DiagScale;
+    MPI_Bcast(&diag, 1, MPI_INT, 0, grid3d->zscp.comm);
+    int rowequ = options->Equil == YES && (diag == ROW || diag == BOTH);
+    int colequ = options->Equil == YES && (diag == COL || diag == BOTH);
+    if ( myGrid == 0 ) {
+	perm_r = ScalePermstruct->perm_r;
+	perm_c = ScalePermstruct->perm_c;
+	if ( rowequ ) R = ScalePermstruct->R;
+	if ( colequ ) C = ScalePermstruct->C;
+    } else {
+	perm_r = intMalloc_dist(n);
+	perm_c = intMalloc_dist(n);
+	if ( rowequ ) R = doubleMalloc_dist(n);
+	if ( colequ ) C = doubleMalloc_dist(n);
+    }
+    MPI_Bcast(perm_r, n, mpi_int_t, 0, grid3d->zscp.comm);
+    MPI_Bcast(perm_c, n, mpi_int_t, 0, grid3d->zscp.comm);
+    if ( rowequ ) MPI_Bcast(R, n, MPI_DOUBLE, 0, grid3d->zscp.comm);
+    if ( colequ ) MPI_Bcast(C, n, MPI_DOUBLE, 0, grid3d->zscp.comm);
+
+    /* Row i of my A is row fst_row + i of the A gathered on layer 0 by
+       zGatherNRformat_loc3d(), which stacks the rows of the layers, and
+       which perm_r and R refer to. */
+    int_t fst_row, m_loc = Astore->m_loc, zoff = 0;
+    MPI_Exscan(&m_loc, &zoff, 1, mpi_int_t, MPI_SUM, grid3d->zscp.comm);
+    if ( myGrid == 0 ) zoff = 0;
+    if ( grid3d->rankorder == 1 ) { /* XY-major */
+	fst_row = Astore->fst_row;
+	MPI_Bcast(&fst_row, 1, mpi_int_t, 0, grid3d->zscp.comm);
+    } else { /* Z-major */
+	int_t m_loc_2d;
+	MPI_Allreduce(&m_loc, &m_loc_2d, 1, mpi_int_t, MPI_SUM, grid3d->zscp.comm);
+	fst_row = 0;
+	MPI_Exscan(&m_loc_2d, &fst_row, 1, mpi_int_t, MPI_SUM, grid->comm);
+	if ( iam == 0 ) fst_row = 0;
+    }
+    fst_row += zoff;
+
+    /* The layer that factors supernode k from A is the leftmost one
+       below its forest. */
+    int *zOwner = SUPERLU_MALLOC(nsupers * sizeof(int));
+    for (k = 0; k < nsupers; ++k) {
+	int_t tr = trf3Dpartition->supernode2treeMap[k];
+	while ( tr < nfirst ) tr = 2 * tr + 1;
+	zOwner[k] = tr - nfirst;
+    }
+
+    /* 3D rank of the process (layer z, 2D rank p) */
+    int *rank3d = SUPERLU_MALLOC(2 * procs * sizeof(int));
+    int *who = rank3d + procs;
+    int me = myGrid * procs2d + iam;
+    MPI_Allgather(&me, 1, MPI_INT, who, 1, MPI_INT, grid3d->comm);
+    for (int p = 0; p < procs; ++p) rank3d[who[p]] = p;
+
+    /* Count, and the norm: '1' sums the columns, 'I' the rows. */
+    int notran = (options->Trans == NOTRANS);
+    double *asum = doubleCalloc_dist(notran ? n : Astore->m_loc);
+    int *cnt = SUPERLU_MALLOC(8 * procs * sizeof(int));
+    int *sendcnt = cnt, *recvcnt = cnt + procs;
+    int *sdispl = cnt + 2 * procs, *rdispl = cnt + 3 * procs;
+    for (int p = 0; p < 2 * procs; ++p) sendcnt[p] = 0;
+    for (i = 0; i < Astore->m_loc; ++i) {
+	int_t irow = fst_row + i;
+	for (j = Astore->rowptr[i]; j < Astore->rowptr[i+1]; ++j) {
+	    int_t jcol = Astore->colind[j];
+	    int_t gb = supno[perm_c[perm_r[irow]]], jb = supno[perm_c[jcol]];
+	    doublecomplex a = ((doublecomplex *) Astore->nzval)[j];
+	    if ( rowequ ) zd_mult(&a, &a, R[irow]);
+	    if ( colequ ) zd_mult(&a, &a, C[jcol]);
+	    asum[notran ? jcol : i] += slud_z_abs(&a);
+	    ++sendcnt[rank3d[zOwner[SUPERLU_MIN(gb, jb)] * procs2d
+			     + PNUM(PROW(gb, grid), PCOL(jb, grid), grid)]];
+	}
+    }
+    if ( notran ) {
+	MPI_Allreduce(MPI_IN_PLACE, asum, n, MPI_DOUBLE, MPI_SUM, grid3d->comm);
+	for (*anorm = 0.0, j = 0; j < n; ++j) *anorm = SUPERLU_MAX(*anorm, asum[j]);
+    } else {
+	for (*anorm = 0.0, i = 0; i < Astore->m_loc; ++i)
+	    *anorm = SUPERLU_MAX(*anorm, asum[i]);
+	MPI_Allreduce(MPI_IN_PLACE, anorm, 1, MPI_DOUBLE, MPI_MAX, grid3d->comm);
+    }
+    SUPERLU_FREE(asum);
+
+    MPI_Alltoall(sendcnt, 1, MPI_INT, recvcnt, 1, MPI_INT, grid3d->comm);
+    int nsend = 0, nrecv = 0;
+    for (int p = 0; p < procs; ++p) {
+	sdispl[p] = nsend;
+	rdispl[p] = nrecv;
+	nsend += sendcnt[p];
+	nrecv += recvcnt[p];
+    }
+
+    /* Pack (row, column) of Pc*Pr*diag(R)*A*diag(C)*Pc' and the values. */
+    int_t *ij_send = intMalloc_dist(2 * SUPERLU_MAX(nsend, 1));
+    doublecomplex *a_send = doublecomplexMalloc_dist(SUPERLU_MAX(nsend, 1));
+    int *next = cnt + 4 * procs;
+    for (int p = 0; p < procs; ++p) next[p] = sdispl[p];
+    for (i = 0; i < Astore->m_loc; ++i) {
+	int_t irow = fst_row + i;
+	for (j = Astore->rowptr[i]; j < Astore->rowptr[i+1]; ++j) {
+	    int_t jcol = Astore->colind[j];
+	    int_t pi = perm_c[perm_r[irow]], pj = perm_c[jcol];
+	    int_t gb = supno[pi], jb = supno[pj];
+	    doublecomplex a = ((doublecomplex *) Astore->nzval)[j];
+	    if ( rowequ ) zd_mult(&a, &a, R[irow]);
+	    if ( colequ ) zd_mult(&a, &a, C[jcol]);
+	    int q = next[rank3d[zOwner[SUPERLU_MIN(gb, jb)] * procs2d
+				+ PNUM(PROW(gb, grid), PCOL(jb, grid), grid)]]++;
+	    ij_send[2 * q] = pi;
+	    ij_send[2 * q + 1] = pj;
+	    a_send[q] = a;
+	}
+    }
+
+    int_t *ij_recv = intMalloc_dist(2 * SUPERLU_MAX(nrecv, 1));
+    doublecomplex *a_recv = doublecomplexMalloc_dist(SUPERLU_MAX(nrecv, 1));
+    MPI_Alltoallv(a_send, sendcnt, sdispl, SuperLU_MPI_DOUBLE_COMPLEX,
+		  a_recv, recvcnt, rdispl, SuperLU_MPI_DOUBLE_COMPLEX, grid3d->comm);
+    for (int p = 0; p < procs; ++p) {
+	sendcnt[p] *= 2; sdispl[p] *= 2;
+	recvcnt[p] *= 2; rdispl[p] *= 2;
+    }
+    MPI_Alltoallv(ij_send, sendcnt, sdispl, mpi_int_t,
+		  ij_recv, recvcnt, rdispl, mpi_int_t, grid3d->comm);
+    SUPERLU_FREE(ij_send);
+    SUPERLU_FREE(a_send);
+    SUPERLU_FREE(cnt);
+    SUPERLU_FREE(rank3d);
+
+    /* Start the supernodes I factor from zero; the other copies are set
+       by zresetTrf3Dpartition(). */
+    zrestoreLU(nsupers, trf3Dpartition, LUstruct, grid3d);
+    for (k = 0; k < nsupers; ++k)
+	if ( zOwner[k] == myGrid )
+	    for (int p = 0; p < 2; ++p)
+		if ( (val = zancPiece(k, part[p], &len, LUstruct, grid)) )
+		    memset(*val, 0, len * sizeof(doublecomplex));
+    SUPERLU_FREE(zOwner);
+
+    /* Sort the entries by local L block column, then U block row. */
+    int_t *ptr = intCalloc_dist(nbc + nbr + 1);
+    int_t *ord = intMalloc_dist(SUPERLU_MAX(nrecv, 1));
+    for (int e = 0; e < nrecv; ++e) {
+	int_t gb = supno[ij_recv[2 * e]], jb = supno[ij_recv[2 * e + 1]];
+	++ptr[(gb >= jb ? LBj(jb, grid) : nbc + LBi(gb, grid)) + 1];
+    }
+    for (k = 0; k < nbc + nbr; ++k) ptr[k + 1] += ptr[k];
+    for (int e = 0; e < nrecv; ++e) {
+	int_t gb = supno[ij_recv[2 * e]], jb = supno[ij_recv[2 * e + 1]];
+	ord[ptr[gb >= jb ? LBj(jb, grid) : nbc + LBi(gb, grid)]++] = e;
+    }
+    for (k = nbc + nbr; k > 0; --k) ptr[k] = ptr[k - 1];
+    ptr[0] = 0;
+
+    /* pos[] gives, per block, the offset of a row of an L panel, or of a
+       column of a U block row less its first nonzero row. */
+    int_t *pos = intMalloc_dist(n);
+    for (int_t lk = 0; lk < nbc; ++lk) {
+	if ( ptr[lk] == ptr[lk + 1] ) continue;
+	int_t jb = lk * grid->npcol + mycol;
+	int_t *index = Llu->Lrowind_bc_ptr[lk];
+	doublecomplex *lusup = Llu->Lnzval_bc_ptr[lk];
+	int_t ld = index[1], next_lind = BC_HEADER, r = 0;
+	for (int_t b = 0; b < index[0]; ++b) {
+	    int_t len1 = index[next_lind + 1];
+	    next_lind += LB_DESCRIPTOR;
+	    for (i = 0; i < len1; ++i) pos[index[next_lind++]] = r++;
+	}
+	for (int_t e = ptr[lk]; e < ptr[lk + 1]; ++e) {
+	    int_t q = ord[e];
+	    lusup[pos[ij_recv[2 * q]] + (ij_recv[2 * q + 1] - FstBlockC(jb)) * ld]
+		= a_recv[q];
+	}
+    }
+    for (int_t lk = 0; lk < nbr; ++lk) {
+	if ( ptr[nbc + lk] == ptr[nbc + lk + 1] ) continue;
+	int_t gb = lk * grid->nprow + myrow;
+	int_t *index = Llu->Ufstnz_br_ptr[lk];
+	doublecomplex *uval = Llu->Unzval_br_ptr[lk];
+	int_t fsupc1 = FstBlockC(gb + 1), iu = BR_HEADER, off = 0;
+	for (int_t b = 0; b < index[0]; ++b) {
+	    int_t jb = index[iu];
+	    iu += UB_DESCRIPTOR;
+	    for (j = 0; j < SuperSize(jb); ++j) {
+		int_t fstnz = index[iu++];
+		pos[FstBlockC(jb) + j] = off - fstnz;
+		off += fsupc1 - fstnz;
+	    }
+	}
+	for (int_t e = ptr[nbc + lk]; e < ptr[nbc + lk + 1]; ++e) {
+	    int_t q = ord[e];
+	    uval[pos[ij_recv[2 * q + 1]] + ij_recv[2 * q]] = a_recv[q];
+	}
+    }
+
+    SUPERLU_FREE(pos);
+    SUPERLU_FREE(ptr);
+    SUPERLU_FREE(ord);
+    SUPERLU_FREE(ij_recv);
+    SUPERLU_FREE(a_recv);
+    if ( myGrid != 0 ) {
+	SUPERLU_FREE(perm_r);
+	SUPERLU_FREE(perm_c);
+	if ( rowequ ) SUPERLU_FREE(R);
+	if ( colequ ) SUPERLU_FREE(C);
+    }
+    return 0;
+} /* zp3dDistributeA */
+
+/*
+ * Nonblocking form of the ancestor loop of zreduceAllAncestors3d().  The
+ * sender tells which pieces it updated, then sends them without waiting.
+ * The receiver only posts the receives; zancReduceWait() adds a piece in
+ * before its supernode is factored, so the next level starts at once.
+ */
+static void zancReduceStart(int_t sender, int_t receiver, int_t ilvl,
+			    int_t *myNodeCount, int_t **treePerm,
+			    zLUstruct_t *LUstruct, gridinfo3d_t *grid3d,
+			    SCT_t *SCT)
+{
+    ancReduce_t *ar = LUstruct->Llu->ancRed;
+    gridinfo_t *grid = &(grid3d->grid2d);
+    int_t maxLvl = log2i(grid3d->zscp.Np) + 1;
+    int_t nanc = 0, i = 0;
+    int len;
+    doublecomplex **val;
+
+    /* What I received at the previous level goes up with my own pieces. */
+    zancReduceDrain(ar, -1, LUstruct, grid3d);
+    ar->n = ar->nposted = ar->ndone = 0;
+
+    for (int_t alvl = ilvl + 1; alvl < maxLvl; ++alvl)
+	nanc += myNodeCount[alvl];
+    char *touched = SUPERLU_MALLOC((nanc + 1) * sizeof(char));
+
+    if ( grid3d->zscp.Iam == sender ) {
+	for (int_t alvl = ilvl + 1; alvl < maxLvl; ++alvl)
+	    for (int_t node = 0; node < myNodeCount[alvl]; ++node, ++i) {
+		int_t k = treePerm[alvl][node];
+		touched[i] = 0;
+		if ( (val = zancPiece(k, 'L', &len, LUstruct, grid)) ) {
+		    if ( zancTouched(len, *val) ) touched[i] |= 1;
+		    else ++ar->nskip;
+		}
+		if ( (val = zancPiece(k, 'U', &len, LUstruct, grid)) ) {
+		    if ( zancTouched(len, *val) ) touched[i] |= 2;
+		    else ++ar->nskip;
+		}
+	    }
+	/* before any piece: the tag of supernode 0 is also 0 */
+	commProfSend(COMM_Z, grid3d->zscp.comm, receiver, nanc, MPI_CHAR);
+	MPI_Send(touched, nanc, MPI_CHAR, receiver, 0, grid3d->zscp.comm);
+
+	i = 0;
+	for (int_t alvl = ilvl + 1; alvl < maxLvl; ++alvl)
+	    for (int_t node = 0; node < myNodeCount[alvl]; ++node, ++i) {
+		int_t k = treePerm[alvl][node];
+		for (int p = 0; p < 2; ++p) {
+		    if ( !(touched[i] & (1 << p)) ) continue;
+		    val = zancPiece(k, p ? 'U' : 'L', &len, LUstruct, grid);
+		    commProfSend(COMM_Z, grid3d->zscp.comm, receiver, len,
+				 SuperLU_MPI_DOUBLE_COMPLEX);
+		    MPI_Isend(*val, len, SuperLU_MPI_DOUBLE_COMPLEX, receiver, k,
+			      grid3d->zscp.comm, &ar->sreq[ar->nsend++]);
+		    SCT->commVolRed += len * sizeof(doublecomplex);
+		}
+	    }
+    } else {
+	MPI_Recv(touched, nanc, MPI_CHAR, sender, 0, grid3d->zscp.comm,
+		 MPI_STATUS_IGNORE);
+	for (int_t alvl = ilvl + 1; alvl < maxLvl; ++alvl)
+	    for (int_t node = 0; node < myNodeCount[alvl]; ++node, ++i) {
+		int_t k = treePerm[alvl][node];
+		for (int p = 0; p < 2; ++p) {
+		    if ( !(touched[i] & (1 << p)) ) continue;
+		    ar->node[ar->n] = k;
+		    ar->part[ar->n++] = p ? 'U' : 'L';
+		    ++ar->left[k];
+		}
+	    }
+	ar->peer = sender;
+	zancReducePost(ar, LUstruct, grid3d);
+    }
+    SUPERLU_FREE(touched);
+}
+
 int zreduceAllAncestors3d(int_t ilvl, int_t* myNodeCount, int_t** treePerm,
                              zLUValSubBuf_t* LUvsb, zLUstruct_t* LUstruct,
                              gridinfo3d_t* grid3d, SCT_t* SCT )
@@ -802,6 +1474,16 @@ int zreduceAllAncestors3d(int_t ilvl, int_t* myNodeCount, int_t** treePerm,
 	    sender = myGrid;
 	    receiver = myGrid - (1 << ilvl);
 	}
+    /* the last layers may have no partner when Np is not a power of two */
+    if ( sender >= grid3d->zscp.Np ) return 0;
+
+    if ( LUstruct->Llu->ancRed ) {
+	double treduce = SuperLU_timer_();
+	zancReduceStart(sender, receiver, ilvl, myNodeCount, treePerm,
+			LUstruct, grid3d, SCT);
+	SCT->ancsReduce += SuperLU_timer_() - treduce;
+	return 0;
+    }
     
     /*Reduce all the ancestors*/
     for (int_t alvl = ilvl + 1; alvl < maxLvl; ++alvl)
@@ -846,6 +1528,7 @@ int_t zgatherAllFactoredLU( ztrf3Dpartition_t*  trf3Dpartition,
 			    sender = myGrid;
 			    receiver = myGrid - (1 << ilvl);
 			}
+		    if ( sender >= grid3d->zscp.Np ) continue;
 		    
 		    for (int_t alvl = 0; alvl <= ilvl; alvl++)
 			{
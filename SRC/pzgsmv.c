@@ -179,6 +179,7 @@ void pzgsmv_init
     for (p = 0; p < procs; ++p) {
         ptr_ind_tosend[p] -= SendCounts[p]; /* Reset pointer to beginning */
         if ( SendCounts[p] ) {
+	    commProfSend(COMM_SPMV, grid->comm, p, SendCounts[p], mpi_int_t);
 	    MPI_Isend(&ind_tosend[ptr_ind_tosend[p]], SendCounts[p],
 		      mpi_int_t, p, iam, grid->comm, &send_req[p]);
 	}
@@ -301,6 +302,7 @@ pzgsmv
     recv_req = send_req + procs;
     for (p = 0; p < procs; ++p) {
         if ( RecvCounts[p] ) {
+	    commProfSend(COMM_SPMV, grid->comm, p, RecvCounts[p], SuperLU_MPI_DOUBLE_COMPLEX);
 	    MPI_Isend(&val_tosend[ptr_ind_torecv[p]], RecvCounts[p],
                       SuperLU_MPI_DOUBLE_COMPLEX, p, iam,
                       grid->comm, &send_req[p]);
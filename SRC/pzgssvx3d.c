@@ -210,6 +210,15 @@ at the top-level directory.
  *                            L and U (the actual numerical values of L and U
  *                            stored in LUstruct->Llu are ignored)
  *
+ *      If the process layers other than 0 keep their copy of LUstruct
+ *      (no zDeAllocLlu_3d() / zDeAllocGlu_3d() in between), the 3D
+ *      partition of the previous factorization is reused as well, and only
+ *      the numerical values are sent to those layers. If in addition
+ *      SUPERLU_A3D_DIRECT is set and options->IterRefine = NOREFINE, A is
+ *      not gathered on layer 0: each process sends its rows of A directly
+ *      to the L and U storage of all the layers (zp3dDistributeA()). The
+ *      copy of A kept on layer 0 for iterative refinement is then stale.
+ *
  *      The outputs returned include
  *
  *        o  A, the input matrix A overwritten by the scaled and permuted
@@ -320,6 +329,10 @@ at the top-level directory.
  *                        matching to permute rows of the original matrix
  *                        to make the diagonal large relative to the
  *                        off-diagonal.
+ *           = LargeDiag_LDM: use a parallel locally dominant matching on
+ *                        the distributed matrix, with equilibration, to
+ *                        make the diagonal large relative to the
+ *                        off-diagonal; the values of A are not gathered.
  *           = MY_PERMR:  use the ordering given in ScalePermstruct->perm_r
  *                        input by the user.
  *
@@ -328,6 +341,10 @@ at the top-level directory.
  *           = NATURAL:       natural ordering.
  *           = MMD_AT_PLUS_A: minimum degree ordering on structure of A'+A.
  *           = MMD_ATA:       minimum degree ordering on structure of A'*A.
+ *           = AMD_AT_PLUS_A: approximate minimum degree ordering on A'+A.
+ *           = ND_AT_PLUS_A:  nested dissection ordering on A'+A.
+ *           = BEST_ORDERING: the cheapest of several orderings computed
+ *                            on different processes (see sp_ienv(12)).
  *           = MY_PERMC:      the ordering given in ScalePermstruct->perm_c.
  *
  *         o ReplaceTinyPivot (yes_no_t)
@@ -525,7 +542,7 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
     yes_no_t parSymbFact = options->ParSymbFact;
     fact_t Fact;
     doublecomplex *a;
-    int_t *colptr, *rowind;
+    int_t *colptr = NULL, *rowind = NULL;
     int_t *perm_r;              /* row permutations from partial pivoting */
     int_t *perm_c;              /* column permutation vector */
     int_t *etree;               /* elimination tree */
@@ -559,9 +576,9 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
     Fact = options->Fact;
     if (Fact < 0 || Fact > FACTORED)
 	*info = -1;
-    else if (options->RowPerm < 0 || options->RowPerm > MY_PERMR)
+    else if (options->RowPerm < 0 || options->RowPerm > LargeDiag_LDM)
 	*info = -1;
-    else if (options->ColPerm < 0 || options->ColPerm > MY_PERMC)
+    else if (options->ColPerm < 0 || options->ColPerm > ND_AT_PLUS_A)
 	*info = -1;
     else if (options->IterRefine < 0 || options->IterRefine > SLU_EXTRA)
 	*info = -1;
@@ -598,11 +615,26 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
     NRformat_loc *Astore3d = (NRformat_loc *)A->Store;
     NRformat_loc3d *A3d = SOLVEstruct->A3d;
 
+    /* With the same structure and row permutation, the other layers may
+       still hold the LU structure and the 3D partition of the previous
+       factorization; then only the values are sent. With SUPERLU_A3D_DIRECT
+       and no iterative refinement, A is not even gathered on layer 0: its
+       values go straight from every layer to the L and U storage. */
+    int reuse = 0, direct = 0;
+    if ( Fact == SamePattern_SameRowPerm && A3d->trf3Dpart ) {
+	reuse = grid3d->zscp.Iam == 0 ||
+	    (LUstruct->Llu->Lrowind_bc_ptr && LUstruct->Glu_persist->xsup);
+	MPI_Allreduce( MPI_IN_PLACE, &reuse, 1, MPI_INT, MPI_MIN, grid3d->comm );
+	char *ttemp = getenv("SUPERLU_A3D_DIRECT");
+	direct = reuse && ttemp && atoi(ttemp)
+	    && options->IterRefine == NOREFINE;
+    }
+
     /* B3d is aliased to B;
        B2d is allocated; 
        B is then aliased to B2d for the following 2D solve;
     */
-    zGatherNRformat_loc3d(Fact, (NRformat_loc *)A->Store,
+    zGatherNRformat_loc3d(direct ? FACTORED : Fact, (NRformat_loc *)A->Store,
 			  B, ldb, nrhs, grid3d, &A3d);
     
     B = (doublecomplex *) A3d->B2d; /* B is now pointing to B2d, 
@@ -711,7 +743,7 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 	/* ------------------------------------------------------------
 	   Diagonal scaling to equilibrate the matrix.
 	   ------------------------------------------------------------ */
-	if ( Equil ) {
+	if ( Equil && !direct ) {
 #if ( DEBUGlevel>=1 )
 	    CHECK_MALLOC (iam, "Enter equil");
 #endif
@@ -802,9 +834,11 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 	     * global A in compressed column format.
 	     * Numerical values are gathered only when a row permutation
 	     * for large diagonal is sought after.
+	     * With ParSymbFact, only MC64 needs A gathered; otherwise
+	     * colptr and rowind stay NULL.
 	     */
 	    if (Fact != SamePattern_SameRowPerm &&
-		(parSymbFact == NO || options->RowPerm != NO)) {
+		(parSymbFact == NO || options->RowPerm == LargeDiag_MC64)) {
 		    
 		need_value = (options->RowPerm == LargeDiag_MC64);
 		
@@ -834,11 +868,12 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 		    if (options->RowPerm == MY_PERMR) {
 			/* Use user's perm_r. */
 			/* Permute the global matrix GA for symbfact() */
-			for (i = 0; i < colptr[n]; ++i) {
+			for (i = 0; colptr && i < colptr[n]; ++i) {
 			    irow = rowind[i];
 			    rowind[i] = perm_r[irow];
 			}
-		    } else if ( options->RowPerm == LargeDiag_MC64 ) {
+		    } else if ( options->RowPerm == LargeDiag_MC64
+		               || options->RowPerm == LargeDiag_LDM ) {
 			/* Get a new perm_r[] */
 			if (job == 5) {
 			    /* Allocate storage for scaling factors. */
@@ -848,7 +883,9 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 				ABORT ("SUPERLU_MALLOC fails for C1[]");
 			}
 			
-			if ( iam==0 ) {
+			if ( options->RowPerm == LargeDiag_LDM ) {
+			    iinfo = pzldperm_dist(A, grid, colptr, rowind, perm_r, R1, C1);
+			} else if ( iam==0 ) {
 			    /* Process 0 finds a row permutation */
 			    iinfo = zldperm_dist (job, m, nnz, colptr, rowind, a_GA,
 						  perm_r, R1, C1);
@@ -928,7 +965,7 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 				}  /* end if Equil */
 
 				/* Now permute global A to prepare for symbfact() */
-				for (j = 0; j < n; ++j) {
+				for (j = 0; colptr && j < n; ++j) {
 				    for (i = colptr[j]; i < colptr[j + 1]; ++i) {
 					irow = rowind[i];
 					rowind[i] = perm_r[irow];
@@ -937,7 +974,7 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 				SUPERLU_FREE (R1);
 				SUPERLU_FREE (C1);
 			    } else { /* job = 2,3,4 */
-				for (j = 0; j < n; ++j)  {
+				for (j = 0; colptr && j < n; ++j)  {
 				    for (i = colptr[j]; i < colptr[j + 1]; ++i)
 				    {
 					irow = rowind[i];
@@ -989,7 +1026,7 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 #endif
 	} /* end if (!factored) */
 
-	if ( !factored || options->IterRefine ) {
+	if ( (!factored || options->IterRefine) && !direct ) {
 	    /* Compute norm(A), which will be used to adjust small diagonal. */
 	    if (notran)
 		*(unsigned char *) norm = '1';
@@ -1007,7 +1044,7 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 	/* ------------------------------------------------------------
 	   Perform ordering and symbolic factorization
 	   ------------------------------------------------------------ */
-	if ( !factored ) {
+	if ( !factored && !direct ) {
 	    t = SuperLU_timer_ ();
 	    /*
 	     * Get column permutation vector perm_c[], according to permc_spec:
@@ -1017,6 +1054,9 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 	     *   permc_spec = METIS_AT_PLUS_A: METIS on structure of A'+A
 	     *   permc_spec = PARMETIS: parallel METIS on structure of A'+A
 	     *   permc_spec = MY_PERMC: the ordering already supplied in perm_c[]
+	     * With ParSymbFact = YES, ND_AT_PLUS_A is a distributed nested
+	     * dissection (get_perm_c_dnd), which also stands in for PARMETIS
+	     * when ParMETIS is not available.
 	     */
 	    permc_spec = options->ColPerm;
 
@@ -1049,7 +1089,7 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 		    }
 		    sizes[2 * noDomains - 2] = m;
 		    fstVtxSep[2 * noDomains - 2] = 0;
-		} else if (permc_spec != PARMETIS) {
+		} else if (permc_spec != PARMETIS && permc_spec != ND_AT_PLUS_A) {
 		    /* same as before */
 		    printf("{%4d,%4d}: pzgssvx3d: invalid ColPerm option when ParSymbfact is used\n",
 			 (int) MYROW(grid->iam, grid), (int) MYCOL(grid->iam, grid));
@@ -1057,17 +1097,31 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 	    } /* end ... use parmetis */
 
 	    if (permc_spec != MY_PERMC && Fact == DOFACT) {
-		if (permc_spec == PARMETIS) {
+		if (permc_spec == PARMETIS ||
+		    (parSymbFact == YES && permc_spec == ND_AT_PLUS_A)) {
 	        /* Get column permutation vector in perm_c.                   *
 		 * This routine takes as input the distributed input matrix A *
 		 * and does not modify it.  It also allocates memory for      *
 		 * sizes[] and fstVtxSep[] arrays, that contain information   *
 		 * on the separator tree computed by ParMETIS.                */
-		    flinfo = get_perm_c_parmetis (A, perm_r, perm_c, nprocs_num,
-						  noDomains, &sizes, &fstVtxSep,
-						  grid, &symb_comm);
+#ifdef HAVE_PARMETIS
+		    if (permc_spec == PARMETIS)
+			flinfo = get_perm_c_parmetis (A, perm_r, perm_c, nprocs_num,
+						      noDomains, &sizes, &fstVtxSep,
+						      grid, &symb_comm);
+		    else
+#endif
+		    /* Distributed nested dissection, no global A is formed. */
+		    flinfo = get_perm_c_dnd (A, perm_r, perm_c, nprocs_num,
+					     noDomains, &sizes, &fstVtxSep,
+					     grid, &symb_comm);
 		    if (flinfo > 0)
 			ABORT ("ERROR in get perm_c parmetis.");
+		} else if (parSymbFact == YES && permc_spec == NATURAL) {
+		    /* NATURAL: perm_c[] and the trivial tree are set above. */
+		} else if (permc_spec == BEST_ORDERING) {
+		    get_perm_c_race_dist (options, &GA,
+					  perm_c, grid);
 		} else {
 		    get_perm_c_dist (iam, permc_spec, &GA, perm_c);
 		}
@@ -1111,8 +1165,8 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 			  SUPERLU_MALLOC (sizeof (Glu_freeable_t))))
 			ABORT ("Malloc fails for Glu_freeable.");
 
-		    /* Every process does this. */
-		    iinfo = symbfact (options, iam, &GAC, perm_c, etree,
+		    /* Every process does this, or one per node (sp_ienv(13)). */
+		    iinfo = symbfact_shared (options, grid, &GAC, perm_c, etree,
 				      Glu_persist, Glu_freeable);
 
 		    stat->utime[SYMBFAC] = SuperLU_timer_ () - t;
@@ -1160,7 +1214,7 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 		}
 
 		/* Destroy GA */
-		if (parSymbFact == NO || options->RowPerm != NO)
+		if (parSymbFact == NO || options->RowPerm == LargeDiag_MC64)
 		    Destroy_CompCol_Matrix_dist (&GA);
 		if (parSymbFact == NO)
 		    Destroy_CompCol_Permuted_dist (&GAC);
@@ -1225,11 +1279,32 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 	MPI_Bcast( &n, 1, mpi_int_t, 0,  grid3d->zscp.comm);
 	MPI_Bcast( &anorm, 1, MPI_DOUBLE, 0,  grid3d->zscp.comm);
 	
-	/* send the LU structure to all the grids */
-	zp3dScatter(n, LUstruct, grid3d);
+	trf3Dpartition = A3d->trf3Dpart;
+	int_t nsupers;
+	if ( reuse ) {
+	    nsupers = getNsupers(n, LUstruct->Glu_persist);
+	    if ( LUstruct->Llu->nodeCost && getenv("SUPERLU_LBS_COST") ) { /* re-balance */
+		zDestroy_trf3Dpartition(trf3Dpartition, grid3d);
+		trf3Dpartition = zinitTrf3Dpartition(nsupers, options, LUstruct, grid3d);
+	    } else
+		zresetTrf3Dpartition(nsupers, trf3Dpartition, LUstruct, grid3d);
+	    if ( direct ) {
+		t = SuperLU_timer_ ();
+		zp3dDistributeA(options, n, Astore3d, ScalePermstruct, &anorm,
+				trf3Dpartition, LUstruct, grid3d);
+		stat->utime[DIST] = SuperLU_timer_ () - t;
+	    } else
+		zp3dScatterValues(nsupers, trf3Dpartition, LUstruct, grid3d);
+	} else {
+	    if ( trf3Dpartition ) zDestroy_trf3Dpartition(trf3Dpartition, grid3d);
+
+	    /* send the LU structure to all the grids */
+	    zp3dScatter(n, LUstruct, grid3d);
 
-	int_t nsupers = getNsupers(n, LUstruct->Glu_persist);
-	trf3Dpartition = zinitTrf3Dpartition(nsupers, options, LUstruct, grid3d);
+	    nsupers = getNsupers(n, LUstruct->Glu_persist);
+	    trf3Dpartition = zinitTrf3Dpartition(nsupers, options, LUstruct, grid3d);
+	}
+	A3d->trf3Dpart = trf3Dpartition; /* freed by zDestroy_A3d_gathered_on_2d() */
 
 	SCT_t *SCT = (SCT_t *) SUPERLU_MALLOC(sizeof(SCT_t));
 	SCT_init(SCT);
@@ -1272,7 +1347,6 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
 	/*reduces stat from all the layers*/
 #endif
 
-        zDestroy_trf3Dpartition(trf3Dpartition, grid3d);
 	SCT_free(SCT);
 
     } /* end if not Factored ... factor on all process layers */
@@ -1623,6 +1697,8 @@ pzgssvx3d (superlu_dist_options_t * options, SuperMatrix * A,
     B = A3d->B3d; // B is now assigned back to B3d on return
     A->Store = Astore3d; // restore Astore to 3D
     
+    commProfDump(grid3d->comm, "pzgssvx3d");
+
 #if ( DEBUGlevel>=1 )
 	CHECK_MALLOC (iam, "Exit pzgssvx3d()");
 #endif
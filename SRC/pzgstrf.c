@@ -574,8 +574,8 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
 #endif
 
     nblocks = 0;
-    ncb = nsupers / Pc; /* number of column blocks, horizontal */
-    nrb = nsupers / Pr; /* number of row blocks, vertical  */
+    ncb = MyNLBj( nsupers, grid ); /* number of column blocks, horizontal */
+    nrb = MyNLBi( nsupers, grid ); /* number of row blocks, vertical  */
 
     /* in order to have dynamic scheduling */
     int *full_u_cols;
@@ -630,7 +630,7 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
     /* Sherry: omp parallel?
        not worth doing, due to concurrent write to look_ahead_l[jb] */
     for (lb = 0; lb < nrb; ++lb) { /* go through U-factor */
-        ib = lb * Pr + myrow;
+        ib = GBi( lb, grid );
         index = Llu->Ufstnz_br_ptr[lb];
         if (index) { /* Not an empty row */
             k = BR_HEADER;
@@ -643,26 +643,12 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
             }
         }
     }
-    if (myrow < nsupers % grid->nprow) { /* leftover block rows */
-        ib = nrb * Pr + myrow;
-        index = Llu->Ufstnz_br_ptr[nrb];
-        if (index) {             /* Not an empty row */
-            k = BR_HEADER;
-            for (j = 0; j < index[0]; ++j) {
-                jb = index[k];
-                if (jb != ib)
-                    look_ahead_l[jb] =
-                        SUPERLU_MAX (iperm_c_supno[ib], look_ahead_l[jb]);
-                k += UB_DESCRIPTOR + SuperSize (index[k]);
-            }
-        }
-    }
 
     if (options->SymPattern == NO) {
 	/* Sherry: omp parallel?
 	   not worth doing, due to concurrent write to look_ahead_l[jb] */
         for (lb = 0; lb < ncb; lb++) { /* go through L-factor */
-            ib = lb * Pc + mycol;
+            ib = GBj( lb, grid );
             index = Llu->Lrowind_bc_ptr[lb];
             if (index) {
                 k = BC_HEADER;
@@ -675,20 +661,6 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
                 }
             }
         }
-        if (mycol < nsupers % grid->npcol) { /* leftover block columns */
-            ib = ncb * Pc + mycol;
-            index = Llu->Lrowind_bc_ptr[ncb];
-            if (index) {
-                k = BC_HEADER;
-                for (j = 0; j < index[0]; j++) {
-                    jb = index[k];
-                    if (jb != ib)
-                        look_ahead_l[jb] =
-                            SUPERLU_MAX (iperm_c_supno[ib], look_ahead_l[jb]);
-                    k += LB_DESCRIPTOR + index[k + 1];
-                }
-            }
-        }
     }
     MPI_Allreduce (look_ahead_l, look_ahead, nsupers, MPI_INT, MPI_MAX, grid->comm);
     SUPERLU_FREE (look_ahead_l);
@@ -734,7 +706,7 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
     ToSendR = Llu->ToSendR;
 
     ldt = sp_ienv_dist (3, options); /* Size of maximum supernode */
-    k = CEILING (nsupers, Pr);       /* Number of local block rows */
+    k = NLBi( nsupers, grid );       /* Number of local block rows */
 
     /* Following code is for finding maximum row dimension of all L panels */
     int local_max_row_size = 0;
@@ -745,9 +717,7 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
 #pragma omp parallel for reduction(max :local_max_row_size) private(lk,lsub)
 #endif
 #endif
-    for (i = mycol; i < nsupers; i += Pc) { /* grab my local columns */
-        //int tpc = PCOL (i, grid);
-	lk = LBj (i, grid);
+    for (lk = 0; lk < ncb; ++lk) { /* grab my local columns */
 	lsub = Lrowind_bc_ptr[lk];
 	if (lsub != NULL) {
 	    if (lsub[1] > local_max_row_size) local_max_row_size = lsub[1];
@@ -944,8 +914,8 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
     lookAhead_lptr     = intMalloc_dist( (num_look_aheads+1) );
     lookAhead_ib       = intMalloc_dist( (num_look_aheads+1) );
 
-    int_t mrb = (nsupers + Pr - 1) / Pr;
-    int_t mcb = (nsupers + Pc - 1) / Pc;
+    int_t mrb = NLBi( nsupers, grid );
+    int_t mcb = NLBj( nsupers, grid );
 
     RemainStRow     = intMalloc_dist(mrb);
 #if 0
@@ -992,6 +962,9 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
     InitTimer = SuperLU_timer_() - tt1;
 
     double pxgstrfTimer = SuperLU_timer_();
+    MPI_Comm probe[2] = {grid->rscp.comm, grid->cscp.comm};
+    commProgress_t *prog = commProgressPoll("factorization", grid->comm,
+					    2, probe);
 
     /* ##################################################################
        ** Handle first block column separately to start the pipeline. **
@@ -1035,9 +1008,11 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
                 TIC (t1);
 #endif
 
+                commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
                 MPI_Isend (lsub, msgcnt[0], mpi_int_t, pj,
                            SLU_MPI_TAG (0, 0) /* 0 */,
                            scp->comm, &send_req[pj]);
+                commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX);
                 MPI_Isend (lusup, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX, pj,
                            SLU_MPI_TAG (1, 0) /* 1 */,
                            scp->comm, &send_req[pj + Pc]);
@@ -1160,9 +1135,11 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
 #if ( PROFlevel>=1 )
 			    TIC (t1);
 #endif
+                            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
                             MPI_Isend (lsub1, msgcnt[0], mpi_int_t, pj,
                                        SLU_MPI_TAG (0, kk0),  /* (4*kk0)%tag_ub */
                                        scp->comm, &send_req[pj]);
+                            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX);
                             MPI_Isend (lusup1, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX, pj,
                                        SLU_MPI_TAG (1, kk0),  /* (4*kk0+1)%tag_ub */
                                        scp->comm, &send_req[pj + Pc]);
@@ -1326,9 +1303,11 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
                                     TIC (t1);
 #endif
 
+                                    commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[2], mpi_int_t);
                                     MPI_Isend (usub, msgcnt[2], mpi_int_t, pi,
                                                SLU_MPI_TAG (2, kk0), /* (4*kk0+2)%tag_ub */
                                                scp->comm, &send_reqs_u[look_id][pi]);
+                                    commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[3], SuperLU_MPI_DOUBLE_COMPLEX);
                                     MPI_Isend (uval, msgcnt[3], SuperLU_MPI_DOUBLE_COMPLEX,
                                                pi, SLU_MPI_TAG (3, kk0), /* (4*kk0+3)%tag_ub */
                                                scp->comm, &send_reqs_u[look_id][pi + Pr]);
@@ -1488,9 +1467,11 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
 #if ( PROFlevel>=1 )
                             TIC (t1);
 #endif
+                            commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[2], mpi_int_t);
                             MPI_Send (usub, msgcnt[2], mpi_int_t, pi,
                                       SLU_MPI_TAG (2, k0), /* (4*k0+2)%tag_ub */
                                       scp->comm);
+                            commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[3], SuperLU_MPI_DOUBLE_COMPLEX);
                             MPI_Send (uval, msgcnt[3], SuperLU_MPI_DOUBLE_COMPLEX, pi,
                                       SLU_MPI_TAG (3, k0), /* (4*k0+3)%tag_ub */
                                       scp->comm);
@@ -1708,9 +1689,11 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
 #if ( PROFlevel>=1 )
 			       TIC (t1);
 #endif
+                                commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
                                 MPI_Isend (lsub1, msgcnt[0], mpi_int_t, pj,
                                            SLU_MPI_TAG (0, kk0), /* (4*kk0)%tag_ub */
                                            scp->comm, &send_req[pj]);
+                                commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX);
                                 MPI_Isend (lusup1, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX, pj,
                                            SLU_MPI_TAG (1, kk0), /* (4*kk0+1)%tag_ub */
                                            scp->comm, &send_req[pj + Pc]);
@@ -1759,6 +1742,7 @@ pzgstrf(superlu_dist_options_t * options, int m, int n, double anorm,
        ################################################################## */
 
     pxgstrfTimer = SuperLU_timer_() - pxgstrfTimer;
+    commProgressStop(prog);
 
 #if ( PRNTlevel>=1 )
     /* Print detailed statistics */
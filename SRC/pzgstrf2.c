@@ -282,6 +282,7 @@ pzgstrf2_trsm
                 if (pr != krow) {
                     /* tag = ((k0<<2)+2) % tag_ub;        */
                     /* tag = (4*(nsupers+k0)+2) % tag_ub; */
+                    commProfSend(COMM_DIAG, comm, pr, nsupc * nsupc, SuperLU_MPI_DOUBLE_COMPLEX);
                     MPI_Isend (ublk_ptr, nsupc * nsupc, SuperLU_MPI_DOUBLE_COMPLEX, pr,
                                SLU_MPI_TAG (4, k0) /* tag */ ,
                                comm, U_diag_blk_send_req + pr);
@@ -877,7 +878,7 @@ void pzgstrs2_omp
 		} /* end task */
 		rukp += segsize;
 #ifndef USE_Ublock_info
-		stat->ops[FACT] += segsize * (segsize + 1);
+		stat->ops[FACT] += 4 * segsize * (segsize + 1);
 #endif
 	    } /* end if segsize > 0 */
 	} /* end for j in parallel ... */
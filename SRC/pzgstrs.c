@@ -307,6 +307,7 @@ pzReDistribute_B_to_X(doublecomplex *B, int_t m_loc, int nrhs, int_t ldb,
 		if(ppr<0)ppr+=procs;
 
 		if(SendCnt[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt[pps], mpi_int_t);
 			MPI_Isend(&send_ibuf[sdispls[pps]], SendCnt[pps], mpi_int_t, pps, 0, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -333,6 +334,7 @@ pzReDistribute_B_to_X(doublecomplex *B, int_t m_loc, int nrhs, int_t ldb,
 		if(ppr>=procs)ppr-=procs;
 		if(ppr<0)ppr+=procs;
 		if(SendCnt_nrhs[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt_nrhs[pps], SuperLU_MPI_DOUBLE_COMPLEX);
 			MPI_Isend(&send_dbuf[sdispls_nrhs[pps]], SendCnt_nrhs[pps], SuperLU_MPI_DOUBLE_COMPLEX, pps, 1, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -425,7 +427,6 @@ pzReDistribute_X_to_B(int_t n, doublecomplex *B, int_t m_loc, int_t ldb, int_t f
     int_t  *row_to_proc = SOLVEstruct->row_to_proc; /* row-process mapping */
     pxgstrs_comm_t *gstrs_comm = SOLVEstruct->gstrs_comm;
     int  iam, p, q, pkk, procs;
-    int_t  num_diag_procs, *diag_procs;
 	MPI_Request req_i, req_d, *req_send, *req_recv;
 	MPI_Status status, *status_send, *status_recv;
 	int Nreq_recv, Nreq_send, pp,pps,ppr;
@@ -503,12 +504,9 @@ pzReDistribute_X_to_B(int_t n, doublecomplex *B, int_t m_loc, int_t ldb, int_t f
 			ptr_to_ibuf[p] = sdispls[p];
 			ptr_to_dbuf[p] = sdispls_nrhs[p];
 		}
-		num_diag_procs = SOLVEstruct->num_diag_procs;
-		diag_procs = SOLVEstruct->diag_procs;
- 		for (p = 0; p < num_diag_procs; ++p) {  /* For all diagonal processes. */
-		pkk = diag_procs[p];
+		for (k = 0; k < nsupers; ++k) { /* For my diagonal blocks. */
+		pkk = PNUM( PROW(k,grid), PCOL(k,grid), grid );
 		if ( iam == pkk ) {
-			for (k = p; k < nsupers; k += num_diag_procs) {
 			knsupc = SuperSize( k );
 			lk = LBi( k, grid ); /* Local block number */
 			irow = FstBlockC( k );
@@ -530,7 +528,6 @@ pzReDistribute_X_to_B(int_t n, doublecomplex *B, int_t m_loc, int_t ldb, int_t f
 				ptr_to_dbuf[q] += nrhs;
 				++irow;
 			}
-			}
 		}
 		}
 
@@ -566,6 +563,7 @@ pzReDistribute_X_to_B(int_t n, doublecomplex *B, int_t m_loc, int_t ldb, int_t f
 		if(ppr>=procs)ppr-=procs;
 		if(ppr<0)ppr+=procs;
 		if(SendCnt[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt[pps], mpi_int_t);
 			MPI_Isend(&send_ibuf[sdispls[pps]], SendCnt[pps], mpi_int_t, pps, 0, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -592,6 +590,7 @@ pzReDistribute_X_to_B(int_t n, doublecomplex *B, int_t m_loc, int_t ldb, int_t f
 		if(ppr>=procs)ppr-=procs;
 		if(ppr<0)ppr+=procs;
 		if(SendCnt_nrhs[pps]>0){
+			commProfSend(COMM_REDIST, grid->comm, pps, SendCnt_nrhs[pps], SuperLU_MPI_DOUBLE_COMPLEX);
 			MPI_Isend(&send_dbuf[sdispls_nrhs[pps]], SendCnt_nrhs[pps], SuperLU_MPI_DOUBLE_COMPLEX, pps, 1, grid->comm,
 			&req_send[Nreq_send] );
 			Nreq_send++;
@@ -704,7 +703,7 @@ pzCompute_Diag_Inv(int_t n, zLUstruct_t *LUstruct,gridinfo_t *grid,
     Linv_bc_ptr = Llu->Linv_bc_ptr;
     Uinv_bc_ptr = Llu->Uinv_bc_ptr;
     Lnzval_bc_ptr = Llu->Lnzval_bc_ptr;
-    nlb = CEILING( nsupers, Pr ); /* Number of local block rows. */
+    nlb = NLBi( nsupers, grid ); /* Number of local block rows. */
 
     Llu->inv = 1;
 
@@ -767,6 +766,42 @@ pzCompute_Diag_Inv(int_t n, zLUstruct_t *LUstruct,gridinfo_t *grid,
 }
 
 
+/*
+ * The broadcast messages of a triangular solve, as seen by the progress
+ * thread (SUPERLU_PROGRESS_THREAD): it receives them into recvbuf_BC_fwd[]
+ * and forwards them down their trees on arrival.
+ */
+typedef struct
+{
+    C_Tree     *tree;
+    gridinfo_t *grid;
+    doublecomplex *buf;
+    int        maxrecvsz, nbuf, nrhs, tag;
+} zSolveFwd_t;
+
+static void *zSolveKeep(void *arg, MPI_Status *status)
+{
+    zSolveFwd_t *f = (zSolveFwd_t *) arg;
+
+    if ( status->MPI_TAG != f->tag ) return NULL;
+    return &f->buf[(f->nbuf++) * f->maxrecvsz];
+}
+
+static int zSolveFwd(void *arg, void *buf, MPI_Status *status)
+{
+    zSolveFwd_t *f = (zSolveFwd_t *) arg;
+    gridinfo_t *grid = f->grid;
+    int_t k, lk;
+
+    if ( status->MPI_TAG != f->tag ) return 0;
+    k = ((doublecomplex *) buf)->r;
+    lk = LBj( k, grid );
+    if ( f->tree[lk].destCnt_ <= 0 ) return 0;
+    C_BcTree_forwardMessageSimple(&f->tree[lk], buf,
+				  f->tree[lk].msgSize_*f->nrhs+XK_H);
+    return 1;
+}
+
 /*! \brief
  *
  * <pre>
@@ -885,7 +920,7 @@ pzgstrs(superlu_dist_options_t *options, int_t n,
     int_t  nb, nlb,nlb_nodiag, nub, nsupers, nsupers_j, nsupers_i,maxsuper;
     int_t  *xsup, *supno, *lsub, *usub;
     int_t  *ilsum;    /* Starting position of each supernode in lsum (LOCAL)*/
-    int    Pc, Pr, iam;
+    int    iam;
     int    knsupc, nsupr, nprobe;
     int    nbtree, nrtree, outcount;
     int    ldalsum;   /* Number of lsum entries locally owned. */
@@ -908,6 +943,8 @@ pzgstrs(superlu_dist_options_t *options, int_t n,
     int  **fsendx_plist = Llu->fsendx_plist;
     int  nfrecvx = Llu->nfrecvx; /* Number of X components to be recv'd. */
     int  nfrecvx_buf=0;
+    commProgress_t *prog; /* progress thread of the L- or U-solve */
+    zSolveFwd_t pfwd;
     int  *frecv;        /* Count of lsum[lk] contributions to be received
     			     from processes in this row.
     			     It is only valid on the diagonal processes. */
@@ -1010,8 +1047,6 @@ pzgstrs(superlu_dist_options_t *options, int_t n,
      * Initialization.
      */
     iam = grid->iam;
-    Pc = grid->npcol;
-    Pr = grid->nprow;
     myrow = MYROW( iam, grid );
     mycol = MYCOL( iam, grid );
     xsup = Glu_persist->xsup;
@@ -1021,7 +1056,7 @@ pzgstrs(superlu_dist_options_t *options, int_t n,
     Lnzval_bc_ptr = Llu->Lnzval_bc_ptr;
     Linv_bc_ptr = Llu->Linv_bc_ptr;
     Uinv_bc_ptr = Llu->Uinv_bc_ptr;
-    nlb = CEILING( nsupers, Pr ); /* Number of local block rows. */
+    nlb = NLBi( nsupers, grid ); /* Number of local block rows. */
 
     stat->utime[SOL_COMM] = 0.0;
     stat->utime[SOL_GEMM] = 0.0;
@@ -1044,10 +1079,10 @@ pzgstrs(superlu_dist_options_t *options, int_t n,
 	ABORT("Calloc fails for frecv[].");
     Llu->frecv = frecv;
 
-    if ( !(leaf_send = intMalloc_dist((CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i)) )
+    if ( !(leaf_send = intMalloc_dist((NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i)) )
 	ABORT("Malloc fails for leaf_send[].");
     nleaf_send=0;
-    if ( !(root_send = intMalloc_dist((CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i)) )
+    if ( !(root_send = intMalloc_dist((NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i)) )
 	ABORT("Malloc fails for root_send[].");
     nroot_send=0;
 
@@ -1144,7 +1179,7 @@ pzgstrs(superlu_dist_options_t *options, int_t n,
 	/* ---------------------------------------------------------
 	   Initialize the async Bcast trees on all processes.
 	   --------------------------------------------------------- */
-	nsupers_j = CEILING( nsupers, grid->npcol ); /* Number of local block columns */
+	nsupers_j = NLBj( nsupers, grid ); /* Number of local block columns */
 
 	nbtree = 0;
 	for (lk=0;lk<nsupers_j;++lk){
@@ -1160,7 +1195,7 @@ pzgstrs(superlu_dist_options_t *options, int_t n,
 		}
 	}
 
-	nsupers_i = CEILING( nsupers, grid->nprow ); /* Number of local block rows */
+	nsupers_i = NLBi( nsupers, grid ); /* Number of local block rows */
 	if ( !(	leafsups = (int_t*)intCalloc_dist(nsupers_i)) )
 		ABORT("Calloc fails for leafsups.");
 
@@ -1170,7 +1205,7 @@ pzgstrs(superlu_dist_options_t *options, int_t n,
 
 if(procs==1){
 	for (lk=0;lk<nsupers_i;++lk){
-		gb = myrow+lk*grid->nprow;  /* not sure */
+		gb = GBi( lk, grid );  /* not sure */
 		if(gb<nsupers){
 			if (fmod[lk*aln_i]==0){
 				leafsups[nleaf]=gb;
@@ -1187,7 +1222,7 @@ if(procs==1){
 			frecv[lk] = LRtree_ptr[lk].destCnt_;
 			nfrecvmod += frecv[lk];
 		}else{
-			gb = myrow+lk*grid->nprow;  /* not sure */
+			gb = GBi( lk, grid );  /* not sure */
 			if(gb<nsupers){
 				kcol = PCOL( gb, grid );
 				if(mycol==kcol) { /* Diagonal process */
@@ -1210,7 +1245,7 @@ if(procs==1){
 		ABORT("Malloc fails for recvbuf_BC_fwd[].");
 	nfrecvx_buf=0;
 
-	log_memory(nlb*aln_i*iword+nlb*iword+(CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i*2.0*iword+ nsupers_i*iword + sizelsum*num_thread * dword*2.0 + (ldalsum * nrhs + nlb * XK_H) *dword*2.0 + (sizertemp*num_thread + 1)*dword*2.0+maxrecvsz*(nfrecvx+1)*dword*2.0, stat);	//account for fmod, frecv, leaf_send, root_send, leafsups, recvbuf_BC_fwd	, lsum, x, rtemp
+	log_memory(nlb*aln_i*iword+nlb*iword+(NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i*2.0*iword+ nsupers_i*iword + sizelsum*num_thread * dword*2.0 + (ldalsum * nrhs + nlb * XK_H) *dword*2.0 + (sizertemp*num_thread + 1)*dword*2.0+maxrecvsz*(nfrecvx+1)*dword*2.0, stat);	//account for fmod, frecv, leaf_send, root_send, leafsups, recvbuf_BC_fwd	, lsum, x, rtemp
 
 #if ( DEBUGlevel>=2 )
 	printf("(%2d) nfrecvx %4d,  nfrecvmod %4d,  nleaf %4d\n,  nbtree %4d\n,  nrtree %4d\n",
@@ -1236,6 +1271,17 @@ if(procs==1){
 	__itt_resume(); // start VTune, again use 2 underscores
 #endif
 
+	/* Hand the messages of the L-solve to the progress thread, if any. */
+	pfwd.tree = LBtree_ptr;
+	pfwd.grid = grid;
+	pfwd.buf = recvbuf_BC_fwd;
+	pfwd.maxrecvsz = maxrecvsz;
+	pfwd.nbuf = 0;
+	pfwd.nrhs = nrhs;
+	pfwd.tag = BC_L;
+	prog = commProgressStart("L-solve", grid->comm, nfrecvx+nfrecvmod, maxrecvsz,
+				 SuperLU_MPI_DOUBLE_COMPLEX, zSolveKeep, zSolveFwd, &pfwd);
+
 	/* ---------------------------------------------------------
 	   Solve the leaf nodes first by all the diagonal processes.
 	   --------------------------------------------------------- */
@@ -1443,7 +1489,7 @@ if(procs==1){
 	for (i=0;i<nleaf_send;i++){
 		lk = leaf_send[i*aln_i];
 		if(lk>=0){ // this is a bcast forwarding
-			gb = mycol+lk*grid->npcol;  /* not sure */
+			gb = GBj( lk, grid );  /* not sure */
 			lib = LBi( gb, grid ); /* Local block number, row-wise. */
 			ii = X_BLK( lib );
 			//BcTree_forwardMessageSimple(LBtree_ptr[lk],&x[ii - XK_H],BcTree_GetMsgSize(LBtree_ptr[lk],'z')*nrhs+XK_H,'z');
@@ -1490,7 +1536,8 @@ if(procs==1){
 			recvbuf0 = &recvbuf_BC_fwd[nfrecvx_buf*maxrecvsz];
 
 			/* Receive a message. */
-			MPI_Recv( recvbuf0, maxrecvsz, SuperLU_MPI_DOUBLE_COMPLEX,
+			if ( prog ) recvbuf0 = commProgressRecv(prog, &status);
+			else MPI_Recv( recvbuf0, maxrecvsz, SuperLU_MPI_DOUBLE_COMPLEX,
 				MPI_ANY_SOURCE, MPI_ANY_TAG, grid->comm, &status );
 			// MPI_Irecv(recvbuf0,maxrecvsz,SuperLU_MPI_DOUBLE_COMPLEX,MPI_ANY_SOURCE,MPI_ANY_TAG,grid->comm,&req);
 			// ready=0;
@@ -1521,7 +1568,7 @@ if(procs==1){
 				{
 				lk = LBj( k, grid );    /* local block number */
 
-				if(LBtree_ptr[lk].destCnt_>0){
+				if(LBtree_ptr[lk].destCnt_>0 && !prog){
 
 					//BcTree_forwardMessageSimple(LBtree_ptr[lk],recvbuf0,BcTree_GetMsgSize(LBtree_ptr[lk],'z')*nrhs+XK_H,'z');
 					C_BcTree_forwardMessageSimple(&LBtree_ptr[lk], recvbuf0, LBtree_ptr[lk].msgSize_*nrhs+XK_H);
@@ -1691,6 +1738,7 @@ if(procs==1){
                     } /* while not finished ... */
        	    }
         } // end of parallel
+	commProgressStop(prog);
 
 #if ( PRNTlevel>=2 )
 	t = SuperLU_timer_() - t;
@@ -1732,7 +1780,7 @@ if(procs==1){
 	SUPERLU_FREE(leaf_send);
 	SUPERLU_FREE(leafsups);
 	SUPERLU_FREE(recvbuf_BC_fwd);
-	log_memory(-nlb*aln_i*iword-nlb*iword-(CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i*iword- nsupers_i*iword -maxrecvsz*(nfrecvx+1)*dword*2.0, stat);	//account for fmod, frecv, leaf_send, leafsups, recvbuf_BC_fwd
+	log_memory(-nlb*aln_i*iword-nlb*iword-(NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i*iword- nsupers_i*iword -maxrecvsz*(nfrecvx+1)*dword*2.0, stat);	//account for fmod, frecv, leaf_send, leafsups, recvbuf_BC_fwd
 
 	for (lk=0;lk<nsupers_j;++lk){
 		if(LBtree_ptr[lk].empty_==NO){
@@ -1751,6 +1799,10 @@ if(procs==1){
 		}
 	}
 	MPI_Barrier( grid->comm );
+	if ( getenv("SUPERLU_TREE_STATS") ) {
+		C_Tree_Stats("L-bcast", LBtree_ptr, nsupers_j, grid->comm);
+		C_Tree_Stats("L-reduce", LRtree_ptr, nsupers_i, grid->comm);
+	}
 
 #if ( VAMPIR>=1 )
 	VT_traceoff();
@@ -1817,8 +1869,8 @@ if(procs==1){
 #endif
 
 #if ( DEBUGlevel>=2 )
-        nub = CEILING( nsupers, Pc ); /* Number of local block columns. */
-        for (p = 0; p < Pr*Pc; ++p) {
+        nub = NLBj( nsupers, grid ); /* Number of local block columns. */
+        for (p = 0; p < grid->nprow * grid->npcol; ++p) {
 	    if (iam == p) {
 		printf("(%2d) .. Ublocks %d, nub %d\n",iam,Ublocks,nub); fflush(stdout);
 		for (lb = 0; lb < nub; ++lb) {
@@ -1837,12 +1889,12 @@ if(procs==1){
 	    }
 	    MPI_Barrier( grid->comm );
 	}
-	for (p = 0; p < Pr*Pc; ++p) {
+	for (p = 0; p < grid->nprow * grid->npcol; ++p) {
 		if ( iam == p ) {
 			printf("\n(%d) bsendx_plist[][]", iam);
 			for (lb = 0; lb < nub; ++lb) {
 				printf("\n(%d) .. local col %2d: ", iam, lb);
-				for (i = 0; i < Pr; ++i)
+				for (i = 0; i < grid->nprow; ++i)
 					printf("%4d", bsendx_plist[lb][i]);
 			}
 			printf("\n");
@@ -1854,7 +1906,7 @@ if(procs==1){
 	/* ---------------------------------------------------------
 	   Initialize the async Bcast trees on all processes.
 	   --------------------------------------------------------- */
-	nsupers_j = CEILING( nsupers, grid->npcol ); /* Number of local block columns */
+	nsupers_j = NLBj( nsupers, grid ); /* Number of local block columns */
 
 	nbtree = 0;
 	for (lk=0;lk<nsupers_j;++lk){
@@ -1868,7 +1920,7 @@ if(procs==1){
 	    }
 	}
 
-	nsupers_i = CEILING( nsupers, grid->nprow ); /* Number of local block rows */
+	nsupers_i = NLBi( nsupers, grid ); /* Number of local block rows */
 	if ( !(	rootsups = (int_t*)intCalloc_dist(nsupers_i)) )
 		ABORT("Calloc fails for rootsups.");
 
@@ -1883,7 +1935,7 @@ if(procs==1){
 			brecv[lk] = URtree_ptr[lk].destCnt_;
 			nbrecvmod += brecv[lk];
 		}else{
-			gb = myrow+lk*grid->nprow;  /* not sure */
+			gb = GBi( lk, grid );  /* not sure */
 			if(gb<nsupers){
 				kcol = PCOL( gb, grid );
 				if(mycol==kcol) { /* Diagonal process */
@@ -1920,6 +1972,17 @@ if(procs==1){
 	t = SuperLU_timer_();
 #endif
 
+	/* Hand the messages of the U-solve to the progress thread, if any. */
+	pfwd.tree = UBtree_ptr;
+	pfwd.grid = grid;
+	pfwd.buf = recvbuf_BC_fwd;
+	pfwd.maxrecvsz = maxrecvsz;
+	pfwd.nbuf = 0;
+	pfwd.nrhs = nrhs;
+	pfwd.tag = BC_U;
+	prog = commProgressStart("U-solve", grid->comm, nbrecvx+nbrecvmod, maxrecvsz,
+				 SuperLU_MPI_DOUBLE_COMPLEX, zSolveKeep, zSolveFwd, &pfwd);
+
 	/*
 	 * Solve the roots first by all the diagonal processes.
 	 */
@@ -2058,7 +2121,7 @@ if(procs==1){
 for (i=0;i<nroot_send;i++){
 	lk = root_send[(i)*aln_i];
 	if(lk>=0){ // this is a bcast forwarding
-		gb = mycol+lk*grid->npcol;  /* not sure */
+		gb = GBj( lk, grid );  /* not sure */
 		lib = LBi( gb, grid ); /* Local block number, row-wise. */
 		ii = X_BLK( lib );
 		//BcTree_forwardMessageSimple(UBtree_ptr[lk],&x[ii - XK_H],BcTree_GetMsgSize(UBtree_ptr[lk],'z')*nrhs+XK_H,'z');
@@ -2098,7 +2161,8 @@ for (i=0;i<nroot_send;i++){
 		recvbuf0 = &recvbuf_BC_fwd[nbrecvx_buf*maxrecvsz];
 
 		/* Receive a message. */
-		MPI_Recv( recvbuf0, maxrecvsz, SuperLU_MPI_DOUBLE_COMPLEX,
+		if ( prog ) recvbuf0 = commProgressRecv(prog, &status);
+		else MPI_Recv( recvbuf0, maxrecvsz, SuperLU_MPI_DOUBLE_COMPLEX,
 			MPI_ANY_SOURCE, MPI_ANY_TAG, grid->comm, &status );
 
 #if ( PROFlevel>=1 )
@@ -2117,7 +2181,7 @@ for (i=0;i<nroot_send;i++){
 		    // --nfrecvx;
 		    nbrecvx_buf++;
 		    lk = LBj( k, grid );    /* local block number */
-		    if(UBtree_ptr[lk].destCnt_>0){
+		    if(UBtree_ptr[lk].destCnt_>0 && !prog){
 
 			// BcTree_forwardMessageSimple(UBtree_ptr[lk],recvbuf0,BcTree_GetMsgSize(UBtree_ptr[lk],'d')*nrhs+XK_H,'d');
 			C_BcTree_forwardMessageSimple(&UBtree_ptr[lk], recvbuf0, UBtree_ptr[lk].msgSize_*nrhs+XK_H);
@@ -2254,6 +2318,7 @@ for (i=0;i<nroot_send;i++){
 		    } /* end if MPI_TAG==RD_U */
 		} /* while not finished ... */
 	} /* end parallel region */
+	commProgressStop(prog);
 
 #if ( PRNTlevel>=2 )
 	t = SuperLU_timer_() - t;
@@ -2339,7 +2404,7 @@ for (i=0;i<nroot_send;i++){
 	SUPERLU_FREE(rootsups);
 	SUPERLU_FREE(recvbuf_BC_fwd);
 
-	log_memory(-nlb*aln_i*iword-nlb*iword - nsupers_i*iword - (CEILING( nsupers, Pr )+CEILING( nsupers, Pc ))*aln_i*iword - maxrecvsz*(nbrecvx+1)*dword*2.0 - sizelsum*num_thread * dword*2.0 - (ldalsum * nrhs + nlb * XK_H) *dword*2.0 - (sizertemp*num_thread + 1)*dword*2.0, stat);	//account for bmod, brecv, root_send, rootsups, recvbuf_BC_fwd,rtemp,lsum,x
+	log_memory(-nlb*aln_i*iword-nlb*iword - nsupers_i*iword - (NLBi( nsupers, grid )+NLBj( nsupers, grid ))*aln_i*iword - maxrecvsz*(nbrecvx+1)*dword*2.0 - sizelsum*num_thread * dword*2.0 - (ldalsum * nrhs + nlb * XK_H) *dword*2.0 - (sizertemp*num_thread + 1)*dword*2.0, stat);	//account for bmod, brecv, root_send, rootsups, recvbuf_BC_fwd,rtemp,lsum,x
 
 	for (lk=0;lk<nsupers_j;++lk){
 		if(UBtree_ptr[lk].empty_==NO){
@@ -2357,6 +2422,10 @@ for (i=0;i<nroot_send;i++){
 		}
 	}
 	MPI_Barrier( grid->comm );
+	if ( getenv("SUPERLU_TREE_STATS") ) {
+		C_Tree_Stats("U-bcast", UBtree_ptr, nsupers_j, grid->comm);
+		C_Tree_Stats("U-reduce", URtree_ptr, nsupers_i, grid->comm);
+	}
 
 
 #if ( PROFlevel>=2 )
@@ -297,7 +297,7 @@ void zlsum_bmod
 	i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 	i += UB_DESCRIPTOR;
 	il = LSUM_BLK( ik );
-	gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+	gik = GBi( ik, grid );/* Global block number, row-wise. */
 	iknsupc = SuperSize( gik );
 	ikfrow = FstBlockC( gik );
 	iklrow = FstBlockC( gik+1 );
@@ -1502,7 +1502,7 @@ void zlsum_bmod_inv
 				i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 				i += UB_DESCRIPTOR;
 				il = LSUM_BLK( ik );
-				gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+				gik = GBi( ik, grid );/* Global block number, row-wise. */
 				iknsupc = SuperSize( gik );
 				ikfrow = FstBlockC( gik );
 				iklrow = FstBlockC( gik+1 );
@@ -1696,7 +1696,7 @@ void zlsum_bmod_inv
 			i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 			i += UB_DESCRIPTOR;
 			il = LSUM_BLK( ik );
-			gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+			gik = GBi( ik, grid );/* Global block number, row-wise. */
 			iknsupc = SuperSize( gik );
 			ikfrow = FstBlockC( gik );
 			iklrow = FstBlockC( gik+1 );
@@ -1995,7 +1995,7 @@ void zlsum_bmod_inv_master
 				i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 				i += UB_DESCRIPTOR;
 				il = LSUM_BLK( ik );
-				gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+				gik = GBi( ik, grid );/* Global block number, row-wise. */
 				iknsupc = SuperSize( gik );
 				ikfrow = FstBlockC( gik );
 				iklrow = FstBlockC( gik+1 );
@@ -2042,7 +2042,7 @@ void zlsum_bmod_inv_master
 			i = Ucb_indptr[lk][ub].indpos; /* Start of the block in usub[]. */
 			i += UB_DESCRIPTOR;
 			il = LSUM_BLK( ik );
-			gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+			gik = GBi( ik, grid );/* Global block number, row-wise. */
 			iknsupc = SuperSize( gik );
 			ikfrow = FstBlockC( gik );
 			iklrow = FstBlockC( gik+1 );
@@ -2082,7 +2082,7 @@ void zlsum_bmod_inv_master
 	for (ub = 0; ub < nub; ++ub){
 		ik = Ucb_indptr[lk][ub].lbnum; /* Local block number, row-wise. */
 		il = LSUM_BLK( ik );
-		gik = ik * grid->nprow + myrow;/* Global block number, row-wise. */
+		gik = GBi( ik, grid );/* Global block number, row-wise. */
 		iknsupc = SuperSize( gik );
 
 	// #ifdef _OPENMP
@@ -0,0 +1,483 @@
+/*! \file
+Copyright (c) 2003, The Regents of the University of California, through
+Lawrence Berkeley National Laboratory (subject to receipt of any required
+approvals from U.S. Dept. of Energy)
+
+All rights reserved.
+
+The source code is distributed under BSD license, see the file License.txt
+at the top-level directory.
+*/
+
+
+/*! @file
+ * \brief Finds a row permutation with large diagonal entries from the distributed matrix
+ *
+ * <pre>
+ * -- Distributed SuperLU routine (version 9.0) --
+ * Lawrence Berkeley National Lab, Univ. of California Berkeley.
+ * </pre>
+ */
+
+#include <math.h>
+#include <float.h>
+#include "superlu_zdefs.h"
+
+#define RUIZ_MAXITER     20    /* maximum number of scaling sweeps */
+#define RUIZ_TOL         1e-2  /* stop when row/column maxima are 1 +- tol */
+#define LDM_MAXROUND     200   /* maximum number of matching rounds */
+#define AUCTION_MAXROUND 5000  /* maximum number of auction rounds */
+#define AUCTION_EPS      5e-2  /* minimum bid increment */
+
+typedef struct { double val; int idx; } ldm_pair_t;
+typedef struct { double val; int_t col, row; } ldm_bid_t;
+
+static int_t ldm_complete(int_t, int_t [], int_t [], int_t [], int_t []);
+
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *
+ *   PZLDPERM_DIST finds a row permutation so that the matrix has large
+ *   entries on the diagonal, working directly on the distributed
+ *   compressed row storage of A.  It is the LargeDiag_LDM alternative
+ *   to MC64: the numerical values of A are never gathered, and every
+ *   process works on its own block of rows.
+ *
+ *   1. A is equilibrated in the max-norm by Ruiz's iteration, so that
+ *      every row and column of diag(exp(u))*A*diag(exp(v)) has largest
+ *      entry close to one in absolute value.
+ *   2. A locally dominant matching on the bipartite graph of the scaled
+ *      matrix is computed with edge weights log|b_ij|: in each round,
+ *      every unmatched row points to its heaviest unmatched column and
+ *      every unmatched column to its heaviest unmatched row, and mutual
+ *      pairs are matched.  A round costs one reduction over the columns
+ *      that are still unmatched.  This 1/2-approximation of the maximum
+ *      product matching of MC64 (job = 5) typically matches 90% of the
+ *      columns within a few rounds.
+ *   3. The matching is completed by a parallel (Jacobi) auction on the
+ *      same weights, started from the matching of step 2: the unmatched
+ *      rows bid for their best columns and may displace matched rows.
+ *      Only the bids are exchanged, so the late rounds are cheap.
+ *   4. Rows left unmatched, e.g. when A is structurally singular or has
+ *      explicit zeros, are matched by augmenting paths on the pattern of
+ *      A, ignoring the values.
+ *
+ * Arguments
+ * =========
+ *
+ * A      (input) SuperMatrix*
+ *        The distributed matrix A in NRformat_loc; it is not modified.
+ *
+ * grid   (input) gridinfo_t*
+ *        The 2D process mesh; all processes in grid must call this routine.
+ *
+ * colptr (input) int_t*, of size n+1
+ * rowind (input) int_t*, of size nnz
+ *        The pattern of the global matrix A in compressed column format,
+ *        as returned by pdCompRow_loc_to_CompCol_global() with
+ *        need_value = 0.  Used only in step 4; they may be NULL, e.g.
+ *        with the parallel symbolic factorization, in which case the
+ *        rows left over by step 3 are paired arbitrarily.
+ *
+ * perm   (output) int_t*, of size n
+ *        The permutation vector. perm[i] = j means row i in the
+ *        original matrix is in row j of the permuted matrix.
+ *
+ * u      (output) double*, of size n
+ *        The natural logarithms of the row scaling factors.
+ *
+ * v      (output) double*, of size n
+ *        The natural logarithms of the column scaling factors.
+ *        The scaled matrix B has entries b_ij = a_ij * exp(u_i + v_j).
+ *
+ * The outputs are the same on all processes.  Returns 0 on success, or
+ * the number of columns that could not be matched when A is
+ * structurally singular.
+ * </pre>
+ */
+
+int
+pzldperm_dist(SuperMatrix *A, gridinfo_t *grid, int_t colptr[],
+              int_t rowind[], int_t *perm, double u[], double v[])
+{
+    NRformat_loc *Astore = (NRformat_loc *) A->Store;
+    int_t n = A->ncol, m_loc = Astore->m_loc, fst_row = Astore->fst_row;
+    int_t *rowptr = Astore->rowptr, *colind = Astore->colind;
+    doublecomplex *a = (doublecomplex *) Astore->nzval;
+    int_t nnz_loc = rowptr[m_loc];
+    int_t i, j, j1, k, p, q, il, na, nu, nd, nnew, nbid, nfail, round;
+#if ( PRNTlevel>=1 )
+    int_t nsweep;
+#endif
+    int nprocs, nb, *cnts, *displs;
+    int_t *colmate, *rowmate, *acol, *cpos, *newmate, *rowm, *urow;
+    double *w, *r, *c, *rmax, *cmax, *price, err, t, v1, v2, wmin, wmax, big;
+    ldm_pair_t *cbest;
+    ldm_bid_t *bids;
+
+#if ( DEBUGlevel>=1 )
+    CHECK_MALLOC(grid->iam, "Enter pzldperm_dist()");
+#endif
+
+    if ( !(w = doubleMalloc_dist(SUPERLU_MAX(nnz_loc, 1))) )
+        ABORT("Malloc fails for w[]");
+    if ( !(r = doubleMalloc_dist(SUPERLU_MAX(m_loc, 1))) )
+        ABORT("Malloc fails for r[]");
+    if ( !(rmax = doubleMalloc_dist(SUPERLU_MAX(m_loc, 1))) )
+        ABORT("Malloc fails for rmax[]");
+    if ( !(c = doubleMalloc_dist(n)) ) ABORT("Malloc fails for c[]");
+    if ( !(cmax = doubleMalloc_dist(n)) ) ABORT("Malloc fails for cmax[]");
+
+    /* ------------------------------------------------------------
+       Step 1: max-norm equilibration, r and c are the local row and
+       the global column scaling factors.
+       ------------------------------------------------------------*/
+    for (k = 0; k < nnz_loc; ++k) w[k] = slud_z_abs1(&a[k]);
+    for (il = 0; il < m_loc; ++il) r[il] = 1.0;
+    for (j = 0; j < n; ++j) c[j] = 1.0;
+
+    for (round = 0; round < RUIZ_MAXITER; ++round) {
+        for (j = 0; j < n; ++j) cmax[j] = 0.0;
+	for (il = 0; il < m_loc; ++il) {
+	    rmax[il] = 0.0;
+	    for (k = rowptr[il]; k < rowptr[il+1]; ++k) {
+	        j = colind[k];
+	        t = w[k] * r[il] * c[j];
+		rmax[il] = SUPERLU_MAX(rmax[il], t);
+		cmax[j] = SUPERLU_MAX(cmax[j], t);
+	    }
+	}
+	MPI_Allreduce(MPI_IN_PLACE, cmax, n, MPI_DOUBLE, MPI_MAX, grid->comm);
+
+	err = 0.0;
+	for (il = 0; il < m_loc; ++il)
+	    if ( rmax[il] > 0.0 ) {
+	        err = SUPERLU_MAX(err, fabs(1.0 - rmax[il]));
+		r[il] /= sqrt(rmax[il]);
+	    }
+	for (j = 0; j < n; ++j)
+	    if ( cmax[j] > 0.0 ) {
+	        err = SUPERLU_MAX(err, fabs(1.0 - cmax[j]));
+		c[j] /= sqrt(cmax[j]);
+	    }
+	MPI_Allreduce(MPI_IN_PLACE, &err, 1, MPI_DOUBLE, MPI_MAX, grid->comm);
+	if ( err <= RUIZ_TOL ) break;
+    }
+#if ( PRNTlevel>=1 )
+    nsweep = round;
+#endif
+
+    /* Edge weights log|b_ij|; exact zeros are never matched in step 2. */
+    for (il = 0; il < m_loc; ++il)
+        for (k = rowptr[il]; k < rowptr[il+1]; ++k)
+	    w[k] = w[k] > 0.0 ? log(w[k] * r[il] * c[colind[k]]) : -DBL_MAX;
+
+    /* ------------------------------------------------------------
+       Step 2: locally dominant matching.  colmate[] is replicated,
+       rowmate[] holds the local rows.  acol[0:na) are the columns still
+       active, cpos[j] is the position of column j in acol[], or -1.
+       ------------------------------------------------------------*/
+    if ( !(colmate = intMalloc_dist(n)) ) ABORT("Malloc fails for colmate[]");
+    if ( !(rowmate = intMalloc_dist(SUPERLU_MAX(m_loc, 1))) )
+        ABORT("Malloc fails for rowmate[]");
+    if ( !(acol = intMalloc_dist(n)) ) ABORT("Malloc fails for acol[]");
+    if ( !(cpos = intMalloc_dist(n)) ) ABORT("Malloc fails for cpos[]");
+    if ( !(newmate = intMalloc_dist(n)) ) ABORT("Malloc fails for newmate[]");
+    if ( !(cbest = (ldm_pair_t *) SUPERLU_MALLOC(n * sizeof(ldm_pair_t))) )
+        ABORT("Malloc fails for cbest[]");
+
+    for (j = 0; j < n; ++j) {
+        colmate[j] = SLU_EMPTY;
+        acol[j] = j;
+	cpos[j] = j;
+    }
+    for (il = 0; il < m_loc; ++il) rowmate[il] = SLU_EMPTY;
+    na = n;
+
+    for (round = 0; round < LDM_MAXROUND && na > 0; ++round) {
+        /* Each active column points to its heaviest unmatched row;
+	   ties go to the smaller row index, as MPI_MAXLOC does. */
+        for (p = 0; p < na; ++p) {
+	    cbest[p].val = -DBL_MAX;
+	    cbest[p].idx = SLU_EMPTY;
+	}
+	for (il = 0; il < m_loc; ++il) {
+	    if ( rowmate[il] != SLU_EMPTY ) continue;
+	    i = fst_row + il;
+	    for (k = rowptr[il]; k < rowptr[il+1]; ++k) {
+	        if ( w[k] == -DBL_MAX || (p = cpos[colind[k]]) < 0 ) continue;
+		if ( w[k] > cbest[p].val
+		     || (w[k] == cbest[p].val && i < cbest[p].idx) ) {
+		    cbest[p].val = w[k];
+		    cbest[p].idx = (int) i;
+		}
+	    }
+	}
+	MPI_Allreduce(MPI_IN_PLACE, cbest, na, MPI_DOUBLE_INT, MPI_MAXLOC,
+	              grid->comm);
+
+	/* Each unmatched row points to its heaviest active column; the
+	   mutual pairs are locally dominant and are matched. */
+	for (p = 0; p < na; ++p) newmate[p] = SLU_EMPTY;
+	for (il = 0; il < m_loc; ++il) {
+	    if ( rowmate[il] != SLU_EMPTY ) continue;
+	    i = fst_row + il;
+	    j = SLU_EMPTY;
+	    t = -DBL_MAX;
+	    for (k = rowptr[il]; k < rowptr[il+1]; ++k) {
+	        if ( w[k] == -DBL_MAX || cpos[colind[k]] < 0 ) continue;
+		if ( w[k] > t || (w[k] == t && colind[k] < j) ) {
+		    t = w[k];
+		    j = colind[k];
+		}
+	    }
+	    if ( j != SLU_EMPTY && cbest[cpos[j]].idx == i ) {
+	        rowmate[il] = j;
+		newmate[cpos[j]] = i;
+	    }
+	}
+	MPI_Allreduce(MPI_IN_PLACE, newmate, na, mpi_int_t, MPI_MAX,
+	              grid->comm);
+
+	/* Drop the matched columns and those without candidates. */
+	nnew = 0;
+	for (p = 0, k = 0; p < na; ++p) {
+	    j = acol[p];
+	    if ( newmate[p] != SLU_EMPTY ) {
+	        colmate[j] = newmate[p];
+		++nnew;
+	    }
+	    if ( newmate[p] != SLU_EMPTY || cbest[p].idx == SLU_EMPTY ) {
+	        cpos[j] = SLU_EMPTY;
+	    } else {
+	        cpos[j] = k;
+		acol[k++] = j;
+	    }
+	}
+	na = k;
+	if ( nnew == 0 ) break;
+    }
+
+    /* ------------------------------------------------------------
+       Step 3: Jacobi auction from the locally dominant matching.  Each
+       unmatched row bids for its best column at the current prices,
+       raising the price by its margin over the second best column;
+       each column goes to the highest bid and its previous row becomes
+       unmatched.  price[] (in cmax[]) is replicated.  Only the bids are
+       exchanged, so a round costs O(number of unmatched rows).
+       ------------------------------------------------------------*/
+    price = cmax;
+    for (j = 0; j < n; ++j) price[j] = 0.0;
+    wmin = 0.0;
+    wmax = -DBL_MAX;
+    for (k = 0; k < nnz_loc; ++k)
+        if ( w[k] != -DBL_MAX ) {
+	    wmin = SUPERLU_MIN(wmin, w[k]);
+	    wmax = SUPERLU_MAX(wmax, w[k]);
+	}
+    MPI_Allreduce(MPI_IN_PLACE, &wmin, 1, MPI_DOUBLE, MPI_MIN, grid->comm);
+    MPI_Allreduce(MPI_IN_PLACE, &wmax, 1, MPI_DOUBLE, MPI_MAX, grid->comm);
+    big = wmax - wmin + 1.0; /* increment of a row with one candidate */
+
+    nprocs = grid->nprow * grid->npcol;
+    if ( !(cnts = SUPERLU_MALLOC(2 * nprocs * sizeof(int))) )
+        ABORT("Malloc fails for cnts[]");
+    displs = cnts + nprocs;
+    if ( !(bids = (ldm_bid_t *) SUPERLU_MALLOC(n * sizeof(ldm_bid_t))) )
+        ABORT("Malloc fails for bids[]");
+    for (j = 0; j < n; ++j) cpos[j] = SLU_EMPTY; /* winning bid of column j */
+    urow = acol; /* the local unmatched rows */
+    for (il = 0, nu = 0; il < m_loc; ++il)
+        if ( rowmate[il] == SLU_EMPTY ) urow[nu++] = il;
+
+    for (k = 0; k < AUCTION_MAXROUND; ++k) {
+	nb = nd = 0;
+	for (q = 0; q < nu; ++q) {
+	    il = urow[q];
+	    j1 = SLU_EMPTY;
+	    v1 = v2 = -DBL_MAX;
+	    for (p = rowptr[il]; p < rowptr[il+1]; ++p) {
+	        if ( w[p] == -DBL_MAX ) continue;
+		t = w[p] - price[colind[p]];
+		if ( t > v1 ) {
+		    v2 = v1;
+		    v1 = t;
+		    j1 = colind[p];
+		} else if ( t > v2 ) v2 = t;
+	    }
+	    if ( j1 == SLU_EMPTY ) continue; /* no candidate, drop row */
+	    urow[nb] = il;
+	    bids[nb].val = price[j1] + (v2 == -DBL_MAX ? big : v1 - v2)
+	                   + AUCTION_EPS;
+	    bids[nb].col = j1;
+	    bids[nb].row = fst_row + il;
+	    ++nb;
+	}
+	nu = nb;
+	/* Local bids are stored after the slots of the lower ranks. */
+	nb *= sizeof(ldm_bid_t);
+	MPI_Allgather(&nb, 1, MPI_INT, cnts, 1, MPI_INT, grid->comm);
+	for (p = 0, displs[0] = 0; p < nprocs - 1; ++p)
+	    displs[p+1] = displs[p] + cnts[p];
+	nbid = (displs[nprocs-1] + cnts[nprocs-1]) / sizeof(ldm_bid_t);
+	if ( nbid == 0 ) break;
+	memmove((char *) bids + displs[grid->iam], bids, nb);
+	MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, bids, cnts, displs,
+	               MPI_BYTE, grid->comm);
+
+	/* Highest bid wins; ties go to the smaller row.  The losers and
+	   the displaced rows bid again in the next round. */
+	for (p = 0; p < nbid; ++p) {
+	    j = bids[p].col;
+	    q = cpos[j];
+	    if ( q == SLU_EMPTY || bids[p].val > bids[q].val
+	         || (bids[p].val == bids[q].val && bids[p].row < bids[q].row) )
+	        cpos[j] = p;
+	}
+	for (p = 0; p < nbid; ++p) {
+	    j = bids[p].col;
+	    if ( (q = cpos[j]) == SLU_EMPTY ) continue;
+	    cpos[j] = SLU_EMPTY;
+	    i = colmate[j];
+	    if ( i >= fst_row && i < fst_row + m_loc ) {
+	        rowmate[i - fst_row] = SLU_EMPTY;
+		urow[nu + nd++] = i - fst_row;
+	    }
+	    i = bids[q].row;
+	    colmate[j] = i;
+	    price[j] = bids[q].val;
+	    if ( i >= fst_row && i < fst_row + m_loc ) rowmate[i - fst_row] = j;
+	}
+	for (p = 0, q = 0; p < nu; ++p)
+	    if ( rowmate[urow[p]] == SLU_EMPTY ) urow[q++] = urow[p];
+	for (p = 0; p < nd; ++p) urow[q++] = urow[nu + p];
+	nu = q;
+    }
+    SUPERLU_FREE(cnts);
+    SUPERLU_FREE(bids);
+
+#if ( PRNTlevel>=1 )
+    if ( !grid->iam ) {
+        for (j = 0, i = 0; j < n; ++j) if ( colmate[j] != SLU_EMPTY ) ++i;
+	printf(".. LDM: %d scaling sweeps, %d matching rounds, %d auction rounds,"
+	       " %ld of %ld columns matched\n", (int) nsweep, (int) round,
+	       (int) k, (long) i, (long) n);
+    }
+#endif
+    /* ------------------------------------------------------------
+       Step 4: complete the matching on the replicated pattern.
+       All processes do the same work and get the same result.
+       ------------------------------------------------------------*/
+    rowm = newmate;
+    for (i = 0; i < n; ++i) rowm[i] = SLU_EMPTY;
+    for (j = 0; j < n; ++j) if ( colmate[j] != SLU_EMPTY ) rowm[colmate[j]] = j;
+    nfail = ldm_complete(n, colptr, rowind, colmate, rowm);
+
+    for (i = 0; i < n; ++i) perm[i] = rowm[i];
+
+    /* Scaling factors; u[] is assembled from the local rows. */
+    for (i = 0; i < n; ++i) cmax[i] = 0.0;
+    for (il = 0; il < m_loc; ++il) cmax[fst_row + il] = log(r[il]);
+    MPI_Allreduce(MPI_IN_PLACE, cmax, n, MPI_DOUBLE, MPI_SUM, grid->comm);
+    for (i = 0; i < n; ++i) u[i] = cmax[i];
+    for (j = 0; j < n; ++j) v[j] = log(c[j]);
+
+    SUPERLU_FREE(w);
+    SUPERLU_FREE(r);
+    SUPERLU_FREE(rmax);
+    SUPERLU_FREE(c);
+    SUPERLU_FREE(cmax);
+    SUPERLU_FREE(colmate);
+    SUPERLU_FREE(rowmate);
+    SUPERLU_FREE(acol);
+    SUPERLU_FREE(cpos);
+    SUPERLU_FREE(newmate);
+    SUPERLU_FREE(cbest);
+
+#if ( DEBUGlevel>=1 )
+    CHECK_MALLOC(grid->iam, "Exit pzldperm_dist()");
+#endif
+    return (int) nfail;
+} /* pzldperm_dist */
+
+
+/*! \brief Extend the matching (colmate, rowm) to a maximum matching by
+ *  depth-first augmenting paths with lookahead (as in MC21).  Unmatched
+ *  rows are then paired with unmatched columns.  Returns the number of
+ *  columns that could not be matched structurally; without colptr, only
+ *  the pairing is done and 0 is returned.
+ */
+static int_t
+ldm_complete(int_t n, int_t colptr[], int_t rowind[], int_t colmate[],
+             int_t rowm[])
+{
+    int_t *look, *next, *visit, *cstack, *rstack;
+    int_t i, j, j0, k, top, found, nfail = 0;
+
+    if ( !(look = intMalloc_dist(5 * n)) ) ABORT("Malloc fails for look[]");
+    next = look + n;
+    visit = next + n;
+    cstack = visit + n;
+    rstack = cstack + n;
+    for (j = 0; j < n; ++j) {
+        look[j] = colptr ? colptr[j] : 0;
+	visit[j] = SLU_EMPTY;
+    }
+
+    for (j0 = 0; colptr && j0 < n; ++j0) {
+        if ( colmate[j0] != SLU_EMPTY ) continue;
+	top = 0;
+	cstack[0] = j0;
+	next[j0] = colptr[j0];
+	found = SLU_EMPTY;
+	while ( top >= 0 ) {
+	    j = cstack[top];
+	    /* Lookahead for a free row in column j. */
+	    for (; look[j] < colptr[j+1]; ++look[j])
+	        if ( rowm[rowind[look[j]]] == SLU_EMPTY ) {
+		    found = rowind[look[j]];
+		    break;
+		}
+	    if ( found != SLU_EMPTY ) break;
+	    /* Descend through a matched row not yet visited. */
+	    for (k = next[j]; k < colptr[j+1]; ++k)
+	        if ( visit[rowind[k]] != j0 ) break;
+	    next[j] = k + 1;
+	    if ( k < colptr[j+1] ) {
+	        i = rowind[k];
+		visit[i] = j0;
+		rstack[top] = i;
+		cstack[++top] = rowm[i];
+		next[rowm[i]] = colptr[rowm[i]];
+	    } else --top;
+	}
+	if ( found == SLU_EMPTY ) {
+	    ++nfail;
+	    continue;
+	}
+	/* Augment along the path. */
+	for (i = found; top >= 0; --top) {
+	    j = cstack[top];
+	    colmate[j] = i;
+	    rowm[i] = j;
+	    if ( top > 0 ) i = rstack[top-1];
+	}
+    }
+
+    /* Structurally singular, or no pattern given: pair the leftovers
+       arbitrarily. */
+    if ( nfail || !colptr ) {
+        for (i = 0, j = 0; i < n; ++i) {
+	    if ( rowm[i] != SLU_EMPTY ) continue;
+	    while ( colmate[j] != SLU_EMPTY ) ++j;
+	    colmate[j] = i;
+	    rowm[i] = j;
+	}
+    }
+
+    SUPERLU_FREE(look);
+    return nfail;
+} /* ldm_complete */
@@ -290,6 +290,88 @@ int pzCompRow_loc_to_CompCol_global
 } /* pzCompRow_loc_to_CompCol_global */
 
 
+/*! \brief Predict nnz(L+U), flops, per-process memory and panel message
+ *  volume of the factorization of A for the candidate process grids,
+ *  without distributing or factoring A.
+ *
+ * <pre>
+ * The row permutation and the column ordering are computed as in
+ * pzgssvx, then superlu_symbfact_predict() does the serial symbolic
+ * factorization and the cost model.  A is not modified.  The perm_r[]
+ * and perm_c[] of ScalePermstruct are read only when options->RowPerm
+ * is MY_PERMR or options->ColPerm is MY_PERMC.  Equilibration does not
+ * change the structure and is skipped; LargeDiag_HWPM is approximated
+ * by MC64, LargeDiag_LDM computes its matching from the local rows.
+ *
+ * All processes in grid must call this routine; on exit pred[] is the
+ * same on all of them.  Returns 0 on success, or the error of the
+ * symbolic factorization.
+ * </pre>
+ */
+int
+pzsymbfact_predict(superlu_dist_options_t *options, SuperMatrix *A,
+                   zScalePermstruct_t *ScalePermstruct, gridinfo_t *grid,
+                   int ncand, superlu_predict_t *pred)
+{
+    SuperMatrix GA;
+    NCformat *GAstore;
+    int_t *perm_r, *perm_c, *rowind, i, m = A->nrow, n = A->ncol;
+    double *R1, *C1;
+    int need_value, iinfo = 0, info;
+
+    need_value = (options->RowPerm == LargeDiag_MC64
+                  || options->RowPerm == LargeDiag_HWPM);
+    pzCompRow_loc_to_CompCol_global(need_value, A, grid, &GA);
+    GAstore = (NCformat *) GA.Store;
+    rowind = GAstore->rowind;
+
+    if ( !(perm_r = intMalloc_dist(m)) ) ABORT("Malloc fails for perm_r[].");
+    if ( !(perm_c = intMalloc_dist(n)) ) ABORT("Malloc fails for perm_c[].");
+
+    for (i = 0; i < m; ++i) perm_r[i] = i;
+    if ( options->RowPerm == MY_PERMR ) {
+        for (i = 0; i < m; ++i) perm_r[i] = ScalePermstruct->perm_r[i];
+    } else if ( options->RowPerm == LargeDiag_LDM ) {
+	if ( !(R1 = doubleMalloc_dist(m)) ) ABORT("Malloc fails for R1[].");
+	if ( !(C1 = doubleMalloc_dist(n)) ) ABORT("Malloc fails for C1[].");
+	iinfo = pzldperm_dist(A, grid, GAstore->colptr, rowind, perm_r, R1, C1);
+	if ( iinfo ) for (i = 0; i < m; ++i) perm_r[i] = i;
+	SUPERLU_FREE(R1);
+	SUPERLU_FREE(C1);
+    } else if ( need_value ) {
+        if ( !grid->iam ) { /* Process 0 finds a row permutation */
+	    if ( !(R1 = doubleMalloc_dist(m)) ) ABORT("Malloc fails for R1[].");
+	    if ( !(C1 = doubleMalloc_dist(n)) ) ABORT("Malloc fails for C1[].");
+	    iinfo = zldperm_dist(5, m, GAstore->nnz, GAstore->colptr, rowind,
+	                         (doublecomplex *) GAstore->nzval, perm_r, R1, C1);
+	    SUPERLU_FREE(R1);
+	    SUPERLU_FREE(C1);
+	}
+	MPI_Bcast( &iinfo, 1, MPI_INT, 0, grid->comm );
+	if ( iinfo == 0 ) MPI_Bcast( perm_r, m, mpi_int_t, 0, grid->comm );
+	else for (i = 0; i < m; ++i) perm_r[i] = i;
+    }
+    for (i = 0; i < GAstore->nnz; ++i) rowind[i] = perm_r[rowind[i]];
+
+    if ( options->ColPerm == MY_PERMC )
+        for (i = 0; i < n; ++i) perm_c[i] = ScalePermstruct->perm_c[i];
+
+    info = superlu_symbfact_predict(options, &GA, perm_c, sizeof(doublecomplex),
+                                    grid, ncand, pred);
+
+    /* A complex multiply-add is 8 real flops, as counted in pzgstrf. */
+    for (i = 0; i < ncand; ++i) {
+        pred[i].flops *= 4.0;
+        pred[i].crit_flops *= 4.0;
+    }
+
+    SUPERLU_FREE(perm_r);
+    SUPERLU_FREE(perm_c);
+    Destroy_CompCol_Matrix_dist(&GA);
+    return info;
+} /* pzsymbfact_predict */
+
+
 /*! \brief Permute the distributed dense matrix: B <= perm(X). perm[i] = j means the i-th row of X is in the j-th row of B.
  */
 int pzPermute_Dense_Matrix
@@ -415,6 +497,11 @@ void zLUstructInit(const int_t n, zLUstruct_t *LUstruct)
 	   SUPERLU_MALLOC(sizeof(zLocalLU_t))) )
 	ABORT("Malloc fails for LocalLU_t.");
 	LUstruct->Llu->inv = 0;
+	LUstruct->Llu->shmL = LUstruct->Llu->shmU = NULL;
+	LUstruct->Llu->segL = LUstruct->Llu->segU = NULL;
+	LUstruct->Llu->aggL = LUstruct->Llu->aggU = NULL;
+	LUstruct->Llu->rmaL = LUstruct->Llu->rmaU = NULL;
+	LUstruct->Llu->nodeCost = NULL;
 }
 
 /*! \brief Deallocate LUstruct */
@@ -428,6 +515,7 @@ void zLUstructFree(zLUstruct_t *LUstruct)
 
     SUPERLU_FREE(LUstruct->etree);
     SUPERLU_FREE(LUstruct->Glu_persist);
+    if ( LUstruct->Llu->nodeCost ) SUPERLU_FREE(LUstruct->Llu->nodeCost);
     SUPERLU_FREE(LUstruct->Llu);
 
 #if ( DEBUGlevel>=1 )
@@ -454,7 +542,7 @@ zDestroy_LU(int_t n, gridinfo_t *grid, zLUstruct_t *LUstruct)
     nsupers = Glu_persist->supno[n-1] + 1;
 
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->npcol);
+    // nb = NLBj( nsupers, grid );
     // for (i = 0; i < nb; ++i) 
     //	if ( Llu->Lrowind_bc_ptr[i] ) {
     //	    SUPERLU_FREE (Llu->Lrowind_bc_ptr[i]);
@@ -473,7 +561,7 @@ zDestroy_LU(int_t n, gridinfo_t *grid, zLUstruct_t *LUstruct)
     SUPERLU_FREE (Llu->Lnzval_bc_offset);
     
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->nprow);
+    // nb = NLBi( nsupers, grid );
     // for (i = 0; i < nb; ++i)
     //	if ( Llu->Ufstnz_br_ptr[i] ) {
     //	    SUPERLU_FREE (Llu->Ufstnz_br_ptr[i]);
@@ -503,7 +591,7 @@ zDestroy_LU(int_t n, gridinfo_t *grid, zLUstruct_t *LUstruct)
     SUPERLU_FREE(Llu->mod_bit);
 
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->npcol);
+    // nb = NLBj( nsupers, grid );
     // for (i = 0; i < nb; ++i) 
     //	if ( Llu->Lindval_loc_bc_ptr[i]!=NULL) {
     //	    SUPERLU_FREE (Llu->Lindval_loc_bc_ptr[i]);
@@ -513,7 +601,7 @@ zDestroy_LU(int_t n, gridinfo_t *grid, zLUstruct_t *LUstruct)
     SUPERLU_FREE(Llu->Lindval_loc_bc_offset);
 	
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->npcol);
+    // nb = NLBj( nsupers, grid );
     // for (i=0; i<nb; ++i) {
     //	if(Llu->Linv_bc_ptr[i]!=NULL) {
     //	    SUPERLU_FREE(Llu->Linv_bc_ptr[i]);
@@ -531,7 +619,7 @@ zDestroy_LU(int_t n, gridinfo_t *grid, zLUstruct_t *LUstruct)
     SUPERLU_FREE(Llu->Unnz);
 	
     /* Following are free'd in distribution routines */
-    // nb = CEILING(nsupers, grid->npcol);
+    // nb = NLBj( nsupers, grid );
     // for (i = 0; i < nb; ++i)
     //	if ( Llu->Urbs[i] ) {
     //	    SUPERLU_FREE(Llu->Ucb_indptr[i]);
@@ -547,6 +635,7 @@ zDestroy_LU(int_t n, gridinfo_t *grid, zLUstruct_t *LUstruct)
     
     SUPERLU_FREE(Glu_persist->xsup);
     SUPERLU_FREE(Glu_persist->supno);
+    superlu_smap_free(grid);
 
 #ifdef GPU_ACC
     checkGPU (gpuFree (Llu->d_xsup));
@@ -622,7 +711,7 @@ pzgstrs_init(int_t n, int_t m_loc, int_t nrhs, int_t fst_row,
     int *sdispls, *sdispls_nrhs, *rdispls, *rdispls_nrhs;
     int *itemp, *ptr_to_ibuf, *ptr_to_dbuf;
     int_t *row_to_proc;
-    int_t i, gbi, k, l, num_diag_procs, *diag_procs;
+    int_t i, gbi, k, l;
     int_t irow, q, knsupc, nsupers, *xsup, *supno;
     int   iam, p, pkk, procs;
     pxgstrs_comm_t *gstrs_comm;
@@ -692,24 +781,19 @@ pzgstrs_init(int_t n, int_t m_loc, int_t nrhs, int_t fst_row,
 
     /* Count the number of X entries to be sent to each process.*/
     for (p = 0; p < procs; ++p) SendCnt[p] = 0;
-    num_diag_procs = SOLVEstruct->num_diag_procs;
-    diag_procs = SOLVEstruct->diag_procs;
-
-    for (p = 0; p < num_diag_procs; ++p) { /* for all diagonal processes */
-	pkk = diag_procs[p];
+    for (k = 0; k < nsupers; ++k) { /* for my diagonal blocks */
+	pkk = PNUM( PROW(k,grid), PCOL(k,grid), grid );
 	if ( iam == pkk ) {
-	    for (k = p; k < nsupers; k += num_diag_procs) {
-		knsupc = SuperSize( k );
-		irow = FstBlockC( k );
-		for (i = 0; i < knsupc; ++i) {
+	    knsupc = SuperSize( k );
+	    irow = FstBlockC( k );
+	    for (i = 0; i < knsupc; ++i) {
 #if 0
-		    q = row_to_proc[inv_perm_c[irow]];
+		q = row_to_proc[inv_perm_c[irow]];
 #else
-		    q = row_to_proc[irow];
+		q = row_to_proc[irow];
 #endif
-		    ++SendCnt[q];
-		    ++irow;
-		}
+		++SendCnt[q];
+		++irow;
 	    }
 	}
     }
@@ -873,6 +957,8 @@ void zDestroy_A3d_gathered_on_2d(zSOLVEstruct_t *SOLVEstruct, gridinfo3d_t *grid
         SUPERLU_FREE(A3d->procs_recv_from_list);
         SUPERLU_FREE(A3d->recv_count_list);
     }
+    if ( A3d->trf3Dpart )        // 3D partition of the last factorization
+	zDestroy_trf3Dpartition(A3d->trf3Dpart, grid3d);
     SUPERLU_FREE( A2d );         // free 2D structure
     SUPERLU_FREE( A3d );         // free 3D structure
 } /* zDestroy_A3d_gathered_on_2d */
@@ -932,29 +1018,29 @@ zDestroy_Tree(int_t n, gridinfo_t *grid, zLUstruct_t *LUstruct)
 
     nsupers = Glu_persist->supno[n-1] + 1;
 
-    nb = CEILING(nsupers, grid->npcol);
+    nb = NLBj( nsupers, grid );
     for (i=0;i<nb;++i){
         if(Llu->LBtree_ptr[i].empty_==NO){    
 			// BcTree_Destroy(Llu->LBtree_ptr[i],LUstruct->dt);
-            C_BcTree_Nullify(&Llu->LBtree_ptr[i]);
+            C_BcTree_Destroy(&Llu->LBtree_ptr[i]);
 	}
         if(Llu->UBtree_ptr[i].empty_==NO){  
 			// BcTree_Destroy(Llu->UBtree_ptr[i],LUstruct->dt);
-            C_BcTree_Nullify(&Llu->UBtree_ptr[i]);
+            C_BcTree_Destroy(&Llu->UBtree_ptr[i]);
 	}
     }
     SUPERLU_FREE(Llu->LBtree_ptr);
     SUPERLU_FREE(Llu->UBtree_ptr);
 	
-    nb = CEILING(nsupers, grid->nprow);
+    nb = NLBi( nsupers, grid );
     for (i=0;i<nb;++i){
         if(Llu->LRtree_ptr[i].empty_==NO){             
 			// RdTree_Destroy(Llu->LRtree_ptr[i],LUstruct->dt);
-            C_RdTree_Nullify(&Llu->LRtree_ptr[i]);
+            C_RdTree_Destroy(&Llu->LRtree_ptr[i]);
 	}
         if(Llu->URtree_ptr[i].empty_==NO){ 
 			// RdTree_Destroy(Llu->URtree_ptr[i],LUstruct->dt);
-            C_RdTree_Nullify(&Llu->URtree_ptr[i]);
+            C_RdTree_Destroy(&Llu->URtree_ptr[i]);
 	}
     }
     SUPERLU_FREE(Llu->LRtree_ptr);
@@ -52,9 +52,11 @@ int_t sIBcast_LPanel
         {
 
 
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
             MPI_Isend (lsub, msgcnt[0], mpi_int_t, pj,
                        SLU_MPI_TAG (0, k0) /* 0 */ ,
                        scp->comm, &send_req[pj]);
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], MPI_FLOAT);
             MPI_Isend (lusup, msgcnt[1], MPI_FLOAT, pj,
                        SLU_MPI_TAG (1, k0) /* 1 */ ,
                        scp->comm, &send_req[pj + Pc]);
@@ -94,9 +96,11 @@ int_t sBcast_LPanel
         {
 
 
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
             MPI_Send (lsub, msgcnt[0], mpi_int_t, pj,
                        SLU_MPI_TAG (0, k0) /* 0 */ ,
                        scp->comm);
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], MPI_FLOAT);
             MPI_Send (lusup, msgcnt[1], MPI_FLOAT, pj,
                        SLU_MPI_TAG (1, k0) /* 1 */ ,
                        scp->comm);
@@ -138,10 +142,12 @@ int_t sIBcast_UPanel
             if (pi != myrow)
             {
 
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[2], mpi_int_t);
                 MPI_Isend (usub, msgcnt[2], mpi_int_t, pi,
                            SLU_MPI_TAG (2, k0) /* (4*k0+2)%tag_ub */ ,
                            scp->comm,
                            &send_req_u[pi]);
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[3], MPI_FLOAT);
                 MPI_Isend (uval, msgcnt[3], MPI_FLOAT,
                            pi, SLU_MPI_TAG (3, k0) /* (4*kk0+3)%tag_ub */ ,
                            scp->comm,
@@ -182,9 +188,11 @@ int_t sBcast_UPanel(int_t k, int_t k0, int_t* usub,
         {
             if (pi != myrow)
             {
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[2], mpi_int_t);
                 MPI_Send (usub, msgcnt[2], mpi_int_t, pi,
                           SLU_MPI_TAG (2, k0) /* (4*k0+2)%tag_ub */ ,
                           scp->comm);
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[3], MPI_FLOAT);
                 MPI_Send (uval, msgcnt[3], MPI_FLOAT, pi,
                           SLU_MPI_TAG (3, k0) /* (4*k0+3)%tag_ub */ ,
                           scp->comm);
@@ -298,6 +306,7 @@ int_t sISend_UDiagBlock(int_t k0, float *ublk_ptr, /*pointer for the diagonal bl
         {
             /* tag = ((k0<<2)+2) % tag_ub;        */
             /* tag = (4*(nsupers+k0)+2) % tag_ub; */
+            commProfSend(COMM_DIAG, comm, pr, size, MPI_FLOAT);
             MPI_Isend (ublk_ptr, size, MPI_FLOAT, pr,
                        SLU_MPI_TAG (4, k0) /* tag */ ,
                        comm, U_diag_blk_send_req + pr);
@@ -369,6 +378,7 @@ int_t sISend_LDiagBlock(int_t k0, float *lblk_ptr, /*pointer for the diagonal bl
         {
             /* tag = ((k0<<2)+2) % tag_ub;        */
             /* tag = (4*(nsupers+k0)+2) % tag_ub; */
+            commProfSend(COMM_DIAG, comm, pc, size, MPI_FLOAT);
             MPI_Isend (lblk_ptr, size, MPI_FLOAT, pc,
                        SLU_MPI_TAG (5, k0) /* tag */ ,
                        comm, L_diag_blk_send_req + pc);
@@ -548,7 +548,7 @@ void treeImbalance3D(gridinfo3d_t *grid3d, SCT_t* SCT)
         double tmax;
         MPI_Reduce( &SCT->tFactor3D[i], &tmax,  1, MPI_DOUBLE, MPI_MAX, 0, grid3d->zscp.comm );
         
-        double tavg = tsum /(grid3d->zscp.Np>>i);
+        double tavg = tsum /((grid3d->zscp.Np + (1 << i) - 1) >> i);
         double lLmb =  100*(tmax-tavg)/tavg;
         sprintf( funName, "Imbalance Factor:Level-%d    ",  (int) maxLvl-1-i);
         if(!grid3d->zscp.Iam)
@@ -254,9 +254,11 @@ while (j < nub && perm_u[2 * j] <= k0 + num_look_aheads)
 #if ( PROFlevel>=1 )
                 TIC (t1);
 #endif
+                commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
                 MPI_Isend (lsub1, msgcnt[0], mpi_int_t, pj,
                            SLU_MPI_TAG (0, kk0) /* (4*kk0)%tag_ub */ ,
                            scp->comm, &send_req[pj]);
+                commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], MPI_FLOAT);
                 MPI_Isend (lusup1, msgcnt[1], MPI_FLOAT, pj,
                            SLU_MPI_TAG (1, kk0) /* (4*kk0+1)%tag_ub */ ,
                            scp->comm, &send_req[pj + Pc]);
@@ -58,6 +58,14 @@ at the top-level directory.
 		 done in multiple partitions, may be slower.
 	    = 9: number of GPU streams
 	    = 10: whether to offload work to GPU or not
+	    = 11: the autotuning mode for parameters 2, 3 and the number
+	          of look-aheads (0: off, 1: lookup, 2: tune);
+	          see superlu_autotune.c
+	    = 12: the cost compared by ColPerm = BEST_ORDERING
+	          (0: factorization flops, 1: nnz(L+U))
+	    = 13: whether the serial symbolic factorization is computed by
+	          one process per shared-memory node and shared with the
+	          others (1), or by every process (0); see symbfact_shared()
 
    options (input) superlu_dist_options_t*
            The structure defines the input parameters to control
@@ -145,6 +153,21 @@ sp_ienv_dist(int ispec, superlu_dist_options_t *options)
 	    if (ttemp) 
 		return atoi (ttemp);
 	    else return (options->superlu_acc_offload);
+         case 11:
+  	    ttemp = getenv ("SUPERLU_AUTOTUNE");
+	    if (ttemp) 
+		return atoi (ttemp);
+	    else return (options->superlu_autotune);
+         case 12:
+  	    ttemp = getenv ("SUPERLU_ORDERING_METRIC");
+	    if (ttemp) 
+		return atoi (ttemp);
+	    else return (0);
+         case 13:
+  	    ttemp = getenv ("SUPERLU_SYMBFACT_NODE");
+	    if (ttemp) 
+		return atoi (ttemp);
+	    else return (0);
     }
 
     /* Invalid value for ISPEC */
@@ -400,7 +400,16 @@ int_t sIBcastRecvLPanel(
     int_t kcol = PCOL (k, grid);
     int_t** Lrowind_bc_ptr = Llu->Lrowind_bc_ptr;
     float** Lnzval_bc_ptr = Llu->Lnzval_bc_ptr;
-    /* code */
+    /* Lsub_buf may be a node-shared slot (SUPERLU_SHM_BCAST), a slot in
+       an RMA window (SUPERLU_BCAST_RMA) or a slot of the segmented tree
+       broadcast (SUPERLU_BCAST_SEG). */
+    shmBcast_t *sh = Llu->shmL;
+    int s = shmBcastSlot(sh, Lsub_buf);
+    int t = segBcastSlot(Llu->segL, Lsub_buf);
+    int a = aggBcastSlot(Llu->aggL, Lsub_buf, k);
+    int r = rmaBcastSlot(Llu->rmaL, Lsub_buf);
+    if (s >= 0) shmBcastNext(sh, s, k);
+
     if (mycol == kcol)
     {
         /*send the L panel to myrow*/
@@ -409,8 +418,42 @@ int_t sIBcastRecvLPanel(
         int_t* lsub = Lrowind_bc_ptr[lk];
         float* lusup = Lnzval_bc_ptr[lk];
 
-        sIBcast_LPanel (k, k0, lsub, lusup, grid, msgcnt, send_req,
-		       ToSendR, xsup, tag_ub);
+        if (a >= 0)
+        {
+            /*small panel, sent with the rest of its batch*/
+            msgcnt[0] = lsub ? lsub[1] + BC_HEADER + lsub[0] * LB_DESCRIPTOR : 0;
+            msgcnt[1] = lsub ? lsub[1] * SuperSize (k) : 0;
+            aggBcastIsend(Llu->aggL, a, k, ToSendR[lk], lsub, msgcnt[0],
+                          lusup, msgcnt[1], SLU_MPI_TAG (0, k0));
+        }
+        else if (s >= 0)
+        {
+            /*send one copy per node group*/
+            msgcnt[0] = lsub ? lsub[1] + BC_HEADER + lsub[0] * LB_DESCRIPTOR : 0;
+            msgcnt[1] = lsub ? lsub[1] * SuperSize (k) : 0;
+            shmBcastIsend(sh, ToSendR[lk], mycol, lsub, msgcnt[0],
+                          lusup, msgcnt[1], SLU_MPI_TAG (0, k0),
+                          SLU_MPI_TAG (1, k0), send_req);
+        }
+        else if (r >= 0)
+        {
+            /*put the panel into the readers' slots*/
+            msgcnt[0] = lsub ? lsub[1] + BC_HEADER + lsub[0] * LB_DESCRIPTOR : 0;
+            msgcnt[1] = lsub ? lsub[1] * SuperSize (k) : 0;
+            rmaBcastIsend(Llu->rmaL, r, k, ToSendR[lk], lsub, msgcnt[0],
+                          lusup, msgcnt[1]);
+        }
+        else if (t >= 0)
+        {
+            /*send long panels down the tree in segments*/
+            msgcnt[0] = lsub ? lsub[1] + BC_HEADER + lsub[0] * LB_DESCRIPTOR : 0;
+            msgcnt[1] = lsub ? lsub[1] * SuperSize (k) : 0;
+            segBcastIsend(Llu->segL, t, k, lsub, msgcnt[0], lusup, msgcnt[1],
+                          SLU_MPI_TAG (0, k0), SLU_MPI_TAG (1, k0), send_req);
+        }
+        else
+            sIBcast_LPanel (k, k0, lsub, lusup, grid, msgcnt, send_req,
+                            ToSendR, xsup, tag_ub);
 
         if (lsub)
         {
@@ -427,10 +470,25 @@ int_t sIBcastRecvLPanel(
         if (ToRecv[k] >= 1)     /* Recv block column L(:,0). */
         {
             /*place Irecv*/
-            sIrecv_LPanel (k, k0, Lsub_buf, Lval_buf, grid, recv_req, Llu, tag_ub);
+            if (a >= 0)
+                aggBcastIrecv(Llu->aggL, a, k, kcol, 1, SLU_MPI_TAG (0, k0),
+                              msgcnt);
+            else if (s >= 0)
+                shmBcastIrecv(sh, s, k, kcol, SLU_MPI_TAG (0, k0),
+                              SLU_MPI_TAG (1, k0), recv_req);
+            else if (r >= 0)
+                rmaBcastIrecv(Llu->rmaL, r, k, kcol);
+            else if (t >= 0)
+                segBcastIrecv(Llu->segL, t, k, kcol, SLU_MPI_TAG (0, k0),
+                              SLU_MPI_TAG (1, k0), recv_req);
+            else
+                sIrecv_LPanel (k, k0, Lsub_buf, Lval_buf, grid, recv_req, Llu, tag_ub);
         }
         else
         {
+            if (a >= 0)
+                aggBcastIrecv(Llu->aggL, a, k, kcol, 0, SLU_MPI_TAG (0, k0),
+                              NULL);
             msgcnt[0] = 0;
         }
 
@@ -458,14 +516,63 @@ int_t sIBcastRecvUPanel(int_t k, int_t k0, int* msgcnt,
 
     int_t** Ufstnz_br_ptr = Llu->Ufstnz_br_ptr;
     float** Unzval_br_ptr = Llu->Unzval_br_ptr;
+    shmBcast_t *sh = Llu->shmU;
+    int s = shmBcastSlot(sh, Usub_buf);
+    int t = segBcastSlot(Llu->segU, Usub_buf);
+    int a = aggBcastSlot(Llu->aggU, Usub_buf, k);
+    int r = rmaBcastSlot(Llu->rmaU, Usub_buf);
+    if (s >= 0) shmBcastNext(sh, s, k);
+
     if (myrow == krow)
     {
         /*send U panel to myrow*/
         int_t   lk = LBi (k, grid);
         int_t*  usub = Ufstnz_br_ptr[lk];
         float* uval = Unzval_br_ptr[lk];
-        sIBcast_UPanel(k, k0, usub, uval, grid, msgcnt,
-                        send_requ, ToSendD, tag_ub);
+        if (a >= 0)
+        {
+            /*small panel, sent with the rest of its batch*/
+            msgcnt[2] = usub ? usub[2] : 0;
+            msgcnt[3] = usub ? usub[1] : 0;
+            if (ToSendD[lk] == YES)
+                aggBcastIsend(Llu->aggU, a, k, NULL, usub, msgcnt[2],
+                              uval, msgcnt[3], SLU_MPI_TAG (2, k0));
+            else
+                aggBcastIrecv(Llu->aggU, a, k, -1, 0, SLU_MPI_TAG (2, k0),
+                              NULL);
+        }
+        else if (s >= 0)
+        {
+            /*send one copy per node group*/
+            msgcnt[2] = usub ? usub[2] : 0;
+            msgcnt[3] = usub ? usub[1] : 0;
+            if (ToSendD[lk] == YES)
+                shmBcastIsend(sh, NULL, myrow, usub, msgcnt[2],
+                              uval, msgcnt[3], SLU_MPI_TAG (2, k0),
+                              SLU_MPI_TAG (3, k0), send_requ);
+        }
+        else if (r >= 0)
+        {
+            /*put the panel into the readers' slots*/
+            msgcnt[2] = usub ? usub[2] : 0;
+            msgcnt[3] = usub ? usub[1] : 0;
+            if (ToSendD[lk] == YES)
+                rmaBcastIsend(Llu->rmaU, r, k, NULL, usub, msgcnt[2],
+                              uval, msgcnt[3]);
+        }
+        else if (t >= 0)
+        {
+            /*send long panels down the tree in segments*/
+            msgcnt[2] = usub ? usub[2] : 0;
+            msgcnt[3] = usub ? usub[1] : 0;
+            if (ToSendD[lk] == YES)
+                segBcastIsend(Llu->segU, t, k, usub, msgcnt[2],
+                              uval, msgcnt[3], SLU_MPI_TAG (2, k0),
+                              SLU_MPI_TAG (3, k0), send_requ);
+        }
+        else
+            sIBcast_UPanel(k, k0, usub, uval, grid, msgcnt,
+                           send_requ, ToSendD, tag_ub);
         if (usub)
         {
             /* code */
@@ -479,10 +586,25 @@ int_t sIBcastRecvUPanel(int_t k, int_t k0, int* msgcnt,
         /*receive U panels */
         if (ToRecv[k] == 2)     /* Recv block row U(k,:). */
         {
-            sIrecv_UPanel (k, k0, Usub_buf, Uval_buf, Llu, grid, recv_requ, tag_ub);
+            if (a >= 0)
+                aggBcastIrecv(Llu->aggU, a, k, krow, 1, SLU_MPI_TAG (2, k0),
+                              &msgcnt[2]);
+            else if (s >= 0)
+                shmBcastIrecv(sh, s, k, krow, SLU_MPI_TAG (2, k0),
+                              SLU_MPI_TAG (3, k0), recv_requ);
+            else if (r >= 0)
+                rmaBcastIrecv(Llu->rmaU, r, k, krow);
+            else if (t >= 0)
+                segBcastIrecv(Llu->segU, t, k, krow, SLU_MPI_TAG (2, k0),
+                              SLU_MPI_TAG (3, k0), recv_requ);
+            else
+                sIrecv_UPanel (k, k0, Usub_buf, Uval_buf, Llu, grid, recv_requ, tag_ub);
         }
         else
         {
+            if (a >= 0)
+                aggBcastIrecv(Llu->aggU, a, k, krow, 0, SLU_MPI_TAG (2, k0),
+                              NULL);
             msgcnt[2] = 0;
         }
     }
@@ -495,15 +617,25 @@ int_t sWaitL( int_t k, int* msgcnt, int* msgcntU,
     	      gridinfo_t *grid, sLUstruct_t *LUstruct, SCT_t *SCT)
 {
     sLocalLU_t *Llu = LUstruct->Llu;
+    int_t* xsup = LUstruct->Glu_persist->xsup;
     int** ToSendR = Llu->ToSendR;
     int* ToRecv = Llu->ToRecv;
     int_t iam = grid->iam;
     int_t mycol = MYCOL (iam, grid);
     int_t kcol = PCOL (k, grid);
+    double t1 = SuperLU_timer_();
+    if (aggBcastWait(Llu->aggL, k))
+    {
+        /*the batch of k was completed with its first panel*/
+        SCT->Wait_LRecv_tl += SuperLU_timer_() - t1;
+        return 0;
+    }
     if (mycol == kcol)
     {
         /*send the L panel to myrow*/
-        Wait_LSend (k, grid, ToSendR, send_req, SCT);
+        if (!rmaBcastWaitSend(Llu->rmaL, k))
+            Wait_LSend (k, grid, ToSendR, send_req, SCT);
+        segBcastWaitSend(Llu->segL, k);
     }
     else
     {
@@ -511,7 +643,31 @@ int_t sWaitL( int_t k, int* msgcnt, int* msgcntU,
         if (ToRecv[k] >= 1)     /* Recv block column L(:,0). */
         {
             /*force wait for I recv to complete*/
-            sWait_LRecv( recv_req,  msgcnt, msgcntU, grid, SCT);
+            int s = shmBcastHeld(Llu->shmL, k);
+            if (s >= 0)
+            {
+                t1 = SuperLU_timer_();
+                shmBcastWait(Llu->shmL, s, k, recv_req, msgcnt);
+                SCT->Wait_LRecv_tl += SuperLU_timer_() - t1;
+            }
+            else if ((s = rmaBcastHeld(Llu->rmaL, k)) >= 0)
+            {
+                t1 = SuperLU_timer_();
+                rmaBcastWait(Llu->rmaL, s, k, msgcnt);
+                SCT->Wait_LRecv_tl += SuperLU_timer_() - t1;
+            }
+            else if ((s = segBcastHeld(Llu->segL, k)) >= 0)
+            {
+                /*the index part gives the length of the value part*/
+                segBcast_t *sb = Llu->segL;
+                t1 = SuperLU_timer_();
+                segBcastWaitIndex(sb, s, recv_req, msgcnt);
+                segBcastWaitValue(sb, s, k, msgcnt[0] ?
+                                  sb->sub[s][1] * SuperSize (k) : 0, msgcnt);
+                SCT->Wait_LRecv_tl += SuperLU_timer_() - t1;
+            }
+            else
+                sWait_LRecv( recv_req,  msgcnt, msgcntU, grid, SCT);
         }
     }
 
@@ -529,11 +685,22 @@ int_t sWaitU( int_t k, int* msgcnt,
     int_t iam = grid->iam;
     int_t myrow = MYROW (iam, grid);
     int_t krow = PROW (k, grid);
+    double t1 = SuperLU_timer_();
+    if (aggBcastWait(Llu->aggU, k))
+    {
+        /*the batch of k was completed with its first panel*/
+        SCT->Wait_URecv_tl += SuperLU_timer_() - t1;
+        return 0;
+    }
     if (myrow == krow)
     {
         int_t lk = LBi (k, grid);
         if (ToSendD[lk] == YES)
-            Wait_USend(send_requ, grid, SCT);
+        {
+            if (!rmaBcastWaitSend(Llu->rmaU, k))
+                Wait_USend(send_requ, grid, SCT);
+            segBcastWaitSend(Llu->segU, k);
+        }
     }
     else
     {
@@ -541,7 +708,30 @@ int_t sWaitU( int_t k, int* msgcnt,
         if (ToRecv[k] == 2)     /* Recv block row U(k,:). */
         {
             /*force wait*/
-            sWait_URecv( recv_requ, msgcnt, SCT);
+            int s = shmBcastHeld(Llu->shmU, k);
+            if (s >= 0)
+            {
+                t1 = SuperLU_timer_();
+                shmBcastWait(Llu->shmU, s, k, recv_requ, &msgcnt[2]);
+                SCT->Wait_URecv_tl += SuperLU_timer_() - t1;
+            }
+            else if ((s = rmaBcastHeld(Llu->rmaU, k)) >= 0)
+            {
+                t1 = SuperLU_timer_();
+                rmaBcastWait(Llu->rmaU, s, k, &msgcnt[2]);
+                SCT->Wait_URecv_tl += SuperLU_timer_() - t1;
+            }
+            else if ((s = segBcastHeld(Llu->segU, k)) >= 0)
+            {
+                segBcast_t *sb = Llu->segU;
+                t1 = SuperLU_timer_();
+                segBcastWaitIndex(sb, s, recv_requ, &msgcnt[2]);
+                segBcastWaitValue(sb, s, k, msgcnt[2] ? sb->sub[s][1] : 0,
+                                  &msgcnt[2]);
+                SCT->Wait_URecv_tl += SuperLU_timer_() - t1;
+            }
+            else
+                sWait_URecv( recv_requ, msgcnt, SCT);
         }
     }
     return 0;
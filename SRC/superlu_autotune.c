@@ -0,0 +1,454 @@
+/*! \file
+Copyright (c) 2003, The Regents of the University of California, through
+Lawrence Berkeley National Laboratory (subject to receipt of any required
+approvals from U.S. Dept. of Energy)
+
+All rights reserved.
+
+The source code is distributed under BSD license, see the file License.txt
+at the top-level directory.
+*/
+/*! @file
+ * \brief Automatic tuning of the blocking parameters with a tuning database
+ *
+ * <pre>
+ * -- Distributed SuperLU routine (version 8.1.2) --
+ * Lawrence Berkeley National Lab, Univ. of California Berkeley.
+ * October 18, 2026
+ *
+ * The performance of the factorization depends on superlu_relax,
+ * superlu_maxsup, num_lookaheads and, when the Schur complement update
+ * is offloaded to the GPU, the GEMM size threshold superlu_n_gemm;
+ * these otherwise come from the options or the environment (see
+ * sp_ienv.c).  The autotuner keys a setting on a few features of the
+ * matrix:
+ *     n, nnz(A), the pattern symmetry, and the fill ratio predicted
+ *     from the column counts of Pc*(A'+A)*Pc',
+ * together with the number of processes.
+ *
+ * The candidate (relax, maxsup) pairs are compared by a cheap symbolic
+ * model: the supernode partition is derived from the etree and the
+ * column counts, and each supernode is charged its flops at a rate that
+ * grows with the supernode width, plus a fixed per-supernode overhead.
+ * The number of look-aheads and the GEMM threshold do not show up in a
+ * symbolic model, so they are explored across runs: each tuning run
+ * records the measured factorization time, and once all candidates
+ * have been timed the fastest setting is used.
+ *
+ * The process grid is created by the caller before the matrix is
+ * seen, so its shape cannot be changed here.  Records of other grid
+ * shapes with the same number of processes are kept in the search
+ * nevertheless: if one of them factored the matrix faster than the
+ * best setting on the current grid, that shape is reported (with
+ * PrintStat) for the next run.
+ *
+ * The database is a plain text file, one run per line, named by the
+ * environment variable SUPERLU_TUNING_DB.  Without it nothing is read
+ * or written, and only the model choice is available.  Only process 0
+ * reads and writes the file.
+ *
+ * The tuned values are placed in options for the symbolic and the
+ * numerical factorization only; superlu_autotune_record() gives the
+ * caller's values back afterwards.  The one exception is a tuned
+ * superlu_maxsup larger than the caller's: it stays, as it bounds the
+ * supernode size that the solve and later factorizations with the same
+ * pattern rely on.
+ * </pre>
+ */
+
+#include <math.h>
+#include "superlu_ddefs.h"
+
+/* Per-supernode overhead of the factorization, in flops. */
+#define TUNE_ALPHA  2.0e5
+/* Supernode width at which GEMM runs at half of its peak rate. */
+#define TUNE_W0     32.0
+
+static const int relax_cand[] = {8, 16, 32, 60, 100, 160};
+static const int maxsup_cand[] = {64, 128, 256, 512};
+static const int lookahead_cand[] = {5, 10, 15, 20};
+static const int n_gemm_cand[] = {1000, 5000, 20000, 100000};
+#define NRELAX      ((int) (sizeof(relax_cand) / sizeof(int)))
+#define NMAXSUP     ((int) (sizeof(maxsup_cand) / sizeof(int)))
+#define NLOOKAHEAD  ((int) (sizeof(lookahead_cand) / sizeof(int)))
+#define NNGEMM      ((int) (sizeof(n_gemm_cand) / sizeof(int)))
+
+typedef struct {
+    superlu_autotune_t key;
+    double time;
+} tune_record_t;
+
+static char *tune_db_name(void)
+{
+    return getenv("SUPERLU_TUNING_DB");
+}
+
+/*! \brief Compute the features of GA, and the postordered etree and the
+ *  column counts of Pc*(A'+A)*Pc' for the cost model.
+ */
+static void
+tune_analyze(SuperMatrix *GA, int_t *perm_c, int_t *parent, int_t *colcnt,
+	     superlu_autotune_t *tune)
+{
+    NCformat *Astore = GA->Store;
+    int_t n = GA->ncol, nnz = Astore->nnz;
+    int_t *colptr = Astore->colptr, *rowind = Astore->rowind;
+    int_t bnz, *b_colptr, *b_rowind = NULL, *colbeg, *colend;
+    int_t *par, *cnt, *post, i, j, ndiag = 0, offdiag;
+    double nnzLU = 0.0;
+
+    for (j = 0; j < n; ++j)
+	for (i = colptr[j]; i < colptr[j+1]; ++i)
+	    if ( rowind[i] == j ) ++ndiag;
+
+    at_plus_a_dist(n, nnz, colptr, rowind, &bnz, &b_colptr, &b_rowind);
+
+    /* Off-diagonals with a mirror counted twice in nnz(A'+A) once. */
+    offdiag = nnz - ndiag;
+    tune->sym = offdiag ? (float) (2.0 * offdiag - bnz) / offdiag : 1.0;
+
+    if ( !(colbeg = intMalloc_dist(4*n)) )
+	ABORT("Malloc fails for colbeg[]");
+    colend = colbeg + n;
+    par = colend + n;
+    cnt = par + n;
+    for (j = 0; j < n; ++j) {
+	colbeg[perm_c[j]] = b_colptr[j];
+	colend[perm_c[j]] = b_colptr[j+1];
+    }
+    for (i = 0; i < bnz; ++i) b_rowind[i] = perm_c[b_rowind[i]];
+
+    sp_symetree_dist(colbeg, colend, b_rowind, n, par);
+    sp_symcolcnt_dist(colbeg, colend, b_rowind, n, par, cnt);
+
+    /* Renumber in postorder, so that subtrees are contiguous. */
+    post = TreePostorder_dist(n, par);
+    for (j = 0; j < n; ++j) {
+	parent[post[j]] = ( par[j] == n ) ? n : post[par[j]];
+	colcnt[post[j]] = cnt[j];
+	nnzLU += 2.0 * cnt[j] - 1.0;
+    }
+
+    tune->n = n;
+    tune->nnz = nnz;
+    tune->fill = nnz ? (float) (nnzLU / nnz) : 1.0;
+
+    SUPERLU_FREE(post);
+    SUPERLU_FREE(colbeg);
+    SUPERLU_FREE(b_colptr);
+    if ( bnz ) SUPERLU_FREE(b_rowind);
+}
+
+/*! \brief Predicted factorization cost (in flops at peak rate) of the
+ *  supernode partition induced by (relax, maxsup).
+ *
+ * <pre>
+ * Relaxed supernodes are formed at the leaves as in relax_snode();
+ * the other columns are merged into T2 supernodes, i.e. column j
+ * joins j-1 when parent[j-1] = j and colcnt[j-1] = colcnt[j]+1,
+ * as long as the supernode is narrower than maxsup.
+ * </pre>
+ */
+static double
+tune_model(int_t n, int_t *parent, int_t *colcnt, int relax, int maxsup,
+	   int nprocs, int_t *desc, int_t *relax_end)
+{
+    int_t j, k, i, nsupc, nrow, r;
+    double flops, cost = 0.0;
+    double alpha = TUNE_ALPHA * (1.0 + log2((double) nprocs));
+
+    relax = SUPERLU_MIN(relax, maxsup);
+    ifill_dist(relax_end, n, SLU_EMPTY);
+    ifill_dist(desc, n+1, 0);
+    for (j = 0; j < n; j++)
+	if ( parent[j] != n ) desc[parent[j]] += desc[j] + 1;
+    for (j = 0; j < n; ) {
+	k = j;
+	while ( parent[j] != n && desc[parent[j]] < relax ) j = parent[j];
+	relax_end[k] = j;
+	++j;
+	while ( j < n && desc[j] != 0 ) ++j;
+    }
+
+    for (j = 0; j < n; j = k + 1) {
+	if ( relax_end[j] != SLU_EMPTY ) {
+	    k = relax_end[j];
+	    for (nrow = 0, i = j; i <= k; ++i)
+		nrow = SUPERLU_MAX(nrow, colcnt[i] + i - j);
+	} else {
+	    k = j;
+	    while ( k+1 < n && k+1-j < maxsup && relax_end[k+1] == SLU_EMPTY
+		    && parent[k] == k+1 && colcnt[k] == colcnt[k+1] + 1 ) ++k;
+	    nrow = colcnt[j];
+	}
+	nsupc = k - j + 1;
+
+	/* Panel factorization and Schur complement update. */
+	for (flops = 0.0, i = 0; i < nsupc; ++i) {
+	    r = nrow - i - 1;
+	    flops += (double) r + 2.0 * (double) r * (double) r;
+	}
+	cost += flops / (nprocs * nsupc / (nsupc + TUNE_W0)) + alpha;
+    }
+    return cost;
+}
+
+static int
+tune_match(superlu_autotune_t *a, superlu_autotune_t *b)
+{
+    return ( a->nprow * a->npcol == b->nprow * b->npcol
+	     && fabs((double) (a->n - b->n)) <= 0.05 * a->n
+	     && fabs((double) (a->nnz - b->nnz)) <= 0.05 * a->nnz
+	     && fabs(a->sym - b->sym) <= 0.05
+	     && fabs(a->fill - b->fill) <= 0.2 * a->fill );
+}
+
+static int
+tune_same_grid(superlu_autotune_t *a, superlu_autotune_t *b)
+{
+    return ( a->nprow == b->nprow && a->npcol == b->npcol );
+}
+
+/*! \brief Read the records of the tuning database that match tune, on
+ *  any grid with the same number of processes.
+ */
+static int
+tune_db_read(superlu_autotune_t *tune, tune_record_t **records)
+{
+    FILE *fp;
+    char line[256];
+    long long n, nnz;
+    tune_record_t rec, *recs = NULL;
+    int nrec = 0, maxrec = 0;
+
+    *records = NULL;
+    if ( !tune_db_name() || !(fp = fopen(tune_db_name(), "r")) ) return 0;
+    while ( fgets(line, sizeof(line), fp) ) {
+	if ( line[0] == '#' ) continue;
+	if ( sscanf(line, "%lld %lld %f %f %d %d %d %d %d %d %lf",
+		    &n, &nnz, &rec.key.sym, &rec.key.fill,
+		    &rec.key.nprow, &rec.key.npcol, &rec.key.relax,
+		    &rec.key.maxsup, &rec.key.num_lookaheads,
+		    &rec.key.n_gemm, &rec.time) != 11 ) continue;
+	rec.key.n = n;
+	rec.key.nnz = nnz;
+	if ( !tune_match(tune, &rec.key) ) continue;
+	if ( nrec == maxrec ) {
+	    tune_record_t *tmp;
+	    maxrec = SUPERLU_MAX(16, 2 * maxrec);
+	    if ( !(tmp = SUPERLU_MALLOC(maxrec * sizeof(tune_record_t))) )
+		ABORT("Malloc fails for tuning records.");
+	    if ( nrec ) {
+		memcpy(tmp, recs, nrec * sizeof(tune_record_t));
+		SUPERLU_FREE(recs);
+	    }
+	    recs = tmp;
+	}
+	recs[nrec++] = rec;
+    }
+    fclose(fp);
+    *records = recs;
+    return nrec;
+}
+
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *   superlu_autotune_dist() sets superlu_relax, superlu_maxsup,
+ *   num_lookaheads and superlu_n_gemm in options before the serial
+ *   symbolic factorization,
+ *   according to the mode returned by sp_ienv_dist(11) (see
+ *   superlu_defs.h).  The caller's values are saved in tune and put
+ *   back by superlu_autotune_record().  Explicit SUPERLU_RELAX / SUPERLU_MAXSUP
+ *   environment variables still take precedence in sp_ienv_dist().
+ *
+ *   All processes must call this routine.  GA is the global matrix
+ *   Pr*A in column format and perm_c the column permutation returned by
+ *   sp_colorder(); both are replicated.  On exit, tune holds the key
+ *   and the chosen setting, to be passed to superlu_autotune_record()
+ *   after the numerical factorization.
+ * </pre>
+ */
+void
+superlu_autotune_dist(superlu_dist_options_t *options, SuperMatrix *GA,
+		      int_t *perm_c, gridinfo_t *grid, superlu_autotune_t *tune)
+{
+    int_t n = GA->ncol, *parent, *colcnt, *desc, *relax_end;
+    int   i, j, g, nrec, nprocs = grid->nprow * grid->npcol, nngemm = 1;
+    int   param[5];
+    double cost, mincost, t = SuperLU_timer_();
+    tune_record_t *recs, *best = NULL, *bestgrid = NULL;
+
+    tune->mode = sp_ienv_dist(11, options);
+    tune->source = 0;
+    if ( tune->mode <= 0 || options->Fact != DOFACT || n <= 0 ) {
+	tune->mode = 0;
+	return;
+    }
+
+    if ( grid->iam == 0 ) {
+	tune->nprow = grid->nprow;
+	tune->npcol = grid->npcol;
+	tune->relax = options->superlu_relax;
+	tune->maxsup = options->superlu_maxsup;
+	tune->num_lookaheads = options->num_lookaheads;
+	tune->n_gemm = options->superlu_n_gemm;
+
+	if ( !(parent = intMalloc_dist(4*n + 1)) )
+	    ABORT("Malloc fails for parent[]");
+	colcnt = parent + n;
+	relax_end = colcnt + n;
+	desc = relax_end + n;
+	tune_analyze(GA, perm_c, parent, colcnt, tune);
+
+	nrec = tune_db_read(tune, &recs);
+	for (i = 0; i < nrec; ++i) {
+	    if ( tune_same_grid(tune, &recs[i].key) ) {
+		if ( !best || recs[i].time < best->time ) best = &recs[i];
+	    } else if ( !bestgrid || recs[i].time < bestgrid->time )
+		bestgrid = &recs[i];
+	}
+	if ( bestgrid && best && bestgrid->time >= best->time )
+	    bestgrid = NULL;
+
+#ifdef GPU_ACC
+	/* The GEMM threshold only matters when the update is offloaded. */
+	if ( get_acc_offload() ) nngemm = NNGEMM;
+#endif
+
+	if ( tune->mode >= 2 ) {
+	    /* Model choice of (relax, maxsup). */
+	    mincost = -1.0;
+	    for (i = 0; i < NRELAX; ++i) {
+		for (j = 0; j < NMAXSUP; ++j) {
+		    if ( relax_cand[i] > maxsup_cand[j] ) continue;
+		    cost = tune_model(n, parent, colcnt, relax_cand[i],
+				      maxsup_cand[j], nprocs, desc, relax_end);
+		    if ( mincost < 0.0 || cost < mincost ) {
+			mincost = cost;
+			tune->relax = relax_cand[i];
+			tune->maxsup = maxsup_cand[j];
+		    }
+		}
+	    }
+
+	    /* Explore the look-aheads and GEMM thresholds not yet timed
+	       with this choice on this grid. */
+	    for (i = 0; i < NLOOKAHEAD * nngemm; ++i) {
+		g = ( nngemm > 1 ) ? n_gemm_cand[i % nngemm] : tune->n_gemm;
+		for (j = 0; j < nrec; ++j)
+		    if ( tune_same_grid(tune, &recs[j].key)
+			 && recs[j].key.relax == tune->relax
+			 && recs[j].key.maxsup == tune->maxsup
+			 && recs[j].key.num_lookaheads
+			    == lookahead_cand[i / nngemm]
+			 && recs[j].key.n_gemm == g )
+			break;
+		if ( j == nrec ) break;
+	    }
+	    if ( i < NLOOKAHEAD * nngemm ) {
+		tune->num_lookaheads = lookahead_cand[i / nngemm];
+		tune->n_gemm = g;
+		tune->source = 2;
+	    }
+	}
+
+	if ( tune->source == 0 && best ) {
+	    tune->relax = best->key.relax;
+	    tune->maxsup = best->key.maxsup;
+	    tune->num_lookaheads = best->key.num_lookaheads;
+	    tune->n_gemm = best->key.n_gemm;
+	    tune->source = 1;
+	}
+
+	if ( bestgrid && options->PrintStat == YES ) {
+	    printf(".. autotune: a %d x %d grid factored this matrix in %.2f s",
+		   bestgrid->key.nprow, bestgrid->key.npcol, bestgrid->time);
+	    if ( best ) printf(", this grid in %.2f s", best->time);
+	    printf("\n");
+	}
+
+	if ( recs ) SUPERLU_FREE(recs);
+	SUPERLU_FREE(parent);
+
+	param[0] = tune->relax;
+	param[1] = tune->maxsup;
+	param[2] = tune->num_lookaheads;
+	param[3] = tune->n_gemm;
+	param[4] = tune->source;
+    }
+
+    MPI_Bcast(param, 5, MPI_INT, 0, grid->comm);
+    tune->relax = param[0];
+    tune->maxsup = param[1];
+    tune->num_lookaheads = param[2];
+    tune->n_gemm = param[3];
+    tune->source = param[4];
+    if ( tune->source ) {
+	tune->saved[0] = options->superlu_relax;
+	tune->saved[1] = options->superlu_maxsup;
+	tune->saved[2] = options->num_lookaheads;
+	tune->saved[3] = options->superlu_n_gemm;
+	options->superlu_relax = tune->relax;
+	options->superlu_maxsup = tune->maxsup;
+	options->num_lookaheads = tune->num_lookaheads;
+	options->superlu_n_gemm = tune->n_gemm;
+    }
+
+    if ( grid->iam == 0 && options->PrintStat == YES ) {
+	printf(".. autotune (%s): relax %d, maxsup %d, num_lookaheads %d,"
+	       " n_gemm %d\tfill %.1f, sym %.2f, time %.2f\n",
+	       tune->source == 1 ? "database" :
+	       (tune->source == 2 ? "model" : "options"),
+	       tune->relax, tune->maxsup, tune->num_lookaheads, tune->n_gemm,
+	       tune->fill, tune->sym, SuperLU_timer_() - t);
+	fflush(stdout);
+    }
+}
+
+/*! \brief Restore the caller's parameters in options after the numerical
+ *  factorization, and append the measured factorization time of a
+ *  tuning run to the database.  All processes must call this routine;
+ *  factor_time is the local time, and the maximum over the grid is
+ *  recorded.
+ */
+void
+superlu_autotune_record(superlu_dist_options_t *options,
+			superlu_autotune_t *tune, double factor_time,
+			gridinfo_t *grid)
+{
+    FILE *fp;
+    double tmax;
+    int newfile;
+
+    if ( tune->mode > 0 && tune->source ) {
+	options->superlu_relax = tune->saved[0];
+	/* The factored supernodes may be as wide as the tuned maxsup. */
+	options->superlu_maxsup = SUPERLU_MAX(tune->saved[1], tune->maxsup);
+	options->num_lookaheads = tune->saved[2];
+	options->superlu_n_gemm = tune->saved[3];
+    }
+
+    if ( tune->mode < 2 || tune->source != 2 || !tune_db_name() ) return;
+
+    MPI_Reduce(&factor_time, &tmax, 1, MPI_DOUBLE, MPI_MAX, 0, grid->comm);
+    if ( grid->iam != 0 ) return;
+
+    newfile = ( (fp = fopen(tune_db_name(), "r")) == NULL );
+    if ( fp ) fclose(fp);
+    if ( !(fp = fopen(tune_db_name(), "a")) ) {
+	fprintf(stderr, "Cannot open tuning database %s\n", tune_db_name());
+	return;
+    }
+    if ( newfile )
+	fprintf(fp, "# SuperLU_DIST tuning database\n"
+		"# n nnz sym fill nprow npcol relax maxsup "
+		"num_lookaheads n_gemm factor_time\n");
+    fprintf(fp, "%lld %lld %.4f %.4f %d %d %d %d %d %d %.6e\n",
+	    (long long) tune->n, (long long) tune->nnz, tune->sym, tune->fill,
+	    tune->nprow, tune->npcol, tune->relax, tune->maxsup,
+	    tune->num_lookaheads, tune->n_gemm, tmax);
+    fclose(fp);
+}
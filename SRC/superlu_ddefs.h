@@ -178,6 +178,17 @@ typedef struct {
 			       *  3 : maximum size of Uval_buf[]
 			       *  4 : maximum size of tempv[LDA]
 			       */
+    shmBcast_t *shmL;         /* Node-shared L receive slots, or NULL  */
+    shmBcast_t *shmU;         /* Node-shared U receive slots, or NULL  */
+    segBcast_t *segL;         /* Segmented L tree broadcast, or NULL   */
+    segBcast_t *segU;         /* Segmented U tree broadcast, or NULL   */
+    aggBcast_t *aggL;         /* Coalesced small L panels, or NULL     */
+    aggBcast_t *aggU;         /* Coalesced small U panels, or NULL     */
+    rmaBcast_t *rmaL;         /* One-sided L panel delivery, or NULL   */
+    rmaBcast_t *rmaU;         /* One-sided U panel delivery, or NULL   */
+    ancReduce_t *ancRed;      /* Pending ancestor reduction, or NULL   */
+    double *nodeCost;         /* Supernode times of the last 3D        */
+    int_t  nodeCostN;         /* factorization (SUPERLU_LBS_COST)      */
 
     /*-- Record communication schedule for factorization. --*/
     int   *ToRecv;          /* Recv from no one (0), left (1), and up (2).*/
@@ -452,6 +463,10 @@ dCompRow_to_CompCol_dist(int_t, int_t, int_t, double *, int_t *, int_t *,
 extern int
 pdCompRow_loc_to_CompCol_global(int_t, SuperMatrix *, gridinfo_t *,
 	 		        SuperMatrix *);
+extern int
+pdsymbfact_predict(superlu_dist_options_t *, SuperMatrix *,
+                   dScalePermstruct_t *, gridinfo_t *, int,
+                   superlu_predict_t *);
 extern void
 dCopy_CompCol_Matrix_dist(SuperMatrix *, SuperMatrix *);
 extern void
@@ -529,6 +544,8 @@ extern int_t pdgstrs_init(int_t, int_t, int_t, int_t,
 extern void pxgstrs_finalize(pxgstrs_comm_t *);
 extern int  dldperm_dist(int, int, int_t, int_t [], int_t [],
 		    double [], int_t *, double [], double []);
+extern int  pdldperm_dist(SuperMatrix *, gridinfo_t *, int_t [], int_t [],
+			  int_t *, double [], double []);
 extern int  dstatic_schedule(superlu_dist_options_t *, int, int,
 		            dLUstruct_t *, gridinfo_t *, SuperLUStat_t *,
 			    int_t *, int_t *, int *);
@@ -873,6 +890,8 @@ extern dtrf3Dpartition_t* dinitTrf3Dpartition(int_t nsupers,
 					     superlu_dist_options_t *options,
 					     dLUstruct_t *LUstruct, gridinfo3d_t * grid3d);
 extern void dDestroy_trf3Dpartition(dtrf3Dpartition_t *trf3Dpartition, gridinfo3d_t *grid3d);
+extern void dresetTrf3Dpartition(int_t nsupers, dtrf3Dpartition_t *,
+				 dLUstruct_t *, gridinfo3d_t *);
 
 extern void d3D_printMemUse(dtrf3Dpartition_t*  trf3Dpartition,
 			    dLUstruct_t *LUstruct, gridinfo3d_t * grid3d);
@@ -927,6 +946,11 @@ extern void pdgstrf2(superlu_dist_options_t *, int_t nsupers, int_t k0,
     /* from p3dcomm.h */
 extern int_t dAllocLlu_3d(int_t nsupers, dLUstruct_t * LUstruct, gridinfo3d_t* grid3d);
 extern int_t dp3dScatter(int_t n, dLUstruct_t * LUstruct, gridinfo3d_t* grid3d);
+extern int_t dp3dScatterValues(int_t nsupers, dtrf3Dpartition_t *,
+			       dLUstruct_t *, gridinfo3d_t *);
+extern int_t dp3dDistributeA(superlu_dist_options_t *, int_t n, NRformat_loc *,
+			     dScalePermstruct_t *, double *anorm,
+			     dtrf3Dpartition_t *, dLUstruct_t *, gridinfo3d_t *);
 extern int_t dscatter3dLPanels(int_t nsupers,
                        dLUstruct_t * LUstruct, gridinfo3d_t* grid3d);
 extern int_t dscatter3dUPanels(int_t nsupers,
@@ -955,6 +979,12 @@ extern int dreduceAllAncestors3d(int_t ilvl, int_t* myNodeCount,
                            dLUstruct_t* LUstruct,
                            gridinfo3d_t* grid3d,
                            SCT_t* SCT );
+/* nonblocking ancestor reduction, SUPERLU_ANC_ASYNC */
+extern void dancReduceInit(int_t nsupers, dLUstruct_t *LUstruct);
+extern void dancReduceProgress(dLUstruct_t *, gridinfo3d_t *);
+extern void dancReduceWait(int_t k, dLUstruct_t *, gridinfo3d_t *, SCT_t *);
+extern void dancReduceFree(dLUstruct_t *, gridinfo3d_t *, SCT_t *);
+extern void dancLazyAlloc(HyP_t *, dLUstruct_t *, gridinfo_t *);
 /*
 	Copies factored L and U panels from sender grid to receiver grid
 	receiver[L(nodelist)] <-- sender[L(nodelist)];
@@ -1172,6 +1202,9 @@ extern int_t dsparseTreeFactor_ASYNC(
 );
 extern dLUValSubBuf_t** dLluBufInitArr(int_t numLA, dLUstruct_t *LUstruct);
 extern int dLluBufFreeArr(int_t numLA, dLUValSubBuf_t **LUvsbs);
+extern int dLluBufShmInit(int_t numLA, dLUValSubBuf_t **, int_t nsupers,
+			  gridinfo_t *, dLUstruct_t *);
+extern int dLluBufShmFree(int_t numLA, dLUValSubBuf_t **, dLUstruct_t *);
 extern ddiagFactBufs_t** dinitDiagFactBufsArr(int_t mxLeafNode, int_t ldt, gridinfo_t* grid);
 extern int dfreeDiagFactBufsArr(int_t mxLeafNode, ddiagFactBufs_t** dFBufs);
 extern int_t dinitDiagFactBufs(int_t ldt, ddiagFactBufs_t* dFBuf);
@@ -264,10 +264,35 @@ static const int RD_U=4;	/* MPI tag for lsum in U-solve*/
 #define BlockNum(i)     ( supno[i] )
 #define FstBlockC(bnum) ( xsup[bnum] )
 #define SuperSize(bnum) ( xsup[bnum+1]-xsup[bnum] )
-#define LBi(bnum,grid)  ( (bnum)/grid->nprow )/* Global to local block rowwise */
-#define LBj(bnum,grid)  ( (bnum)/grid->npcol )/* Global to local block columnwise*/
-#define PROW(bnum,grid) ( (bnum) % grid->nprow )
-#define PCOL(bnum,grid) ( (bnum) % grid->npcol )
+    /* The block-cyclic (modulo) form is the expected path; the table
+       lookup is taken only when a supernode map is installed. */
+#if defined(__GNUC__)
+#define SMAP_ON(grid)   __builtin_expect( grid->smap != NULL, 0 )
+#else
+#define SMAP_ON(grid)   ( grid->smap != NULL )
+#endif
+#define LBi(bnum,grid)  ( SMAP_ON(grid) ? grid->smap->lbi[bnum] : \
+			  (bnum)/grid->nprow )/* Global to local block rowwise */
+#define LBj(bnum,grid)  ( SMAP_ON(grid) ? grid->smap->lbj[bnum] : \
+			  (bnum)/grid->npcol )/* Global to local block columnwise*/
+#define PROW(bnum,grid) ( SMAP_ON(grid) ? grid->smap->prow[bnum] : \
+			  (bnum) % grid->nprow )
+#define PCOL(bnum,grid) ( SMAP_ON(grid) ? grid->smap->pcol[bnum] : \
+			  (bnum) % grid->npcol )
+    /* Local to global block number in my process row / column; a value
+       >= nsupers means lb is past my last local block. */
+#define GBi(lb,grid)    ( SMAP_ON(grid) ? grid->smap->gbi[lb] : \
+			  (lb)*grid->nprow + MYROW(grid->iam,grid) )
+#define GBj(lb,grid)    ( SMAP_ON(grid) ? grid->smap->gbj[lb] : \
+			  (lb)*grid->npcol + MYCOL(grid->iam,grid) )
+    /* Number of local block rows / columns to size the local arrays */
+#define NLBi(nsup,grid) ( SMAP_ON(grid) ? grid->smap->nlbi : CEILING(nsup,grid->nprow) )
+#define NLBj(nsup,grid) ( SMAP_ON(grid) ? grid->smap->nlbj : CEILING(nsup,grid->npcol) )
+    /* Number of block rows / columns owned by my process row / column */
+#define MyNLBi(nsup,grid) ( SMAP_ON(grid) ? grid->smap->mynlbi : \
+	  ((nsup) + grid->nprow - 1 - MYROW(grid->iam,grid)) / grid->nprow )
+#define MyNLBj(nsup,grid) ( SMAP_ON(grid) ? grid->smap->mynlbj : \
+	  ((nsup) + grid->npcol - 1 - MYCOL(grid->iam,grid)) / grid->npcol )
 #define PNUM(i,j,grid)  ( (i)*grid->npcol + j ) /* Process number at coord(i,j) */
 #define CEILING(a,b)    ( ((a)%(b)) ? ((a)/(b) + 1) : ((a)/(b)) )
     /* For triangular solves */
@@ -378,6 +403,8 @@ extern "C" {
  *
  *  Mapping of matrix block (I,J) to process grid (pr,pc):
  *     (pr,pc) = ( MOD(I,NPROW), MOD(J,NPCOL) )
+ *  or, with a proportional mapping (superlu_smap_t), the table lookup
+ *     (pr,pc) = ( prow[I], pcol[J] )
  *  
  *  (xsup[nsupers],supno[n]) are replicated on all processors.
  *
@@ -390,6 +417,26 @@ typedef struct {
     int Iam;              /* my process number */
 } superlu_scope_t;
 
+/*-- Supernode-to-process mapping replacing the block-cyclic one.
+ *   Each subtree of the supernodal etree is mapped cyclically onto a
+ *   subgrid whose size is proportional to the subtree's flop weight.
+ */
+typedef struct {
+    int_t nsupers;        /* number of supernodes mapped */
+    int   *prow;          /* process row of block row I; size nsupers */
+    int   *pcol;          /* process column of block column J; size nsupers */
+    int_t *lbi;           /* local block row number of I in prow[I] */
+    int_t *lbj;           /* local block column number of J in pcol[J] */
+    int_t *gbi;           /* global number of my local block rows;
+			     size nlbi+1, padded with nsupers */
+    int_t *gbj;           /* global number of my local block columns;
+			     size nlbj+1, padded with nsupers */
+    int_t nlbi;           /* max. number of local block rows of any process */
+    int_t nlbj;           /* max. number of local block columns of any process */
+    int_t mynlbi;         /* number of my local block rows */
+    int_t mynlbj;         /* number of my local block columns */
+} superlu_smap_t;
+
 /*-- 2D process grid definition */
 typedef struct {
     MPI_Comm comm;        /* MPI communicator */
@@ -398,6 +445,9 @@ typedef struct {
     int iam;              /* my process number in this grid */
     int_t nprow;          /* number of process rows */
     int_t npcol;          /* number of process columns */
+    superlu_smap_t *smap; /* supernode mapping; NULL means block-cyclic.
+			     A grid not made by superlu_gridinit() or
+			     superlu_gridmap() must set it to NULL. */
 } gridinfo_t;
 
 /*-- 3D process grid definition */
@@ -613,6 +663,15 @@ typedef struct {
  *        = MMD_ATA: use minimum degree ordering on structure of A'*A
  *        = MMD_AT_PLUS_A: use minimum degree ordering on structure of A'+A
  *        = COLAMD: use approximate minimum degree column ordering
+ *        = AMD_AT_PLUS_A: use the built-in approximate minimum degree
+ *                   ordering on structure of A'+A
+ *        = ND_AT_PLUS_A: use the built-in nested dissection ordering
+ *                   on structure of A'+A (no METIS needed)
+ *                   With ParSymbFact = YES it is computed on the
+ *                   distributed A, which is not gathered
+ *        = BEST_ORDERING: compute several orderings on different
+ *                   processes and keep the one with the smallest
+ *                   predicted cost (see get_perm_c_race_dist)
  *        = MY_PERMC: use the ordering specified by the user
  *         
  * Trans  (trans_t)
@@ -647,6 +706,9 @@ typedef struct {
  *        Specifies whether to permute rows of the original matrix.
  *        = NO: not to permute the rows
  *        = LargeDiag: make the diagonal large relative to the off-diagonal
+ *        = LargeDiag_LDM: as LargeDiag_MC64, but computed in parallel on
+ *                   the distributed matrix by an approximate matching,
+ *                   without gathering the numerical values
  *        = MY_PERMR: use the permutation given by the user
  *
  * ILU_DropRule (int)  (only for serial SuperLU)
@@ -714,6 +776,19 @@ typedef struct {
  *        Gives the scheduling algorithm a hint whether the matrix
  *        would have symmetric pattern.
  *
+ * superlu_autotune (int) (only for SuperLU_DIST)
+ *        Specifies whether superlu_relax, superlu_maxsup,
+ *        num_lookaheads and superlu_n_gemm are taken from a tuning
+ *        database named by SUPERLU_TUNING_DB (see superlu_autotune.c):
+ *        = 0: no tuning, use the values in options (default)
+ *        = 1: use the settings stored for a matching matrix, if any
+ *        = 2: as 1; on a miss, search the parameter space with a cheap
+ *             symbolic model and record the measured factorization
+ *             time in the database
+ *        The tuned values apply to this factorization only; options
+ *        gets the caller's values back, except that a larger tuned
+ *        superlu_maxsup is kept.
+ *
  */
 typedef struct {
     fact_t        Fact;
@@ -754,8 +829,43 @@ typedef struct {
     yes_no_t      SymPattern;      /* symmetric factorization          */
     yes_no_t      Use_TensorCore;  /* Use Tensor Core or not  */
     yes_no_t      Algo3d;          /* use 3D factorization/solve algorithms */
+    int superlu_autotune; /* tuning of the blocking parameters; see sp_ienv(11) */
 } superlu_dist_options_t;
 
+/*
+ * Matrix features and tuned parameters used by the autotuner; the
+ * features are the key of the persistent tuning database.
+ */
+typedef struct {
+    int      mode;         /* 0: off, 1: lookup, 2: tune; see options */
+    int_t    n, nnz;       /* dimension and nonzeros of A */
+    float    sym;          /* fraction of off-diagonals with a mirror */
+    float    fill;         /* predicted nnz(L+U)/nnz(A) */
+    int      nprow, npcol; /* process grid the setting applies to */
+    int      relax, maxsup, num_lookaheads, n_gemm;
+    int      source;       /* 0: options, 1: database, 2: model */
+    int      saved[4];     /* caller's relax, maxsup, num_lookaheads
+			      and n_gemm, restored after factorization */
+} superlu_autotune_t;
+
+/*
+ * Cost of a factorization predicted from the symbolic analysis alone,
+ * for one candidate process grid; see superlu_symbfact_predict().
+ * Sizes are in bytes.
+ */
+typedef struct {
+    int      nprow, npcol; /* candidate process grid (input) */
+    int64_t  nnzLU;        /* nonzeros in L+U */
+    int_t    nsuper;       /* number of supernodes */
+    double   flops;        /* factorization flops */
+    double   crit_flops;   /* flops on the critical path of the supernodal etree */
+    int_t    crit_depth;   /* supernodes on that path */
+    double   mem_max;      /* L, U and panel buffers on the busiest process */
+    double   mem_avg;      /* ... averaged over the processes */
+    double   comm_volume;  /* L and U panel broadcasts, all processes */
+    double   comm_max;     /* ... sent by the busiest process */
+} superlu_predict_t;
+
 typedef struct {
     float for_lu;
     float total;
@@ -950,6 +1060,8 @@ typedef struct{
 	double weight; 		// weight of the supernode
 	double iWeight; 	// weight of the whole subtree below
 	double scuWeight; 	// weight of schur complement update = max|n_k||L_k||U_k|
+	double commWeight; 	// words of the L and U panels = max|n_k|(|L_k|+|U_k|)
+	double bLevel; 		// weight of the heaviest path up to the root
 } treeList_t;
 
 typedef struct 
@@ -1022,6 +1134,189 @@ typedef struct
     int* msgcntU;
 } msgs_t;
 
+/*
+ * Node-local receive slots for the hierarchical panel broadcast
+ * (SUPERLU_SHM_BCAST).  The ranks of a process row (L panels) or process
+ * column (U panels) that share a node receive each panel once, into a
+ * slot of an MPI-3 shared-memory window, and all read it from there.
+ */
+typedef struct
+{
+    MPI_Comm scope;    /* process row or column */
+    MPI_Comm comm;     /* ranks of my scope in my node group */
+    MPI_Win  win;      /* nslots slots, allocated by rank 0 of comm */
+    MPI_Datatype tsub, tval; /* types of the index and value parts */
+    int      rank;     /* my rank in comm */
+    int      Np;       /* size of the scope */
+    int      *leader;  /* leader[p] = scope rank leading p's node group */
+    int      *first;   /* work array of size Np */
+    int      *dlg;     /* dlg[k] = rank in comm that receives k, or -1 */
+    int      *nrd;     /* nrd[k] = number of ranks in comm reading k */
+    int      nslots;
+    int      subcnt, valcnt; /* capacity of each slot, in elements */
+    MPI_Aint slotsize; /* bytes per slot */
+    int_t    **sub;    /* sub[s] = index part of slot s */
+    void     **val;    /* val[s] = value part of slot s */
+    int_t    *held;    /* held[s] = supernode I read from slot s, or -1 */
+    int_t    *pend;    /* pend[s] = supernode whose receive is deferred */
+    int      *psrc;    /* source and tags of the deferred receives */
+    int      *gate;    /* gate[s] = releases due before my panel in slot s */
+    int      *cum;     /* cum[s] = readers of the panels of slot s so far */
+    int      phase;    /* COMM_PANEL_L or COMM_PANEL_U, for the profile */
+} shmBcast_t;
+
+/*
+ * Segmented, pipelined k-ary tree broadcast of large panels
+ * (SUPERLU_BCAST_SEG).  The index part of a panel still goes from the
+ * owner to every reader; a value part longer than one segment is sent in
+ * segments down a tree of degree deg over the readers, each relay
+ * forwarding a segment as soon as it has it.
+ */
+typedef struct
+{
+    MPI_Comm scope;    /* process row or column */
+    int      iam, Np;  /* my rank in scope, size of scope */
+    MPI_Datatype tsub, tval; /* types of the index and value parts */
+    int      valsize;  /* bytes per value */
+    int      deg;      /* tree degree */
+    int      seg;      /* segment length, in values */
+    int      nwords;   /* words per row of need[] */
+    unsigned *need;    /* bit p of row k: scope rank p reads panel k */
+    int      *list;    /* work array of size Np */
+    int      nslots;
+    int      subcnt;   /* capacity of the index buffers */
+    int_t    **sub;    /* sub[s], val[s] = receive buffers of slot s */
+    void     **val;
+    int_t    *held;    /* held[s] = panel I receive in slot s, or -1 */
+    int_t    *root;    /* root[s] = panel I send from slot s, or -1 */
+    int      *nreq;    /* segment sends pending for root[s] */
+    int      *maxreq;
+    int      *psrc;    /* psrc[2s:2s+1] = root and value tag of held[s] */
+    MPI_Request **req;
+    int      phase;    /* COMM_PANEL_L or COMM_PANEL_U, for the profile */
+} segBcast_t;
+
+/*
+ * Coalesced broadcast of small panels (SUPERLU_BCAST_AGG).  A run of
+ * consecutive narrow supernodes of one etree level forms a batch; an owner
+ * sends all its panels of the batch to a reader in one message, in place
+ * of an index and a value message per panel.
+ */
+typedef struct
+{
+    MPI_Comm scope;    /* process row or column */
+    int      iam, Np;  /* my rank in scope, size of scope */
+    int      valsize;  /* bytes per value */
+    int      maxw;     /* supernodes of at most maxw columns are batched */
+    int      nslots;   /* slots, and longest batch */
+    int_t    *head;    /* head[k] = first supernode of k's batch, or -1 */
+    int      *len;     /* len[k] = length of the batch headed by k */
+    int      *nadd;    /* nadd[k] = members of that batch posted so far */
+    int_t    **sub;    /* sub[s], val[s] = receive buffers of slot s */
+    void     **val;
+    int_t    *mk;      /* mk[s] = batch member posted in slot s, or -1 */
+    int      *msrc;    /* scope rank owning mk[s] */
+    int      *mread;   /* mread[s] = 1 if I read mk[s] */
+    int      *mtag;    /* message tag of mk[s] */
+    int      **mcnt;   /* counts of mk[s]: index, value */
+    int      **mto;    /* readers of a panel I own, as in shmBcastIsend() */
+    void     **msub, **mval; /* a panel I own and its lengths */
+    int      *mnsub, *mnval;
+    char     **buf;    /* buf[s] = messages of the batch headed in slot s */
+    size_t   *bufsize;
+    MPI_Request *req;  /* req[s * Np + p] = send of buf[s] to rank p */
+    char     *rbuf;    /* receive buffer */
+    size_t   rsize;
+    int      phase;    /* COMM_PANEL_L or COMM_PANEL_U, for the profile */
+} aggBcast_t;
+
+/*
+ * One-sided panel delivery (SUPERLU_BCAST_RMA).  The look-ahead receive
+ * slots of the ranks of a scope lie in an MPI window.  A reader marks a
+ * slot free in the owner's window; the owner puts the panel into the slot
+ * and raises the slot's arrival flag, without the reader taking part.
+ */
+typedef struct
+{
+    MPI_Comm scope;    /* process row or column */
+    MPI_Win  win;      /* slots, then free flags */
+    MPI_Datatype tsub, tval; /* types of the index and value parts */
+    int      iam, Np;  /* my rank in scope, size of scope */
+    int      nslots;
+    MPI_Aint slotsize; /* bytes per slot */
+    MPI_Aint valoff;   /* offset of the value part in a slot */
+    MPI_Aint freeoff;  /* offset of free[s * Np + p] = k + 1: rank p has
+			  slot s free for my panel k */
+    int_t    **sub;    /* sub[s], val[s] = receive buffers of slot s */
+    void     **val;
+    int_t    *held;    /* held[s] = panel I receive in slot s, or -1 */
+    int_t    *root;    /* root[s] = panel I put from slot s, or -1 */
+    char     *pend;    /* pend[s * Np + p] = 1 if p still waits for root[s] */
+    void     **psub, **pval; /* panel root[s] and its lengths */
+    int      *pnsub, *pnval;
+    int      phase;    /* COMM_PANEL_L or COMM_PANEL_U, for the profile */
+} rmaBcast_t;
+
+/*
+ * Communication progress thread (SUPERLU_PROGRESS_THREAD).  A thread
+ * outside the OpenMP team drives the messages of a phase while the
+ * calling thread computes: it only polls MPI in the factorization, and in
+ * the solve it receives every message, forwards the broadcast ones and
+ * queues them for commProgressRecv().
+ */
+typedef struct
+{
+    char     *name;    /* phase, for the report */
+    MPI_Comm comm;     /* the report is over comm */
+    MPI_Comm probe[3]; /* polled communicators */
+    int      nprobe;
+    MPI_Datatype type;
+    int      maxcnt;   /* receive length, in type */
+    int      nrecv;    /* messages the thread receives; -1: it only polls */
+    void     *(*keep)(void *, MPI_Status *); /* where to receive a message
+						that outlives its use, or NULL */
+    int      (*fwd)(void *, void *, MPI_Status *); /* 1 if it forwarded */
+    void     *arg;     /* of keep() and fwd() */
+    int      nring;    /* other messages land in ring[] */
+    char     *ring;
+    size_t   slotsize;
+    void     **msg;    /* msg[i], st[i]: i-th message received */
+    MPI_Status *st;
+    double   *tin;     /* arrival time of msg[i], or -1 if not forwarded */
+    int      nin;      /* messages received by the thread */
+    int      nout;     /* messages taken by the caller */
+    int      nused, nfree; /* ring slots filled, released */
+    int      stop;
+    void     *sync;    /* thread, lock and condition */
+    double   t0, lead, wait;
+    double   npoll, nhit;
+} commProgress_t;
+
+/*
+ * Nonblocking reduction of the ancestor panels between two layers of the
+ * 3D factorization (SUPERLU_ANC_ASYNC).  The layer leaving the
+ * factorization sends the ancestor panels it updated.  Its partner
+ * receives them through a few slots and adds each piece in before the
+ * supernode is factored, while it goes on with its next forest.
+ */
+typedef struct
+{
+    int      nslots;   /* receives in flight */
+    int      peer;     /* layer sending the pieces */
+    int_t    n;        /* pieces to receive from peer */
+    int_t    nposted, ndone; /* pieces posted, added in */
+    int_t    *node;    /* node[i] = supernode of the i-th piece */
+    char     *part;    /* part[i] = 'L' or 'U' */
+    int_t    *left;    /* left[k] = pieces of supernode k not added in */
+    void     **buf;    /* buf[s] = receive buffer of slot s */
+    MPI_Request *req;  /* req[s] = receive into slot s */
+    int_t    nsend;
+    MPI_Request *sreq; /* sends of my pieces to my partner */
+    int_t    nskip;    /* pieces I did not send: no update reached them */
+    int      lazy;     /* SUPERLU_ANC_LAZY: copies of the ancestors I do
+			  not own are allocated on first touch */
+} ancReduce_t;
+
 typedef struct xtrsTimer_t
 {
     double trsDataSendXY;
@@ -1064,6 +1359,11 @@ extern "C" {
 extern void   superlu_gridinit(MPI_Comm, int, int, gridinfo_t *);
 extern void   superlu_gridmap(MPI_Comm, int, int, int [], int, gridinfo_t *);
 extern void   superlu_gridexit(gridinfo_t *);
+extern void   superlu_smap_init(int_t, int_t *, Glu_persist_t *,
+				Glu_freeable_t *, gridinfo_t *);
+extern void   superlu_smap_free(gridinfo_t *);
+extern void   superlu_node_order(MPI_Comm, int, int [], int []);
+extern double superlu_internode_fraction(int, int [], int [], double []);
 extern void   superlu_gridinit3d(MPI_Comm Bcomm,  int nprow, int npcol, int npdep,
 				 gridinfo3d_t *grid) ;
 extern void   superlu_gridmap3d(MPI_Comm, int, int, int, int [], gridinfo3d_t *);
@@ -1083,15 +1383,22 @@ extern void   sp_colorder (superlu_dist_options_t*, SuperMatrix*, int_t*, int_t*
 extern int    sp_symetree_dist(int_t *, int_t *, int_t *, int_t, int_t *);
 extern int    sp_coletree_dist (int_t *, int_t *, int_t *, int_t, int_t, int_t *);
 extern void   get_perm_c_dist(int_t, int_t, SuperMatrix *, int_t *);
+extern void   get_perm_c_race_dist(superlu_dist_options_t *, SuperMatrix *,
+                                   int_t *, gridinfo_t *);
 extern void   at_plus_a_dist(const int_t, const int_t, int_t *, int_t *,
 			     int_t *, int_t **, int_t **);
 extern int    genmmd_dist_(int_t *, int_t *, int_t *a, 
 			   int_t *, int_t *, int_t *, int_t *, 
 			   int_t *, int_t *, int_t *, int_t *, int_t *);
+extern int    amd_order_dist(int_t, int_t *, int_t *, int_t *);
+extern int    nd_order_dist(int_t, int_t *, int_t *, int_t *);
 extern void  bcast_tree(void *, int, MPI_Datatype, int, int,
 			gridinfo_t *, int, int *);
 extern int_t symbfact(superlu_dist_options_t *, int, SuperMatrix *, int_t *,
                       int_t *, Glu_persist_t *, Glu_freeable_t *);
+extern int_t symbfact_shared(superlu_dist_options_t *, gridinfo_t *,
+			     SuperMatrix *, int_t *, int_t *,
+			     Glu_persist_t *, Glu_freeable_t *);
 extern int_t symbfact_SubInit(superlu_dist_options_t *options,
 			      fact_t, void *, int_t, int_t, int_t, int_t,
 			      Glu_persist_t *, Glu_freeable_t *);
@@ -1103,6 +1410,8 @@ extern void    countnz_dist (const int_t, int_t *, int_t *, int_t *,
 extern int64_t fixupL_dist (const int_t, const int_t *, Glu_persist_t *,
 				  Glu_freeable_t *);
 extern int_t   *TreePostorder_dist (int_t, int_t *);
+extern int     sp_symcolcnt_dist(int_t *, int_t *, int_t *, int_t, int_t *,
+				 int_t *);
 extern float   smach_dist(char *);
 extern double  dmach_dist(char *);
 extern void    *superlu_malloc_dist (size_t);
@@ -1122,6 +1431,15 @@ extern int_t estimate_bigu_size (int_t, int_t **, Glu_persist_t *,
 extern double SuperLU_timer_ (void);
 extern void   superlu_abort_and_exit_dist(char *);
 extern int    sp_ienv_dist (int, superlu_dist_options_t *);
+extern void   superlu_autotune_dist(superlu_dist_options_t *, SuperMatrix *,
+				    int_t *, gridinfo_t *, superlu_autotune_t *);
+extern void   superlu_autotune_record(superlu_dist_options_t *,
+				      superlu_autotune_t *, double,
+				      gridinfo_t *);
+extern int    superlu_symbfact_predict(superlu_dist_options_t *, SuperMatrix *,
+				       int_t *, int, gridinfo_t *, int,
+				       superlu_predict_t *);
+extern void   superlu_predict_print(int, superlu_predict_t *, gridinfo_t *);
 extern void   ifill_dist (int_t *, int_t, int_t);
 extern void   super_stats_dist (int_t, int_t *);
 extern void  get_diag_procs(int_t, Glu_persist_t *, gridinfo_t *, int_t *,
@@ -1148,6 +1466,10 @@ extern float symbfact_dist
 
 /* Get the column permutation using parmetis */
 extern float get_perm_c_parmetis 
+(SuperMatrix *, int_t *, int_t *, int, int, 
+ int_t **, int_t **, gridinfo_t *, MPI_Comm *);
+/* Get the column permutation by distributed nested dissection */
+extern float get_perm_c_dnd
 (SuperMatrix *, int_t *, int_t *, int, int, 
  int_t **, int_t **, gridinfo_t *, MPI_Comm *);
 
@@ -1220,18 +1542,31 @@ extern int   file_PrintLong10(FILE *, char *, int_t, int_t *);
 
 #ifndef __SUPERLU_ASYNC_TREE /* allow multiple inclusions */
 #define __SUPERLU_ASYNC_TREE
+#define C_TREE_MAXDEST 16   /* largest tree degree */
+
+/* Tree shapes, see SUPERLU_TREE in comm_tree.c */
+#define C_TREE_BINARY   0
+#define C_TREE_FLAT     1
+#define C_TREE_KARY     2
+#define C_TREE_BINOMIAL 3
+#define C_TREE_NODE     4
+#define C_TREE_AUTO     5
+
 typedef struct
 {
-    MPI_Request sendRequests_[2];
+    MPI_Request *sendRequests_; /* destCnt_ (broadcast) or 1 (reduction) */
     MPI_Comm comm_;
     int myRoot_;
     int destCnt_;
-    int myDests_[2];
+    int *myDests_;  /* destCnt_ children, in sendRequests_'s allocation */
     int myRank_;
     int msgSize_;
     int tag_;
     yes_no_t empty_;
     MPI_Datatype type_;
+    int depth_;     /* levels below the root */
+    int shape_;     /* C_TREE_BINARY, ... */
+    double wait_;   /* time spent completing sends */
 } C_Tree;
 
 #ifndef DEG_TREE
@@ -1242,16 +1577,21 @@ typedef struct
 
 extern void C_RdTree_Create(C_Tree* tree, MPI_Comm comm, int* ranks, int rank_cnt, int msgSize, char precision);
 extern void C_RdTree_Nullify(C_Tree* tree);
+extern void C_RdTree_Destroy(C_Tree* tree);
 extern yes_no_t C_RdTree_IsRoot(C_Tree* tree);
 extern void C_RdTree_forwardMessageSimple(C_Tree* Tree, void* localBuffer, int msgSize);
 extern void C_RdTree_waitSendRequest(C_Tree* Tree);
 
 extern void C_BcTree_Create(C_Tree* tree, MPI_Comm comm, int* ranks, int rank_cnt, int msgSize, char precision);
 extern void C_BcTree_Nullify(C_Tree* tree);
+extern void C_BcTree_Destroy(C_Tree* tree);
 extern yes_no_t C_BcTree_IsRoot(C_Tree* tree);
 extern void C_BcTree_forwardMessageSimple(C_Tree* tree, void* localBuffer, int msgSize);
 extern void C_BcTree_waitSendRequest(C_Tree* tree);
 
+extern void C_Tree_SetNodes(MPI_Comm comm);
+extern void C_Tree_Stats(char *name, C_Tree* trees, int ntrees, MPI_Comm comm);
+
 /*==== For 3D code ====*/
 
 extern void DistPrint(char* function_name,  double value, char* Units, gridinfo_t* grid);
@@ -1276,6 +1616,8 @@ extern int  free_treelist(int_t nsuper, treeList_t* treeList);
 
 // int_t calcTreeWeight(int_t nsupers, treeList_t* treeList, int_t* xsup);
 extern int_t calcTreeWeight(int_t nsupers, int_t*setree, treeList_t* treeList, int_t* xsup);
+extern void setMeasuredWeight(int_t nsupers, int_t* setree, treeList_t* treeList,
+			      double* nodeCost);
 extern int_t getDescendList(int_t k, int_t*dlist,  treeList_t* treeList);
 extern int_t getCommonAncestorList(int_t k, int_t* alist,  int_t* seTree, treeList_t* treeList);
 extern int_t getCommonAncsCount(int_t k, treeList_t* treeList);
@@ -1351,8 +1693,8 @@ extern int_t*  getNodeCountsFr(int_t maxLvl, sForest_t**  sForests);
 // int_t* getNodeToForstMap(int_t nsupers, sForest_t**  sForests, gridinfo3d_t* grid3d);
 extern int* getIsNodeInMyGrid(int_t nsupers, int_t maxLvl, int_t* myNodeCount, int_t** treePerm);
 extern void printForestWeightCost(sForest_t**  sForests, SCT_t* SCT, gridinfo3d_t* grid3d);
-extern sForest_t**  getGreedyLoadBalForests( int_t maxLvl, int_t nsupers, int_t* setree, treeList_t* treeList);
-extern sForest_t**  getForests( int_t maxLvl, int_t nsupers, int_t*setree, treeList_t* treeList);
+extern sForest_t**  getGreedyLoadBalForests( int_t maxLvl, int_t Pz, int_t nsupers, int_t* setree, treeList_t* treeList);
+extern sForest_t**  getForests( int_t maxLvl, int_t Pz, int_t nsupers, int_t*setree, treeList_t* treeList);
 
     /* from trfAux.h */
 extern int_t getBigUSize(superlu_dist_options_t *, int_t nsupers,
@@ -1360,6 +1702,10 @@ extern int_t getBigUSize(superlu_dist_options_t *, int_t nsupers,
 extern void getSCUweight(int_t nsupers, treeList_t* treeList, int_t* xsup,
 			 int_t** Lrowind_bc_ptr, int_t** Ufstnz_br_ptr,
 			 gridinfo3d_t * grid3d);
+extern void printCriticalPath(int_t nsupers, int_t* setree, double* nodeCost,
+			      int_t* xsup, int_t** Lrowind_bc_ptr,
+			      int_t** Ufstnz_br_ptr, double tFact,
+			      gridinfo3d_t* grid3d);
 extern int Wait_LUDiagSend(int_t k, MPI_Request *U_diag_blk_send_req,
 			   MPI_Request *L_diag_blk_send_req,
 			   gridinfo_t *grid, SCT_t *SCT);
@@ -1427,6 +1773,79 @@ extern int_t Test_UDiagBlock_Recv(MPI_Request *, SCT_t *);
 extern int_t Wait_LDiagBlock_Recv(MPI_Request *, SCT_t *);
 extern int_t Test_LDiagBlock_Recv(MPI_Request *, SCT_t *);
 extern int_t LDiagBlockRecvWait( int_t k, int_t* factored_U, MPI_Request *, gridinfo_t *);
+extern int   shmBcastGroupSize(void);
+extern shmBcast_t *shmBcastInit(MPI_Comm, int nslots, int_t nsupers,
+				int need[], int subcnt, MPI_Datatype,
+				int valcnt, MPI_Datatype);
+extern void  shmBcastFree(shmBcast_t *);
+extern int   shmBcastSlot(shmBcast_t *, void *sub);
+extern int   shmBcastHeld(shmBcast_t *, int_t k);
+extern void  shmBcastNext(shmBcast_t *, int s, int_t k);
+extern int_t shmBcastIsend(shmBcast_t *, int to[], int self,
+			   void *sub, int nsub, void *val, int nval,
+			   int tag0, int tag1, MPI_Request *send_req);
+extern int_t shmBcastIrecv(shmBcast_t *, int s, int_t k, int src,
+			   int tag0, int tag1, MPI_Request *recv_req);
+extern int_t shmBcastWait(shmBcast_t *, int s, int_t k,
+			  MPI_Request *recv_req, int *cnt);
+/* Phases of the communication profile (SUPERLU_COMM_PROFILE) */
+#define COMM_PANEL_L  0   /* L panel broadcast */
+#define COMM_PANEL_U  1   /* U panel broadcast */
+#define COMM_DIAG     2   /* diagonal block sends */
+#define COMM_Z        3   /* 3D reduction and gathering along Z */
+#define COMM_SPMV     4   /* pxgsmv */
+#define COMM_REDIST   5   /* redistribution of B and X */
+#define COMM_NPHASE   6
+extern int   commProfOn(void);
+extern void  commProfSend(int phase, MPI_Comm, int dest, int count,
+			  MPI_Datatype);
+extern void  commProfDump(MPI_Comm, char *name);
+extern segBcast_t *segBcastInit(MPI_Comm, int nslots, int_t *sub[],
+				void *val[], int_t nsupers, int need[],
+				int subcnt, MPI_Datatype, MPI_Datatype);
+extern void  segBcastFree(segBcast_t *);
+extern int   segBcastSlot(segBcast_t *, void *sub);
+extern int   segBcastHeld(segBcast_t *, int_t k);
+extern int_t segBcastIsend(segBcast_t *, int s, int_t k,
+			   void *sub, int nsub, void *val, int nval,
+			   int tag0, int tag1, MPI_Request *send_req);
+extern int_t segBcastIrecv(segBcast_t *, int s, int_t k, int src,
+			   int tag0, int tag1, MPI_Request *recv_req);
+extern int_t segBcastWaitIndex(segBcast_t *, int s, MPI_Request *recv_req,
+			       int *cnt);
+extern int_t segBcastWaitValue(segBcast_t *, int s, int_t k, int nval,
+			       int *cnt);
+extern int_t segBcastWaitSend(segBcast_t *, int_t k);
+extern aggBcast_t *aggBcastInit(MPI_Comm, int nslots, int_t *sub[],
+				void *val[], int_t nsupers, MPI_Datatype);
+extern void  aggBcastFree(aggBcast_t *);
+extern void  aggBcastPlan(aggBcast_t *, int_t *perm, int_t *lims, int_t nlvl,
+			  int_t *xsup);
+extern int   aggBcastSlot(aggBcast_t *, void *sub, int_t k);
+extern int_t aggBcastIsend(aggBcast_t *, int s, int_t k, int to[],
+			   void *sub, int nsub, void *val, int nval, int tag);
+extern int_t aggBcastIrecv(aggBcast_t *, int s, int_t k, int src, int read,
+			   int tag, int *cnt);
+extern int   aggBcastWait(aggBcast_t *, int_t k);
+extern rmaBcast_t *rmaBcastInit(MPI_Comm, int nslots, int subcnt,
+				MPI_Datatype, int valcnt, MPI_Datatype);
+extern void  rmaBcastFree(rmaBcast_t *);
+extern int   rmaBcastSlot(rmaBcast_t *, void *sub);
+extern int   rmaBcastHeld(rmaBcast_t *, int_t k);
+extern int_t rmaBcastIsend(rmaBcast_t *, int s, int_t k, int to[],
+			   void *sub, int nsub, void *val, int nval);
+extern int_t rmaBcastIrecv(rmaBcast_t *, int s, int_t k, int src);
+extern int_t rmaBcastWait(rmaBcast_t *, int s, int_t k, int *cnt);
+extern int   rmaBcastWaitSend(rmaBcast_t *, int_t k);
+extern commProgress_t *commProgressPoll(char *name, MPI_Comm, int nprobe,
+				       MPI_Comm probe[]);
+extern commProgress_t *commProgressStart(char *name, MPI_Comm, int nrecv,
+				int maxcnt, MPI_Datatype,
+				void *(*keep)(void *, MPI_Status *),
+				int (*fwd)(void *, void *, MPI_Status *),
+				void *arg);
+extern void  *commProgressRecv(commProgress_t *, MPI_Status *);
+extern void  commProgressStop(commProgress_t *);
 
 /*=====================*/
 
@@ -33,20 +33,22 @@ MPI_Datatype SuperLU_MPI_DOUBLE_COMPLEX = MPI_DATATYPE_NULL;
  *  values are assigned to it:
  *      grid->comm = MPI_COMM_NULL
  *      grid->iam = -1
+ *
+ *  With SUPERLU_RANKORDER=NODE in the environment, the processes are
+ *  grouped by shared-memory node and each process column is filled from
+ *  consecutive processes of a node, so that the column broadcasts stay
+ *  inside a node whenever a node holds a multiple of NPROW processes.
+ *  The expected fraction of inter-node traffic is printed.
  */
 void superlu_gridinit(MPI_Comm Bcomm, /* The base communicator upon which
 					 the new grid is formed. */
 		      int nprow, int npcol, gridinfo_t *grid)
 {
     int Np = nprow * npcol;
-    int *usermap;
+    int *usermap, *node = NULL;
     int i, j, info;
+    char *ttemp = getenv("SUPERLU_RANKORDER");
 
-    /* Make a list of the processes in the new communicator. */
-    usermap = SUPERLU_MALLOC(Np*sizeof(int));
-    for (j = 0; j < npcol; ++j)
-	for (i = 0; i < nprow; ++i) usermap[j*nprow+i] = i*npcol+j;
-    
     /* Check MPI environment initialization. */
     MPI_Initialized( &info );
     if ( !info )
@@ -58,13 +60,39 @@ void superlu_gridinit(MPI_Comm Bcomm, /* The base communicator upon which
 	exit(-1);
     }
 
+    /* Make a list of the processes in the new communicator. */
+    usermap = SUPERLU_MALLOC(Np*sizeof(int));
+    if ( ttemp && strcmp(ttemp, "NODE") == 0 ) {
+        /* Column-major fill from the processes sorted by node. */
+        node = SUPERLU_MALLOC(Np*sizeof(int));
+	superlu_node_order(Bcomm, Np, usermap, node);
+    } else {
+	for (j = 0; j < npcol; ++j)
+	    for (i = 0; i < nprow; ++i) usermap[j*nprow+i] = i*npcol+j;
+    }
+
     superlu_gridmap(Bcomm, nprow, npcol, usermap, nprow, grid);
+
+    if ( node ) {
+        /* Nodes in the row-major layout of grid->comm. */
+        int dims[2] = {nprow, npcol};
+	double frac[2], f;
+	for (j = 0; j < npcol; ++j)
+	    for (i = 0; i < nprow; ++i) usermap[i*npcol+j] = node[j*nprow+i];
+	f = superlu_internode_fraction(2, dims, usermap, frac);
+	if ( grid->iam == 0 ) {
+	    printf(".. Node-aware grid: inter-node pairs in rows %.1f%%, "
+		   "in columns %.1f%%; expected inter-node traffic %.1f%%\n",
+		   100. * frac[1], 100. * frac[0], 100. * f);
+	    fflush(stdout);
+	}
+        SUPERLU_FREE(node);
+    }
     
     SUPERLU_FREE(usermap);
     
 #ifdef GPU_ACC
     /* Binding each MPI to a GPU device */
-    char *ttemp;
     ttemp = getenv ("SUPERLU_BIND_MPI_GPU");
 
     if (ttemp) {
@@ -76,6 +104,74 @@ void superlu_gridinit(MPI_Comm Bcomm, /* The base communicator upon which
 #endif
 }
 
+/*! \brief Group the first Np processes of Bcomm by shared-memory node.
+ *
+ *  All processes in Bcomm must call this routine.  On return, order[k]
+ *  is the k-th process of Bcomm in the order of (node, rank), and node[k]
+ *  identifies its node by the lowest rank on it.
+ */
+void superlu_node_order(MPI_Comm Bcomm, int Np, int order[], int node[])
+{
+    MPI_Comm nodecomm;
+    int rank, size, leader, i, j, k, *nodeof;
+
+    MPI_Comm_rank(Bcomm, &rank);
+    MPI_Comm_size(Bcomm, &size);
+    MPI_Comm_split_type(Bcomm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                        &nodecomm);
+    MPI_Allreduce(&rank, &leader, 1, MPI_INT, MPI_MIN, nodecomm);
+    MPI_Comm_free(&nodecomm);
+
+    nodeof = SUPERLU_MALLOC(size * sizeof(int));
+    MPI_Allgather(&leader, 1, MPI_INT, nodeof, 1, MPI_INT, Bcomm);
+
+    /* Each leader starts a node; its members follow in rank order. */
+    for (i = 0, k = 0; i < Np; ++i) {
+        if ( nodeof[i] != i ) continue;
+	for (j = i; j < Np; ++j)
+	    if ( nodeof[j] == i ) {
+	        order[k] = j;
+		node[k++] = i;
+	    }
+    }
+    SUPERLU_FREE(nodeof);
+}
+
+/*! \brief Fraction of inter-node peers in a process grid.
+ *
+ *  The grid has ndim dimensions dims[], laid out in row-major order
+ *  (the last one varies the fastest), and node[] holds the node of each
+ *  process in that layout.  On return, frac[d] is the fraction of the
+ *  pairs of processes differing only in coordinate d that are on
+ *  different nodes, i.e. the share of a broadcast along d that leaves a
+ *  node.  Returns the mean of frac[] over the dimensions of size > 1.
+ */
+double superlu_internode_fraction(int ndim, int dims[], int node[],
+                                  double frac[])
+{
+    int Np = 1, d, p, q, k, stride, c, nd = 0;
+    double pairs, cross, sum = 0.;
+
+    for (d = 0; d < ndim; ++d) Np *= dims[d];
+    for (d = ndim - 1, stride = 1; d >= 0; stride *= dims[d--]) {
+        pairs = cross = 0.;
+	for (p = 0; p < Np; ++p) {
+	    c = (p / stride) % dims[d];
+	    for (k = c + 1; k < dims[d]; ++k) {
+	        q = p + (k - c) * stride;
+		pairs += 1.;
+		if ( node[p] != node[q] ) cross += 1.;
+	    }
+	}
+	frac[d] = pairs > 0. ? cross / pairs : 0.;
+	if ( dims[d] > 1 ) {
+	    sum += frac[d];
+	    ++nd;
+	}
+    }
+    return nd ? sum / nd : 0.;
+}
+
 
 /*! \brief All processes in the MPI communicator must call this routine.
  *
@@ -83,6 +179,9 @@ void superlu_gridinit(MPI_Comm Bcomm, /* The base communicator upon which
  *  values are assigned to it:
  *      grid->comm = MPI_COMM_NULL
  *      grid->iam = -1
+ *  Every process gets grid->smap = NULL (block-cyclic mapping). A grid
+ *  filled in by the caller instead of by superlu_gridinit/superlu_gridmap
+ *  must set grid->smap = NULL as well.
  */
 void superlu_gridmap(
 		     MPI_Comm Bcomm, /* The base communicator upon which
@@ -116,6 +215,7 @@ void superlu_gridmap(
 
     grid->nprow = nprow;
     grid->npcol = npcol;
+    grid->smap = NULL; /* block-cyclic until a map is installed */
 
     /* Make a list of the processes in the new communicator. */
     pranks = (int *) SUPERLU_MALLOC(Np*sizeof(int));
@@ -176,6 +276,7 @@ void superlu_gridmap(
     grid->rscp.Iam = mycol;
     grid->cscp.Np = nprow;
     grid->cscp.Iam = myrow;
+    C_Tree_SetNodes(grid->comm); /* node map for the solve trees */
 
 #if 0
     {
@@ -199,6 +300,7 @@ void superlu_gridmap(
 
 void superlu_gridexit(gridinfo_t *grid)
 {
+    superlu_smap_free(grid);
     if ( grid->comm != MPI_COMM_NULL ) {
 	/* Marks the communicator objects for deallocation. */
 	MPI_Comm_free( &grid->rscp.comm );
@@ -213,3 +315,21 @@ void superlu_gridexit(gridinfo_t *grid)
     }
 #endif    
 }
+
+/*! \brief Drop the proportional supernode mapping; the grid reverts to
+ *  the block-cyclic one.
+ */
+void superlu_smap_free(gridinfo_t *grid)
+{
+    superlu_smap_t *smap = grid->smap;
+
+    if ( !smap ) return;
+    SUPERLU_FREE(smap->prow);
+    SUPERLU_FREE(smap->pcol);
+    SUPERLU_FREE(smap->lbi);
+    SUPERLU_FREE(smap->lbj);
+    SUPERLU_FREE(smap->gbi);
+    SUPERLU_FREE(smap->gbj);
+    SUPERLU_FREE(smap);
+    grid->smap = NULL;
+}
@@ -12,6 +12,12 @@
 #include "superlu_ddefs.h"
 
 /*! \brief All processes in the MPI communicator must call this routine.
+ *
+ *  With SUPERLU_RANKORDER=NODE in the environment, the processes are
+ *  grouped by shared-memory node and laid out XY-major, so that the Z
+ *  reductions stay inside a node whenever a node holds a multiple of
+ *  NPDEP processes.  The expected fraction of inter-node traffic is
+ *  printed.
  */
 void superlu_gridinit3d(MPI_Comm Bcomm, /* The base communicator upon which
 					   the new grid is formed. */
@@ -21,13 +27,8 @@ void superlu_gridinit3d(MPI_Comm Bcomm, /* The base communicator upon which
     int i, j, k, info;
     int *usermap; /* usermap(i,j,k) holds the process number from Bcomm
 		      to be placed in {i,j,k} of the new process (group) (3D grid).  */
-
-    /* Make a list of the processes in the new communicator. */
-    usermap = SUPERLU_MALLOC(Np*sizeof(int));
-    for (k = 0; k < npdep; ++k)
-	for (j = 0; j < npcol; ++j)
-	    for (i = 0; i < nprow; ++i)
-		usermap[k*nprow*npcol + j*nprow + i] = k*nprow*npcol + j*nprow + i;
+    int *node = NULL;
+    char *ttemp = getenv("SUPERLU_RANKORDER");
 
     /* Check MPI environment initialization. */
     MPI_Initialized( &info );
@@ -38,13 +39,39 @@ void superlu_gridinit3d(MPI_Comm Bcomm, /* The base communicator upon which
     if ( info < Np )
         ABORT("Number of processes is smaller than NPROW * NPCOL * NPDEP");
 
+    /* Make a list of the processes in the new communicator. */
+    usermap = SUPERLU_MALLOC(Np*sizeof(int));
+    if ( ttemp && strcmp(ttemp, "NODE") == 0 ) {
+        node = SUPERLU_MALLOC(Np*sizeof(int));
+	superlu_node_order(Bcomm, Np, usermap, node);
+    } else {
+	for (k = 0; k < npdep; ++k)
+	    for (j = 0; j < npcol; ++j)
+		for (i = 0; i < nprow; ++i)
+		    usermap[k*nprow*npcol + j*nprow + i] = k*nprow*npcol + j*nprow + i;
+    }
+
     superlu_gridmap3d(Bcomm, nprow, npcol, npdep, usermap, grid);
 
+    if ( node ) {
+        /* grid->comm keeps the order of usermap[], laid out XY-major. */
+        int dims[3] = {nprow, npcol, npdep};
+	double frac[3], f;
+	f = superlu_internode_fraction(3, dims, node, frac);
+	if ( grid->iam == 0 ) {
+	    printf(".. Node-aware 3D grid: inter-node pairs in rows %.1f%%, "
+		   "in columns %.1f%%, in depth %.1f%%; expected inter-node "
+		   "traffic %.1f%%\n", 100. * frac[1], 100. * frac[0],
+		   100. * frac[2], 100. * f);
+	    fflush(stdout);
+	}
+        SUPERLU_FREE(node);
+    }
+
     SUPERLU_FREE(usermap);
 
 #ifdef GPU_ACC
     /* Binding each MPI to a GPU device */
-    char *ttemp;
     ttemp = getenv ("SUPERLU_BIND_MPI_GPU");
 
     if (ttemp) {
@@ -91,6 +118,8 @@ void superlu_gridmap3d(
     if ( !info )
         ABORT("C main program must explicitly call MPI_Init()");
 
+    grid->grid2d.smap = NULL; /* block-cyclic until a map is installed */
+
 #if 0 /* Sherry: can directly use usermap[] passed in */
     /* Make a list of the processes in the new communicator. */
     pranks = (int *) SUPERLU_MALLOC(Np * sizeof(int));
@@ -133,7 +162,8 @@ void superlu_gridmap3d(
     int iam;
     MPI_Comm superlu3d_comm;
 
-    if ( getenv("SUPERLU_RANKORDER") && strcmp(getenv("SUPERLU_RANKORDER"), "XY" )==0 )
+    if ( getenv("SUPERLU_RANKORDER") && (strcmp(getenv("SUPERLU_RANKORDER"), "XY" )==0
+                                         || strcmp(getenv("SUPERLU_RANKORDER"), "NODE")==0) )
     {
 	grid->rankorder = 1;  // XY-major
 
@@ -239,6 +269,7 @@ void superlu_gridmap3d(
     grid->grid2d.nprow = nprow;
     grid->grid2d.npcol = npcol;
     MPI_Comm_rank( grid->grid2d.comm, &(grid->grid2d.iam));
+    C_Tree_SetNodes(grid->grid2d.comm); /* node map for the solve trees */
 
     // grid->grid2d.cscp = grid->cscp;
 
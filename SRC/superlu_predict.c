@@ -0,0 +1,331 @@
+/*! \file
+Copyright (c) 2003, The Regents of the University of California, through
+Lawrence Berkeley National Laboratory (subject to receipt of any required
+approvals from U.S. Dept. of Energy)
+
+All rights reserved.
+
+The source code is distributed under BSD license, see the file License.txt
+at the top-level directory.
+*/
+/*! @file
+ * \brief Predict the cost of a factorization from its symbolic analysis
+ *
+ * <pre>
+ * -- Distributed SuperLU routine (version 8.1.2) --
+ * Lawrence Berkeley National Lab, Univ. of California Berkeley.
+ * October 18, 2026
+ *
+ * The column ordering and the serial symbolic factorization give the
+ * supernode partition and the block structure of L and U.  From these
+ * the following are derived, without distributing or factoring A:
+ *     nnz(L+U), the factorization flops, and the flops and depth of the
+ *     critical path of the supernodal elimination tree;
+ * and, for each candidate process grid under the 2D block-cyclic
+ * mapping (see PROW/PCOL):
+ *     the storage of the local L and U blocks with their index
+ *     metadata, plus the panel receive buffers of the look-ahead
+ *     window, and the bytes sent by the L panel broadcasts along the
+ *     process rows and the U panel broadcasts along the process
+ *     columns.
+ * </pre>
+ */
+
+#include <math.h>
+#include "superlu_ddefs.h"
+
+/*! \brief Predict nnz(L+U), flops, per-process memory and panel message
+ *  volume of the factorization for the candidate process grids.
+ *
+ * <pre>
+ * Arguments
+ * =========
+ *
+ * options (input) superlu_dist_options_t*
+ *         ColPerm, the supernode parameters (see sp_ienv_dist) and
+ *         num_lookaheads are used as in the factorization.
+ *         ColPerm = PARMETIS is replaced by METIS on A'+A.
+ *
+ * GA      (input/output) SuperMatrix*
+ *         The global matrix Pr*A in NC format; only the pattern is used.
+ *         On exit, its row subscripts are overwritten.
+ *
+ * perm_c  (input/output) int_t*, dimension A->ncol
+ *         Input when options->ColPerm == MY_PERMC; otherwise it is
+ *         computed.  On exit, the postordered column permutation.
+ *
+ * dsize   (input) int
+ *         Size in bytes of one numerical value (e.g. sizeof(double)).
+ *
+ * grid    (input) gridinfo_t*
+ *         The analysis is done by process 0 of grid->comm and pred[]
+ *         is broadcast to the others.
+ *
+ * ncand   (input) int
+ *         Number of candidate process grids.
+ *
+ * pred    (input/output) superlu_predict_t*, dimension ncand
+ *         On entry, pred[i].nprow and pred[i].npcol give the i-th grid.
+ *         On exit, the remaining fields are set.
+ *
+ * Return value
+ * ============
+ *   = 0: successful exit
+ *   > 0: memory allocation failure in the symbolic factorization
+ * </pre>
+ */
+int
+superlu_symbfact_predict(superlu_dist_options_t *options, SuperMatrix *GA,
+                         int_t *perm_c, int dsize, gridinfo_t *grid,
+			 int ncand, superlu_predict_t *pred)
+{
+    SuperMatrix GAC;
+    NCPformat *GACstore;
+    Glu_persist_t Glu_persist;
+    Glu_freeable_t Glu_freeable;
+    int_t n = GA->ncol, nsuper, i, j, k, K, J, fsupc, ns, nr, irow;
+    int_t *etree, *xsup, *supno, *xlsub, *lsub, *xusub, *usub;
+    int_t *spar, *depth, *ustart, *useg, *bmark;
+    double *sflops, *path, fk, mk, uk, us, crit = 0.0;
+    int_t crit_depth = 0, iinfo = 0;
+    int c, p, q, pr, pc, P, destrows, destcols, isize = sizeof(int_t);
+    int_t *lrow, *lblk, *ucol, *ublk, *unz;
+    double *mem, *send, bytes, maxLbuf, maxUbuf, buf;
+    int_t permc_spec = options->ColPerm;
+
+    if ( permc_spec == BEST_ORDERING )
+	get_perm_c_race_dist(options, GA, perm_c, grid);
+
+    if ( !grid->iam ) {
+#ifdef HAVE_PARMETIS
+	if ( permc_spec == PARMETIS ) permc_spec = METIS_AT_PLUS_A;
+#else
+	if ( permc_spec == PARMETIS ) permc_spec = MMD_AT_PLUS_A;
+#endif
+	if ( permc_spec != MY_PERMC && permc_spec != BEST_ORDERING )
+	    get_perm_c_dist(0, permc_spec, GA, perm_c);
+
+	if ( !(etree = intMalloc_dist(n)) ) ABORT("Malloc fails for etree[].");
+	sp_colorder(options, GA, perm_c, etree, &GAC);
+
+	/* Form Pc*A*Pc^T, as in the factorization. */
+	GACstore = (NCPformat *) GAC.Store;
+	for (j = 0; j < n; ++j)
+	    for (i = GACstore->colbeg[j]; i < GACstore->colend[j]; ++i) {
+		irow = GACstore->rowind[i];
+		GACstore->rowind[i] = perm_c[irow];
+	    }
+
+	iinfo = symbfact(options, 0, &GAC, perm_c, etree,
+			 &Glu_persist, &Glu_freeable);
+	Destroy_CompCol_Permuted_dist(&GAC);
+	SUPERLU_FREE(etree);
+    }
+    MPI_Bcast( &iinfo, 1, mpi_int_t, 0, grid->comm );
+    if ( iinfo > 0 ) return (int) iinfo;
+
+    if ( !grid->iam ) {
+	xsup = Glu_persist.xsup;
+	supno = Glu_persist.supno;
+	xlsub = Glu_freeable.xlsub;
+	lsub = Glu_freeable.lsub;
+	xusub = Glu_freeable.xusub;
+	usub = Glu_freeable.usub;
+	nsuper = supno[n-1] + 1;
+
+	/* Group the U segments by block row: for block row K, the pairs
+	   (useg[2*i], useg[2*i+1]) = (column, length), ustart[K] <= i
+	   < ustart[K+1]. */
+	if ( !(ustart = intCalloc_dist(nsuper + 1)) )
+	    ABORT("Calloc fails for ustart[].");
+	if ( !(useg = intMalloc_dist(2 * SUPERLU_MAX(xusub[n], 1))) )
+	    ABORT("Malloc fails for useg[].");
+	for (j = 0; j < n; ++j)
+	    for (i = xusub[j]; i < xusub[j+1]; ++i) ++ustart[supno[usub[i]] + 1];
+	for (K = 0; K < nsuper; ++K) ustart[K+1] += ustart[K];
+	for (j = 0; j < n; ++j)
+	    for (i = xusub[j]; i < xusub[j+1]; ++i) {
+		K = supno[usub[i]];
+		k = ustart[K]++;
+		useg[2*k] = j;
+		useg[2*k+1] = xsup[K+1] - usub[i];
+	    }
+	for (K = nsuper; K > 0; --K) ustart[K] = ustart[K-1];
+	ustart[0] = 0;
+
+	/* Flops per supernode, and the supernodal etree: the parent of K
+	   is the block of the first off-diagonal row of L(:,K). */
+	if ( !(spar = intMalloc_dist(4 * nsuper)) )
+	    ABORT("Malloc fails for spar[].");
+	depth = spar + nsuper;
+	bmark = depth + nsuper;
+	if ( !(sflops = (double *) SUPERLU_MALLOC(2 * nsuper * sizeof(double))) )
+	    ABORT("Malloc fails for sflops[].");
+	path = sflops + nsuper;
+	for (K = 0; K < nsuper; ++K) {
+	    fsupc = xsup[K];
+	    ns = xsup[K+1] - fsupc;
+	    nr = xlsub[fsupc+1] - xlsub[fsupc];
+	    spar[K] = nsuper;
+	    for (i = xlsub[fsupc]; i < xlsub[fsupc+1]; ++i)
+		if ( lsub[i] >= xsup[K+1] )
+		    spar[K] = SUPERLU_MIN(spar[K], supno[lsub[i]]);
+	    uk = us = 0.0;
+	    for (i = ustart[K]; i < ustart[K+1]; ++i) {
+		uk += useg[2*i+1];
+		us += (double) useg[2*i+1] * (useg[2*i+1] + 1);
+	    }
+	    fk = (double) ns;
+	    mk = (double) (nr - ns);
+	    /* As counted in pdgstrf2: the diagonal block, the triangular
+	       solves for the L and U panels, then the Schur update. */
+	    sflops[K] = fk*(fk-1.0)/2.0 + (fk-1.0)*fk*(2.0*fk-1.0)/3.0
+	              + fk*(fk+1.0)*mk + us + 2.0*mk*uk;
+	    path[K] = 0.0;
+	    depth[K] = 0;
+	}
+	for (K = 0; K < nsuper; ++K) { /* children precede their parents */
+	    path[K] += sflops[K];
+	    ++depth[K];
+	    if ( path[K] > crit ) {
+		crit = path[K];
+		crit_depth = depth[K];
+	    }
+	    if ( (J = spar[K]) < nsuper && path[K] > path[J] ) {
+		path[J] = path[K];
+		depth[J] = depth[K];
+	    }
+	}
+
+	for (c = 0; c < ncand; ++c) {
+	    pr = pred[c].nprow;
+	    pc = pred[c].npcol;
+	    P = pr * pc;
+	    pred[c].nnzLU = Glu_freeable.nnzLU;
+	    pred[c].nsuper = nsuper;
+	    pred[c].crit_flops = crit;
+	    pred[c].crit_depth = crit_depth;
+	    pred[c].flops = 0.0;
+	    for (K = 0; K < nsuper; ++K) pred[c].flops += sflops[K];
+
+	    if ( !(lrow = intCalloc_dist(2*pr + 3*pc)) )
+		ABORT("Calloc fails for lrow[].");
+	    lblk = lrow + pr;
+	    ucol = lblk + pr;
+	    ublk = ucol + pc;
+	    unz = ublk + pc;
+	    if ( !(mem = (double *) SUPERLU_MALLOC(2 * P * sizeof(double))) )
+		ABORT("Malloc fails for mem[].");
+	    send = mem + P;
+	    for (p = 0; p < 2 * P; ++p) mem[p] = 0.0;
+	    for (K = 0; K < 2 * nsuper; ++K) bmark[K] = -1;
+	    maxLbuf = maxUbuf = 0.0;
+
+	    for (K = 0; K < nsuper; ++K) {
+		fsupc = xsup[K];
+		ns = xsup[K+1] - fsupc;
+
+		/* L(:,K) on process column PCOL(K), split by block rows. */
+		for (i = xlsub[fsupc]; i < xlsub[fsupc+1]; ++i) {
+		    J = supno[lsub[i]];
+		    p = J % pr;
+		    ++lrow[p];
+		    if ( bmark[J] != K ) {
+			bmark[J] = K;
+			++lblk[p];
+		    }
+		}
+		/* U(K,:) on process row PROW(K), split by block columns. */
+		for (i = ustart[K]; i < ustart[K+1]; ++i) {
+		    J = supno[useg[2*i]];
+		    q = J % pc;
+		    ++ucol[q];
+		    unz[q] += useg[2*i+1];
+		    if ( bmark[nsuper + J] != K ) {
+			bmark[nsuper + J] = K;
+			++ublk[q];
+		    }
+		}
+
+		destrows = destcols = 0;
+		for (p = 0; p < pr; ++p)
+		    if ( lrow[p] && p != K % pr ) ++destrows;
+		for (q = 0; q < pc; ++q)
+		    if ( ucol[q] && q != K % pc ) ++destcols;
+
+		for (p = 0; p < pr; ++p) {
+		    if ( !lrow[p] ) continue;
+		    bytes = (double) lrow[p] * ns * dsize + (double) isize
+			* (BC_HEADER + LB_DESCRIPTOR * lblk[p] + lrow[p]);
+		    mem[p * pc + K % pc] += bytes;
+		    send[p * pc + K % pc] += bytes * destcols;
+		    maxLbuf = SUPERLU_MAX(maxLbuf, bytes);
+		    lrow[p] = lblk[p] = 0;
+		}
+		for (q = 0; q < pc; ++q) {
+		    if ( !ucol[q] ) continue;
+		    bytes = (double) unz[q] * dsize + (double) isize
+			* (BR_HEADER + UB_DESCRIPTOR * ublk[q] + ucol[q]);
+		    mem[(K % pr) * pc + q] += bytes;
+		    send[(K % pr) * pc + q] += bytes * destrows;
+		    maxUbuf = SUPERLU_MAX(maxUbuf, bytes);
+		    ucol[q] = ublk[q] = unz[q] = 0;
+		}
+	    } /* for K ... */
+
+	    /* Each process keeps the L and U panels of the look-ahead
+	       window in receive buffers. */
+	    buf = (options->num_lookaheads + 1) * (maxLbuf + maxUbuf);
+	    pred[c].mem_max = pred[c].mem_avg = 0.0;
+	    pred[c].comm_volume = pred[c].comm_max = 0.0;
+	    for (p = 0; p < P; ++p) {
+		pred[c].mem_max = SUPERLU_MAX(pred[c].mem_max, mem[p] + buf);
+		pred[c].mem_avg += mem[p] + buf;
+		pred[c].comm_max = SUPERLU_MAX(pred[c].comm_max, send[p]);
+		pred[c].comm_volume += send[p];
+	    }
+	    pred[c].mem_avg /= P;
+
+	    SUPERLU_FREE(lrow);
+	    SUPERLU_FREE(mem);
+	} /* for c ... */
+
+	SUPERLU_FREE(ustart);
+	SUPERLU_FREE(useg);
+	SUPERLU_FREE(spar);
+	SUPERLU_FREE(sflops);
+	symbfact_SubFree(&Glu_freeable);
+	SUPERLU_FREE(Glu_persist.xsup);
+	SUPERLU_FREE(Glu_persist.supno);
+    }
+
+    MPI_Bcast( pred, ncand * sizeof(superlu_predict_t), MPI_BYTE,
+	       0, grid->comm );
+    return 0;
+}
+
+/*! \brief Print the predictions of superlu_symbfact_predict() on process 0.
+ */
+void
+superlu_predict_print(int ncand, superlu_predict_t *pred, gridinfo_t *grid)
+{
+    int c;
+
+    if ( grid->iam || ncand <= 0 ) return;
+    printf("**************************************************\n");
+    printf(".. Predicted factorization cost\n");
+    printf("\tnnz(L+U) %lld, supernodes " IFMT ", flops %e\n",
+	   (long long) pred[0].nnzLU, pred[0].nsuper, pred[0].flops);
+    printf("\tcritical path: flops %e, supernodes " IFMT
+	   ", parallelism %.1f\n", pred[0].crit_flops, pred[0].crit_depth,
+	   pred[0].crit_flops > 0.0 ? pred[0].flops / pred[0].crit_flops : 0.0);
+    printf("\t%6s %6s %12s %12s %12s %12s\n", "nprow", "npcol",
+	   "mem max(MB)", "mem avg(MB)", "comm (MB)", "comm max(MB)");
+    for (c = 0; c < ncand; ++c)
+	printf("\t%6d %6d %12.2f %12.2f %12.2f %12.2f\n",
+	       pred[c].nprow, pred[c].npcol, pred[c].mem_max * 1e-6,
+	       pred[c].mem_avg * 1e-6, pred[c].comm_volume * 1e-6,
+	       pred[c].comm_max * 1e-6);
+    printf("**************************************************\n");
+    fflush(stdout);
+}
@@ -178,6 +178,17 @@ typedef struct {
 			       *  3 : maximum size of Uval_buf[]
 			       *  4 : maximum size of tempv[LDA]
 			       */
+    shmBcast_t *shmL;         /* Node-shared L receive slots, or NULL  */
+    shmBcast_t *shmU;         /* Node-shared U receive slots, or NULL  */
+    segBcast_t *segL;         /* Segmented L tree broadcast, or NULL   */
+    segBcast_t *segU;         /* Segmented U tree broadcast, or NULL   */
+    aggBcast_t *aggL;         /* Coalesced small L panels, or NULL     */
+    aggBcast_t *aggU;         /* Coalesced small U panels, or NULL     */
+    rmaBcast_t *rmaL;         /* One-sided L panel delivery, or NULL   */
+    rmaBcast_t *rmaU;         /* One-sided U panel delivery, or NULL   */
+    ancReduce_t *ancRed;      /* Pending ancestor reduction, or NULL   */
+    double *nodeCost;         /* Supernode times of the last 3D        */
+    int_t  nodeCostN;         /* factorization (SUPERLU_LBS_COST)      */
 
     /*-- Record communication schedule for factorization. --*/
     int   *ToRecv;          /* Recv from no one (0), left (1), and up (2).*/
@@ -452,6 +463,10 @@ sCompRow_to_CompCol_dist(int_t, int_t, int_t, float *, int_t *, int_t *,
 extern int
 psCompRow_loc_to_CompCol_global(int_t, SuperMatrix *, gridinfo_t *,
 	 		        SuperMatrix *);
+extern int
+pssymbfact_predict(superlu_dist_options_t *, SuperMatrix *,
+                   sScalePermstruct_t *, gridinfo_t *, int,
+                   superlu_predict_t *);
 extern void
 sCopy_CompCol_Matrix_dist(SuperMatrix *, SuperMatrix *);
 extern void
@@ -529,6 +544,8 @@ extern int_t psgstrs_init(int_t, int_t, int_t, int_t,
 extern void pxgstrs_finalize(pxgstrs_comm_t *);
 extern int  sldperm_dist(int, int, int_t, int_t [], int_t [],
 		    float [], int_t *, float [], float []);
+extern int  psldperm_dist(SuperMatrix *, gridinfo_t *, int_t [], int_t [],
+			  int_t *, float [], float []);
 extern int  sstatic_schedule(superlu_dist_options_t *, int, int,
 		            sLUstruct_t *, gridinfo_t *, SuperLUStat_t *,
 			    int_t *, int_t *, int *);
@@ -873,6 +890,8 @@ extern strf3Dpartition_t* sinitTrf3Dpartition(int_t nsupers,
 					     superlu_dist_options_t *options,
 					     sLUstruct_t *LUstruct, gridinfo3d_t * grid3d);
 extern void sDestroy_trf3Dpartition(strf3Dpartition_t *trf3Dpartition, gridinfo3d_t *grid3d);
+extern void sresetTrf3Dpartition(int_t nsupers, strf3Dpartition_t *,
+				 sLUstruct_t *, gridinfo3d_t *);
 
 extern void s3D_printMemUse(strf3Dpartition_t*  trf3Dpartition,
 			    sLUstruct_t *LUstruct, gridinfo3d_t * grid3d);
@@ -927,6 +946,11 @@ extern void psgstrf2(superlu_dist_options_t *, int_t nsupers, int_t k0,
     /* from p3dcomm.h */
 extern int_t sAllocLlu_3d(int_t nsupers, sLUstruct_t * LUstruct, gridinfo3d_t* grid3d);
 extern int_t sp3dScatter(int_t n, sLUstruct_t * LUstruct, gridinfo3d_t* grid3d);
+extern int_t sp3dScatterValues(int_t nsupers, strf3Dpartition_t *,
+			       sLUstruct_t *, gridinfo3d_t *);
+extern int_t sp3dDistributeA(superlu_dist_options_t *, int_t n, NRformat_loc *,
+			     sScalePermstruct_t *, float *anorm,
+			     strf3Dpartition_t *, sLUstruct_t *, gridinfo3d_t *);
 extern int_t sscatter3dLPanels(int_t nsupers,
                        sLUstruct_t * LUstruct, gridinfo3d_t* grid3d);
 extern int_t sscatter3dUPanels(int_t nsupers,
@@ -955,6 +979,12 @@ extern int sreduceAllAncestors3d(int_t ilvl, int_t* myNodeCount,
                            sLUstruct_t* LUstruct,
                            gridinfo3d_t* grid3d,
                            SCT_t* SCT );
+/* nonblocking ancestor reduction, SUPERLU_ANC_ASYNC */
+extern void sancReduceInit(int_t nsupers, sLUstruct_t *LUstruct);
+extern void sancReduceProgress(sLUstruct_t *, gridinfo3d_t *);
+extern void sancReduceWait(int_t k, sLUstruct_t *, gridinfo3d_t *, SCT_t *);
+extern void sancReduceFree(sLUstruct_t *, gridinfo3d_t *, SCT_t *);
+extern void sancLazyAlloc(HyP_t *, sLUstruct_t *, gridinfo_t *);
 /*
 	Copies factored L and U panels from sender grid to receiver grid
 	receiver[L(nodelist)] <-- sender[L(nodelist)];
@@ -1172,6 +1202,9 @@ extern int_t ssparseTreeFactor_ASYNC(
 );
 extern sLUValSubBuf_t** sLluBufInitArr(int_t numLA, sLUstruct_t *LUstruct);
 extern int sLluBufFreeArr(int_t numLA, sLUValSubBuf_t **LUvsbs);
+extern int sLluBufShmInit(int_t numLA, sLUValSubBuf_t **, int_t nsupers,
+			  gridinfo_t *, sLUstruct_t *);
+extern int sLluBufShmFree(int_t numLA, sLUValSubBuf_t **, sLUstruct_t *);
 extern sdiagFactBufs_t** sinitDiagFactBufsArr(int_t mxLeafNode, int_t ldt, gridinfo_t* grid);
 extern int sfreeDiagFactBufsArr(int_t mxLeafNode, sdiagFactBufs_t** dFBufs);
 extern int_t sinitDiagFactBufs(int_t ldt, sdiagFactBufs_t* dFBuf);
@@ -178,6 +178,17 @@ typedef struct {
 			       *  3 : maximum size of Uval_buf[]
 			       *  4 : maximum size of tempv[LDA]
 			       */
+    shmBcast_t *shmL;         /* Node-shared L receive slots, or NULL  */
+    shmBcast_t *shmU;         /* Node-shared U receive slots, or NULL  */
+    segBcast_t *segL;         /* Segmented L tree broadcast, or NULL   */
+    segBcast_t *segU;         /* Segmented U tree broadcast, or NULL   */
+    aggBcast_t *aggL;         /* Coalesced small L panels, or NULL     */
+    aggBcast_t *aggU;         /* Coalesced small U panels, or NULL     */
+    rmaBcast_t *rmaL;         /* One-sided L panel delivery, or NULL   */
+    rmaBcast_t *rmaU;         /* One-sided U panel delivery, or NULL   */
+    ancReduce_t *ancRed;      /* Pending ancestor reduction, or NULL   */
+    double *nodeCost;         /* Supernode times of the last 3D        */
+    int_t  nodeCostN;         /* factorization (SUPERLU_LBS_COST)      */
 
     /*-- Record communication schedule for factorization. --*/
     int   *ToRecv;          /* Recv from no one (0), left (1), and up (2).*/
@@ -452,6 +463,10 @@ zCompRow_to_CompCol_dist(int_t, int_t, int_t, doublecomplex *, int_t *, int_t *,
 extern int
 pzCompRow_loc_to_CompCol_global(int_t, SuperMatrix *, gridinfo_t *,
 	 		        SuperMatrix *);
+extern int
+pzsymbfact_predict(superlu_dist_options_t *, SuperMatrix *,
+                   zScalePermstruct_t *, gridinfo_t *, int,
+                   superlu_predict_t *);
 extern void
 zCopy_CompCol_Matrix_dist(SuperMatrix *, SuperMatrix *);
 extern void
@@ -529,6 +544,8 @@ extern int_t pzgstrs_init(int_t, int_t, int_t, int_t,
 extern void pxgstrs_finalize(pxgstrs_comm_t *);
 extern int  zldperm_dist(int, int, int_t, int_t [], int_t [],
 		    doublecomplex [], int_t *, double [], double []);
+extern int  pzldperm_dist(SuperMatrix *, gridinfo_t *, int_t [], int_t [],
+			  int_t *, double [], double []);
 extern int  zstatic_schedule(superlu_dist_options_t *, int, int,
 		            zLUstruct_t *, gridinfo_t *, SuperLUStat_t *,
 			    int_t *, int_t *, int *);
@@ -875,6 +892,8 @@ extern ztrf3Dpartition_t* zinitTrf3Dpartition(int_t nsupers,
 					     superlu_dist_options_t *options,
 					     zLUstruct_t *LUstruct, gridinfo3d_t * grid3d);
 extern void zDestroy_trf3Dpartition(ztrf3Dpartition_t *trf3Dpartition, gridinfo3d_t *grid3d);
+extern void zresetTrf3Dpartition(int_t nsupers, ztrf3Dpartition_t *,
+				 zLUstruct_t *, gridinfo3d_t *);
 
 extern void z3D_printMemUse(ztrf3Dpartition_t*  trf3Dpartition,
 			    zLUstruct_t *LUstruct, gridinfo3d_t * grid3d);
@@ -929,6 +948,11 @@ extern void pzgstrf2(superlu_dist_options_t *, int_t nsupers, int_t k0,
     /* from p3dcomm.h */
 extern int_t zAllocLlu_3d(int_t nsupers, zLUstruct_t * LUstruct, gridinfo3d_t* grid3d);
 extern int_t zp3dScatter(int_t n, zLUstruct_t * LUstruct, gridinfo3d_t* grid3d);
+extern int_t zp3dScatterValues(int_t nsupers, ztrf3Dpartition_t *,
+			       zLUstruct_t *, gridinfo3d_t *);
+extern int_t zp3dDistributeA(superlu_dist_options_t *, int_t n, NRformat_loc *,
+			     zScalePermstruct_t *, double *anorm,
+			     ztrf3Dpartition_t *, zLUstruct_t *, gridinfo3d_t *);
 extern int_t zscatter3dLPanels(int_t nsupers,
                        zLUstruct_t * LUstruct, gridinfo3d_t* grid3d);
 extern int_t zscatter3dUPanels(int_t nsupers,
@@ -957,6 +981,12 @@ extern int zreduceAllAncestors3d(int_t ilvl, int_t* myNodeCount,
                            zLUstruct_t* LUstruct,
                            gridinfo3d_t* grid3d,
                            SCT_t* SCT );
+/* nonblocking ancestor reduction, SUPERLU_ANC_ASYNC */
+extern void zancReduceInit(int_t nsupers, zLUstruct_t *LUstruct);
+extern void zancReduceProgress(zLUstruct_t *, gridinfo3d_t *);
+extern void zancReduceWait(int_t k, zLUstruct_t *, gridinfo3d_t *, SCT_t *);
+extern void zancReduceFree(zLUstruct_t *, gridinfo3d_t *, SCT_t *);
+extern void zancLazyAlloc(HyP_t *, zLUstruct_t *, gridinfo_t *);
 /*
 	Copies factored L and U panels from sender grid to receiver grid
 	receiver[L(nodelist)] <-- sender[L(nodelist)];
@@ -1174,6 +1204,9 @@ extern int_t zsparseTreeFactor_ASYNC(
 );
 extern zLUValSubBuf_t** zLluBufInitArr(int_t numLA, zLUstruct_t *LUstruct);
 extern int zLluBufFreeArr(int_t numLA, zLUValSubBuf_t **LUvsbs);
+extern int zLluBufShmInit(int_t numLA, zLUValSubBuf_t **, int_t nsupers,
+			  gridinfo_t *, zLUstruct_t *);
+extern int zLluBufShmFree(int_t numLA, zLUValSubBuf_t **, zLUstruct_t *);
 extern zdiagFactBufs_t** zinitDiagFactBufsArr(int_t mxLeafNode, int_t ldt, gridinfo_t* grid);
 extern int zfreeDiagFactBufsArr(int_t mxLeafNode, zdiagFactBufs_t** dFBufs);
 extern int_t zinitDiagFactBufs(int_t ldt, zdiagFactBufs_t* dFBuf);
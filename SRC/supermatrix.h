@@ -214,6 +214,9 @@ typedef struct NRformat_loc3d
     int num_procs_to_recv;
     int *procs_recv_from_list;
     int *recv_count_list;
+
+    void *trf3Dpart; /* 3D partition kept for SamePattern_SameRowPerm,
+                        see pdgssvx3d() */
 } NRformat_loc3d;
 
 
@@ -26,23 +26,24 @@ int_t calcTopInfoForest(sForest_t *forest,
                         int_t nsupers, int_t* setree);
 
 
-sForest_t**  getForests( int_t maxLvl, int_t nsupers, int_t*setree, treeList_t* treeList)
+/* Pz is the number of process layers; when it is not a power of two, the
+   forests of the missing layers 2^(maxLvl-1) > z >= Pz are left empty. */
+sForest_t**  getForests( int_t maxLvl, int_t Pz, int_t nsupers, int_t*setree, treeList_t* treeList)
 {
 	// treePartStrat tps;
 	if (getenv("SUPERLU_LBS"))
 	{
-		if (strcmp(getenv("SUPERLU_LBS"), "ND" ) == 0)
+		/* ND splits the tree by its separators, which only pairs up
+		   when every layer has a partner */
+		if (strcmp(getenv("SUPERLU_LBS"), "ND" ) == 0 && Pz == (1 << (maxLvl - 1)))
 		{
 			return getNestDissForests( maxLvl, nsupers, setree, treeList);
 		}
-		if (strcmp(getenv("SUPERLU_LBS"), "GD" ) == 0)
-		{
-			return getGreedyLoadBalForests( maxLvl, nsupers, setree, treeList);
-		}
+		return getGreedyLoadBalForests( maxLvl, Pz, nsupers, setree, treeList);
 	}
 	else
 	{
-		return getGreedyLoadBalForests( maxLvl, nsupers, setree, treeList);
+		return getGreedyLoadBalForests( maxLvl, Pz, nsupers, setree, treeList);
 	}
 	return 0;
 }
@@ -460,9 +461,10 @@ void printGantt(int root, int numForests, char* nodename, double scale, double*
 }
 
 #define ABS(a) ((a)<0?-(a):a)
+/* frac is the share of the total weight wanted in the first half */
 double getLoadImbalance(int_t nTrees,
                         int_t * treeIndx,				// index of tree in gtrees
-                        double * gTreeWeights)
+                        double * gTreeWeights, double frac)
 {
 
 	if (nTrees < 1)
@@ -481,7 +483,7 @@ double getLoadImbalance(int_t nTrees,
 	for (int i = nTrees - 2 ; i > -1; --i)
 	{
 		/* code */
-		if (w1 > w2)
+		if (w1 * (1 - frac) > w2 * frac)
 		{
 			/* code */
 			w2 += gTreeWeights[wSortIdx[i]];
@@ -495,7 +497,7 @@ double getLoadImbalance(int_t nTrees,
 	}
 
 	SUPERLU_FREE(wSortIdx);
-	return ABS(w2 - w1) / (w2 + w1);
+	return ABS(w2 * frac - w1 * (1 - frac)) / (w2 * frac + w1 * (1 - frac));
 	// return trPart;
 
 }
@@ -523,10 +525,40 @@ typedef struct
 
 void freeRforest(rForest_t* rforest)
 {
-	SUPERLU_FREE(rforest->treeHeads);
+	if (rforest->treeHeads) SUPERLU_FREE(rforest->treeHeads);
 }
 
 
+static treeList_t* sortTreeList;
+
+static int cmpfuncBLevel(const void * a, const void * b)
+{
+	double ba = sortTreeList[*(int_t*)a].bLevel;
+	double bb = sortTreeList[*(int_t*)b].bLevel;
+	if (ba != bb) return ba < bb ? 1 : -1;
+	return (*(int_t*)a > *(int_t*)b) - (*(int_t*)a < *(int_t*)b);
+}
+
+/*
+ * Critical-path schedule (SUPERLU_CP_SCHED): the supernodes of a
+ * topological level do not depend on each other, so factor and broadcast
+ * them heaviest path to the root first.
+ */
+static void sortLevelsByBLevel(sForest_t *forest, int_t nsupers, treeList_t* treeList)
+{
+	treeTopoInfo_t* ttI = &forest->topoInfo;
+
+	sortTreeList = treeList;
+	for (int_t lvl = 0; lvl < ttI->numLvl; ++lvl)
+	{
+		int_t st = ttI->eTreeTopLims[lvl];
+		qsort(&forest->nodeList[st], ttI->eTreeTopLims[lvl + 1] - st,
+		      sizeof(int_t), cmpfuncBLevel);
+	}
+	SUPERLU_FREE(ttI->myIperm);
+	ttI->myIperm = getMyIperm(forest->nNodes, nsupers, forest->nodeList);
+}
+
 sForest_t*  createForestNew(int_t numTrees, int_t nsupers, int_t * nodeCounts,  int_t** NodeLists, int_t * setree, treeList_t* treeList)
 {
 	if (numTrees == 0) return NULL;
@@ -564,13 +596,15 @@ sForest_t*  createForestNew(int_t numTrees, int_t nsupers, int_t * nodeCounts,
 
 	// using the nodelist create factorization ordering
 	calcTopInfoForest(forest, nsupers, setree);
+	if (getenv("SUPERLU_CP_SCHED"))
+		sortLevelsByBLevel(forest, nsupers, treeList);
 
 	return forest;
 }
 
 void oneLeveltreeFrPartition( int_t nTrees, int_t * trCount, int_t** trList,
                               int_t * treeSet,
-                              double * sWeightArr)
+                              double * sWeightArr, double frac)
 {
 	if (nTrees < 1)
 	{
@@ -595,7 +629,7 @@ void oneLeveltreeFrPartition( int_t nTrees, int_t * trCount, int_t** trList,
 	for (int i = nTrees - 2 ; i > -1; --i)
 	{
 		/* code */
-		if (w1 > w2)
+		if (w1 * (1 - frac) > w2 * frac)
 		{
 			/* code */
 			w2 += sWeightArr[wSortIdx[i]];
@@ -615,7 +649,7 @@ void oneLeveltreeFrPartition( int_t nTrees, int_t * trCount, int_t** trList,
 
 } /* oneLeveltreeFrPartition */
 
-forestPartition_t iterativeFrPartitioning(rForest_t* rforest, int_t nsupers, int_t * setree, treeList_t* treeList)
+forestPartition_t iterativeFrPartitioning(rForest_t* rforest, int_t nsupers, int_t * setree, treeList_t* treeList, double frac)
 {
 
     int_t nTreeSet = rforest->ntrees;
@@ -643,7 +677,7 @@ forestPartition_t iterativeFrPartitioning(rForest_t* rforest, int_t nsupers, int
 		weightArr[i] = treeList[treeHeads[i]].iWeight;
 	}
 
-	while (getLoadImbalance(nTreeSet, treeSet, weightArr) > ACCEPTABLE_TREE_IMBALANCE )
+	while (getLoadImbalance(nTreeSet, treeSet, weightArr, frac) > ACCEPTABLE_TREE_IMBALANCE )
 	{
 		// get index of maximum weight subtree
 		int_t idx = 0;
@@ -712,7 +746,7 @@ forestPartition_t iterativeFrPartitioning(rForest_t* rforest, int_t nsupers, int
 
 	oneLeveltreeFrPartition( nTreeSet, trCount, trList,
 	                         treeSet,
-	                         sWeightArr);
+	                         sWeightArr, frac);
 
 	rForest_t *rforestS1, *rforestS2;
 #if 0
@@ -791,7 +825,48 @@ sForest_t* r2sForest(rForest_t* rforest, int_t nsupers, int_t * setree, treeList
 } /* r2sForest */
 
 
-sForest_t**  getGreedyLoadBalForests( int_t maxLvl, int_t nsupers, int_t * setree, treeList_t* treeList)
+/* Number of the Pz real layers below forest tr at level lvl of the heap */
+static int_t numLayersBelow(int_t maxLvl, int_t Pz, int_t lvl, int_t tr)
+{
+	int_t span = 1 << (maxLvl - 1 - lvl);
+	int_t nl = Pz - (tr - ((1 << lvl) - 1)) * span;
+
+	return SUPERLU_MAX(0, SUPERLU_MIN(nl, span));
+}
+
+static void freeSforest(sForest_t* sforest)
+{
+	if (!sforest) return;
+	SUPERLU_FREE(sforest->nodeList);
+	SUPERLU_FREE((sforest->topoInfo).eTreeTopLims);
+	SUPERLU_FREE((sforest->topoInfo).myIperm);
+	SUPERLU_FREE(sforest);
+}
+
+/*
+ * Hybrid mode (SUPERLU_LBS_HYBRID=r, r the cost of sending one word in
+ * units of the supernode weight): whether giving the two parts of a forest
+ * to its nl left and nr right layers saves more than the right layers take
+ * to send back their copies of the ancestors, ancWords words in all.  If
+ * not, the right layers sit out this subtree.
+ */
+static int splitPays(forestPartition_t* frPr, int_t nl, int_t nr,
+		     double ancWords, double wordCost, treeList_t* treeList)
+{
+	double w[2];
+
+	for (int s = 0; s < 2; ++s)
+	{
+	    w[s] = 0.0;
+	    for (int_t i = 0; i < frPr->S[s]->ntrees; ++i)
+		w[s] += treeList[frPr->S[s]->treeHeads[i]].iWeight;
+	}
+
+	return SUPERLU_MAX(w[0] / nl, w[1] / nr) + wordCost * ancWords
+	    < (w[0] + w[1]) / nl;
+}
+
+sForest_t**  getGreedyLoadBalForests( int_t maxLvl, int_t Pz, int_t nsupers, int_t * setree, treeList_t* treeList)
 {
 
 	// assert(maxLvl == 2);
@@ -836,6 +911,12 @@ sForest_t**  getGreedyLoadBalForests( int_t maxLvl, int_t nsupers, int_t * setre
 		return sForests;
 	}
 
+	char* ttemp = getenv("SUPERLU_LBS_HYBRID");
+	double wordCost = ttemp ? atof(ttemp) : 0.0;
+	/* words of the ancestors above each forest */
+	double* ancWords = DOUBLE_ALLOC(numForests);
+	ancWords[0] = 0.0;
+
 	// now loop over level
 	for (int_t lvl = 0; lvl < maxLvl - 1; ++lvl)
 	{
@@ -845,9 +926,51 @@ sForest_t**  getGreedyLoadBalForests( int_t maxLvl, int_t nsupers, int_t * setre
 
 		for (int_t tr = lvlSt; tr < lvlEnd; ++tr)
 		{
-		    /* code */
-		    forestPartition_t frPr_t = iterativeFrPartitioning(&rForests[tr], nsupers, setree, treeList);
+		    /* layers under the two children; the left one is full first */
+		    int_t nl = numLayersBelow(maxLvl, Pz, lvl + 1, 2 * tr + 1);
+		    int_t nr = numLayersBelow(maxLvl, Pz, lvl + 1, 2 * tr + 2);
+		    int split = nr > 0 && rForests[tr].ntrees > 0;
+		    forestPartition_t frPr_t;
+		    double aWords = 0.0;
+
+		    if (split) {
+			frPr_t = iterativeFrPartitioning(&rForests[tr], nsupers, setree, treeList,
+							 (double) nl / (nl + nr));
+			if (frPr_t.Ans)
+			    for (int_t i = 0; i < frPr_t.Ans->nNodes; ++i)
+				aWords += treeList[frPr_t.Ans->nodeList[i]].commWeight;
+			if (wordCost > 0.0 && !splitPays(&frPr_t, nl, nr, ancWords[tr] + aWords,
+							  wordCost, treeList)) {
+			    freeSforest(frPr_t.Ans);
+			    freeRforest(frPr_t.S[0]);
+			    freeRforest(frPr_t.S[1]);
+			    SUPERLU_FREE(frPr_t.S[0]);
+			    SUPERLU_FREE(frPr_t.S[1]);
+			    split = 0;
+			}
+		    }
+
+		    if (!split) {
+			/* No layer to pair with, or the pair does not pay for
+			   the ancestor reduction: nothing is replicated at this
+			   level and the whole forest goes down the left side. */
+			ancWords[2 * tr + 1] = ancWords[2 * tr + 2] = ancWords[tr];
+			sForests[tr] = NULL;
+			if (lvl == maxLvl - 2) {
+			    sForests[2 * tr + 1] = r2sForest(&rForests[tr], nsupers, setree, treeList);
+			    sForests[2 * tr + 2] = NULL;
+			} else {
+			    rForests[2 * tr + 1] = rForests[tr];
+			    rForests[2 * tr + 2].ntrees = 0;
+			    rForests[2 * tr + 2].treeHeads = NULL;
+			    rForests[tr].ntrees = 0;
+			    rForests[tr].treeHeads = NULL;
+			}
+			continue;
+		    }
+
 		    sForests[tr] = frPr_t.Ans;
+		    ancWords[2 * tr + 1] = ancWords[2 * tr + 2] = ancWords[tr] + aWords;
 
 		    if (lvl == maxLvl - 2) {
 			/* code */
@@ -877,6 +1000,7 @@ sForest_t**  getGreedyLoadBalForests( int_t maxLvl, int_t nsupers, int_t * setre
 	}
 
 	SUPERLU_FREE(rForests);  // Sherry added
+	SUPERLU_FREE(ancWords);
 
 	return sForests;
 
@@ -937,7 +1061,7 @@ sForest_t**  getOneLevelBalForests( int_t maxLvl, int_t nsupers, int_t * setree,
 		for (int_t tr = lvlSt; tr < lvlEnd; ++tr)
 		{
 			/* code */
-			forestPartition_t frPr_t = iterativeFrPartitioning(&rForests[tr], nsupers, setree, treeList);
+			forestPartition_t frPr_t = iterativeFrPartitioning(&rForests[tr], nsupers, setree, treeList, 0.5);
 			sForests[tr] = frPr_t.Ans;
 
 			if (lvl == maxLvl - 2)
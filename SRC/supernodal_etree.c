@@ -14,10 +14,12 @@
 //#include "supernodal_etree.h"
 
 #define INT_T_ALLOC(x)  ((int_t *) SUPERLU_MALLOC ( (x) * sizeof (int_t)))
+/* Smallest l with 2^l >= index: the 3D code keeps log2i(Pz) + 1 levels
+   of forests, whatever the number Pz of process layers. */
 int_t log2i(int_t index)
 {
 	int_t targetlevel = 0;
-	while (index >>= 1) ++targetlevel;
+	while ((1 << targetlevel) < index) ++targetlevel;
 	return targetlevel;
 }
 
@@ -81,6 +83,8 @@ treeList_t* setree2list(int_t nsuper, int_t* setree )
 	    treeList[i].right = -1;
 	    treeList[i].right = -1;
 	    treeList[i].depth = 0;
+	    treeList[i].commWeight = 0.0;
+	    treeList[i].bLevel = 0.0;
 	}
 	for (int i = 0; i < nsuper; ++i)
 	{
@@ -180,6 +184,18 @@ int_t estimateWeight(int_t nsupers, int_t*setree, treeList_t* treeList, int_t* x
 } /* estimateWeight */
 
 
+/* Weight of the heaviest path from each supernode up to the root; the
+   parent comes after its children. */
+static void calcBottomLevel(int_t nsupers, int_t* setree, treeList_t* treeList)
+{
+	for (int_t i = nsupers - 1; i > -1; --i)
+	{
+		int_t parenti = setree[i];
+		treeList[i].bLevel = treeList[i].weight
+		    + (parenti < nsupers ? treeList[parenti].bLevel : 0.0);
+	}
+}
+
 int_t calcTreeWeight(int_t nsupers, int_t*setree, treeList_t* treeList, int_t* xsup)
 {
 
@@ -231,12 +247,45 @@ int_t calcTreeWeight(int_t nsupers, int_t*setree, treeList_t* treeList, int_t* x
 		int_t parenti = setree[i];
 		treeList[parenti].iWeight += treeList[i].iWeight;
 	}
+	calcBottomLevel(nsupers, setree, treeList);
 
 
 	return 0;
 
 } /* calcTreeWeight */
 
+/*
+ * Replace the estimated supernode weights by the times measured in the
+ * previous factorization (SUPERLU_LBS_COST), scaled to the same total,
+ * and recompute the subtree weights.  The partitioning then balances the
+ * layers by what they actually spent.
+ */
+void setMeasuredWeight(int_t nsupers, int_t* setree, treeList_t* treeList,
+		       double* nodeCost)
+{
+	double wsum = 0.0, csum = 0.0;
+
+	for (int i = 0; i < nsupers; ++i)
+	{
+		wsum += treeList[i].weight;
+		csum += nodeCost[i];
+	}
+	if (csum <= 0.0) return;	/* nothing was timed */
+
+	for (int i = 0; i < nsupers; ++i)
+	{
+		treeList[i].weight = wsum / csum * nodeCost[i];
+		treeList[i].iWeight = treeList[i].weight;
+	}
+
+	for (int i = 0; i < nsupers; ++i)
+	{
+		int_t parenti = setree[i];
+		treeList[parenti].iWeight += treeList[i].iWeight;
+	}
+	calcBottomLevel(nsupers, setree, treeList);
+} /* setMeasuredWeight */
+
 
 int_t printFileList(char* sname, int_t nnodes, int_t*dlist, int_t*setree)
 {
@@ -803,7 +852,7 @@ int_t* getGridTrees( gridinfo3d_t* grid3d)
 {
 	int_t maxLvl = log2i(grid3d->zscp.Np) + 1;
 	int_t* myTreeIdx = (int_t*) SUPERLU_MALLOC (maxLvl * sizeof (int_t));
-	myTreeIdx[0] = grid3d->zscp.Np - 1 + grid3d->zscp.Iam ;
+	myTreeIdx[0] = (1 << (maxLvl - 1)) - 1 + grid3d->zscp.Iam ;
 	for (int i = 1; i < maxLvl; ++i)
 	{
 		/* code */
@@ -1058,3 +1107,187 @@ void print_etree(int_t *setree, int_t* iperm, int_t nsuper)
 	fprintf(fp, "//EOF\n");
 	fclose(fp);
 }
+
+
+/* Rectangle of the process grid holding a subtree */
+typedef struct {
+	int r0, nr;		/* first process row, number of process rows */
+	int c0, nc;		/* first process column, number of process columns */
+} subgrid_t;
+
+typedef struct {
+	int_t node;
+	double weight;		/* weight of the subtree under node */
+} smapChild_t;
+
+static int cmpfuncSmapChild(const void* a, const void* b)
+{
+	double wa = ((const smapChild_t*) a)->weight;
+	double wb = ((const smapChild_t*) b)->weight;
+	return (wa < wb) - (wa > wb);	/* heaviest first */
+}
+
+/* Split subgrid g among the sibling subtrees child[0:nchild-1], sorted
+   heaviest first: two groups of about equal weight share g along its
+   longer side in proportion to their weights, recursively.  A single
+   subtree, or a single process, keeps the whole of g. */
+static void splitSubgrid(int_t nchild, smapChild_t* child, smapChild_t* work,
+			 subgrid_t g, subgrid_t* sg)
+{
+	if (nchild == 0) return;
+	if (nchild == 1 || g.nr * g.nc == 1)
+	{
+		for (int_t i = 0; i < nchild; ++i) sg[child[i].node] = g;
+		return;
+	}
+
+	/* Greedy two-way partition; both groups stay sorted. */
+	double w[2] = {0.0, 0.0};
+	int_t n1 = 0, n2 = 0;
+	for (int_t i = 0; i < nchild; ++i)
+	{
+		if (w[0] <= w[1])
+		{
+			w[0] += child[i].weight;
+			child[n1++] = child[i];
+		}
+		else
+		{
+			w[1] += child[i].weight;
+			work[n2++] = child[i];
+		}
+	}
+	for (int_t i = 0; i < n2; ++i) child[n1 + i] = work[i];
+
+	subgrid_t g1 = g, g2 = g;
+	int len = SUPERLU_MAX(g.nr, g.nc);
+	int l1 = w[0] + w[1] > 0.0 ? (int) (len * w[0] / (w[0] + w[1]) + 0.5)
+	                           : len / 2;
+	l1 = SUPERLU_MIN(SUPERLU_MAX(l1, 1), len - 1);
+	if (g.nr >= g.nc)
+	{
+		g1.nr = l1;
+		g2.r0 = g.r0 + l1;
+		g2.nr = g.nr - l1;
+	}
+	else
+	{
+		g1.nc = l1;
+		g2.c0 = g.c0 + l1;
+		g2.nc = g.nc - l1;
+	}
+	splitSubgrid(n1, child, work, g1, sg);
+	splitSubgrid(n2, child + n1, work, g2, sg);
+}
+
+/*
+ * Replace the block-cyclic mapping of supernodes to the process grid by
+ * a proportional one (SUPERLU_PROP_MAP): the etree is walked from the
+ * root, and the subgrid of each node is split among its children in
+ * proportion to the flop weight of their subtrees.  Supernodes are then
+ * mapped cyclically within their own subgrid, so the top separators
+ * still use the whole grid while independent subtrees use disjoint
+ * process sets and need no communication between them.
+ * The weight of a supernode comes from its L structure in Glu_freeable.
+ * The mapping is installed in grid->smap and read through PROW, PCOL,
+ * LBi, LBj, GBi, GBj and NLBi, NLBj.
+ */
+void superlu_smap_init(int_t n, int_t *etree, Glu_persist_t *Glu_persist,
+		       Glu_freeable_t *Glu_freeable, gridinfo_t *grid)
+{
+	int_t *xsup = Glu_persist->xsup;
+	int_t *xlsub = Glu_freeable->xlsub;
+	int_t nsupers = Glu_persist->supno[n - 1] + 1;
+	int Pr = grid->nprow, Pc = grid->npcol;
+	int myrow = MYROW(grid->iam, grid), mycol = MYCOL(grid->iam, grid);
+
+	superlu_smap_free(grid);
+#ifdef GPU_ACC
+	/* The device copy of the grid cannot follow the host tables. */
+	return;
+#endif
+	if (Pr * Pc == 1) return;
+
+	int_t *setree = supernodal_etree(nsupers, etree, Glu_persist->supno, xsup);
+	treeList_t *treeList = setree2list(nsupers, setree);
+
+	/* Panel factorization plus Schur complement update */
+	for (int_t k = 0; k <= nsupers; ++k) treeList[k].iWeight = 0.0;
+	for (int_t k = 0; k < nsupers; ++k)
+	{
+		double sz = SuperSize(k);
+		double nr = xlsub[xsup[k] + 1] - xlsub[xsup[k]];
+		treeList[k].iWeight += sz * sz * nr + 2.0 * (nr - sz) * (nr - sz) * sz;
+		treeList[setree[k]].iWeight += treeList[k].iWeight;
+	}
+
+	int_t maxChild = 0;
+	for (int_t k = 0; k <= nsupers; ++k)
+		maxChild = SUPERLU_MAX(maxChild, treeList[k].numChild);
+	smapChild_t *child = SUPERLU_MALLOC(2 * (maxChild + 1) * sizeof(smapChild_t));
+	subgrid_t *sg = SUPERLU_MALLOC((nsupers + 1) * sizeof(subgrid_t));
+
+	/* Parents come after their children; nsupers is the virtual root. */
+	sg[nsupers].r0 = sg[nsupers].c0 = 0;
+	sg[nsupers].nr = Pr;
+	sg[nsupers].nc = Pc;
+	for (int_t k = nsupers; k >= 0; --k)
+	{
+		int_t nchild = treeList[k].numChild;
+		for (int_t i = 0; i < nchild; ++i)
+		{
+			child[i].node = treeList[k].childrenList[i];
+			child[i].weight = treeList[child[i].node].iWeight;
+		}
+		qsort(child, nchild, sizeof(smapChild_t), cmpfuncSmapChild);
+		splitSubgrid(nchild, child, child + maxChild + 1, sg[k], sg);
+	}
+
+	superlu_smap_t *smap = SUPERLU_MALLOC(sizeof(superlu_smap_t));
+	smap->nsupers = nsupers;
+	smap->prow = SUPERLU_MALLOC(nsupers * sizeof(int));
+	smap->pcol = SUPERLU_MALLOC(nsupers * sizeof(int));
+	smap->lbi = intMalloc_dist(nsupers);
+	smap->lbj = intMalloc_dist(nsupers);
+	int_t *nbr = intCalloc_dist(Pr + Pc), *nbc = nbr + Pr;
+	for (int_t k = 0; k < nsupers; ++k)
+	{
+		int pr = sg[k].r0 + k % sg[k].nr;
+		int pc = sg[k].c0 + k % sg[k].nc;
+		smap->prow[k] = pr;
+		smap->pcol[k] = pc;
+		smap->lbi[k] = nbr[pr]++;
+		smap->lbj[k] = nbc[pc]++;
+	}
+	smap->nlbi = smap->nlbj = 1;
+	for (int i = 0; i < Pr; ++i) smap->nlbi = SUPERLU_MAX(smap->nlbi, nbr[i]);
+	for (int j = 0; j < Pc; ++j) smap->nlbj = SUPERLU_MAX(smap->nlbj, nbc[j]);
+	smap->mynlbi = nbr[myrow];
+	smap->mynlbj = nbc[mycol];
+	smap->gbi = intMalloc_dist(smap->nlbi + 1);
+	smap->gbj = intMalloc_dist(smap->nlbj + 1);
+	for (int_t lb = 0; lb <= smap->nlbi; ++lb) smap->gbi[lb] = nsupers;
+	for (int_t lb = 0; lb <= smap->nlbj; ++lb) smap->gbj[lb] = nsupers;
+	for (int_t k = 0; k < nsupers; ++k)
+	{
+		if (smap->prow[k] == myrow) smap->gbi[smap->lbi[k]] = k;
+		if (smap->pcol[k] == mycol) smap->gbj[smap->lbj[k]] = k;
+	}
+	grid->smap = smap;
+
+#if ( PRNTlevel>=1 )
+	int_t nsub = 0;
+	for (int_t k = 0; k < nsupers; ++k)
+		if (sg[k].nr * sg[k].nc < Pr * Pc) ++nsub;
+	if (!grid->iam)
+		printf(".. Proportional mapping: " IFMT " of " IFMT
+		       " supernodes on a subgrid, local blocks <= " IFMT " x " IFMT "\n",
+		       nsub, nsupers, smap->nlbi, smap->nlbj);
+#endif
+
+	SUPERLU_FREE(nbr);
+	SUPERLU_FREE(sg);
+	SUPERLU_FREE(child);
+	free_treelist(nsupers, treeList);
+	SUPERLU_FREE(setree);
+} /* superlu_smap_init */
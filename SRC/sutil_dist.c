@@ -401,8 +401,8 @@ void sScaleAdd_CompRowLoc_Matrix_dist(SuperMatrix *A, SuperMatrix *B, float c)
 float sMaxAbsLij(int iam, int n, Glu_persist_t *Glu_persist,
 		 sLUstruct_t *LUstruct, gridinfo_t *grid)
 {
-    register int extra, gb, j, lb, nsupc, nsupr, ncb;
-    register int_t k, mycol, r;
+    register int gb, j, lb, nsupc, nsupr, ncb;
+    register int_t k, r;
     sLocalLU_t *Llu = LUstruct->Llu;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
@@ -410,16 +410,13 @@ float sMaxAbsLij(int iam, int n, Glu_persist_t *Glu_persist,
     int nsupers = Glu_persist->supno[n-1] + 1;
     float lmax = 0.0, lmax_loc = 0.0;
 
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (j = 0; j < nsupc; ++j) {
                 for (r = 0; r < nsupr; ++r) {
@@ -443,18 +440,15 @@ float sMaxAbsUij(int iam, int n, Glu_persist_t *Glu_persist,
 		 sLUstruct_t *LUstruct, gridinfo_t *grid)
 {
     sLocalLU_t *Llu = LUstruct->Llu;
-    register int c, extra, jb, k, lb, len, nb, nrb, nsupc;
-    register int myrow, r, j, nsupers;
+    register int c, jb, k, lb, len, nb, nrb, nsupc;
+    register int r, j, nsupers;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
     float *nzval;
     float umax = 0.0, umax_loc = 0.0;
 
     nsupers = Glu_persist->supno[n-1] + 1;
-    nrb = nsupers / grid->nprow;
-    extra = nsupers % grid->nprow;
-    myrow = MYROW( iam, grid );
-    if ( myrow < extra ) ++nrb;
+    nrb = MyNLBi( nsupers, grid );
 
     // Sherry: Can also compute the maximum row count ...
     for (lb = 0; lb < nrb; ++lb) {
@@ -534,6 +528,7 @@ int sDeAllocGlu_3d(sLUstruct_t * LUstruct)
 {
     SUPERLU_FREE(LUstruct->Glu_persist->xsup);
     SUPERLU_FREE(LUstruct->Glu_persist->supno);
+    LUstruct->Glu_persist->xsup = LUstruct->Glu_persist->supno = NULL;
     return 0;
 }
 
@@ -549,16 +544,19 @@ int sDeAllocLlu_3d(int_t n, sLUstruct_t * LUstruct, gridinfo3d_t* grid3d)
     for (i = 0; i < nbc; ++i) 
 	if ( Llu->Lrowind_bc_ptr[i] ) {
 	    SUPERLU_FREE (Llu->Lrowind_bc_ptr[i]);
-	    SUPERLU_FREE (Llu->Lnzval_bc_ptr[i]);
+	    /* may be unallocated with lazy ancestor storage */
+	    if ( Llu->Lnzval_bc_ptr[i] ) SUPERLU_FREE (Llu->Lnzval_bc_ptr[i]);
 	}
     SUPERLU_FREE (Llu->Lrowind_bc_ptr);
     SUPERLU_FREE (Llu->Lnzval_bc_ptr);
+    Llu->Lrowind_bc_ptr = NULL; /* tells pdgssvx3d() the structure is gone */
+    Llu->Lnzval_bc_ptr = NULL;
 
     nbr = CEILING(nsupers, grid3d->nprow);
     for (i = 0; i < nbr; ++i)
 	if ( Llu->Ufstnz_br_ptr[i] ) {
 	    SUPERLU_FREE (Llu->Ufstnz_br_ptr[i]);
-	    SUPERLU_FREE (Llu->Unzval_br_ptr[i]);
+	    if ( Llu->Unzval_br_ptr[i] ) SUPERLU_FREE (Llu->Unzval_br_ptr[i]);
 	}
     SUPERLU_FREE (Llu->Ufstnz_br_ptr);
     SUPERLU_FREE (Llu->Unzval_br_ptr);
@@ -704,24 +702,21 @@ int file_Printfloat5(FILE *fp, char *name, int_t len, float *x)
 void sPrintLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, sLocalLU_t *Llu)
 {
-    register int c, extra, gb, j, lb, nsupc, nsupr, len, nb, ncb;
-    register int_t k, mycol, r;
+    register int c, gb, j, lb, nsupc, nsupr, len, nb, ncb;
+    register int_t k, r;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
     float *nzval;
 
     printf("\n[%d] L BLOCKS IN COLUMN-MAJOR ORDER -->\n", iam);
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nb = index[0];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    printf("[%d] block column %d (local # %d), nsupc %d, # row blocks %d\n",
 		   iam, gb, lb, nsupc, nb);
@@ -742,7 +737,7 @@ void sPrintLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 	PrintInt32("fsendx_plist[]", grid->nprow, Llu->fsendx_plist[lb]);
     }
     printf("nfrecvx %d\n", Llu->nfrecvx);
-    k = CEILING( nsupers, grid->nprow );
+    k = NLBi( nsupers, grid );
     PrintInt32("fmod", k, Llu->fmod);
 
 } /* SPRINTLBLOCKS */
@@ -753,8 +748,8 @@ void sPrintLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void sZeroLblocks(int iam, int n, gridinfo_t *grid, sLUstruct_t *LUstruct)
 {
     float zero = 0.0;
-    register int extra, gb, j, lb, nsupc, nsupr, ncb;
-    register int k, mycol, r;
+    register int gb, j, lb, nsupc, nsupr, ncb;
+    register int k, r;
     sLocalLU_t *Llu = LUstruct->Llu;
     Glu_persist_t *Glu_persist = LUstruct->Glu_persist;
     int_t *xsup = Glu_persist->xsup;
@@ -762,16 +757,13 @@ void sZeroLblocks(int iam, int n, gridinfo_t *grid, sLUstruct_t *LUstruct)
     float *nzval;
     int nsupers = Glu_persist->supno[n-1] + 1;
 
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (j = 0; j < nsupc; ++j) {
                 for (r = 0; r < nsupr; ++r) {
@@ -788,8 +780,8 @@ void sZeroLblocks(int iam, int n, gridinfo_t *grid, sLUstruct_t *LUstruct)
 void sDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, sLocalLU_t *Llu)
 {
-    register int c, extra, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
-    int k, mycol, r, n, nmax;
+    register int c, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
+    int k, r, n, nmax;
     int_t nnzL;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
@@ -802,17 +794,14 @@ void sDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 	// count nonzeros in the first pass
 	nnzL = 0;
 	n = 0;
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nb = index[0];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -846,17 +835,14 @@ void sDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		fprintf(fp, "%d %d " IFMT "\n", n,n,nnzL);
 	}
 
-     ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+     ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nb = index[0];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -884,24 +870,21 @@ void sDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void sPrintUblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, sLocalLU_t *Llu)
 {
-    register int c, extra, jb, k, lb, len, nb, nrb, nsupc;
-    register int_t myrow, r;
+    register int c, jb, k, lb, len, nb, nrb, nsupc;
+    register int_t r;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
     float *nzval;
 
     printf("\n[%d] U BLOCKS IN ROW-MAJOR ORDER -->\n", iam);
-    nrb = nsupers / grid->nprow;
-    extra = nsupers % grid->nprow;
-    myrow = MYROW( iam, grid );
-    if ( myrow < extra ) ++nrb;
+    nrb = MyNLBi( nsupers, grid );
     for (lb = 0; lb < nrb; ++lb) {
 	index = Llu->Ufstnz_br_ptr[lb];
 	if ( index ) { /* Not an empty row */
 	    nzval = Llu->Unzval_br_ptr[lb];
 	    nb = index[0];
 	    printf("[%d] block row " IFMT " (local # %d), # column blocks %d\n",
-		   iam, lb*grid->nprow+myrow, lb, nb);
+		   iam, GBi( lb, grid ), lb, nb);
 	    r  = 0;
 	    for (c = 0, k = BR_HEADER; c < nb; ++c) {
 		jb = index[k];
@@ -925,8 +908,8 @@ void sPrintUblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void sZeroUblocks(int iam, int n, gridinfo_t *grid, sLUstruct_t *LUstruct)
 {
     float zero = 0.0;
-    register int i, extra, lb, len, nrb;
-    register int myrow, r;
+    register int i, lb, len, nrb;
+    register int r;
     sLocalLU_t *Llu = LUstruct->Llu;
     Glu_persist_t *Glu_persist = LUstruct->Glu_persist;
     int_t *xsup = Glu_persist->xsup;
@@ -934,10 +917,7 @@ void sZeroUblocks(int iam, int n, gridinfo_t *grid, sLUstruct_t *LUstruct)
     float *nzval;
     int nsupers = Glu_persist->supno[n-1] + 1;
 
-    nrb = nsupers / grid->nprow;
-    extra = nsupers % grid->nprow;
-    myrow = MYROW( iam, grid );
-    if ( myrow < extra ) ++nrb;
+    nrb = MyNLBi( nsupers, grid );
     for (lb = 0; lb < nrb; ++lb) {
 	index = Llu->Ufstnz_br_ptr[lb];
 	if ( index ) { /* Not an empty row */
@@ -988,7 +968,7 @@ sGenXtrueRHS(int nrhs, SuperMatrix *A, Glu_persist_t *Glu_persist,
     myrow = MYROW( iam, grid );
     Astore = (NCformat *) A->Store;
     aval = Astore->nzval;
-    lb = CEILING( nsupers, grid->nprow ) + 1;
+    lb = NLBi( nsupers, grid ) + 1;
     if ( !(lxsup = intMalloc_dist(lb)) )
 	ABORT("Malloc fails for lxsup[].");
 
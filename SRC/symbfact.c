@@ -38,6 +38,22 @@ at the top-level directory.
 /* What type of supernodes we want */
 #define T2_SUPER
 
+/* Minimum number of columns of a subtree factored by one thread */
+#define SUBTREE_MIN 256
+
+/*
+ * An etree subtree, or a group of sibling subtrees, factored
+ * independently of the rest of the matrix (see symbfact_subtrees()).
+ * The result is stored with local indices: column (or row) first+i is
+ * i, and the ancestor anc[d] at depth d is row (last-first+1)+d.
+ */
+typedef struct {
+    int_t first, last; /* range of columns */
+    int_t info;        /* 0: factored; otherwise left to the serial loop */
+    int_t nsuper;      /* last local supernode number */
+    int_t *anc;        /* ancestors of the subtree roots, by depth */
+    int_t *xsup, *supno, *xlsub, *xusub, *xprune, *lsub, *usub;
+} symb_subtree_t;
 
 /*
  * Internal protypes
@@ -45,7 +61,7 @@ at the top-level directory.
 static void  relax_snode(int_t, int_t *, int_t, int_t *, int_t *);
 static int_t snode_dfs(SuperMatrix *, const int_t, const int_t, int_t *,
 		       int_t *,	Glu_persist_t *, Glu_freeable_t *);
-static int_t column_dfs(superlu_dist_options_t *, SuperMatrix *,
+static int_t column_dfs(const int_t, SuperMatrix *,
 			const int_t, int_t *, int_t *, int_t *,
 			int_t *, int_t *, int_t *, int_t *, int_t *,
 			Glu_persist_t *, Glu_freeable_t *);
@@ -56,6 +72,18 @@ static int_t set_usub(const int_t, const int_t, const int_t, int_t *, int_t *,
 static void  pruneL(const int_t, const int_t *, const int_t, const int_t,
 		    const int_t *, const int_t *, int_t *,
 		    Glu_persist_t *, Glu_freeable_t *);
+static int_t symbfact_cols(const int_t, SuperMatrix *, const int_t,
+			   const int_t, int_t *, int_t *, int_t *, int_t *,
+			   int_t *, int_t *, int_t *, int_t *,
+			   Glu_persist_t *, Glu_freeable_t *);
+#ifdef _OPENMP
+static int_t symbfact_subtrees(const int, const int_t, const int_t,
+			       const int_t, SuperMatrix *, int_t *, int_t *,
+			       symb_subtree_t **);
+#endif
+static int_t subtree_merge(symb_subtree_t *, int_t *, int_t *, int_t *,
+			   int_t *, Glu_persist_t *, Glu_freeable_t *);
+static void  subtree_free(symb_subtree_t *);
 
 
 /************************************************************************/
@@ -70,6 +98,9 @@ static void  pruneL(const int_t, const int_t *, const int_t, const int_t,
  *        o depth-first search (DFS)
  *        o supernodes
  *        o symmetric structure pruning
+ *        o with OpenMP, independent subtrees of the etree are factored
+ *          concurrently, then merged in column order; the result is
+ *          the same as that of the sequential algorithm
  *
  * Return value
  * ============
@@ -91,13 +122,13 @@ int_t symbfact
  )
 {
 
-    int_t m, n, min_mn, j, i, k, irep, nseg, pivrow, info;
+    int_t m, n, min_mn, j, k, jend, nsub = 0, info;
     int_t *iwork, *perm_r, *segrep, *repfnz;
     int_t *xprune, *marker, *parent, *xplore;
-    int_t relax, *desc, *relax_end;
+    int_t relax, maxsuper, *desc, *relax_end;
     int_t nnzLU, nnzLSUB;
     int_t nnzL, nnzU;
-    NRformat_loc *Astore;
+    symb_subtree_t *sub = NULL;
 
 #if ( DEBUGlevel>=1 )
     CHECK_MALLOC(pnum, "Enter symbfact()");
@@ -124,6 +155,7 @@ int_t symbfact
     xprune = xplore + m;
     relax_end = xprune + n;
     relax = sp_ienv_dist(2, options);
+    maxsuper = sp_ienv_dist(3, options);
     ifill_dist(perm_r, m, SLU_EMPTY);
     ifill_dist(repfnz, m, SLU_EMPTY);
     ifill_dist(marker, m, SLU_EMPTY);
@@ -139,48 +171,38 @@ int_t symbfact
 	ABORT("Malloc fails for desc[]");;
     relax_snode(n, etree, relax, desc, relax_end);
     SUPERLU_FREE(desc);
-    
-    for (j = 0; j < min_mn; ) {
-	if ( relax_end[j] != SLU_EMPTY ) { /* beginning of a relaxed snode */
-   	    k = relax_end[j];          /* end of the relaxed snode */
-	 
-	    /* Determine union of the row structure of supernode (j:k). */
-	    if ( (info = snode_dfs(A, j, k, xprune, marker,
-				   Glu_persist, Glu_freeable)) != 0 )
-		return info;
 
-	    for (i = j; i <= k; ++i)
-		pivotL(i, perm_r, &pivrow, Glu_persist, Glu_freeable); 
+#ifdef _OPENMP
+    /* Factor the independent subtrees of the etree concurrently. */
+    if ( m == n && omp_get_max_threads() > 1 )
+	nsub = symbfact_subtrees(pnum, maxsuper, relax,
+				 sp_ienv_dist(6, options), A, etree,
+				 relax_end, &sub);
+#endif
 
-	    j = k+1;
+    /* Factor the remaining columns in order, merging each subtree
+       when its first column is reached. */
+    for (j = 0, k = 0; j < min_mn; ) {
+	if ( k < nsub && j == sub[k].first ) {
+	    if ( sub[k].info == 0 ) {
+		if ( (info = subtree_merge(&sub[k], relax_end, perm_r, xprune,
+					   marker, Glu_persist, Glu_freeable)) )
+		    return info;
+		j = sub[k].last + 1;
+	    }
+	    subtree_free(&sub[k]);
+	    ++k;
 	} else {
-	    /* Perform a symbolic factorization on column j, and detects
-	       whether column j starts a new supernode. */
-	    if ((info = column_dfs(options, A, j, perm_r, &nseg, segrep, repfnz,
-				   xprune, marker, parent, xplore,
-				   Glu_persist, Glu_freeable)) != 0)
-		return info;
-	    
-	    /* Copy the U-segments to usub[*]. */
-	    if ((info = set_usub(min_mn, j, nseg, segrep, repfnz,
-				 Glu_persist, Glu_freeable)) != 0)
+	    jend = ( k < nsub ) ? sub[k].first : min_mn;
+	    if ( (info = symbfact_cols(maxsuper, A, j, jend, relax_end,
+				       perm_r, segrep, repfnz, xprune, marker,
+				       parent, xplore,
+				       Glu_persist, Glu_freeable)) )
 		return info;
-
-	    pivotL(j, perm_r, &pivrow, Glu_persist, Glu_freeable); 
-
-	    /* Prune columns [0:j-1] using column j. */
-	    pruneL(j, perm_r, pivrow, nseg, segrep, repfnz, xprune,
-		   Glu_persist, Glu_freeable);
-
-	    /* Reset repfnz[*] to prepare for the next column. */
-	    for (i = 0; i < nseg; i++) {
-		irep = segrep[i];
-		repfnz[irep] = SLU_EMPTY;
-	    }
-
-	    ++j;
-	} /* else */
+	    j = jend;
+	}
     } /* for j ... */
+    if ( sub ) SUPERLU_FREE(sub);
 
     countnz_dist(min_mn, xprune, &nnzL, &nnzU, Glu_persist, Glu_freeable);
     Glu_freeable->nnzLU = nnzL + nnzU - min_mn;	
@@ -216,6 +238,205 @@ int_t symbfact
 
 } /* SYMBFACT */
 
+/************************************************************************/
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *   symbfact_shared() is symbfact() for the processes of grid, which all
+ *   hold the same matrix A.  If sp_ienv_dist(13) = 1, only one process
+ *   per shared-memory node performs the symbolic factorization; the
+ *   others copy the result from an MPI shared-memory window instead of
+ *   recomputing it.  Otherwise every process calls symbfact().
+ *
+ *   On exit, each process owns its copy of the data structures, as
+ *   after symbfact().
+ *
+ * Return value
+ * ============
+ *   As symbfact().
+ * </pre>
+ */
+int_t symbfact_shared
+/************************************************************************/
+(
+ superlu_dist_options_t *options, /* input options */
+ gridinfo_t  *grid,    /* process grid (input) */
+ SuperMatrix *A,       /* original matrix A permuted by columns (input) */
+ int_t       *perm_c,  /* column permutation vector (input) */
+ int_t       *etree,   /* column elimination tree (input) */
+ Glu_persist_t *Glu_persist,  /* output */
+ Glu_freeable_t *Glu_freeable /* output */
+ )
+{
+    MPI_Comm node;
+    MPI_Win  win;
+    MPI_Aint wsize;
+    int      nrank, nsize, disp;
+    int_t    n = A->ncol, hdr[4], *buf, *src, annz, fill, i;
+    int_t    len[6], *dst[6];
+    int      k;
+
+    if ( sp_ienv_dist(13, options) == 0 )
+	return symbfact(options, grid->iam, A, perm_c, etree,
+			Glu_persist, Glu_freeable);
+
+    MPI_Comm_split_type(grid->comm, MPI_COMM_TYPE_SHARED, grid->iam,
+			MPI_INFO_NULL, &node);
+    MPI_Comm_rank(node, &nrank);
+    MPI_Comm_size(node, &nsize);
+    if ( nsize == 1 ) {
+	MPI_Comm_free(&node);
+	return symbfact(options, grid->iam, A, perm_c, etree,
+			Glu_persist, Glu_freeable);
+    }
+
+    if ( nrank == 0 ) {
+	hdr[0] = symbfact(options, grid->iam, A, perm_c, etree,
+			  Glu_persist, Glu_freeable);
+	if ( hdr[0] <= 0 ) {
+	    hdr[1] = Glu_freeable->xlsub[n];
+	    hdr[2] = Glu_freeable->xusub[n];
+	    hdr[3] = Glu_freeable->nnzLU;
+	}
+    }
+    MPI_Bcast(hdr, 4, mpi_int_t, 0, node);
+    if ( hdr[0] > 0 ) {
+	MPI_Comm_free(&node);
+	return hdr[0];
+    }
+
+    /* xsup, supno, xlsub, xusub, lsub, usub */
+    len[0] = len[1] = len[2] = len[3] = n + 1;
+    len[4] = hdr[1];
+    len[5] = hdr[2];
+    wsize = ( nrank == 0 ) ? (4 * (n + 1) + hdr[1] + hdr[2]) * sizeof(int_t)
+	                   : 0;
+    MPI_Win_allocate_shared(wsize, sizeof(int_t), MPI_INFO_NULL, node,
+			    &buf, &win);
+    if ( nrank == 0 ) {
+	dst[0] = Glu_persist->xsup;
+	dst[1] = Glu_persist->supno;
+	dst[2] = Glu_freeable->xlsub;
+	dst[3] = Glu_freeable->xusub;
+	dst[4] = Glu_freeable->lsub;
+	dst[5] = Glu_freeable->usub;
+	for (src = buf, k = 0; k < 6; src += len[k], ++k)
+	    for (i = 0; i < len[k]; ++i) src[i] = dst[k][i];
+    } else {
+	MPI_Win_shared_query(win, 0, &wsize, &disp, &buf);
+    }
+    MPI_Win_fence(0, win);
+
+    if ( nrank != 0 ) {
+	/* Allocate as symbfact() does, with room for the result. */
+	fill = sp_ienv_dist(6, options);
+	annz = SUPERLU_MAX(hdr[1] / fill, 2 * hdr[2] / fill) + 1;
+	if ( (i = symbfact_SubInit(options, DOFACT, NULL, 0, A->nrow, n, annz,
+				   Glu_persist, Glu_freeable)) != 0 )
+	    hdr[0] = i;
+	else {
+	    dst[0] = Glu_persist->xsup;
+	    dst[1] = Glu_persist->supno;
+	    dst[2] = Glu_freeable->xlsub;
+	    dst[3] = Glu_freeable->xusub;
+	    dst[4] = Glu_freeable->lsub;
+	    dst[5] = Glu_freeable->usub;
+	    for (src = buf, k = 0; k < 6; src += len[k], ++k)
+		for (i = 0; i < len[k]; ++i) dst[k][i] = src[i];
+	    Glu_freeable->nnzLU = hdr[3];
+	}
+    }
+
+    MPI_Win_fence(0, win);
+    MPI_Win_free(&win);
+    MPI_Comm_free(&node);
+    return hdr[0];
+} /* SYMBFACT_SHARED */
+
+/************************************************************************/
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *   symbfact_cols() performs the symbolic factorization of columns
+ *   jfirst to jlast-1, assuming that columns 0 to jfirst-1 are done.
+ *   No relaxed supernode may straddle jlast.
+ *
+ * Return value
+ * ============
+ *   0   success;
+ *  >0   number of bytes allocated when run out of memory.
+ * </pre>
+ */
+static int_t symbfact_cols
+/************************************************************************/
+(
+ const int_t maxsuper,  /* max. allowed supernode size (input) */
+ SuperMatrix *A,        /* original matrix A permuted by columns (input) */
+ const int_t jfirst,    /* first column (input) */
+ const int_t jlast,     /* one past the last column (input) */
+ int_t       *relax_end, /* last column of each relaxed snode (input) */
+ int_t       *perm_r,   /* row permutation vector (modified) */
+ int_t       *segrep,   /* working arrays as in column_dfs() */
+ int_t       *repfnz,
+ int_t       *xprune,
+ int_t       *marker,
+ int_t       *parent,
+ int_t       *xplore,
+ Glu_persist_t *Glu_persist,   /* global LU data structures (modified) */
+ Glu_freeable_t *Glu_freeable
+ )
+{
+    int_t j, i, k, irep, nseg, pivrow, info;
+
+    for (j = jfirst; j < jlast; ) {
+	if ( relax_end[j] != SLU_EMPTY ) { /* beginning of a relaxed snode */
+   	    k = relax_end[j];          /* end of the relaxed snode */
+	 
+	    /* Determine union of the row structure of supernode (j:k). */
+	    if ( (info = snode_dfs(A, j, k, xprune, marker,
+				   Glu_persist, Glu_freeable)) != 0 )
+		return info;
+
+	    for (i = j; i <= k; ++i)
+		pivotL(i, perm_r, &pivrow, Glu_persist, Glu_freeable); 
+
+	    j = k+1;
+	} else {
+	    /* Perform a symbolic factorization on column j, and detects
+	       whether column j starts a new supernode. */
+	    if ((info = column_dfs(maxsuper, A, j, perm_r, &nseg, segrep, repfnz,
+				   xprune, marker, parent, xplore,
+				   Glu_persist, Glu_freeable)) != 0)
+		return info;
+	    
+	    /* Copy the U-segments to usub[*]. */
+	    if ((info = set_usub(A->ncol, j, nseg, segrep, repfnz,
+				 Glu_persist, Glu_freeable)) != 0)
+		return info;
+
+	    pivotL(j, perm_r, &pivrow, Glu_persist, Glu_freeable); 
+
+	    /* Prune columns [0:j-1] using column j. */
+	    pruneL(j, perm_r, pivrow, nseg, segrep, repfnz, xprune,
+		   Glu_persist, Glu_freeable);
+
+	    /* Reset repfnz[*] to prepare for the next column. */
+	    for (i = 0; i < nseg; i++) {
+		irep = segrep[i];
+		repfnz[irep] = SLU_EMPTY;
+	    }
+
+	    ++j;
+	} /* else */
+    } /* for j ... */
+
+    return 0;
+} /* SYMBFACT_COLS */
+
 /************************************************************************/
 /*! \brief
  *
@@ -460,7 +681,7 @@ static int_t snode_dfs
 static int_t column_dfs
 /************************************************************************/
 (
- superlu_dist_options_t *options,
+ const int_t maxsuper,  /* max. allowed supernode size (input) */
  SuperMatrix *A,        /* original matrix A permuted by columns (input) */
  const int_t jcol,      /* current column number (input) */
  int_t       *perm_r,   /* row permutation vector (input) */
@@ -488,7 +709,6 @@ static int_t column_dfs
     int_t     ito, ifrom, istop;	/* used to compress row subscripts */
     int_t     *xsup, *supno, *lsub, *xlsub;
     int_t     nzlmax;
-    static int_t first = 1, maxsuper;
     int_t     mem_error;
     
     /* Initializations */
@@ -505,10 +725,6 @@ static int_t column_dfs
     jcolm1   = jcol - 1;
     jsuper   = nsuper = supno[jcol];
     nextl    = xlsub[jcol];
-    if ( first ) {
-	maxsuper = sp_ienv_dist(3, options);
-	first = 0;
-    }
     
     *nseg = 0;
 
@@ -907,3 +1123,337 @@ static void pruneL
     } /* for each U-segment ... */
 } /* PRUNEL */
 
+
+#ifdef _OPENMP
+/************************************************************************/
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *   subtree_factor() performs the symbolic factorization of the columns
+ *   of one subtree, on a copy of A(:,first:last) with local indices.
+ *
+ *   The structure of a column of L (U) only contains ancestors
+ *   (descendants) of the column in the etree.  Hence the columns of a
+ *   subtree only reach rows of the subtree and the ancestors of its
+ *   root, which are numbered by their depth in the etree; any other
+ *   row leaves the subtree to the serial loop (info = -1).
+ * </pre>
+ */
+static void subtree_factor
+/************************************************************************/
+(
+ const int_t maxsuper,  /* max. allowed supernode size (input) */
+ const int_t fill,      /* estimated fill ratio (input) */
+ SuperMatrix *A,        /* original matrix A permuted by columns (input) */
+ int_t       *relax_end, /* last column of each relaxed snode (input) */
+ int_t       *depth,    /* depth of each node in the etree (input) */
+ int_t       ndepth,    /* number of ancestors of the subtree (input) */
+ symb_subtree_t *t      /* subtree (modified) */
+ )
+{
+    NCPformat *Astore = A->Store, Aloc_store;
+    SuperMatrix Aloc;
+    Glu_persist_t Glu_persist;
+    Glu_freeable_t Glu_freeable;
+    int_t f = t->first, nc = t->last - t->first + 1, mloc = nc + ndepth;
+    int_t *iwork, *perm_r, *segrep, *repfnz, *marker, *parent, *xplore;
+    int_t *relax_loc, *colbeg, *colend, *rowind, annz = 0, i, j, r;
+
+    for (j = f; j <= t->last; ++j) annz += Astore->colend[j] - Astore->colbeg[j];
+    if ( !(colbeg = intMalloc_dist(2 * nc + SUPERLU_MAX(annz, 1))) )
+	ABORT("Malloc fails for colbeg[]");
+    colend = colbeg + nc;
+    rowind = colend + nc;
+    for (annz = 0, j = 0; j < nc; ++j) {
+	colbeg[j] = annz;
+	for (i = Astore->colbeg[f+j]; i < Astore->colend[f+j]; ++i) {
+	    r = Astore->rowind[i];
+	    if ( r >= f && r <= t->last ) {
+		r -= f;
+	    } else if ( r > t->last && depth[r] < ndepth
+			&& t->anc[depth[r]] == r ) {
+		r = nc + depth[r];
+	    } else { /* the etree does not separate this subtree */
+		t->info = -1;
+		SUPERLU_FREE(colbeg);
+		return;
+	    }
+	    rowind[annz++] = r;
+	}
+	colend[j] = annz;
+    }
+    Aloc_store.nnz = annz;
+    Aloc_store.nzval = NULL;
+    Aloc_store.rowind = rowind;
+    Aloc_store.colbeg = colbeg;
+    Aloc_store.colend = colend;
+    Aloc.nrow = mloc;
+    Aloc.ncol = nc;
+    Aloc.Store = &Aloc_store;
+
+    /* Storage of the subtree; it is grown privately by
+       symbfact_SubXpand() in a parallel region. */
+    Glu_freeable.MemModel = SYSTEM;
+    Glu_freeable.nzlmax = SUPERLU_MAX(fill * annz, nc + 1);
+    Glu_freeable.nzumax = SUPERLU_MAX(fill / 2.0 * annz, 1);
+    t->xsup = intMalloc_dist(nc + 1);
+    t->supno = intMalloc_dist(nc + 1);
+    t->xlsub = intMalloc_dist(nc + 1);
+    t->xusub = intMalloc_dist(nc + 1);
+    t->xprune = intMalloc_dist(nc);
+    Glu_freeable.lsub = intMalloc_dist(Glu_freeable.nzlmax);
+    Glu_freeable.usub = intMalloc_dist(Glu_freeable.nzumax);
+    iwork = intMalloc_dist(6 * mloc + nc);
+    if ( !t->xsup || !t->supno || !t->xlsub || !t->xusub || !t->xprune
+	 || !Glu_freeable.lsub || !Glu_freeable.usub || !iwork )
+	ABORT("Malloc fails for the subtree storage");
+    perm_r = iwork;
+    segrep = perm_r + mloc;
+    repfnz = segrep + mloc;
+    marker = repfnz + mloc;
+    parent = marker + mloc;
+    xplore = parent + mloc;
+    relax_loc = xplore + mloc;
+    ifill_dist(perm_r, mloc, SLU_EMPTY);
+    ifill_dist(repfnz, mloc, SLU_EMPTY);
+    ifill_dist(marker, mloc, SLU_EMPTY);
+    for (j = 0; j < nc; ++j)
+	relax_loc[j] = ( relax_end[f+j] == SLU_EMPTY ) ?
+	    SLU_EMPTY : relax_end[f+j] - f; /* <= last, see symbfact_subtrees() */
+
+    Glu_persist.xsup = t->xsup;
+    Glu_persist.supno = t->supno;
+    Glu_freeable.xlsub = t->xlsub;
+    Glu_freeable.xusub = t->xusub;
+    t->supno[0] = -1;
+    t->xsup[0] = 0;
+    t->xlsub[0] = 0;
+    t->xusub[0] = 0;
+
+    t->info = symbfact_cols(maxsuper, &Aloc, 0, nc, relax_loc, perm_r,
+			    segrep, repfnz, t->xprune, marker, parent, xplore,
+			    &Glu_persist, &Glu_freeable);
+    t->nsuper = t->supno[nc];
+    t->lsub = Glu_freeable.lsub;
+    t->usub = Glu_freeable.usub;
+
+    SUPERLU_FREE(iwork);
+    SUPERLU_FREE(colbeg);
+} /* SUBTREE_FACTOR */
+
+/************************************************************************/
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *   symbfact_subtrees() chooses disjoint subtrees of the etree of about
+ *   n/(4*nthreads) columns and factors them concurrently.  Sibling
+ *   subtrees that are adjacent in the postorder are grouped, and groups
+ *   much smaller than that are left to the serial loop.  A chosen
+ *   subtree has at least relax columns above it, so it does not cut a
+ *   relaxed supernode.
+ *
+ * Return value
+ * ============
+ *   Number of subtrees in *sub, in increasing column order; 0 if the
+ *   etree has too little parallelism.
+ * </pre>
+ */
+static int_t symbfact_subtrees
+/************************************************************************/
+(
+ const int   pnum,      /* process number (input) */
+ const int_t maxsuper,  /* max. allowed supernode size (input) */
+ const int_t relax,     /* max. size of a relaxed supernode (input) */
+ const int_t fill,      /* estimated fill ratio (input) */
+ SuperMatrix *A,        /* original matrix A permuted by columns (input) */
+ int_t       *etree,    /* postordered etree (input) */
+ int_t       *relax_end, /* last column of each relaxed snode (input) */
+ symb_subtree_t **sub   /* chosen subtrees (output) */
+ )
+{
+    int_t n = A->ncol, target, smin, nsub = 0, j, k, p, first, *size, *depth;
+    symb_subtree_t *t;
+
+    target = SUPERLU_MAX(n / (4 * omp_get_max_threads()),
+			 SUPERLU_MAX(relax, SUBTREE_MIN));
+    smin = target / 8;
+    if ( n < 2 * target ) return 0;
+
+    if ( !(size = intMalloc_dist(2 * n)) ) ABORT("Malloc fails for size[]");
+    depth = size + n;
+    for (j = 0; j < n; ++j) size[j] = 1;
+    for (j = 0; j < n; ++j)
+	if ( etree[j] != n ) size[etree[j]] += size[j];
+    for (j = n - 1; j >= 0; --j)
+	depth[j] = ( etree[j] == n ) ? 0 : depth[etree[j]] + 1;
+
+    if ( !(*sub = (symb_subtree_t *)
+	   SUPERLU_MALLOC((n / smin + 2) * sizeof(symb_subtree_t))) )
+	ABORT("Malloc fails for sub[]");
+    t = *sub;
+
+    /* The maximal subtrees with at most target columns, in postorder;
+       groups of fewer than smin columns are left to the serial loop. */
+    for (j = 0; j < n; ++j) {
+	p = etree[j];
+	if ( size[j] > target || (p != n && size[p] <= target) ) continue;
+	first = j - size[j] + 1;
+	if ( nsub > 0 && t[nsub-1].last == first - 1
+	     && etree[t[nsub-1].last] == p
+	     && j - t[nsub-1].first + 1 <= target ) {
+	    t[nsub-1].last = j;     /* group with the previous sibling */
+	} else {
+	    if ( nsub > 0 && t[nsub-1].last - t[nsub-1].first + 1 < smin )
+		--nsub;
+	    t[nsub].first = first;
+	    t[nsub].last = j;
+	    ++nsub;
+	}
+    }
+    if ( nsub > 0 && t[nsub-1].last - t[nsub-1].first + 1 < smin ) --nsub;
+
+    if ( nsub < 2 ) {
+	SUPERLU_FREE(size);
+	SUPERLU_FREE(*sub);
+	*sub = NULL;
+	return 0;
+    }
+
+    for (k = 0; k < nsub; ++k) {
+	t[k].info = 0;
+	t[k].anc = t[k].xsup = t[k].supno = t[k].xlsub = t[k].xusub = NULL;
+	t[k].xprune = t[k].lsub = t[k].usub = NULL;
+    }
+
+#pragma omp parallel for private(j, p) schedule(dynamic, 1)
+    for (k = 0; k < nsub; ++k) {
+	int_t ndepth;
+	p = etree[t[k].last];
+	ndepth = ( p == n ) ? 0 : depth[p] + 1;
+	if ( !(t[k].anc = intMalloc_dist(SUPERLU_MAX(ndepth, 1))) )
+	    ABORT("Malloc fails for anc[]");
+	for (j = p; j != n; j = etree[j]) t[k].anc[depth[j]] = j;
+	subtree_factor(maxsuper, fill, A, relax_end, depth, ndepth, &t[k]);
+    }
+
+#if ( PRNTlevel>=1 )
+    for (j = 0, k = 0; k < nsub; ++k)
+	if ( t[k].info == 0 ) j += t[k].last - t[k].first + 1;
+    if ( !pnum )
+	printf(".. symbfact(): %lld subtrees, %lld of %lld columns in parallel\n",
+	       (long long) nsub, (long long) j, (long long) n);
+#endif
+
+    SUPERLU_FREE(size);
+    return nsub;
+} /* SYMBFACT_SUBTREES */
+#endif /* _OPENMP */
+
+/************************************************************************/
+/*! \brief
+ *
+ * <pre>
+ * Purpose
+ * =======
+ *   subtree_merge() appends the factored subtree t to the global data
+ *   structures, when all the columns before t->first are done.  This
+ *   leaves them in the same state as the sequential column-by-column
+ *   algorithm, which continues with column t->last+1.
+ *
+ * Return value
+ * ============
+ *    0   success;
+ *   >0   number of bytes allocated when run out of memory.
+ * </pre>
+ */
+static int_t subtree_merge
+/************************************************************************/
+(
+ symb_subtree_t *t,     /* factored subtree (input) */
+ int_t       *relax_end, /* last column of each relaxed snode (input) */
+ int_t       *perm_r,   /* row permutation vector (modified) */
+ int_t       *xprune,   /* pruned location in each adjacency list (modified) */
+ int_t       *marker,   /* working array of size m (modified) */
+ Glu_persist_t *Glu_persist,   /* global LU data structures (modified) */
+ Glu_freeable_t *Glu_freeable
+ )
+{
+    int_t f = t->first, l = t->last, nc = l - f + 1;
+    int_t *xsup = Glu_persist->xsup, *supno = Glu_persist->supno;
+    int_t *xlsub = Glu_freeable->xlsub, *xusub = Glu_freeable->xusub;
+    int_t *lsub, *usub, fsupc, ito, ifrom, lbase, ubase, llen, ulen;
+    int_t nsuper, i, r, mem_error;
+
+    /* Column f starts a new supernode; as in column_dfs(), compress
+       the previous one unless f starts a relaxed supernode. */
+    nsuper = supno[f];
+    if ( f > 0 && relax_end[f] == SLU_EMPTY ) {
+	fsupc = xsup[nsuper];
+	if ( fsupc < f - 2 ) {
+	    lsub = Glu_freeable->lsub;
+	    ito = xlsub[fsupc+1];
+	    ifrom = xlsub[f-1];
+	    xlsub[f-1] = ito;
+	    for ( ; ifrom < xlsub[f]; ) lsub[ito++] = lsub[ifrom++];
+	    xprune[f-1] = ito;
+	    xlsub[f] = ito;
+	}
+    }
+    ++nsuper;
+
+    lbase = xlsub[f];
+    ubase = xusub[f];
+    llen = t->xlsub[nc];
+    ulen = t->xusub[nc];
+    while ( lbase + llen >= Glu_freeable->nzlmax )
+	if ( (mem_error = symbfact_SubXpand(nc, f, lbase, (MemType) LSUB,
+					    &Glu_freeable->nzlmax,
+					    Glu_freeable)) )
+	    return (mem_error);
+    while ( ubase + ulen > Glu_freeable->nzumax )
+	if ( (mem_error = symbfact_SubXpand(nc, f, ubase, (MemType) USUB,
+					    &Glu_freeable->nzumax,
+					    Glu_freeable)) )
+	    return (mem_error);
+    lsub = Glu_freeable->lsub;
+    usub = Glu_freeable->usub;
+
+    /* Translate the local indices. */
+    for (i = 0; i < llen; ++i) {
+	r = t->lsub[i];
+	lsub[lbase + i] = ( r < nc ) ? f + r : t->anc[r - nc];
+    }
+    for (i = 0; i < ulen; ++i) usub[ubase + i] = f + t->usub[i];
+    for (i = 0; i <= nc; ++i) {
+	xlsub[f + i] = lbase + t->xlsub[i];
+	xusub[f + i] = ubase + t->xusub[i];
+	supno[f + i] = nsuper + t->supno[i];
+    }
+    for (i = 0; i <= t->nsuper + 1; ++i) xsup[nsuper + i] = f + t->xsup[i];
+    for (i = 0; i < nc; ++i) {
+	xprune[f + i] = lbase + t->xprune[i];
+	perm_r[f + i] = f + i;
+    }
+
+    /* Rows of L(:,l), for the supernode test of column l+1. */
+    for (i = xlsub[l]; i < xlsub[l+1]; ++i) marker[lsub[i]] = l;
+
+    return 0;
+} /* SUBTREE_MERGE */
+
+/*! \brief Free the storage of a subtree. */
+static void subtree_free(symb_subtree_t *t)
+{
+    if ( t->anc ) SUPERLU_FREE(t->anc);
+    if ( t->xsup ) SUPERLU_FREE(t->xsup);
+    if ( t->supno ) SUPERLU_FREE(t->supno);
+    if ( t->xlsub ) SUPERLU_FREE(t->xlsub);
+    if ( t->xusub ) SUPERLU_FREE(t->xusub);
+    if ( t->xprune ) SUPERLU_FREE(t->xprune);
+    if ( t->lsub ) SUPERLU_FREE(t->lsub);
+    if ( t->usub ) SUPERLU_FREE(t->usub);
+}
@@ -230,6 +230,165 @@ int_t* getFactIperm(int_t* perm, int_t nsupers)
     return iperm;
 }
 
+/* Largest number of rows of the L panel, and of full columns of the U
+   panel, of each supernode over the processes of the 2D grid. */
+static void getPanelSizes(int_t nsupers, int_t* xsup,
+			  int_t** Lrowind_bc_ptr, int_t** Ufstnz_br_ptr,
+			  gridinfo_t* grid, int_t* mylsize, int_t* myusize)
+{
+    int_t * perm_u = INT_T_ALLOC(nsupers);
+
+    for (int i = 0; i < nsupers; ++i)
+    {
+        perm_u[i] = i;
+        mylsize[i] = 0;
+        myusize[i] = 0;
+    }
+
+    for (int_t k = 0; k < nsupers ; ++k)
+    {
+        int_t iam = grid->iam;
+        int_t myrow = MYROW (iam, grid);
+        int_t mycol = MYCOL (iam, grid);
+        // int_t pkk = PNUM (PROW (k, grid), PCOL (k, grid), grid);
+        int_t krow = PROW (k, grid);
+        int_t kcol = PCOL (k, grid);
+	int_t ldu;
+
+        if (myrow == krow)
+        {
+            /* code */
+            myusize[k] = num_full_cols_U(k,  Ufstnz_br_ptr, xsup, grid,
+					 perm_u, &ldu);
+        }
+
+        if (mycol == kcol)
+        {
+            /* code */
+            int_t lk = LBj( k, grid ); /* Local block number */
+            int_t  *lsub;
+            // double* lnzval;
+            lsub = Lrowind_bc_ptr[lk];
+            if (lsub)
+            {
+                /* code */
+                mylsize[k] = lsub[1];
+            }
+        }
+    }
+
+    // int_t maxlsize = 0;
+    MPI_Allreduce( MPI_IN_PLACE, mylsize, nsupers, mpi_int_t, MPI_MAX, grid->comm );
+    // int_t maxusize = 0;
+    MPI_Allreduce(  MPI_IN_PLACE, myusize, nsupers, mpi_int_t, MPI_MAX, grid->comm );
+
+    SUPERLU_FREE(perm_u);
+} /* getPanelSizes */
+
+/* Weight of each supernode for the critical path: its Schur complement
+   update, as scuWeight, plus its panel factorization. */
+static double* getCPweight(int_t nsupers, int_t* xsup,
+			   int_t** Lrowind_bc_ptr, int_t** Ufstnz_br_ptr,
+			   gridinfo_t* grid)
+{
+    int_t * mylsize = INT_T_ALLOC(nsupers);
+    int_t * myusize = INT_T_ALLOC(nsupers);
+    double* w = doubleMalloc_dist(nsupers);
+
+    getPanelSizes(nsupers, xsup, Lrowind_bc_ptr, Ufstnz_br_ptr, grid,
+		  mylsize, myusize);
+    for (int_t k = 0; k < nsupers; ++k)
+    {
+        double ksupc = SuperSize(k);
+        w[k] = ksupc * mylsize[k] * myusize[k]
+            + ksupc * ksupc * (mylsize[k] + myusize[k]);
+    }
+
+    SUPERLU_FREE(mylsize);
+    SUPERLU_FREE(myusize);
+    return w;
+} /* getCPweight */
+
+/* Weight of the heaviest path from each supernode to the root, when
+   supernode j comes before its nsucc[j] successors succ[j][]. */
+static double* getBottomLevels(int_t nsupers, int_t* nsucc, int_t** succ,
+			       double* w)
+{
+    double* bl = doubleMalloc_dist(nsupers);
+
+    for (int_t j = nsupers - 1; j >= 0; --j)
+    {
+        double m = 0.0;
+        for (int_t i = 0; i < nsucc[j]; ++i)
+            if (succ[j][i] > j) m = SUPERLU_MAX(m, bl[succ[j][i]]);
+        bl[j] = w[j] + m;
+    }
+    return bl;
+}
+
+/* heap of the ready supernodes, heaviest bottom level on top */
+static int cpBefore(double* bl, int_t a, int_t b)
+{
+    return bl[a] > bl[b] || (bl[a] == bl[b] && a < b);
+}
+
+static void cpHeapPush(int_t* heap, int_t* n, int_t j, double* bl)
+{
+    int_t i = (*n)++;
+    while (i > 0 && cpBefore(bl, j, heap[(i - 1) / 2]))
+    {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = j;
+}
+
+static int_t cpHeapPop(int_t* heap, int_t* n, double* bl)
+{
+    int_t top = heap[0], j = heap[--(*n)], i = 0;
+    while (2 * i + 1 < *n)
+    {
+        int_t c = 2 * i + 1;
+        if (c + 1 < *n && cpBefore(bl, heap[c + 1], heap[c])) ++c;
+        if (!cpBefore(bl, heap[c], j)) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = j;
+    return top;
+}
+
+/*
+ * Critical-path schedule (SUPERLU_CP_SCHED): of the supernodes whose
+ * predecessors are done, take the one with the heaviest path to the root
+ * first, instead of the first one that became ready.
+ */
+static void cpTopoOrder(int_t nsupers, int_t* nsucc, int_t** succ,
+			double* w, int_t* perm_c_supno)
+{
+    double* bl = getBottomLevels(nsupers, nsucc, succ, w);
+    int_t* npred = intCalloc_dist(nsupers);
+    int_t* heap = intMalloc_dist(nsupers);
+    int_t nheap = 0, i = 0;
+
+    for (int_t j = 0; j < nsupers; ++j)
+        for (int_t k = 0; k < nsucc[j]; ++k) npred[succ[j][k]]++;
+    for (int_t j = 0; j < nsupers; ++j)
+        if (npred[j] == 0) cpHeapPush(heap, &nheap, j, bl);
+    while (nheap > 0)
+    {
+        int_t j = cpHeapPop(heap, &nheap, bl);
+        perm_c_supno[i++] = j;
+        for (int_t k = 0; k < nsucc[j]; ++k)
+            if (--npred[succ[j][k]] == 0)
+                cpHeapPush(heap, &nheap, succ[j][k], bl);
+    }
+
+    SUPERLU_FREE(bl);
+    SUPERLU_FREE(npred);
+    SUPERLU_FREE(heap);
+} /* cpTopoOrder */
+
 int_t* getPerm_c_supno(int_t nsupers, superlu_dist_options_t *options,
 		       int_t *etree, Glu_persist_t *Glu_persist,
 		       int_t** Lrowind_bc_ptr, int_t** Ufstnz_br_ptr,
@@ -265,6 +424,8 @@ int_t* getPerm_c_supno(int_t nsupers, superlu_dist_options_t *options,
     nblocks = 0;
     ncb = nsupers / Pc;
     nrb = nsupers / Pr;
+    double *cpw = getenv("SUPERLU_CP_SCHED") ?
+	getCPweight(nsupers, xsup, Lrowind_bc_ptr, Ufstnz_br_ptr, grid) : NULL;
     /* ================================================== *
      * static scheduling of j-th step of LU-factorization *
      * ================================================== */
@@ -441,6 +602,19 @@ int_t* getPerm_c_supno(int_t nsupers, superlu_dist_options_t *options,
             /*printf( "\n" );*/
         }
         SUPERLU_FREE(num_child);
+        if ( cpw )
+        {
+            int_t *nsucc = intMalloc_dist(nsupers);
+            int_t **succ = SUPERLU_MALLOC(nsupers * sizeof(int_t*));
+            for ( i = 0; i < nsupers; i++ )
+            {
+                nsucc[i] = etree_supno[i] != nsupers;
+                succ[i] = &etree_supno[i];
+            }
+            cpTopoOrder(nsupers, nsucc, succ, cpw, perm_c_supno);
+            SUPERLU_FREE(nsucc);
+            SUPERLU_FREE(succ);
+        }
         SUPERLU_FREE(etree_supno);
 
     }
@@ -1149,6 +1323,7 @@ int_t* getPerm_c_supno(int_t nsupers, superlu_dist_options_t *options,
             /*printf( "\n" );*/
         }
         SUPERLU_FREE(num_child);
+        if ( cpw ) cpTopoOrder(nsupers, nnodes_l, edag_supno, cpw, perm_c_supno);
 
         for ( lb = 0; lb < nsupers; lb++ ) if ( nnodes_l[lb] > 0 ) SUPERLU_FREE(edag_supno[lb] );
         SUPERLU_FREE(edag_supno);
@@ -1163,6 +1338,7 @@ int_t* getPerm_c_supno(int_t nsupers, superlu_dist_options_t *options,
     /* ======================== *
      * end of static scheduling *
      * ======================== */
+    if ( cpw ) SUPERLU_FREE(cpw);
 
     return perm_c_supno;
 } /* getPerm_c_supno */
@@ -1207,61 +1383,11 @@ void getSCUweight(int_t nsupers, treeList_t* treeList, int_t* xsup,
 		  )
 {
     gridinfo_t* grid = &(grid3d->grid2d);
-    //int_t** Lrowind_bc_ptr = LUstruct->Llu->Lrowind_bc_ptr;
-    //int_t** Ufstnz_br_ptr = LUstruct->Llu->Ufstnz_br_ptr;
-    //int_t* xsup = LUstruct->Glu_persist->xsup;
-
-    int_t * perm_u = INT_T_ALLOC(nsupers);
     int_t * mylsize = INT_T_ALLOC(nsupers);
     int_t * myusize = INT_T_ALLOC(nsupers);
-    // int_t * maxlsize = INT_T_ALLOC(nsupers);
-    // int_t * maxusize = INT_T_ALLOC(nsupers);
-    int ldu;
-
-    for (int i = 0; i < nsupers; ++i)
-    {
-        perm_u[i] = i;
-        mylsize[i] = 0;
-        myusize[i] = 0;
-    }
-
-    for (int_t k = 0; k < nsupers ; ++k)
-    {
-        treeList[k].scuWeight = 0.0;
-        int_t iam = grid->iam;
-        int_t myrow = MYROW (iam, grid);
-        int_t mycol = MYCOL (iam, grid);
-        // int_t pkk = PNUM (PROW (k, grid), PCOL (k, grid), grid);
-        int_t krow = PROW (k, grid);
-        int_t kcol = PCOL (k, grid);
-	int_t ldu;
-
-        if (myrow == krow)
-        {
-            /* code */
-            myusize[k] = num_full_cols_U(k,  Ufstnz_br_ptr, xsup, grid,
-					 perm_u, &ldu);
-        }
-
-        if (mycol == kcol)
-        {
-            /* code */
-            int_t lk = LBj( k, grid ); /* Local block number */
-            int_t  *lsub;
-            // double* lnzval;
-            lsub = Lrowind_bc_ptr[lk];
-            if (lsub)
-            {
-                /* code */
-                mylsize[k] = lsub[1];
-            }
-        }
-    }
 
-    // int_t maxlsize = 0;
-    MPI_Allreduce( MPI_IN_PLACE, mylsize, nsupers, mpi_int_t, MPI_MAX, grid->comm );
-    // int_t maxusize = 0;
-    MPI_Allreduce(  MPI_IN_PLACE, myusize, nsupers, mpi_int_t, MPI_MAX, grid->comm );
+    getPanelSizes(nsupers, xsup, Lrowind_bc_ptr, Ufstnz_br_ptr, grid,
+		  mylsize, myusize);
 
     for (int_t k = 0; k < nsupers ; ++k)
     {
@@ -1269,11 +1395,62 @@ void getSCUweight(int_t nsupers, treeList_t* treeList, int_t* xsup,
         treeList[k].scuWeight = 0.0;
         int_t ksupc = SuperSize(k);
         treeList[k].scuWeight = 1.0 * ksupc * mylsize[k] * myusize[k];
+        treeList[k].commWeight = 1.0 * ksupc * (mylsize[k] + myusize[k]);
     }
 
     SUPERLU_FREE(mylsize);
     SUPERLU_FREE(myusize);
-    SUPERLU_FREE(perm_u);
 
 } /* getSCUweight */
 
+/*
+ * With SUPERLU_CP_SCHED, report the critical path of the 3D factorization
+ * from the supernode times nodeCost[]: the path the model predicts (the
+ * weights of getCPweight() scaled to the measured total), the time it
+ * actually took, and the longest measured path.  Called by all processes.
+ */
+void printCriticalPath(int_t nsupers, int_t* setree, double* nodeCost,
+		       int_t* xsup, int_t** Lrowind_bc_ptr,
+		       int_t** Ufstnz_br_ptr, double tFact,
+		       gridinfo3d_t* grid3d)
+{
+    double* w = getCPweight(nsupers, xsup, Lrowind_bc_ptr, Ufstnz_br_ptr,
+			    &(grid3d->grid2d));
+    int_t* nsucc = intMalloc_dist(nsupers);
+    int_t** succ = SUPERLU_MALLOC(nsupers * sizeof(int_t*));
+
+    for (int_t j = 0; j < nsupers; ++j)
+    {
+        nsucc[j] = setree[j] < nsupers;
+        succ[j] = &setree[j];
+    }
+    double* blw = getBottomLevels(nsupers, nsucc, succ, w);
+    double* blc = getBottomLevels(nsupers, nsucc, succ, nodeCost);
+
+    double wsum = 0.0, csum = 0.0;
+    int_t jw = 0, jc = 0;
+    for (int_t j = 0; j < nsupers; ++j)
+    {
+        wsum += w[j];
+        csum += nodeCost[j];
+        if (blw[j] > blw[jw]) jw = j;
+        if (blc[j] > blc[jc]) jc = j;
+    }
+
+    /* time taken along the predicted path */
+    double tpath = 0.0;
+    for (int_t j = jw; j < nsupers; j = setree[j]) tpath += nodeCost[j];
+
+    if (grid3d->iam == 0)
+        printf(".. Critical path: predicted %8.4f s, took %8.4f s; "
+               "longest measured %8.4f s; factorization %8.4f s\n",
+               wsum > 0.0 ? blw[jw] * csum / wsum : 0.0, tpath,
+               blc[jc], tFact);
+
+    SUPERLU_FREE(w);
+    SUPERLU_FREE(nsucc);
+    SUPERLU_FREE(succ);
+    SUPERLU_FREE(blw);
+    SUPERLU_FREE(blc);
+} /* printCriticalPath */
+
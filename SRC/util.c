@@ -232,6 +232,7 @@ void set_default_options_dist(superlu_dist_options_t *options)
     options->superlu_n_gemm = 5000;
     options->superlu_max_buffer_size = 256000000;
     options->superlu_num_gpu_streams = 8;
+    options->superlu_autotune = 0;
     options->SymPattern = NO;
     options->Algo3d = NO;
 #ifdef SLU_HAVE_LAPACK
@@ -272,6 +273,7 @@ void print_options_dist(superlu_dist_options_t *options)
     printf("**    GPU buffer size           : %10d\n", sp_ienv_dist(8, options));
     printf("**    GPU streams               : %4d\n", sp_ienv_dist(9, options));
     printf("**    estimated fill ratio      : %4d\n", sp_ienv_dist(6, options));
+    printf("**    autotune mode             : %4d\n", sp_ienv_dist(11, options));
     printf("**************************************************\n");
 }
 
@@ -532,6 +534,24 @@ void get_diag_procs(int_t n, Glu_persist_t *Glu_persist, gridinfo_t *grid,
     nsupers = Glu_persist->supno[n - 1] + 1;
     xsup = Glu_persist->xsup;
 
+    if ( grid->smap ) { /* the owners of the diagonal blocks, in order */
+        int_t *procs = intCalloc_dist(nprow * npcol);
+        if (!(*diag_procs = intMalloc_dist(nprow * npcol)))
+            ABORT("Malloc fails for diag_procs[]");
+        if (!(*diag_len = intCalloc_dist(nprow * npcol)))
+            ABORT("Calloc fails for diag_len[]");
+        for (k = 0; k < nsupers; ++k)
+        {
+            pkk = PNUM(PROW(k, grid), PCOL(k, grid), grid);
+            if (!procs[pkk]) (*diag_procs)[(*num_diag_procs)++] = pkk;
+            procs[pkk] += SuperSize(k);
+        }
+        for (k = 0; k < *num_diag_procs; ++k)
+            (*diag_len)[k] = procs[(*diag_procs)[k]];
+        SUPERLU_FREE(procs);
+        return;
+    }
+
     do
     {
         ++(*num_diag_procs);
@@ -1031,8 +1051,6 @@ int_t estimate_bigu_size(
 {
     int_t iam = grid->iam;
     int_t Pc = grid->npcol;
-    int_t Pr = grid->nprow;
-    int_t myrow = MYROW(iam, grid);
     int_t mycol = MYCOL(iam, grid);
 
     int_t *xsup = Glu_persist->xsup;
@@ -1046,8 +1064,9 @@ int_t estimate_bigu_size(
     for (int i = 0; i < nsupers; ++i)
         perm_u[i] = i;
 
-    for (int lk = myrow; lk < nsupers; lk += Pr)
+    for (int lb = 0; lb < MyNLBi(nsupers, grid); ++lb)
     { /* Go through my block rows */
+        int_t lk = GBi(lb, grid);
         ncols = SUPERLU_MAX(ncols, num_full_cols_U(lk, Ufstnz_br_ptr,
                                                    xsup, grid, perm_u, &ldu));
         my_max_ldu = SUPERLU_MAX(ldu, my_max_ldu);
@@ -50,9 +50,11 @@ int_t zIBcast_LPanel
         {
 
 
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
             MPI_Isend (lsub, msgcnt[0], mpi_int_t, pj,
                        SLU_MPI_TAG (0, k0) /* 0 */ ,
                        scp->comm, &send_req[pj]);
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX);
             MPI_Isend (lusup, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX, pj,
                        SLU_MPI_TAG (1, k0) /* 1 */ ,
                        scp->comm, &send_req[pj + Pc]);
@@ -92,9 +94,11 @@ int_t zBcast_LPanel
         {
 
 
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[0], mpi_int_t);
             MPI_Send (lsub, msgcnt[0], mpi_int_t, pj,
                        SLU_MPI_TAG (0, k0) /* 0 */ ,
                        scp->comm);
+            commProfSend(COMM_PANEL_L, scp->comm, pj, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX);
             MPI_Send (lusup, msgcnt[1], SuperLU_MPI_DOUBLE_COMPLEX, pj,
                        SLU_MPI_TAG (1, k0) /* 1 */ ,
                        scp->comm);
@@ -136,10 +140,12 @@ int_t zIBcast_UPanel
             if (pi != myrow)
             {
 
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[2], mpi_int_t);
                 MPI_Isend (usub, msgcnt[2], mpi_int_t, pi,
                            SLU_MPI_TAG (2, k0) /* (4*k0+2)%tag_ub */ ,
                            scp->comm,
                            &send_req_u[pi]);
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[3], SuperLU_MPI_DOUBLE_COMPLEX);
                 MPI_Isend (uval, msgcnt[3], SuperLU_MPI_DOUBLE_COMPLEX,
                            pi, SLU_MPI_TAG (3, k0) /* (4*kk0+3)%tag_ub */ ,
                            scp->comm,
@@ -180,9 +186,11 @@ int_t zBcast_UPanel(int_t k, int_t k0, int_t* usub,
         {
             if (pi != myrow)
             {
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[2], mpi_int_t);
                 MPI_Send (usub, msgcnt[2], mpi_int_t, pi,
                           SLU_MPI_TAG (2, k0) /* (4*k0+2)%tag_ub */ ,
                           scp->comm);
+                commProfSend(COMM_PANEL_U, scp->comm, pi, msgcnt[3], SuperLU_MPI_DOUBLE_COMPLEX);
                 MPI_Send (uval, msgcnt[3], SuperLU_MPI_DOUBLE_COMPLEX, pi,
                           SLU_MPI_TAG (3, k0) /* (4*k0+3)%tag_ub */ ,
                           scp->comm);
@@ -296,6 +304,7 @@ int_t zISend_UDiagBlock(int_t k0, doublecomplex *ublk_ptr, /*pointer for the dia
         {
             /* tag = ((k0<<2)+2) % tag_ub;        */
             /* tag = (4*(nsupers+k0)+2) % tag_ub; */
+            commProfSend(COMM_DIAG, comm, pr, size, SuperLU_MPI_DOUBLE_COMPLEX);
             MPI_Isend (ublk_ptr, size, SuperLU_MPI_DOUBLE_COMPLEX, pr,
                        SLU_MPI_TAG (4, k0) /* tag */ ,
                        comm, U_diag_blk_send_req + pr);
@@ -367,6 +376,7 @@ int_t zISend_LDiagBlock(int_t k0, doublecomplex *lblk_ptr, /*pointer for the dia
         {
             /* tag = ((k0<<2)+2) % tag_ub;        */
             /* tag = (4*(nsupers+k0)+2) % tag_ub; */
+            commProfSend(COMM_DIAG, comm, pc, size, SuperLU_MPI_DOUBLE_COMPLEX);
             MPI_Isend (lblk_ptr, size, SuperLU_MPI_DOUBLE_COMPLEX, pc,
                        SLU_MPI_TAG (5, k0) /* tag */ ,
                        comm, L_diag_blk_send_req + pc);
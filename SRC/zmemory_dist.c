@@ -74,13 +74,11 @@ int_t zQuerySpace_dist(int_t n, zLUstruct_t *LUstruct, gridinfo_t *grid,
 {
     register int_t dword, gb, iword, k, nb, nsupers;
     int_t *index, *xsup;
-    int iam, mycol, myrow;
+    int iam;
     Glu_persist_t *Glu_persist = LUstruct->Glu_persist;
     zLocalLU_t *Llu = LUstruct->Llu;
 
     iam = grid->iam;
-    myrow = MYROW( iam, grid );
-    mycol = MYCOL( iam, grid );
     iword = sizeof(int_t);
     dword = sizeof(doublecomplex);
     nsupers = Glu_persist->supno[n-1] + 1;
@@ -88,9 +86,9 @@ int_t zQuerySpace_dist(int_t n, zLUstruct_t *LUstruct, gridinfo_t *grid,
     mem_usage->for_lu = 0.;
 
     /* For L factor */
-    nb = CEILING( nsupers, grid->npcol ); /* Number of local column blocks */
+    nb = NLBj( nsupers, grid ); /* Number of local column blocks */
     for (k = 0; k < nb; ++k) {
-	gb = k * grid->npcol + mycol; /* Global block number. */
+	gb = GBj( k, grid ); /* Global block number. */
 	if ( gb < nsupers ) {
 	    index = Llu->Lrowind_bc_ptr[k];
 	    if ( index ) {
@@ -102,9 +100,9 @@ int_t zQuerySpace_dist(int_t n, zLUstruct_t *LUstruct, gridinfo_t *grid,
     }
 
     /* For U factor */
-    nb = CEILING( nsupers, grid->nprow ); /* Number of local row blocks */
+    nb = NLBi( nsupers, grid ); /* Number of local row blocks */
     for (k = 0; k < nb; ++k) {
-	gb = k * grid->nprow + myrow; /* Global block number. */
+	gb = GBi( k, grid ); /* Global block number. */
 	if ( gb < nsupers ) {
 	    index = Llu->Ufstnz_br_ptr[k];
 	    if ( index ) {
@@ -124,7 +122,7 @@ int_t zQuerySpace_dist(int_t n, zLUstruct_t *LUstruct, gridinfo_t *grid,
     mem_usage->total +=
 	(float)( Llu->bufmax[0] * iword +  Llu->bufmax[1] * dword );
     mem_usage->total += (float)( maxsup * maxsup + maxsup) * iword;
-    k = CEILING( nsupers, grid->nprow );
+    k = NLBi( nsupers, grid );
     mem_usage->total += (float)(2 * k * iword);
 #else
     /*mem_usage->total += stat->current_buffer;*/
@@ -182,7 +180,7 @@ double zgetLUMem(int_t nodeId, zLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
     int_t** Lrowind_bc_ptr = Llu->Lrowind_bc_ptr;
     doublecomplex** Lnzval_bc_ptr = Llu->Lnzval_bc_ptr;
     int_t** Ufstnz_br_ptr = Llu->Ufstnz_br_ptr;
-    // double** Unzval_br_ptr = Llu->Unzval_br_ptr;
+    doublecomplex** Unzval_br_ptr = Llu->Unzval_br_ptr;
     int_t iam = grid->iam;
 
     int_t myrow = MYROW (iam, grid);
@@ -203,7 +201,9 @@ double zgetLUMem(int_t nodeId, zLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
             int_t  len   = lsub[1];       /* LDA of the nzval[] */
             int_t len1  = len + BC_HEADER + nrbl * LB_DESCRIPTOR;
             int_t len2  = SuperSize(nodeId) * len;
-            memlu += 1.0 * (len1 * sizeof(int_t)  + len2 * sizeof(doublecomplex));
+            memlu += 1.0 * len1 * sizeof(int_t);
+            /* values may be unallocated with lazy ancestor storage */
+            if (lnzval) memlu += 1.0 * len2 * sizeof(doublecomplex);
         }
     }
 
@@ -219,7 +219,8 @@ double zgetLUMem(int_t nodeId, zLUstruct_t *LUstruct, gridinfo3d_t *grid3d)
         {
             int_t lenv = usub[1];
             int_t lens = usub[2];
-            memlu += 1.0 * (lenv * sizeof(int_t)  + lens * sizeof(doublecomplex));
+            memlu += 1.0 * lens * sizeof(int_t);
+            if (Unzval_br_ptr[lib]) memlu += 1.0 * lenv * sizeof(doublecomplex);
         }
     }
     return memlu;
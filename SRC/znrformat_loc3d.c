@@ -68,6 +68,7 @@ void zGatherNRformat_loc3d
 	/* A3d is output. Compute counts from scratch */
 	A3d = SUPERLU_MALLOC(sizeof(NRformat_loc3d));
 	A3d->num_procs_to_send = SLU_EMPTY; // No X(2d) -> X(3d) comm. schedule yet
+	A3d->trf3Dpart = NULL;
 	A2d = SUPERLU_MALLOC(sizeof(NRformat_loc));
     
 	// find number of nnzs
@@ -521,6 +522,7 @@ int zScatter_B3d(NRformat_loc3d *A3d,  // modified
 		  iam,dest, send_count_list[p], tag);
 		  fflush(stdout); */
 		    
+		commProfSend(COMM_REDIST, grid3d->comm, dest, nrhs * send_count_list[p], SuperLU_MPI_DOUBLE_COMPLEX);
 		MPI_Send(B1 + i, nrhs * send_count_list[p], 
 			 SuperLU_MPI_DOUBLE_COMPLEX, dest, tag, grid3d->comm);
 		i += nrhs * send_count_list[p];
@@ -548,6 +550,7 @@ int zScatter_B3d(NRformat_loc3d *A3d,  // modified
 	        dest = p + grid2d->iam * npdep; // Z-major order
 		tag = dest;
 
+		commProfSend(COMM_REDIST, grid3d->comm, dest, b_counts_int[p], SuperLU_MPI_DOUBLE_COMPLEX);
 		MPI_Send(B1 + b_disp[p], b_counts_int[p], 
 			 SuperLU_MPI_DOUBLE_COMPLEX, dest, tag, grid3d->comm);
 	    }
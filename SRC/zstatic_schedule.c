@@ -100,8 +100,8 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
     nsupers = Glu_persist->supno[n - 1] + 1;
     xsup = Glu_persist->xsup;
     nblocks = 0;
-    ncb = nsupers / Pc;
-    nrb = nsupers / Pr;
+    ncb = MyNLBj( nsupers, grid );
+    nrb = MyNLBi( nsupers, grid );
 
 #if ( DEBUGlevel >= 1 ) 
     print_memorylog(stat, "before static schedule");
@@ -155,7 +155,7 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 
             for (i = 0; i < nsupers; i++) etree_supno_l[i] = nsupers;
             for (lb = 0; lb < ncb; lb++) {
-                jb = lb * grid->npcol + mycol;
+                jb = GBj( lb, grid );
                 index = Llu->Lrowind_bc_ptr[lb];
                 if (index) {   /* Not an empty column */
                     i = index[0];
@@ -180,29 +180,6 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
                     }
                 }
             }
-            if (mycol < nsupers % grid->npcol) {
-                jb = ncb * grid->npcol + mycol;
-                index = Llu->Lrowind_bc_ptr[ncb];
-                if (index) {     /* Not an empty column */
-                    i = index[0];
-                    k = BC_HEADER;
-                    krow = PROW (jb, grid);
-                    if (krow == myrow) { /* skip the diagonal block */
-                        k += LB_DESCRIPTOR + index[k + 1];
-                        i--;
-                    }
-                    if (i > 0) {
-                        etree_supno_l[jb] = index[k];
-                        k += LB_DESCRIPTOR + index[k + 1];
-                        i--;
-                    }
-                    for (j = 0; j < i; j++) {
-                        etree_supno_l[jb] =
-                            SUPERLU_MIN (etree_supno_l[jb], index[k]);
-                        k += LB_DESCRIPTOR + index[k + 1];
-                    }
-                }
-            }
 
             /* form global e-tree */
             etree_supno = SUPERLU_MALLOC (nsupers * sizeof (int_t));
@@ -280,19 +257,19 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 
         /* Need to process both L- and U-factors, use the symmetrically
            pruned graph of L & U instead of tree (very naive implementation) */
-        int nrbp1 = nrb + 1;
+        int ldr = NLBi( nsupers, grid ); /* same on all processes */
 	float Ublock_bytes, Urows_bytes, Lblock_bytes, Lrows_bytes;
 
         /* allocate some workspace */
-        if (! (sendcnts = SUPERLU_MALLOC ((4 + 2 * nrbp1) * Pr * Pc * sizeof (int))))
+        if (! (sendcnts = SUPERLU_MALLOC ((4 + 2 * ldr) * Pr * Pc * sizeof (int))))
             ABORT ("Malloc fails for sendcnts[].");
-	log_memory((4 + 2 * nrbp1) * Pr * Pc * sizeof (int), stat);
+	log_memory((4 + 2 * ldr) * Pr * Pc * sizeof (int), stat);
 
         sdispls = &sendcnts[Pr * Pc];
         recvcnts = &sdispls[Pr * Pc];
         rdispls = &recvcnts[Pr * Pc];
         srows = &rdispls[Pr * Pc];
-        rrows = &srows[Pr * Pc * nrbp1];
+        rrows = &srows[Pr * Pc * ldr];
 
         myrow = MYROW (iam, grid);
 #if ( PRNTlevel>=1 )
@@ -305,14 +282,14 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 
         /* srows   : # of block to send to a processor from each supno row */
         /* sendcnts: total # of blocks to send to a processor              */
-        for (p = 0; p < Pr * Pc * nrbp1; p++) srows[p] = 0;
+        for (p = 0; p < Pr * Pc * ldr; p++) srows[p] = 0;
         for (p = 0; p < Pr * Pc; p++) sendcnts[p] = 0;
 
         /* sending blocks of U-factors corresponding to L-factors */
         /* count the number of blocks to send */
         for (lb = 0; lb < nrb; ++lb) {
-            jb = lb * Pr + myrow;
-            pc = jb % Pc;
+            jb = GBi( lb, grid );
+            pc = PCOL( jb, grid );
             index = Llu->Ufstnz_br_ptr[lb];
 
             if (index) {         /* Not an empty row */
@@ -320,34 +297,16 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
                 nblocks += index[0];
                 for (j = 0; j < index[0]; ++j) {
                     ib = index[k];
-                    pr = ib % Pr;
+                    pr = PROW( ib, grid );
                     p = pr * Pc + pc;
                     sendcnts[p]++;
-                    srows[p * nrbp1 + lb]++;
+                    srows[p * ldr + lb]++;
 
                     k += UB_DESCRIPTOR + SuperSize (index[k]);
                 }
             }
         }
 
-        if (myrow < nsupers % grid->nprow) {
-            jb = nrb * Pr + myrow;
-            pc = jb % Pc;
-            index = Llu->Ufstnz_br_ptr[nrb];
-
-            if (index) {         /* Not an empty row */
-                k = BR_HEADER;
-                nblocks += index[0];
-                for (j = 0; j < index[0]; ++j) {
-                    ib = index[k];
-                    pr = ib % Pr;
-                    p = pr * Pc + pc;
-                    sendcnts[p]++;
-                    srows[p * nrbp1 + nrb]++;
-                    k += UB_DESCRIPTOR + SuperSize (index[k]);
-                }
-            }
-        }
 
         /* insert blocks to send */
         sdispls[0] = 0;
@@ -357,15 +316,15 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 	log_memory( nblocks * iword, stat );
 
         for (lb = 0; lb < nrb; ++lb) {
-            jb = lb * Pr + myrow;
-            pc = jb % Pc;
+            jb = GBi( lb, grid );
+            pc = PCOL( jb, grid );
             index = Llu->Ufstnz_br_ptr[lb];
 
             if (index) {       /* Not an empty row */
                 k = BR_HEADER;
                 for (j = 0; j < index[0]; ++j) {
                     ib = index[k];
-                    pr = ib % Pr;
+                    pr = PROW( ib, grid );
                     p = pr * Pc + pc;
                     blocks[sdispls[p]] = ib;
                     sdispls[p]++;
@@ -375,28 +334,10 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
             }
         }
 
-        if (myrow < nsupers % grid->nprow) {
-            jb = nrb * Pr + myrow;
-            pc = jb % Pc;
-            index = Llu->Ufstnz_br_ptr[nrb];
-
-            if (index) {       /* Not an empty row */
-                k = BR_HEADER;
-                for (j = 0; j < index[0]; ++j) {
-                    ib = index[k];
-                    pr = ib % Pr;
-                    p = pr * Pc + pc;
-                    blocks[sdispls[p]] = ib;
-                    sdispls[p]++;
-
-                    k += UB_DESCRIPTOR + SuperSize (index[k]);
-                }
-            }
-        }
 
         /* communication */
         MPI_Alltoall (sendcnts, 1, MPI_INT, recvcnts, 1, MPI_INT, grid->comm);
-        MPI_Alltoall (srows, nrbp1, MPI_INT, rrows, nrbp1, MPI_INT, grid->comm);
+        MPI_Alltoall (srows, ldr, MPI_INT, rrows, ldr, MPI_INT, grid->comm);
 
 	log_memory( -(nblocks * iword), stat );  /* blocks[] to be freed soon */
 
@@ -418,7 +359,7 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 
 	
         /* store the received U-blocks by rows */
-        nlb = nsupers / Pc;
+        nlb = MyNLBj( nsupers, grid );
         if (!(Ublock = intMalloc_dist (nblocks))) ABORT ("Malloc fails for Ublock[].");
         if (!(Urows = intMalloc_dist (1 + nlb))) ABORT ("Malloc fails for Urows[].");
 
@@ -428,21 +369,21 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 
         k = 0;
         for (jb = 0; jb < nlb; jb++) {
-            j = jb * Pc + mycol;
-            pr = j % Pr;
-            lb = j / Pr;
+            j = GBj( jb, grid );
+            pr = PROW( j, grid );
+            lb = LBi( j, grid );
             Urows[jb] = 0;
 
             for (pc = 0; pc < Pc; pc++) {
                 p = pr * Pc + pc; /* the processor owning this block of U-factor */
 
-                for (i = rdispls[p]; i < rdispls[p] + rrows[p * nrbp1 + lb];
+                for (i = rdispls[p]; i < rdispls[p] + rrows[p * ldr + lb];
                      i++) {
                     Ublock[k] = blockr[i];
                     k++;
                     Urows[jb]++;
                 }
-                rdispls[p] += rrows[p * nrbp1 + lb];
+                rdispls[p] += rrows[p * ldr + lb];
             }
             /* sort by the column indices to make things easier for later on */
 
@@ -451,29 +392,6 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 #else
             qsort (&(Ublock[k - Urows[jb]]), (size_t) (Urows[jb]),
                    sizeof (int_t), &superlu_sort_perm);
-#endif
-        }
-        if (mycol < nsupers % grid->npcol) {
-            j = nlb * Pc + mycol;
-            pr = j % Pr;
-            lb = j / Pr;
-            Urows[nlb] = 0;
-
-            for (pc = 0; pc < Pc; pc++) {
-                p = pr * Pc + pc;
-                for (i = rdispls[p]; i < rdispls[p] + rrows[p * nrbp1 + lb];
-                     i++) {
-                    Ublock[k] = blockr[i];
-                    k++;
-                    Urows[nlb]++;
-                }
-                rdispls[p] += rrows[p * nrb + lb];
-            }
-#ifdef ISORT
-            isort1 (Urows[nlb], &(Ublock[k - Urows[nlb]]));
-#else
-            qsort (&(Ublock[k - Urows[nlb]]), (size_t) (Urows[nlb]),
-                   sizeof (int_t), &superlu_sort_perm);
 #endif
         }
         SUPERLU_FREE (blockr);
@@ -482,19 +400,12 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
         /* sort the block in L-factor */
         nblocks = 0;
         for (lb = 0; lb < ncb; lb++) {
-            jb = lb * Pc + mycol;
+            jb = GBj( lb, grid );
             index = Llu->Lrowind_bc_ptr[lb];
             if (index) {        /* Not an empty column */
                 nblocks += index[0];
             }
         }
-        if (mycol < nsupers % grid->npcol) {
-            jb = ncb * Pc + mycol;
-            index = Llu->Lrowind_bc_ptr[ncb];
-            if (index) {       /* Not an empty column */
-                nblocks += index[0];
-            }
-        }
 
         if (!(Lblock = intMalloc_dist (nblocks))) ABORT ("Malloc fails for Lblock[].");
         if (!(Lrows = intMalloc_dist (1 + ncb))) ABORT ("Malloc fails for Lrows[].");
@@ -508,7 +419,7 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
         for (lb = 0; lb < ncb; lb++) {
             Lrows[lb] = 0;
 
-            jb = lb * Pc + mycol;
+            jb = GBj( lb, grid );
             index = Llu->Lrowind_bc_ptr[lb];
             if (index) {      /* Not an empty column */
                 i = index[0];
@@ -535,32 +446,6 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
                    sizeof (int_t), &superlu_sort_perm);
 #endif
         }
-        if (mycol < nsupers % grid->npcol) {
-            Lrows[ncb] = 0;
-            jb = ncb * Pc + mycol;
-            index = Llu->Lrowind_bc_ptr[ncb];
-            if (index) {       /* Not an empty column */
-                i = index[0];
-                k = BC_HEADER;
-                krow = PROW (jb, grid);
-                if (krow == myrow) { /* skip the diagonal block */
-                    k += LB_DESCRIPTOR + index[k + 1];
-                    i--;
-                }
-                for (j = 0; j < i; j++) {
-                    Lblock[nblocks] = index[k];
-                    Lrows[ncb]++;
-                    nblocks++;
-                    k += LB_DESCRIPTOR + index[k + 1];
-                }
-#ifdef ISORT
-                isort1 (Lrows[ncb], &(Lblock[nblocks - Lrows[ncb]]));
-#else
-                qsort (&(Lblock[nblocks - Lrows[ncb]]), (size_t) (Lrows[ncb]),
-                       sizeof (int_t), &superlu_sort_perm);
-#endif
-            }
-        }
 
         /* look for the first local symmetric nonzero block match */
         if (!(sf_block = intMalloc_dist (nsupers))) ABORT ("Malloc fails for sf_block[].");
@@ -575,7 +460,7 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
         for (jb = 0; jb < nlb; jb++) {
             if (Urows[jb] > 0) {
                 ib = i + Urows[jb];
-                lb = jb * Pc + mycol;
+                lb = GBj( jb, grid );
                 for (k = 0; k < Lrows[jb]; k++) {
                     while (Ublock[i] < Lblock[j] && i + 1 < ib)
                         i++;
@@ -593,30 +478,6 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
                 j += Lrows[jb];
             }
         }
-        if (mycol < nsupers % grid->npcol) {
-            if (Urows[nlb] > 0) {
-                ib = i + Urows[nlb];
-                lb = nlb * Pc + mycol;
-                for (k = 0; k < Lrows[nlb]; k++) {
-                    while (Ublock[i] < Lblock[j] && i + 1 < ib)
-                        i++;
-
-                    if (Ublock[i] == Lblock[j])
-                    {
-                        sf_block_l[lb] = Lblock[j];
-                        j += (Lrows[nlb] - k);
-                        k = Lrows[nlb];
-                    }
-                    else
-                    {
-                        j++;
-                    }
-                }
-                i = ib;
-            } else {
-                j += Lrows[nlb];
-            }
-        }
 
         /* compute the first global symmetric matchs */
         MPI_Allreduce (sf_block_l, sf_block, nsupers, mpi_int_t, MPI_MIN,
@@ -635,7 +496,7 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
         nblocks = 0;
         /* from U-factor */
         for (i = 0, jb = 0; jb < nlb; jb++) {
-            lb = jb * Pc + mycol;
+            lb = GBj( jb, grid );
             ib = i + Urows[jb];
             while (i < ib) {
                 if (Ublock[i] <= sf_block[lb]) {
@@ -648,24 +509,10 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
             }
             i = ib;
         }
-        if (mycol < nsupers % grid->npcol) {
-            lb = nlb * Pc + mycol;
-            ib = i + Urows[nlb];
-            while (i < ib) {
-                if (Ublock[i] <= sf_block[lb]) {
-                    nnodes_u[lb]++;
-                    i++;
-                    nblocks++;
-                } else {         /* get out */
-                    i = ib;
-                }
-            }
-            i = ib;
-        }
 
         /* from L-factor */
         for (i = 0, jb = 0; jb < nlb; jb++) {
-            lb = jb * Pc + mycol;
+            lb = GBj( jb, grid );
             ib = i + Lrows[jb];
             while (i < ib) {
                 if (Lblock[i] < sf_block[lb]) {
@@ -678,20 +525,6 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
             }
             i = ib;
         }
-        if (mycol < nsupers % grid->npcol) {
-            lb = nlb * Pc + mycol;
-            ib = i + Lrows[nlb];
-            while (i < ib) {
-                if (Lblock[i] < sf_block[lb]) {
-                    nnodes_l[lb]++;
-                    i++;
-                    nblocks++;
-                } else {
-                    i = ib;
-                }
-            }
-            i = ib;
-        }
 
 #ifdef USE_ALLGATHER
         /* insert local nodes in DAG */
@@ -702,8 +535,8 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 
         iu = il = nblocks = 0;
         for (lb = 0; lb < nsupers; lb++) {
-            j = lb / Pc;
-            pc = lb % Pc;
+            j = LBj( lb, grid );
+            pc = PCOL( lb, grid );
 
             edag_supno_l[nblocks] = nnodes_l[lb] + nnodes_u[lb];
             nblocks++;
@@ -780,8 +613,7 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 	log_memory(-nblocks * iword, stat);
 
 #else   /* not USE_ALLGATHER */
-        int nlsupers = nsupers / Pc;
-        if (mycol < nsupers % Pc) nlsupers++;
+        int nlsupers = MyNLBj( nsupers, grid );
 
         /* insert local nodes in DAG */
         if (!(edag_supno_l = intMalloc_dist (nlsupers + nblocks)))
@@ -791,8 +623,8 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
 
         iu = il = nblocks = 0;
         for (lb = 0; lb < nsupers; lb++) {
-            j = lb / Pc;
-            pc = lb % Pc;
+            j = LBj( lb, grid );
+            pc = PCOL( lb, grid );
             if (mycol == pc) {
                 edag_supno_l[nblocks] = nnodes_l[lb] + nnodes_u[lb];
                 nblocks++;
@@ -847,8 +679,8 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
             yourcol = MYCOL (p, grid);
 
             for (lb = 0; lb < nsupers; lb++) {
-                j = lb / Pc;
-                pc = lb % Pc;
+                j = LBj( lb, grid );
+                pc = PCOL( lb, grid );
                 if (yourcol == pc) {
                     nnodes_l[lb] += recvbuf[k];
                     k += (1 + recvbuf[k]);
@@ -866,8 +698,8 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
             yourcol = MYCOL (p, grid);
 
             for (lb = 0; lb < nsupers; lb++) {
-                j = lb / Pc;
-                pc = lb % Pc;
+                j = LBj( lb, grid );
+                pc = PCOL( lb, grid );
                 if (yourcol == pc)
                 {
                     jb = k + recvbuf[k] + 1;
@@ -958,7 +790,7 @@ zstatic_schedule(superlu_dist_options_t * options, int m, int n,
         SUPERLU_FREE (sf_block);
         SUPERLU_FREE (sendcnts);
 
-	log_memory(-(4 * nsupers + (4 + 2 * nrbp1)*Pr*Pc) * iword, stat);
+	log_memory(-(4 * nsupers + (4 + 2 * ldr)*Pr*Pc) * iword, stat);
 
         SUPERLU_FREE (Ublock);
         SUPERLU_FREE (Urows);
@@ -87,10 +87,15 @@ zLUValSubBuf_t** zLluBufInitArr(int_t numLA, zLUstruct_t *LUstruct)
 int zLluBufFreeArr(int_t numLA, zLUValSubBuf_t **LUvsbs)
 {
     for (int_t i = 0; i < numLA; ++i) {
-	SUPERLU_FREE(LUvsbs[i]->Lsub_buf);
-	SUPERLU_FREE(LUvsbs[i]->Lval_buf);
-	SUPERLU_FREE(LUvsbs[i]->Usub_buf);
-	SUPERLU_FREE(LUvsbs[i]->Uval_buf);
+	/* Slots in node-shared windows are freed by zLluBufShmFree(). */
+	if ( LUvsbs[i]->Lsub_buf ) {
+	    SUPERLU_FREE(LUvsbs[i]->Lsub_buf);
+	    SUPERLU_FREE(LUvsbs[i]->Lval_buf);
+	}
+	if ( LUvsbs[i]->Usub_buf ) {
+	    SUPERLU_FREE(LUvsbs[i]->Usub_buf);
+	    SUPERLU_FREE(LUvsbs[i]->Uval_buf);
+	}
 	SUPERLU_FREE(LUvsbs[i]);
     }
     SUPERLU_FREE(LUvsbs);
@@ -98,6 +103,135 @@ int zLluBufFreeArr(int_t numLA, zLUValSubBuf_t **LUvsbs)
 }
 
 
+/*
+ * Move the L and U receive buffers of the numLA look-ahead slots into
+ * node-shared windows if SUPERLU_SHM_BCAST asks for the hierarchical
+ * panel broadcast; see shmBcastInit().  Otherwise they move into an RMA
+ * window if SUPERLU_BCAST_RMA asks for one-sided delivery; see
+ * rmaBcastInit().  A scope that keeps private buffers uses the segmented
+ * tree broadcast instead if SUPERLU_BCAST_SEG asks for it; see
+ * segBcastInit().  Both kinds of scope also coalesce the small panels if
+ * SUPERLU_BCAST_AGG asks for it; see aggBcastPlan().  Collective over the
+ * 2D grid.
+ */
+int zLluBufShmInit(int_t numLA, zLUValSubBuf_t **LUvsbs, int_t nsupers,
+		   gridinfo_t *grid, zLUstruct_t *LUstruct)
+{
+    zLocalLU_t *Llu = LUstruct->Llu;
+    int* ToRecv = Llu->ToRecv;
+    int_t iam = grid->iam;
+    int_t myrow = MYROW (iam, grid);
+    int_t mycol = MYCOL (iam, grid);
+    int *need;
+    int_t k;
+
+    Llu->shmL = Llu->shmU = NULL;
+    Llu->segL = Llu->segU = NULL;
+    Llu->aggL = Llu->aggU = NULL;
+    Llu->rmaL = Llu->rmaU = NULL;
+    if ( numLA <= 0 ) return 0;
+    need = int32Malloc_dist(SUPERLU_MAX(nsupers, 1));
+    int_t **sub = SUPERLU_MALLOC(numLA * sizeof(int_t *));
+    void **val = SUPERLU_MALLOC(numLA * sizeof(void *));
+
+    for (k = 0; k < nsupers; ++k)
+	need[k] = ( PCOL (k, grid) != mycol && ToRecv[k] >= 1 );
+    Llu->shmL = shmBcastInit(grid->rscp.comm, numLA, nsupers, need,
+			     Llu->bufmax[0], mpi_int_t,
+			     Llu->bufmax[1], SuperLU_MPI_DOUBLE_COMPLEX);
+    if ( !Llu->shmL ) {
+	Llu->rmaL = rmaBcastInit(grid->rscp.comm, numLA, Llu->bufmax[0],
+				 mpi_int_t, Llu->bufmax[1], SuperLU_MPI_DOUBLE_COMPLEX);
+	for (k = 0; k < numLA; ++k) {
+	    sub[k] = Llu->rmaL ? Llu->rmaL->sub[k] : LUvsbs[k]->Lsub_buf;
+	    val[k] = Llu->rmaL ? Llu->rmaL->val[k] : LUvsbs[k]->Lval_buf;
+	}
+	if ( !Llu->rmaL )
+	    Llu->segL = segBcastInit(grid->rscp.comm, numLA, sub, val, nsupers,
+				     need, Llu->bufmax[0], mpi_int_t,
+				     SuperLU_MPI_DOUBLE_COMPLEX);
+	Llu->aggL = aggBcastInit(grid->rscp.comm, numLA, sub, val, nsupers,
+				 SuperLU_MPI_DOUBLE_COMPLEX);
+    }
+    for (k = 0; k < nsupers; ++k)
+	need[k] = ( PROW (k, grid) != myrow && ToRecv[k] == 2 );
+    Llu->shmU = shmBcastInit(grid->cscp.comm, numLA, nsupers, need,
+			     Llu->bufmax[2], mpi_int_t,
+			     Llu->bufmax[3], SuperLU_MPI_DOUBLE_COMPLEX);
+    if ( !Llu->shmU ) {
+	Llu->rmaU = rmaBcastInit(grid->cscp.comm, numLA, Llu->bufmax[2],
+				 mpi_int_t, Llu->bufmax[3], SuperLU_MPI_DOUBLE_COMPLEX);
+	for (k = 0; k < numLA; ++k) {
+	    sub[k] = Llu->rmaU ? Llu->rmaU->sub[k] : LUvsbs[k]->Usub_buf;
+	    val[k] = Llu->rmaU ? Llu->rmaU->val[k] : LUvsbs[k]->Uval_buf;
+	}
+	if ( !Llu->rmaU )
+	    Llu->segU = segBcastInit(grid->cscp.comm, numLA, sub, val, nsupers,
+				     need, Llu->bufmax[2], mpi_int_t,
+				     SuperLU_MPI_DOUBLE_COMPLEX);
+	Llu->aggU = aggBcastInit(grid->cscp.comm, numLA, sub, val, nsupers,
+				 SuperLU_MPI_DOUBLE_COMPLEX);
+    }
+    SUPERLU_FREE(need);
+    SUPERLU_FREE(sub);
+    SUPERLU_FREE(val);
+    if ( Llu->shmU ) Llu->shmU->phase = COMM_PANEL_U;
+    if ( Llu->segU ) Llu->segU->phase = COMM_PANEL_U;
+    if ( Llu->aggU ) Llu->aggU->phase = COMM_PANEL_U;
+    if ( Llu->rmaU ) Llu->rmaU->phase = COMM_PANEL_U;
+
+    for (int_t i = 0; i < numLA; ++i) {
+	if ( Llu->shmL ) {
+	    SUPERLU_FREE(LUvsbs[i]->Lsub_buf);
+	    SUPERLU_FREE(LUvsbs[i]->Lval_buf);
+	    LUvsbs[i]->Lsub_buf = Llu->shmL->sub[i];
+	    LUvsbs[i]->Lval_buf = (doublecomplex *) Llu->shmL->val[i];
+	}
+	if ( Llu->rmaL ) {
+	    SUPERLU_FREE(LUvsbs[i]->Lsub_buf);
+	    SUPERLU_FREE(LUvsbs[i]->Lval_buf);
+	    LUvsbs[i]->Lsub_buf = Llu->rmaL->sub[i];
+	    LUvsbs[i]->Lval_buf = (doublecomplex *) Llu->rmaL->val[i];
+	}
+	if ( Llu->shmU ) {
+	    SUPERLU_FREE(LUvsbs[i]->Usub_buf);
+	    SUPERLU_FREE(LUvsbs[i]->Uval_buf);
+	    LUvsbs[i]->Usub_buf = Llu->shmU->sub[i];
+	    LUvsbs[i]->Uval_buf = (doublecomplex *) Llu->shmU->val[i];
+	}
+	if ( Llu->rmaU ) {
+	    SUPERLU_FREE(LUvsbs[i]->Usub_buf);
+	    SUPERLU_FREE(LUvsbs[i]->Uval_buf);
+	    LUvsbs[i]->Usub_buf = Llu->rmaU->sub[i];
+	    LUvsbs[i]->Uval_buf = (doublecomplex *) Llu->rmaU->val[i];
+	}
+    }
+    return 0;
+}
+
+int zLluBufShmFree(int_t numLA, zLUValSubBuf_t **LUvsbs, zLUstruct_t *LUstruct)
+{
+    zLocalLU_t *Llu = LUstruct->Llu;
+
+    for (int_t i = 0; i < numLA; ++i) {
+	if ( Llu->shmL || Llu->rmaL ) LUvsbs[i]->Lsub_buf = NULL;
+	if ( Llu->shmU || Llu->rmaU ) LUvsbs[i]->Usub_buf = NULL;
+    }
+    shmBcastFree(Llu->shmL);
+    shmBcastFree(Llu->shmU);
+    segBcastFree(Llu->segL);
+    segBcastFree(Llu->segU);
+    aggBcastFree(Llu->aggL);
+    aggBcastFree(Llu->aggU);
+    rmaBcastFree(Llu->rmaL);
+    rmaBcastFree(Llu->rmaU);
+    Llu->shmL = Llu->shmU = NULL;
+    Llu->segL = Llu->segU = NULL;
+    Llu->aggL = Llu->aggU = NULL;
+    Llu->rmaL = Llu->rmaU = NULL;
+    return 0;
+}
+
 int_t zinitScuBufs(superlu_dist_options_t *options,
                   int_t ldt, int_t num_threads, int_t nsupers,
                   zscuBufs_t* scuBufs,
@@ -341,12 +475,19 @@ int_t zsparseTreeFactor_ASYNC(
     int_t numLAMax = getNumLookAhead(options);
     int_t numLA = numLAMax;
 
+    /* batches of small panels sent as one message (SUPERLU_BCAST_AGG) */
+    aggBcastPlan(LUstruct->Llu->aggL, perm_c_supno, eTreeTopLims,
+                 maxTopoLevel, xsup);
+    aggBcastPlan(LUstruct->Llu->aggU, perm_c_supno, eTreeTopLims,
+                 maxTopoLevel, xsup);
+
     for (int_t k0 = 0; k0 < eTreeTopLims[1]; ++k0)
     {
         int_t k = perm_c_supno[k0];   // direct computation no perm_c_supno
         int_t offset = k0;
         /* k-th diagonal factorization */
         /*Now factor and broadcast diagonal block*/
+	zancReduceWait(k, LUstruct, grid3d, SCT);
 #if 0
         sDiagFactIBCast(k,  dFBufs[offset], factStat, comReqss[offset], grid,
                         options, thresh, LUstruct, stat, info, SCT, tag_ub);
@@ -376,6 +517,7 @@ int_t zsparseTreeFactor_ASYNC(
             {
                 /*If LU panels from GPU are not reduced then reduce
                 them before diagonal factorization*/
+		zancReduceWait(k, LUstruct, grid3d, SCT);
 #if 0
                 sDiagFactIBCast(k, dFBufs[offset], factStat, comReqss[offset], grid,
                                 options, thresh, LUstruct, stat, info, SCT, tag_ub);
@@ -469,6 +611,10 @@ int_t zsparseTreeFactor_ASYNC(
             int_t k = perm_c_supno[k0];   // direct computation no perm_c_supno
             int_t offset = k0 % numLA;
 
+	    /* add in the ancestor pieces that have arrived meanwhile */
+	    zancReduceProgress(LUstruct, grid3d);
+	    double tnode = SuperLU_timer_();
+
 #if 0
             sWaitL(k, comReqss[offset], msgss[offset], grid, LUstruct, SCT);
             /*Wait for U panel*/
@@ -492,6 +638,8 @@ int_t zsparseTreeFactor_ASYNC(
             int_t jj_cpu = 0;
 
             scuStatUpdate( SuperSize(k), HyP,  SCT, stat);
+	    /* storage for the ancestor blocks it updates, if lazy */
+	    zancLazyAlloc(HyP, LUstruct, grid);
             uPanelInfo_t* uPanelInfo = packLUInfo->uPanelInfo;
             lPanelInfo_t* lPanelInfo = packLUInfo->lPanelInfo;
             int_t *lsub = lPanelInfo->lsub;
@@ -565,6 +713,7 @@ int_t zsparseTreeFactor_ASYNC(
                         /* code */
                         assert(k0_parent < nnodes);
                         int_t offset = k0_parent - k_end;
+			zancReduceWait(k_parent, LUstruct, grid3d, SCT);
 #if 0
                         sDiagFactIBCast(k_parent,  dFBufs[offset], factStat,
 					comReqss[offset], grid, options, thresh,
@@ -750,6 +899,9 @@ int_t zsparseTreeFactor_ASYNC(
                 }
 
             }
+
+	    if ( LUstruct->Llu->nodeCost ) /* SUPERLU_LBS_COST */
+		LUstruct->Llu->nodeCost[k] += SuperLU_timer_() - tnode;
         }/*for main loop (int_t k0 = 0; k0 < gNodeCount[tree]; ++k0)*/
 
     }
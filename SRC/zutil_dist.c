@@ -444,6 +444,7 @@ int zDeAllocGlu_3d(zLUstruct_t * LUstruct)
 {
     SUPERLU_FREE(LUstruct->Glu_persist->xsup);
     SUPERLU_FREE(LUstruct->Glu_persist->supno);
+    LUstruct->Glu_persist->xsup = LUstruct->Glu_persist->supno = NULL;
     return 0;
 }
 
@@ -459,16 +460,19 @@ int zDeAllocLlu_3d(int_t n, zLUstruct_t * LUstruct, gridinfo3d_t* grid3d)
     for (i = 0; i < nbc; ++i) 
 	if ( Llu->Lrowind_bc_ptr[i] ) {
 	    SUPERLU_FREE (Llu->Lrowind_bc_ptr[i]);
-	    SUPERLU_FREE (Llu->Lnzval_bc_ptr[i]);
+	    /* may be unallocated with lazy ancestor storage */
+	    if ( Llu->Lnzval_bc_ptr[i] ) SUPERLU_FREE (Llu->Lnzval_bc_ptr[i]);
 	}
     SUPERLU_FREE (Llu->Lrowind_bc_ptr);
     SUPERLU_FREE (Llu->Lnzval_bc_ptr);
+    Llu->Lrowind_bc_ptr = NULL; /* tells pdgssvx3d() the structure is gone */
+    Llu->Lnzval_bc_ptr = NULL;
 
     nbr = CEILING(nsupers, grid3d->nprow);
     for (i = 0; i < nbr; ++i)
 	if ( Llu->Ufstnz_br_ptr[i] ) {
 	    SUPERLU_FREE (Llu->Ufstnz_br_ptr[i]);
-	    SUPERLU_FREE (Llu->Unzval_br_ptr[i]);
+	    if ( Llu->Unzval_br_ptr[i] ) SUPERLU_FREE (Llu->Unzval_br_ptr[i]);
 	}
     SUPERLU_FREE (Llu->Ufstnz_br_ptr);
     SUPERLU_FREE (Llu->Unzval_br_ptr);
@@ -573,24 +577,21 @@ int file_PrintDoublecomplex(FILE *fp, char *name, int_t len, doublecomplex *x)
 void zPrintLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, zLocalLU_t *Llu)
 {
-    register int c, extra, gb, j, lb, nsupc, nsupr, len, nb, ncb;
-    register int_t k, mycol, r;
+    register int c, gb, j, lb, nsupc, nsupr, len, nb, ncb;
+    register int_t k, r;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
     doublecomplex *nzval;
 
     printf("\n[%d] L BLOCKS IN COLUMN-MAJOR ORDER -->\n", iam);
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nb = index[0];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    printf("[%d] block column %d (local # %d), nsupc %d, # row blocks %d\n",
 		   iam, gb, lb, nsupc, nb);
@@ -611,7 +612,7 @@ void zPrintLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 	PrintInt32("fsendx_plist[]", grid->nprow, Llu->fsendx_plist[lb]);
     }
     printf("nfrecvx %d\n", Llu->nfrecvx);
-    k = CEILING( nsupers, grid->nprow );
+    k = NLBi( nsupers, grid );
     PrintInt32("fmod", k, Llu->fmod);
 
 } /* ZPRINTLBLOCKS */
@@ -622,8 +623,8 @@ void zPrintLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void zZeroLblocks(int iam, int n, gridinfo_t *grid, zLUstruct_t *LUstruct)
 {
     doublecomplex zero = {0.0, 0.0};
-    register int extra, gb, j, lb, nsupc, nsupr, ncb;
-    register int k, mycol, r;
+    register int gb, j, lb, nsupc, nsupr, ncb;
+    register int k, r;
     zLocalLU_t *Llu = LUstruct->Llu;
     Glu_persist_t *Glu_persist = LUstruct->Glu_persist;
     int_t *xsup = Glu_persist->xsup;
@@ -631,16 +632,13 @@ void zZeroLblocks(int iam, int n, gridinfo_t *grid, zLUstruct_t *LUstruct)
     doublecomplex *nzval;
     int nsupers = Glu_persist->supno[n-1] + 1;
 
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (j = 0; j < nsupc; ++j) {
                 for (r = 0; r < nsupr; ++r) {
@@ -657,8 +655,8 @@ void zZeroLblocks(int iam, int n, gridinfo_t *grid, zLUstruct_t *LUstruct)
 void zDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, zLocalLU_t *Llu)
 {
-    register int c, extra, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
-    int k, mycol, r, n, nmax;
+    register int c, gb, j, i, lb, nsupc, nsupr, len, nb, ncb;
+    int k, r, n, nmax;
     int_t nnzL;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
@@ -671,17 +669,14 @@ void zDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 	// count nonzeros in the first pass
 	nnzL = 0;
 	n = 0;
-    ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+    ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nb = index[0];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -715,17 +710,14 @@ void zDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		fprintf(fp, "%d %d " IFMT "\n", n,n,nnzL);
 	}
 
-     ncb = nsupers / grid->npcol;
-    extra = nsupers % grid->npcol;
-    mycol = MYCOL( iam, grid );
-    if ( mycol < extra ) ++ncb;
+     ncb = MyNLBj( nsupers, grid );
     for (lb = 0; lb < ncb; ++lb) {
 	index = Llu->Lrowind_bc_ptr[lb];
 	if ( index ) { /* Not an empty column */
 	    nzval = Llu->Lnzval_bc_ptr[lb];
 	    nb = index[0];
 	    nsupr = index[1];
-	    gb = lb * grid->npcol + mycol;
+	    gb = GBj( lb, grid );
 	    nsupc = SuperSize( gb );
 	    for (c = 0, k = BC_HEADER, r = 0; c < nb; ++c) {
 		len = index[k+1];
@@ -753,24 +745,21 @@ void zDumpLblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void zPrintUblocks(int iam, int_t nsupers, gridinfo_t *grid,
 		  Glu_persist_t *Glu_persist, zLocalLU_t *Llu)
 {
-    register int c, extra, jb, k, lb, len, nb, nrb, nsupc;
-    register int_t myrow, r;
+    register int c, jb, k, lb, len, nb, nrb, nsupc;
+    register int_t r;
     int_t *xsup = Glu_persist->xsup;
     int_t *index;
     doublecomplex *nzval;
 
     printf("\n[%d] U BLOCKS IN ROW-MAJOR ORDER -->\n", iam);
-    nrb = nsupers / grid->nprow;
-    extra = nsupers % grid->nprow;
-    myrow = MYROW( iam, grid );
-    if ( myrow < extra ) ++nrb;
+    nrb = MyNLBi( nsupers, grid );
     for (lb = 0; lb < nrb; ++lb) {
 	index = Llu->Ufstnz_br_ptr[lb];
 	if ( index ) { /* Not an empty row */
 	    nzval = Llu->Unzval_br_ptr[lb];
 	    nb = index[0];
 	    printf("[%d] block row " IFMT " (local # %d), # column blocks %d\n",
-		   iam, lb*grid->nprow+myrow, lb, nb);
+		   iam, GBi( lb, grid ), lb, nb);
 	    r  = 0;
 	    for (c = 0, k = BR_HEADER; c < nb; ++c) {
 		jb = index[k];
@@ -794,8 +783,8 @@ void zPrintUblocks(int iam, int_t nsupers, gridinfo_t *grid,
 void zZeroUblocks(int iam, int n, gridinfo_t *grid, zLUstruct_t *LUstruct)
 {
     doublecomplex zero = {0.0, 0.0};
-    register int_t i, extra, lb, len, nrb;
-    register int myrow, r;
+    register int_t i, lb, len, nrb;
+    register int r;
     zLocalLU_t *Llu = LUstruct->Llu;
     Glu_persist_t *Glu_persist = LUstruct->Glu_persist;
     int_t *xsup = Glu_persist->xsup;
@@ -803,10 +792,7 @@ void zZeroUblocks(int iam, int n, gridinfo_t *grid, zLUstruct_t *LUstruct)
     doublecomplex *nzval;
     int nsupers = Glu_persist->supno[n-1] + 1;
 
-    nrb = nsupers / grid->nprow;
-    extra = nsupers % grid->nprow;
-    myrow = MYROW( iam, grid );
-    if ( myrow < extra ) ++nrb;
+    nrb = MyNLBi( nsupers, grid );
     for (lb = 0; lb < nrb; ++lb) {
 	index = Llu->Ufstnz_br_ptr[lb];
 	if ( index ) { /* Not an empty row */
@@ -38,6 +38,7 @@ at the top-level directory.
 #define NTESTS 1 /*5*/      /* Number of test types */
 #define NTRAN  2    
 #define THRESH 20.0
+#define PRED_TOL 0.05   /* relative error allowed in the predicted flops */
 #define FMT1   "%10s:n=%d, test(%d)=%12.5g\n"
 #define	FMT2   "%10s:fact=%4d, DiagScale=%d, n=%d, imat=%d, test(%d)=%12.5g, berr=%12.5g\n"
 #define FMT3   "%10s:info=%d, izero=%d, n=%d, nrhs=%d, imat=%d, nfail=%d\n"
@@ -132,6 +133,8 @@ int main(int argc, char *argv[])
     fact_t fact;
     double rowcnd, colcnd, amax;
     double result[NTESTS];
+    superlu_predict_t pred;
+    float  flopcnt;
 
     /* Fixed set of parameters */
     int     iseed[]  = {1988, 1989, 1990, 1991};
@@ -347,6 +350,15 @@ int main(int argc, char *argv[])
 		        /* Set the right-hand side. */
 		        dCopy_Dense_Matrix_dist(m_loc, nrhs, bsave, ldb, b, ldb);
 
+		        /* Predict the cost of a new factorization from the
+			   symbolic analysis alone, to check it below. */
+		        if ( options.Fact == DOFACT ) {
+			    pred.nprow = nprow;
+			    pred.npcol = npcol;
+			    pdsymbfact_predict(&options, &A, &ScalePermstruct,
+					       &grid, 1, &pred);
+		        }
+
 		        PStatInit(&stat);
 
 		    /*if ( !iam ) printf("\ttest pdgssvx: nrun %d, iequed %d, equil %d, fact %d\n", 
@@ -356,6 +368,19 @@ int main(int argc, char *argv[])
 			    &grid, &LUstruct, &SOLVEstruct,
 			    berr, &stat, &info);
 
+		        if ( options.Fact == DOFACT && !info ) {
+			    MPI_Allreduce(&stat.ops[FACT], &flopcnt, 1, MPI_FLOAT,
+					  MPI_SUM, grid.comm);
+			    if ( fabs(pred.flops - flopcnt) > PRED_TOL * flopcnt ) {
+			        if ( !iam )
+				    printf("pdsymbfact_predict: predicted flops %e,"
+					   " factorization %e\n", pred.flops,
+					   (double) flopcnt);
+			        ++nfail;
+			    }
+			    ++nrun;
+		        }
+
 		        PStatFree(&stat);
 #if 0
 		        pdinf_norm_error(iam, ((NRformat_loc *)A.Store)->m_loc,